@@ -0,0 +1,107 @@
+/*
+ *  bit_stream.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Header file for the BitWriter and BitReader objects, which allow values
+ *      of arbitrary bit width to be packed into and unpacked from a DataBuffer.
+ *      Bits are written most significant bit first, so a value that spans
+ *      octets appears in network byte order.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BIT_STREAM_H
+#define BIT_STREAM_H
+
+#include <cstdint>
+#include <cstddef>
+#include "data_buffer.h"
+
+namespace gs
+{
+
+// BitWriter object declaration
+class BitWriter
+{
+    public:
+        BitWriter(DataBuffer &data_buffer);
+        ~BitWriter() = default;
+
+        // Functions to write values to the accumulator
+        void Write(std::uint64_t value, unsigned bits);
+        void WriteBoolean(bool value);
+
+        // Function to write all accumulated bits to the data buffer,
+        // padding with zero bits to an octet boundary
+        std::size_t Flush();
+
+        // Function to return the number of bits written, including padding
+        std::size_t GetBitLength() const;
+
+    protected:
+        void FlushOctets();
+
+        DataBuffer &data_buffer;                // Buffer being written
+        std::uint64_t accumulator;              // Bits not yet written
+        unsigned accumulated;                   // Bits in the accumulator
+        std::size_t bit_length;                 // Number of bits written
+};
+
+// BitReader object declaration
+class BitReader
+{
+    public:
+        BitReader(DataBuffer &data_buffer);
+        ~BitReader() = default;
+
+        // Functions to read values from the data buffer
+        std::uint64_t Read(unsigned bits);
+        bool ReadBoolean();
+
+        // Function to consume the octets read from the data buffer,
+        // discarding any unread bits in the final octet
+        std::size_t Align();
+
+    protected:
+        DataBuffer &data_buffer;                // Buffer being read
+        std::size_t offset;                     // Offset of first octet
+        std::size_t position;                   // Bits read after offset
+};
+
+} // namespace gs
+
+#endif // BIT_STREAM_H
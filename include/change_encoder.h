@@ -0,0 +1,100 @@
+/*
+ *  change_encoder.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the ChangeEncoder object, which remembers the last
+ *      state sent for each object and encodes only those objects whose state
+ *      has since changed.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CHANGE_ENCODER_H
+#define CHANGE_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "data_buffer.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// ChangeEncoder object declaration
+class ChangeEncoder
+{
+    public:
+        ChangeEncoder(float epsilon = 0.0f);
+        ~ChangeEncoder() = default;
+
+        // Function to encode objects that have changed since last sent
+        EncodeResult Encode(DataBuffer &data_buffer, const GSObjects &value);
+        EncodeResult Encode(DataBuffer &data_buffer, const GSObject &value);
+
+        // Function to return the number of unchanged objects skipped by the
+        // last call to Encode()
+        std::size_t GetUnchangedCount() const { return unchanged_count; }
+
+        // Function to forget the state sent for an object, so that it is
+        // sent again even if unchanged
+        bool Invalidate(std::uint64_t id);
+
+        // Function to forget the state sent for all objects
+        void Reset();
+
+    protected:
+        EncodeResult EncodeObject(DataBuffer &data_buffer,
+                                  const GSObject &value);
+        bool HasChanged(const GSObject &value,
+                        std::uint64_t &mesh_hash) const;
+        void Record(const GSObject &value, std::uint64_t mesh_hash);
+
+        Encoder encoder;                        // Encoder object
+        float epsilon;                          // Tolerance for changes
+        std::size_t unchanged_count;            // Unchanged objects skipped
+        ObjectStore<std::optional<GSObject>, std::optional<std::uint64_t>>
+            last_sent;                          // Last state sent (except
+                                                // for meshes) and hash of
+                                                // the last mesh sent
+};
+
+} // namespace gs
+
+#endif // CHANGE_ENCODER_H
@@ -0,0 +1,135 @@
+/*
+ *  compressor.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Header file for the Compressor object, which is an optional stage
+ *      between the Encoder and the transport that compresses a packet of
+ *      encoded objects using a fast LZ77-class algorithm or, optionally, a
+ *      static entropy coder.  Each packet is
+ *      framed so that the receiver can tell whether it was compressed, and
+ *      compression is applied only when the packet is large enough and the
+ *      result is sufficiently smaller than the original.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef COMPRESSOR_H
+#define COMPRESSOR_H
+
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <optional>
+#include "data_buffer.h"
+#include "entropy_coder.h"
+
+namespace gs
+{
+
+// CompressorException exception definition
+class CompressorException : public std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// Method octet that begins each compressed packet frame
+enum class CompressionMethod : std::uint8_t
+{
+    Stored  = 0x00,                     // Payload follows unchanged
+    LZ      = 0x01,                     // Length and LZ block follow
+    Entropy = 0x02                      // Length and rANS coded data follow
+};
+
+// Options controlling when compression is applied to a packet
+struct CompressionOptions
+{
+    std::size_t min_length{128};        // Packets shorter than this are
+                                        // stored without compression
+    unsigned max_percent{90};           // Compressed frames larger than this
+                                        // percentage of the packet length
+                                        // are stored instead
+    bool entropy_coding{false};         // Also try the entropy coder, using
+                                        // whichever method is smaller
+};
+
+// Compressor object declaration
+class Compressor
+{
+    public:
+        Compressor();
+        ~Compressor() = default;
+
+        // Function to compress the data in one buffer, appending the framed
+        // packet to another
+        std::size_t Compress(const DataBuffer &input,
+                             DataBuffer &output,
+                             const CompressionOptions &options = {});
+
+        // Function to decompress a framed packet, appending the original
+        // data to the output buffer
+        std::size_t Decompress(DataBuffer &input, DataBuffer &output);
+
+        // Function to return the largest possible LZ block length
+        static std::size_t GetMaxBlockLength(std::size_t length);
+
+        // Function to set the static table used for entropy coding, which
+        // must be the same at both endpoints
+        void SetEntropyCoder(const EntropyCoder &coder)
+        {
+            entropy_coder = coder;
+        }
+
+    protected:
+        std::size_t CompressBlock(const unsigned char *input,
+                                  std::size_t length,
+                                  unsigned char *output);
+        void DecompressBlock(const unsigned char *input,
+                             std::size_t length,
+                             unsigned char *output,
+                             std::size_t output_length);
+
+        std::vector<std::uint32_t> hash_table;  // Recent match positions
+        std::vector<unsigned char> block;       // Compressed block scratch
+        std::vector<unsigned char> coded;       // Entropy coded scratch
+        std::optional<EntropyCoder> entropy_coder;
+                                                // Static entropy coder
+};
+
+} // namespace gs
+
+#endif // COMPRESSOR_H
@@ -0,0 +1,138 @@
+/*
+ *  dead_reckoning.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the DeadReckoningEncoder object, which suppresses
+ *      updates to heads and hands whose position is predicted by their last
+ *      sent velocity, and the DeadReckoningExtrapolator object, which makes the
+ *      same predictions at the receiver.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DEAD_RECKONING_H
+#define DEAD_RECKONING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "data_buffer.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Thresholds beyond which the DeadReckoningEncoder sends an update
+struct DeadReckoningThresholds
+{
+    float position{0.01f};                      // Prediction error (meters)
+                                                // and joint change
+    float rotation{0.01f};                      // Rotation component change
+    std::uint16_t max_interval{1000};           // Longest time between
+                                                // updates (ms, at most
+                                                // 32767), or zero
+};
+
+// Function to predict a position from a location and its velocity
+Loc1 PredictLocation(const Loc2 &location, Time1 from, Time1 to);
+
+// DeadReckoningEncoder object declaration
+class DeadReckoningEncoder
+{
+    public:
+        DeadReckoningEncoder(const DeadReckoningThresholds &thresholds = {});
+        ~DeadReckoningEncoder() = default;
+
+        // Function to encode objects whose state is not predicted by the
+        // state last sent
+        EncodeResult Encode(DataBuffer &data_buffer, const GSObjects &value);
+        EncodeResult Encode(DataBuffer &data_buffer, const GSObject &value);
+
+        // Function to return the number of objects suppressed by the last
+        // call to Encode()
+        std::size_t GetSuppressedCount() const { return suppressed_count; }
+
+        // Function to forget the state sent for an object, so that it is
+        // sent again
+        bool Invalidate(std::uint64_t id);
+
+        // Function to forget the state sent for all objects
+        void Reset() { last_sent.Clear(); }
+
+    protected:
+        EncodeResult EncodeObject(DataBuffer &data_buffer,
+                                  const GSObject &value);
+        bool IsPredicted(const GSObject &value) const;
+
+        Encoder encoder;                        // Encoder object
+        DeadReckoningThresholds thresholds;     // Configured thresholds
+        std::size_t suppressed_count;           // Objects suppressed
+        ObjectStore<GSObject> last_sent;        // Last head or hand sent
+};
+
+// DeadReckoningExtrapolator object declaration
+class DeadReckoningExtrapolator
+{
+    public:
+        DeadReckoningExtrapolator() = default;
+        ~DeadReckoningExtrapolator() = default;
+
+        // Function to record the state of a received object
+        bool Update(const GSObject &value);
+
+        // Function to predict the position of an object at the given time
+        std::optional<Loc1> Predict(std::uint64_t id, Time1 time) const;
+
+        // Function to forget an object
+        bool Remove(std::uint64_t id) { return received.Remove(id); }
+
+    protected:
+        // Location and time last received for an object
+        struct State
+        {
+            Loc2 location;
+            Time1 time;
+        };
+
+        ObjectStore<State> received;            // State of each object
+};
+
+} // namespace gs
+
+#endif // DEAD_RECKONING_H
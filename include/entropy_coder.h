@@ -0,0 +1,114 @@
+/*
+ *  entropy_coder.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Header file for the EntropyCoder object, which codes octets using range
+ *      asymmetric numeral systems (rANS) with a static symbol frequency table.
+ *      The table is intended to be trained offline from captured packets and
+ *      shared by both endpoints.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ENTROPY_CODER_H
+#define ENTROPY_CODER_H
+
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include "data_buffer.h"
+
+namespace gs
+{
+
+// EntropyCoderException exception definition
+class EntropyCoderException : public std::runtime_error
+{
+    using std::runtime_error::runtime_error;
+};
+
+// Symbol counts from which an EntropyCoder's frequency table is built
+typedef std::array<std::uint64_t, 256> SymbolCounts;
+
+// EntropyCoder object declaration
+class EntropyCoder
+{
+    public:
+        // Frequencies are scaled so that they sum to 1 << Scale_Bits
+        static constexpr unsigned Scale_Bits = 12;
+
+        EntropyCoder();
+        EntropyCoder(const SymbolCounts &counts);
+        ~EntropyCoder() = default;
+
+        // Function to add the octets in a buffer to a set of counts
+        static void CountSymbols(const DataBuffer &data_buffer,
+                                 SymbolCounts &counts);
+
+        // Function to return the scaled frequency table
+        const std::array<std::uint16_t, 256> &GetFrequencies() const
+        {
+            return frequency;
+        }
+
+        // Function to return the largest possible encoded length
+        static std::size_t GetMaxEncodedLength(std::size_t length);
+
+        // Functions to encode and decode octets
+        std::size_t Encode(const unsigned char *input,
+                           std::size_t length,
+                           unsigned char *output,
+                           std::size_t output_size) const;
+        void Decode(const unsigned char *input,
+                    std::size_t length,
+                    unsigned char *output,
+                    std::size_t output_length) const;
+
+    protected:
+        void BuildTables();
+
+        std::array<std::uint16_t, 256> frequency;   // Scaled frequencies
+        std::array<std::uint16_t, 256> cumulative;  // Sum of frequencies of
+                                                    // preceding symbols
+        std::array<std::uint8_t, 1 << Scale_Bits> symbol;
+                                                    // Symbol for each slot
+};
+
+} // namespace gs
+
+#endif // ENTROPY_CODER_H
@@ -48,11 +48,15 @@
 
 #include <stdexcept>
 #include <cstddef>
+#include <cstdint>
 #include <string>
+#include <optional>
 #include <vector>
 #include "data_buffer.h"
+#include "bit_stream.h"
 #include "gs_types.h"
 #include "gs_deserializer.h"
+#include "object_id_mapper.h"
 
 namespace gs
 {
@@ -63,6 +67,13 @@ class DecoderException : public std::runtime_error
     using std::runtime_error::runtime_error;
 };
 
+// Axis-aligned bounding box of a decoded mesh
+struct MeshBounds
+{
+    Loc1 min;
+    Loc1 max;
+};
+
 // Game State Decoder object
 class Decoder
 {
@@ -70,22 +81,77 @@ class Decoder
         Decoder() = default;
         ~Decoder() = default;
 
-        // Function to decode all objects found in the given buffer
-        std::size_t Decode(DataBuffer &data_buffer, GSObjects &value);
+        // Set the maximum number of threads used to deserialize large vectors
+        // (zero to use all hardware threads)
+        void SetMaxThreads(std::size_t threads) { max_threads = threads; }
+
+        // Function to decode all objects found in the given buffer (mesh
+        // triangle indices are checked unless validate is false)
+        std::size_t Decode(DataBuffer &data_buffer,
+                           GSObjects &value,
+                           bool validate = true);
+
+        // Function to decode all objects found in the given buffer, also
+        // returning the bounding box of each mesh
+        std::size_t Decode(DataBuffer &data_buffer,
+                           GSObjects &value,
+                           std::vector<std::optional<MeshBounds>> &bounds,
+                           bool validate = true);
+
+        // Function to decode all objects found in the given buffer, also
+        // returning the dense handle the mapper assigns each object
+        std::size_t Decode(DataBuffer &data_buffer,
+                           GSObjects &value,
+                           ObjectIDMapper &mapper,
+                           std::vector<ObjectHandle> &handles,
+                           bool validate = true);
 
         // Function to decode the next object from the given data buffer
-        std::size_t Decode(DataBuffer &data_buffer, GSObject &value);
+        std::size_t Decode(DataBuffer &data_buffer,
+                           GSObject &value,
+                           bool validate = true);
+
+        // Function to decode the next object from the given data buffer,
+        // appending any further objects expanded from a compound object
+        std::size_t Decode(DataBuffer &data_buffer,
+                           GSObject &value,
+                           GSObjects &expanded,
+                           bool validate = true);
 
     protected:
+        // Function to decode the next object, expanding compound objects
+        // into the given vector, returning the bounds of a mesh if not null
+        // and checking mesh triangle indices if validate is true
+        std::size_t DecodeObject(DataBuffer &data_buffer,
+                                 GSObject &value,
+                                 GSObjects *expanded,
+                                 MeshBounds *mesh_bounds,
+                                 bool validate);
+
         // Function to decode high-level objects
         std::size_t Decode(DataBuffer &data_buffer, Object1 &value);
         std::size_t Decode(DataBuffer &data_buffer, Head1 &value);
         std::size_t Decode(DataBuffer &data_buffer, Hand1 &value);
         std::size_t Decode(DataBuffer &data_buffer, Hand2 &value);
-        std::size_t Decode(DataBuffer &data_buffer, Mesh1 &value);
+        std::size_t Decode(DataBuffer &data_buffer,
+                           Mesh1 &value,
+                           MeshBounds *mesh_bounds,
+                           bool validate);
         std::size_t Decode(DataBuffer &data_buffer, HeadIPD1 &value);
         std::size_t Decode(DataBuffer &data_buffer, UnknownObject &value);
 
+        // Function to decode objects serialized using a compact encoding
+        std::size_t DecodeCompact(DataBuffer &data_buffer,
+                                  Mesh1 &value,
+                                  MeshBounds *mesh_bounds,
+                                  bool validate);
+        std::size_t DecodeCompact(DataBuffer &data_buffer, Object1 &value);
+        std::size_t DecodeCompact(DataBuffer &data_buffer, Head1 &value);
+        std::size_t DecodeCompact(DataBuffer &data_buffer, Hand1 &value);
+        std::size_t DecodeCompact(DataBuffer &data_buffer, Hand2 &value);
+        std::size_t DecodeCompact(DataBuffer &data_buffer,
+                                  PlayerFrame1 &value);
+
         // Ensure no implicit conversions calling Decode
         template <typename T>
         std::size_t Decode(DataBuffer &data_buffer, T &value) = delete;
@@ -104,6 +170,99 @@ class Decoder
         std::size_t Deserialize(DataBuffer &data_buffer, Thumb &value);
         std::size_t Deserialize(DataBuffer &data_buffer, Finger &value);
 
+        // Deserialization function for mesh vertices, computing their bounds
+        // if not null
+        std::size_t DeserializeVertices(DataBuffer &data_buffer,
+                                        std::vector<Loc1> &values,
+                                        MeshBounds *bounds);
+
+        // Deserialization function for triangle indices, optionally ensuring
+        // each refers to one of the given number of vertices
+        std::size_t DeserializeIndices(DataBuffer &data_buffer,
+                                       std::vector<VarUint> &values,
+                                       std::size_t vertex_count,
+                                       bool validate);
+
+        // Function to ensure triangle indices refer to existing vertices
+        void ValidateIndices(const VarUint *values,
+                             std::size_t count,
+                             std::size_t vertex_count);
+
+        // Deserialization function for delta-coded index vectors, optionally
+        // ensuring each refers to one of the given number of vertices
+        std::size_t DeserializeDeltas(DataBuffer &data_buffer,
+                                      std::vector<VarUint> &values,
+                                      std::size_t vertex_count,
+                                      bool validate);
+
+        // Deserialization functions for quantized and predicted vertex
+        // vectors, computing their bounds if not null
+        std::size_t DeserializeQuantized(DataBuffer &data_buffer,
+                                         std::vector<Loc1> &values,
+                                         MeshBounds *bounds);
+        std::size_t DeserializePredicted(DataBuffer &data_buffer,
+                                         std::vector<Loc1> &values,
+                                         const std::vector<VarUint> &triangles,
+                                         MeshBounds *bounds);
+
+        // Deserialization function for octahedral normal vectors
+        std::size_t DeserializeOctahedral(DataBuffer &data_buffer,
+                                          std::vector<Norm1> &values);
+
+        // Deserialization functions for compact object header and fields
+        std::size_t DeserializeObjectFlags(DataBuffer &data_buffer,
+                                           std::uint64_t fields,
+                                           VarUint &flags,
+                                           std::uint8_t &rotation_bits,
+                                           VarUint &presence);
+        std::size_t DeserializePresence(DataBuffer &data_buffer,
+                                        std::uint64_t fields,
+                                        VarUint &presence);
+        std::size_t DeserializeFields(DataBuffer &data_buffer,
+                                      Head1 &value,
+                                      std::uint8_t rotation_bits,
+                                      const VarUint &presence);
+        std::size_t DeserializeFields(DataBuffer &data_buffer,
+                                      Hand2 &value,
+                                      const VarUint &flags,
+                                      std::uint8_t rotation_bits,
+                                      const VarUint &presence);
+        std::size_t DeserializeLocation(DataBuffer &data_buffer,
+                                        Loc2 &value,
+                                        const VarUint &presence);
+
+        // Deserialization functions for rotations that may be compressed
+        std::size_t DeserializeRotation(DataBuffer &data_buffer,
+                                        Rot1 &value,
+                                        std::uint8_t bits);
+        std::size_t DeserializeRotation(DataBuffer &data_buffer,
+                                        Rot2 &value,
+                                        std::uint8_t bits);
+
+        // Deserialization function for compressed rotations
+        std::size_t DeserializeCompressed(DataBuffer &data_buffer,
+                                          Rot1 *values,
+                                          std::size_t count,
+                                          std::uint8_t bits);
+
+        // Deserialization functions for quantized Hand2 joints
+        std::size_t DeserializeJoints(DataBuffer &data_buffer, Hand2 &value);
+        void DeserializeJoint(BitReader &reader,
+                              Transform1 &value,
+                              std::uint8_t bits,
+                              float range,
+                              float step);
+        void DeserializeJoint(BitReader &reader,
+                              Thumb &value,
+                              std::uint8_t bits,
+                              float range,
+                              float step);
+        void DeserializeJoint(BitReader &reader,
+                              Finger &value,
+                              std::uint8_t bits,
+                              float range,
+                              float step);
+
         // Deserialization function for a Blob type
         std::size_t Deserialize(DataBuffer &data_buffer, Blob &value)
         {
@@ -115,6 +274,21 @@ class Decoder
         std::size_t Deserialize(DataBuffer &data_buffer,
                                 std::vector<T> &values);
 
+        // Deserialization function for vectors, examining each block of
+        // elements as it is deserialized
+        template <typename T, typename V>
+        std::size_t DeserializeVector(DataBuffer &data_buffer,
+                                      std::vector<T> &values,
+                                      const V &visit);
+
+        // Deserialization function for large vectors using multiple threads
+        template <typename T, typename V>
+        std::size_t DeserializeParallel(DataBuffer &data_buffer,
+                                        std::vector<T> &values,
+                                        std::size_t count,
+                                        std::size_t chunks,
+                                        const V &visit);
+
         // Deserialization function for all other types
         template <typename T>
         std::size_t Deserialize(DataBuffer &data_buffer, T &value)
@@ -123,6 +297,7 @@ class Decoder
         }
 
         Deserializer deserializer;              // Deserializer object
+        std::size_t max_threads{1};             // Threads used for vectors
 };
 
 } // namespace gs
@@ -53,10 +53,13 @@
 #define GS_ENCODER_H
 
 #include <utility>
+#include <functional>
 #include <stdexcept>
 #include <string>
 #include <cstddef>
+#include <cstdint>
 #include "data_buffer.h"
+#include "bit_stream.h"
 #include "gs_types.h"
 #include "gs_serializer.h"
 
@@ -73,6 +76,58 @@ class EncoderException : public std::runtime_error
 // count of octets serialized
 typedef std::pair<std::size_t, std::size_t> EncodeResult;
 
+// Options controlling how a Mesh1 is serialized as a CompactMesh1
+struct MeshEncoding
+{
+    bool delta_indices{true};           // Delta-code the triangle indices
+    bool reorder_triangles{false};      // Reorder triangles for locality
+    std::uint8_t position_bits{};       // Bits per vertex component (1-16)
+                                        // or zero to send Float32 values
+    std::uint8_t normal_bits{};         // Bits per octahedral normal
+                                        // coordinate (1-16) or zero to
+                                        // send Norm1 values
+    bool predict_positions{false};      // Send quantized positions as
+                                        // parallelogram prediction
+                                        // residuals (needs position_bits)
+    bool weld_vertices{false};          // Merge duplicate vertices before
+                                        // serializing
+};
+
+// Producers of the elements of a Mesh1, allowing a mesh to be encoded
+// without first holding it in memory.  Each producer is called with an
+// element index less than the corresponding count and must return the same
+// value each time it is called with a given index.
+struct MeshSource
+{
+    ObjectID id;
+    std::size_t vertex_count{};
+    std::function<Loc1(std::size_t)> vertex;
+    std::size_t normal_count{};
+    std::function<Norm1(std::size_t)> normal;
+    std::size_t texture_count{};
+    std::function<TextureUV1(std::size_t)> texture;
+    std::size_t triangle_count{};               // Number of indices
+    std::function<VarUint(std::size_t)> triangle;
+};
+
+// Options controlling how high-rate objects are serialized as
+// CompactObject1, CompactHead1, CompactHand1, CompactHand2, or PlayerFrame1
+// objects
+struct ObjectEncoding
+{
+    std::uint8_t rotation_bits{};       // Bits per smallest-three rotation
+                                        // component (2-20) or zero to send
+                                        // Float16 values
+    std::uint8_t joint_bits{};          // Bits per Hand2 joint component
+                                        // (1-16) or zero to send Float16
+                                        // values
+    float joint_range{0.25f};           // Joint components are quantized
+                                        // over [-joint_range, joint_range]
+    bool omit_defaults{false};          // Omit fields having default values
+    bool omit_velocity{false};          // Omit head and hand velocities
+                                        // (needs omit_defaults)
+};
+
 // Game State Encoder object
 class Encoder
 {
@@ -80,6 +135,10 @@ class Encoder
         Encoder() = default;
         ~Encoder() = default;
 
+        // Set the maximum number of threads used to serialize large vectors
+        // (zero to use all hardware threads)
+        void SetMaxThreads(std::size_t threads) { max_threads = threads; }
+
         // Function to encode a vector of objects
         EncodeResult Encode(DataBuffer &data_buffer, const GSObjects &value);
 
@@ -96,6 +155,31 @@ class Encoder
         EncodeResult Encode(DataBuffer &data_buffer,
                             const UnknownObject &value);
 
+        // Function to encode objects using a compact encoding
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const Mesh1 &value,
+                            const MeshEncoding &encoding);
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const Object1 &value,
+                            const ObjectEncoding &encoding);
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const Head1 &value,
+                            const ObjectEncoding &encoding);
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const Hand1 &value,
+                            const ObjectEncoding &encoding);
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const Hand2 &value,
+                            const ObjectEncoding &encoding);
+
+        // Function to encode a Mesh1 whose elements are produced on demand
+        EncodeResult Encode(DataBuffer &data_buffer, const MeshSource &value);
+
+        // Function to encode a user's head and hands as one object
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const PlayerFrame1 &value,
+                            const ObjectEncoding &encoding);
+
         // Determine the required buffer length to encode objects
         template <typename T>
         EncodeResult GetEncodeLength(const T &value)
@@ -103,6 +187,13 @@ class Encoder
             return Encode(null_buffer, value);
         }
 
+        // Determine the required buffer length to compactly encode objects
+        template <typename T, typename E>
+        EncodeResult GetEncodeLength(const T &value, const E &encoding)
+        {
+            return Encode(null_buffer, value, encoding);
+        }
+
         // Ensure no implicit conversions calling Encode
         template <typename T>
         EncodeResult Encode(DataBuffer &data_buffer, const T &value) = delete;
@@ -121,6 +212,118 @@ class Encoder
         std::size_t Serialize(DataBuffer &data_buffer, const Thumb &value);
         std::size_t Serialize(DataBuffer &data_buffer, const Finger &value);
 
+        // Serialization function for delta-coded index vectors
+        std::size_t SerializeDeltas(DataBuffer &data_buffer,
+                                    const std::vector<VarUint> &values);
+
+        // Serialization function for quantized vertex vectors
+        std::size_t SerializeQuantized(DataBuffer &data_buffer,
+                                       const std::vector<Loc1> &values,
+                                       std::uint8_t bits,
+                                       const Loc1 &min,
+                                       const Loc1 &max);
+
+        // Serialization function for predicted vertex vectors
+        std::size_t SerializePredicted(DataBuffer &data_buffer,
+                                       const std::vector<std::int32_t> &values,
+                                       std::uint8_t bits,
+                                       const Loc1 &min,
+                                       const Loc1 &max);
+
+        // Serialization function for octahedral normal vectors
+        std::size_t SerializeOctahedral(DataBuffer &data_buffer,
+                                        const std::vector<Norm1> &values,
+                                        std::uint8_t bits);
+
+        // Functions to validate compact object options and return flags
+        VarUint GetObjectFlags(const ObjectEncoding &encoding);
+        VarUint GetHandFlags(const ObjectEncoding &encoding);
+
+        // Functions to serialize compact object fields and header
+        std::size_t SerializeCompact(DataBuffer &data_buffer,
+                                     const Object1 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &flags);
+        std::size_t SerializeCompact(DataBuffer &data_buffer,
+                                     const Head1 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &flags);
+        std::size_t SerializeCompact(DataBuffer &data_buffer,
+                                     const Hand1 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &flags);
+        std::size_t SerializeCompact(DataBuffer &data_buffer,
+                                     const Hand2 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &flags);
+        std::size_t SerializeFrame(DataBuffer &data_buffer,
+                                   const PlayerFrame1 &value,
+                                   const ObjectEncoding &encoding,
+                                   const VarUint &flags);
+        std::size_t SerializeFields(DataBuffer &data_buffer,
+                                    const Head1 &value,
+                                    const ObjectEncoding &encoding,
+                                    const VarUint &presence);
+        std::size_t SerializeFields(DataBuffer &data_buffer,
+                                    const Hand2 &value,
+                                    const ObjectEncoding &encoding,
+                                    const VarUint &flags,
+                                    const VarUint &presence);
+        std::size_t SerializeObjectFlags(DataBuffer &data_buffer,
+                                         const VarUint &flags,
+                                         const ObjectEncoding &encoding,
+                                         const VarUint &presence);
+        std::size_t SerializeLocation(DataBuffer &data_buffer,
+                                      const Loc2 &value,
+                                      const VarUint &presence);
+
+        // Functions to determine compact object field presence masks
+        VarUint GetPresence(const Object1 &value, const VarUint &flags);
+        VarUint GetPresence(const Head1 &value,
+                            const VarUint &flags,
+                            const ObjectEncoding &encoding);
+        VarUint GetPresence(const Hand1 &value,
+                            const VarUint &flags,
+                            const ObjectEncoding &encoding);
+        VarUint GetPresence(const Hand2 &value,
+                            const VarUint &flags,
+                            const ObjectEncoding &encoding);
+        std::uint64_t GetPresence(const Loc2 &value,
+                                  const ObjectEncoding &encoding);
+        std::uint64_t GetPresence(const Rot2 &value);
+
+        // Serialization functions for rotations that may be compressed
+        std::size_t SerializeRotation(DataBuffer &data_buffer,
+                                      const Rot1 &value,
+                                      std::uint8_t bits);
+        std::size_t SerializeRotation(DataBuffer &data_buffer,
+                                      const Rot2 &value,
+                                      std::uint8_t bits);
+
+        // Serialization function for compressed rotations
+        std::size_t SerializeCompressed(DataBuffer &data_buffer,
+                                        const Rot1 *values,
+                                        std::size_t count,
+                                        std::uint8_t bits);
+
+        // Serialization functions for quantized Hand2 joints
+        std::size_t SerializeJoints(DataBuffer &data_buffer,
+                                    const Hand2 &value,
+                                    std::uint8_t bits,
+                                    float range);
+        void SerializeJoint(BitWriter &writer,
+                            const Transform1 &value,
+                            std::uint8_t bits,
+                            float range);
+        void SerializeJoint(BitWriter &writer,
+                            const Thumb &value,
+                            std::uint8_t bits,
+                            float range);
+        void SerializeJoint(BitWriter &writer,
+                            const Finger &value,
+                            std::uint8_t bits,
+                            float range);
+
         // Serialization function for a Blob type
         std::size_t Serialize(DataBuffer &data_buffer, const Blob &value)
         {
@@ -132,6 +335,18 @@ class Encoder
         std::size_t Serialize(DataBuffer &data_buffer,
                               const std::vector<T> &values);
 
+        // Serialization function for large vectors using multiple threads
+        template <typename T>
+        std::size_t SerializeParallel(DataBuffer &data_buffer,
+                                      const std::vector<T> &values,
+                                      std::size_t chunks);
+
+        // Serialization function for elements produced on demand
+        template <typename T>
+        std::size_t Serialize(DataBuffer &data_buffer,
+                              std::size_t count,
+                              const std::function<T(std::size_t)> &producer);
+
         // Serialization function for all other types
         template <typename T>
         std::size_t Serialize(DataBuffer &data_buffer, const T &value)
@@ -141,6 +356,7 @@ class Encoder
 
         Serializer serializer;                  // Serializer object
         DataBuffer null_buffer;                 // Used to compute encoding size
+        std::size_t max_threads{1};             // Threads used for vectors
 };
 
 } // namespace gs
@@ -103,13 +103,51 @@ namespace gs
     // Tag type values for serializable objects
     enum class Tag
     {
-        Invalid  = 0x00,
-        Head1    = 0x01,
-        Hand1    = 0x02,
-        Object1  = 0x03,
-        Mesh1    = 0x8000,
-        Hand2    = 0x8001,
-        HeadIPD1 = 0x8002
+        Invalid        = 0x00,
+        Head1          = 0x01,
+        Hand1          = 0x02,
+        Object1        = 0x03,
+        Mesh1          = 0x8000,
+        Hand2          = 0x8001,
+        HeadIPD1       = 0x8002,
+        CompactMesh1   = 0x8003,
+        CompactObject1 = 0x8004,
+        CompactHead1   = 0x8005,
+        CompactHand2   = 0x8006,
+        CompactHand1   = 0x8007,
+        PlayerFrame1   = 0x8008
+    };
+
+    // Flags indicating which encodings are used within a CompactMesh1
+    enum CompactMeshFlags : std::uint64_t
+    {
+        CompactMesh_Delta_Indices       = 0x01,
+        CompactMesh_Quantized_Positions = 0x02,
+        CompactMesh_Octahedral_Normals  = 0x04,
+        CompactMesh_Predicted_Positions = 0x08
+    };
+
+    // Flags indicating which encodings are used within compact objects
+    // (CompactObject1, CompactHead1, and CompactHand2)
+    enum CompactObjectFlags : std::uint64_t
+    {
+        CompactObject_Compressed_Rotation = 0x01,
+        CompactObject_Quantized_Joints    = 0x02,
+        CompactObject_Field_Presence      = 0x04
+    };
+
+    // Bits within the field presence mask of compact objects, indicating
+    // which fields are present or, for Boolean fields, the field's value
+    enum CompactPresenceBits : std::uint64_t
+    {
+        CompactPresence_Position = 0x01,
+        CompactPresence_Velocity = 0x02,
+        CompactPresence_Rotation = 0x04,
+        CompactPresence_Scale    = 0x08,
+        CompactPresence_Parent   = 0x10,
+        CompactPresence_IPD      = 0x20,
+        CompactPresence_Active   = 0x40,            // Object1 only
+        CompactPresence_Left     = 0x40             // Hand1 and Hand2 only
     };
 
     // Complex types
@@ -242,6 +280,15 @@ namespace gs
         Finger pinky;
     };
 
+    // A user's head and hands sharing a single time value, which is
+    // serialized as one PlayerFrame1 and decoded as three separate objects
+    struct PlayerFrame1
+    {
+        Head1 head;
+        Hand2 left;
+        Hand2 right;
+    };
+
     struct UnknownObject
     {
         VarUint tag;
@@ -0,0 +1,144 @@
+/*
+ *  interest_manager.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This defines the InterestManager object, which tracks the positions of
+ *      objects in a uniform spatial grid and returns, for each recipient, the
+ *      objects near enough to that recipient to be worth sending.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INTEREST_MANAGER_H
+#define INTEREST_MANAGER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "gs_types.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Options controlling the InterestManager
+struct InterestOptions
+{
+    float cell_size{10.0f};                     // Grid cell edge length
+    float radius{30.0f};                        // Default radius of interest
+};
+
+// Objects of interest to one recipient
+struct InterestSet
+{
+    std::uint64_t recipient;                    // Recipient identifier
+    std::vector<std::uint64_t> ids;             // Object IDs, ascending
+};
+
+// InterestManager object declaration
+class InterestManager
+{
+    public:
+        InterestManager(const InterestOptions &options = {});
+        ~InterestManager() = default;
+
+        // Set the maximum number of threads used for updates and queries
+        // (zero to use all hardware threads)
+        void SetMaxThreads(std::size_t threads) { max_threads = threads; }
+
+        // Functions to record the position of objects
+        void Update(const GSObjects &objects);
+        void Update(std::uint64_t id, const Loc1 &position);
+
+        // Function to stop tracking an object
+        bool Remove(std::uint64_t id);
+
+        // Function to add or move a recipient of objects
+        void UpdateRecipient(std::uint64_t recipient, const Loc1 &position);
+        void UpdateRecipient(std::uint64_t recipient,
+                             const Loc1 &position,
+                             float radius);
+
+        // Function to stop tracking a recipient
+        bool RemoveRecipient(std::uint64_t recipient);
+
+        // Function to return the objects of interest to each recipient
+        std::vector<InterestSet> Query() const;
+
+        // Function to return the objects within a radius of a position
+        std::vector<std::uint64_t> Query(const Loc1 &position,
+                                         float radius) const;
+
+        // Function to select the objects to send given a set of interest
+        GSObjects Select(const GSObjects &objects,
+                         const InterestSet &interest) const;
+
+        // Function to return the number of objects tracked
+        std::size_t GetCount() const { return objects.GetCount(); }
+
+    protected:
+        // Receiver of objects and the region of interest to it
+        struct Recipient
+        {
+            std::uint64_t id;
+            Loc1 position;
+            float radius;
+        };
+
+        std::uint64_t GetCell(const Loc1 &position) const;
+        void Move(std::size_t index, std::uint64_t cell);
+        void Unlink(std::size_t index);
+        void Search(const Loc1 &position,
+                    float radius,
+                    std::vector<std::uint64_t> &ids) const;
+
+        InterestOptions options;                // Configured options
+        std::size_t max_threads{1};             // Threads used for batches
+        ObjectTable objects;                    // Index of each object
+        std::vector<Loc1> positions;            // Position by object index
+        std::vector<std::uint64_t> cell_of;     // Grid cell by object index
+        std::vector<std::size_t> cell_slot;     // Position within the cell
+        std::unordered_map<std::uint64_t, std::vector<std::size_t>> cells;
+                                                // Objects in each cell
+        ObjectTable recipient_table;            // Index of each recipient
+        std::vector<Recipient> recipients;      // Recipient by index
+};
+
+} // namespace gs
+
+#endif // INTEREST_MANAGER_H
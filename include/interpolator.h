@@ -0,0 +1,97 @@
+/*
+ *  interpolator.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the Interpolator object, which blends batches of
+ *      decoded object states for rendering.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INTERPOLATOR_H
+#define INTERPOLATOR_H
+
+#include <cstddef>
+#include <vector>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// Interpolator object declaration
+class Interpolator
+{
+    public:
+        Interpolator() = default;
+        ~Interpolator() = default;
+
+        // Set the maximum number of threads used to interpolate large
+        // batches (zero to use all hardware threads)
+        void SetMaxThreads(std::size_t threads) { max_threads = threads; }
+
+        // Functions to interpolate between pairs of states at the given
+        // fractions of the time between them
+        void Interpolate(const std::vector<Object1> &from,
+                         const std::vector<Object1> &to,
+                         const std::vector<float> &fractions,
+                         std::vector<Object1> &result);
+        void Interpolate(const std::vector<Head1> &from,
+                         const std::vector<Head1> &to,
+                         const std::vector<float> &fractions,
+                         std::vector<Head1> &result);
+        void Interpolate(const std::vector<Hand1> &from,
+                         const std::vector<Hand1> &to,
+                         const std::vector<float> &fractions,
+                         std::vector<Hand1> &result);
+        void Interpolate(const std::vector<Hand2> &from,
+                         const std::vector<Hand2> &to,
+                         const std::vector<float> &fractions,
+                         std::vector<Hand2> &result);
+
+    protected:
+        template <typename T>
+        void InterpolateStates(const std::vector<T> &from,
+                               const std::vector<T> &to,
+                               const std::vector<float> &fractions,
+                               std::vector<T> &result);
+
+        std::size_t max_threads{1};             // Threads used for batches
+};
+
+} // namespace gs
+
+#endif // INTERPOLATOR_H
@@ -0,0 +1,134 @@
+/*
+ *  jitter_buffer.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the JitterBuffer object, which holds recently
+ *      received states for each object, ordered by their unwrapped time, and
+ *      releases them after an adaptive playout delay.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef JITTER_BUFFER_H
+#define JITTER_BUFFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "gs_types.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Options controlling the JitterBuffer
+struct JitterBufferOptions
+{
+    std::size_t capacity{32};                   // States held per object
+    std::int64_t min_delay{20};                 // Playout delay bounds (ms)
+    std::int64_t max_delay{500};
+    double jitter_multiplier{3.0};              // Delay per unit of jitter
+};
+
+// TimeUnwrapper object declaration
+class TimeUnwrapper
+{
+    public:
+        TimeUnwrapper() = default;
+        ~TimeUnwrapper() = default;
+
+        // Function to convert a wrapping time to a 64-bit time
+        std::int64_t Unwrap(Time1 time);
+
+    protected:
+        bool initialized{false};                // Set on first call
+        std::int64_t latest{};                  // Latest time unwrapped
+};
+
+// JitterBuffer object declaration
+class JitterBuffer
+{
+    public:
+        JitterBuffer(const JitterBufferOptions &options = {});
+        ~JitterBuffer() = default;
+
+        // Function to insert a received object given the local time (ms)
+        bool Insert(const GSObject &value, std::int64_t arrival_time);
+
+        // Function to return the state of an object due for playout at the
+        // given local time (ms)
+        std::optional<GSObject> Playout(std::uint64_t id,
+                                        std::int64_t local_time);
+
+        // Function to return the current playout delay for an object (ms)
+        std::int64_t GetPlayoutDelay(std::uint64_t id) const;
+
+        // Function to forget an object
+        bool Remove(std::uint64_t id) { return buffers.Remove(id); }
+
+    protected:
+        // Received state and its unwrapped time
+        struct Entry
+        {
+            std::int64_t time;
+            GSObject value;
+        };
+
+        // Buffered states and timing statistics for one object
+        struct ObjectBuffer
+        {
+            TimeUnwrapper unwrapper;            // Unwraps the object's time
+            std::vector<Entry> ring;            // Recent states in time order
+            std::size_t head{};                 // Slot of the earliest state
+            std::size_t count{};                // Number of states held
+            bool received{false};               // Set on first state
+            std::int64_t last_transit{};        // Transit time of last state
+            std::int64_t min_transit{};         // Smallest transit time
+            double jitter{};                    // Smoothed transit variation
+            std::optional<std::int64_t> played; // Time last played out
+        };
+
+        std::int64_t GetDelay(const ObjectBuffer &buffer) const;
+
+        JitterBufferOptions options;            // Configured options
+        ObjectStore<ObjectBuffer> buffers;      // Buffer for each object
+};
+
+} // namespace gs
+
+#endif // JITTER_BUFFER_H
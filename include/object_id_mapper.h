@@ -0,0 +1,130 @@
+/*
+ *  object_id_mapper.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This defines the ObjectIDMapper object, which assigns dense indices to
+ *      object IDs as they are first seen by a receiver.  Each index carries a
+ *      generation counter so that handles held for an object released and
+ *      replaced by another can be recognized as stale.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OBJECT_ID_MAPPER_H
+#define OBJECT_ID_MAPPER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "gs_types.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Dense index assigned to an object and the generation of that assignment
+struct ObjectHandle
+{
+    static constexpr std::uint32_t Invalid_Index = 0xffffffff;
+
+    std::uint32_t index{Invalid_Index};
+    std::uint32_t generation{};
+
+    bool IsValid() const { return index != Invalid_Index; }
+
+    bool operator==(const ObjectHandle &other) const
+    {
+        return (index == other.index) && (generation == other.generation);
+    }
+    bool operator!=(const ObjectHandle &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+// ObjectIDMapper object declaration
+class ObjectIDMapper
+{
+    public:
+        ObjectIDMapper(std::size_t capacity = 0);
+        ~ObjectIDMapper() = default;
+
+        // Function to return the handle of an object, assigning one if needed
+        ObjectHandle Map(std::uint64_t id);
+
+        // Function to return the handle of each object from the given
+        // position onward, assigning as needed
+        void Map(const GSObjects &objects,
+                 std::vector<ObjectHandle> &handles,
+                 std::size_t first = 0);
+
+        // Function to return the handle of an object if one is assigned
+        std::optional<ObjectHandle> Find(std::uint64_t id) const;
+
+        // Function to release an object's index for reuse
+        bool Release(std::uint64_t id);
+
+        // Function to determine whether a handle still refers to its object
+        bool IsCurrent(const ObjectHandle &handle) const;
+
+        // Function to return the object ID assigned to an index
+        std::uint64_t GetID(std::uint32_t index) const
+        {
+            return table.GetID(index);
+        }
+
+        // Function to return the number of objects mapped
+        std::size_t GetCount() const { return table.GetCount(); }
+
+        // Function to return one more than the largest index assigned, which
+        // is the size arrays indexed by handle must have
+        std::size_t GetIndexLimit() const { return table.GetIndexLimit(); }
+
+        // Function to release all objects
+        void Clear();
+
+    protected:
+        ObjectHandle MakeHandle(std::size_t index) const;
+
+        ObjectTable table;                      // Index of each object
+        std::vector<std::uint32_t> generations; // Generation by index
+};
+
+} // namespace gs
+
+#endif // OBJECT_ID_MAPPER_H
@@ -0,0 +1,246 @@
+/*
+ *  object_table.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This defines the ObjectTable object, which maps object IDs to dense
+ *      indices using a flat open-addressing hash table, and the ObjectStore
+ *      template, which keeps per-object state in one vector per component
+ *      type (structure of arrays) indexed by those dense indices.  An
+ *      object's index remains stable for as long as the object is present.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OBJECT_TABLE_H
+#define OBJECT_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// ObjectTable object declaration
+class ObjectTable
+{
+    public:
+        // Index returned when an object is not present
+        static constexpr std::size_t Not_Found = static_cast<std::size_t>(-1);
+
+        ObjectTable(std::size_t capacity = 0);
+        ~ObjectTable() = default;
+
+        // Function to return the index of an object, adding it if needed
+        std::size_t Insert(std::uint64_t id);
+        std::size_t Insert(const ObjectID &id) { return Insert(id.value); }
+
+        // Function to return the index of an object or Not_Found
+        std::size_t Find(std::uint64_t id) const;
+        std::size_t Find(const ObjectID &id) const { return Find(id.value); }
+
+        // Functions to look up the index of several objects at once
+        void Find(const std::vector<std::uint64_t> &ids,
+                  std::vector<std::size_t> &indices) const;
+        void Find(const GSObjects &objects,
+                  std::vector<std::size_t> &indices) const;
+
+        // Function to remove an object, releasing its index
+        bool Remove(std::uint64_t id);
+        bool Remove(const ObjectID &id) { return Remove(id.value); }
+
+        // Function to determine whether an index is assigned to an object
+        bool IsValid(std::size_t index) const
+        {
+            return (index < assigned.size()) && assigned[index];
+        }
+
+        // Function to return the object ID assigned to an index
+        std::uint64_t GetID(std::size_t index) const { return ids[index]; }
+
+        // Function to return the number of objects in the table
+        std::size_t GetCount() const { return count; }
+
+        // Function to return one more than the largest index assigned
+        std::size_t GetIndexLimit() const { return ids.size(); }
+
+        // Function to remove all objects
+        void Clear();
+
+    protected:
+        // Hash table slot; an empty slot has an index of Not_Found
+        struct Slot
+        {
+            std::uint64_t id;
+            std::size_t index;
+        };
+
+        std::size_t GetHome(std::uint64_t id) const;
+        std::size_t Lookup(std::uint64_t id, std::size_t slot) const;
+        void Resize(std::size_t slot_count);
+
+        std::vector<Slot> slots;                // Hash table slots
+        std::size_t mask;                       // Slot count less one
+        std::size_t count;                      // Objects in the table
+        std::vector<std::uint64_t> ids;         // Object ID by index
+        std::vector<std::uint8_t> assigned;     // Non-zero if index in use
+        std::vector<std::size_t> free_indices;  // Indices to reuse
+};
+
+// ObjectStore holds per-object components of the given types, each in its
+// own vector indexed by the object's dense index
+template <typename... Components>
+class ObjectStore
+{
+    static_assert(sizeof...(Components) > 0, "No components given");
+
+    public:
+        // Type of the component held in column N
+        template <std::size_t N>
+        using Component = std::tuple_element_t<N, std::tuple<Components...>>;
+
+        ObjectStore(std::size_t capacity = 0) : table{capacity}
+        {
+            std::apply(
+                [&](auto &...column) { (column.reserve(capacity), ...); },
+                columns);
+        }
+        ~ObjectStore() = default;
+
+        // Function to return the index of an object, adding it with
+        // value-initialized components if needed
+        std::size_t Insert(std::uint64_t id)
+        {
+            const std::size_t index = table.Insert(id);
+
+            // Extend the columns when a new index is assigned
+            if (table.GetIndexLimit() > std::get<0>(columns).size())
+            {
+                std::apply(
+                    [&](auto &...column)
+                    {
+                        (column.resize(table.GetIndexLimit()), ...);
+                    },
+                    columns);
+            }
+
+            return index;
+        }
+
+        // Function to return the index of an object or Not_Found
+        std::size_t Find(std::uint64_t id) const { return table.Find(id); }
+
+        // Function to look up the index of each object in a decoded frame
+        void Find(const GSObjects &objects,
+                  std::vector<std::size_t> &indices) const
+        {
+            table.Find(objects, indices);
+        }
+
+        // Function to remove an object, resetting its components so the
+        // index may be reused
+        bool Remove(std::uint64_t id)
+        {
+            const std::size_t index = table.Find(id);
+
+            if (index == ObjectTable::Not_Found) return false;
+
+            std::apply([&](auto &...column) { ((column[index] = {}), ...); },
+                       columns);
+
+            return table.Remove(id);
+        }
+
+        // Function to remove all objects
+        void Clear()
+        {
+            std::apply([](auto &...column) { (column.clear(), ...); },
+                       columns);
+            table.Clear();
+        }
+
+        // Functions to access the vector holding all components of a type
+        template <std::size_t N>
+        std::vector<Component<N>> &GetColumn()
+        {
+            return std::get<N>(columns);
+        }
+        template <std::size_t N>
+        const std::vector<Component<N>> &GetColumn() const
+        {
+            return std::get<N>(columns);
+        }
+
+        // Functions to access a component of the object at an index
+        template <std::size_t N>
+        Component<N> &Get(std::size_t index)
+        {
+            return std::get<N>(columns)[index];
+        }
+        template <std::size_t N>
+        const Component<N> &Get(std::size_t index) const
+        {
+            return std::get<N>(columns)[index];
+        }
+
+        // Function to determine whether an index is assigned to an object
+        bool IsValid(std::size_t index) const { return table.IsValid(index); }
+
+        // Function to return the object ID assigned to an index
+        std::uint64_t GetID(std::size_t index) const
+        {
+            return table.GetID(index);
+        }
+
+        // Function to return the number of objects in the store
+        std::size_t GetCount() const { return table.GetCount(); }
+
+        // Function to return the length of each column
+        std::size_t GetIndexLimit() const { return table.GetIndexLimit(); }
+
+    protected:
+        ObjectTable table;                      // Index of each object
+        std::tuple<std::vector<Components>...> columns;
+                                                // Components by index
+};
+
+} // namespace gs
+
+#endif // OBJECT_TABLE_H
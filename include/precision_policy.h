@@ -0,0 +1,129 @@
+/*
+ *  precision_policy.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Header file for the PrecisionPolicy object, which encodes a set of
+ *      objects within a per-tick octet budget.  Rather than omitting objects
+ *      when the budget is exceeded, the policy selects successively coarser
+ *      compact encodings for each type of object from configured precision
+ *      ladders until the objects fit, and reports the levels it selected.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PRECISION_POLICY_H
+#define PRECISION_POLICY_H
+
+#include <cstddef>
+#include <vector>
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "data_buffer.h"
+
+namespace gs
+{
+
+// Successively coarser encodings for each type of object.  An object's
+// standard encoding is used before the first entry in its ladder.
+struct PrecisionLadders
+{
+    std::vector<ObjectEncoding> object1;
+    std::vector<ObjectEncoding> head1;
+    std::vector<ObjectEncoding> hand1;
+    std::vector<ObjectEncoding> hand2;
+    std::vector<MeshEncoding> mesh1;
+};
+
+// Precision level selected for each type of object, where zero indicates
+// the standard encoding and n indicates the nth entry in the type's ladder
+struct PrecisionLevels
+{
+    std::size_t object1{};
+    std::size_t head1{};
+    std::size_t hand1{};
+    std::size_t hand2{};
+    std::size_t mesh1{};
+};
+
+// PrecisionPolicy object declaration
+class PrecisionPolicy
+{
+    public:
+        PrecisionPolicy(const PrecisionLadders &ladders);
+        ~PrecisionPolicy() = default;
+
+        // Function to encode objects, reducing precision as necessary to
+        // fit within the given number of octets
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const GSObjects &value,
+                            std::size_t budget);
+
+        // Function to return the levels selected by the last call to
+        // Encode()
+        const PrecisionLevels &GetLevels() const { return levels; }
+
+    protected:
+        // Object types having precision ladders
+        enum Ladder : std::size_t
+        {
+            Object1_Ladder,
+            Head1_Ladder,
+            Hand1_Ladder,
+            Hand2_Ladder,
+            Mesh1_Ladder,
+            Ladder_Count
+        };
+
+        std::size_t GetLadder(const GSObject &value) const;
+        std::size_t GetLadderLength(std::size_t ladder) const;
+        EncodeResult Encode(DataBuffer &data_buffer,
+                            const GSObject &value,
+                            std::size_t level);
+
+        Encoder encoder;                        // Encoder object
+        DataBuffer null_buffer;                 // Used to compute lengths
+        PrecisionLadders ladders;               // Configured ladders
+        PrecisionLevels levels;                 // Levels last selected
+        std::vector<std::size_t> lengths;       // Encoded length of each
+                                                // object at each level
+        std::vector<std::size_t> offsets;       // Index of each object's
+                                                // first length
+};
+
+} // namespace gs
+
+#endif // PRECISION_POLICY_H
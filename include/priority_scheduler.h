@@ -0,0 +1,126 @@
+/*
+ *  priority_scheduler.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the PriorityScheduler object, which accrues a
+ *      priority for each changed object on every tick and encodes the objects
+ *      having the highest priority within an octet budget.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PRIORITY_SCHEDULER_H
+#define PRIORITY_SCHEDULER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "data_buffer.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Weights controlling the rate at which each object's priority accrues
+struct PriorityWeights
+{
+    double object1{1.0};                        // Weight of each type
+    double head1{1.0};
+    double hand1{1.0};
+    double hand2{1.0};
+    double mesh1{1.0};
+    double other{1.0};
+    double distance_scale{10.0};                // Distance from the viewer
+                                                // at which the rate halves
+};
+
+// PriorityScheduler object declaration
+class PriorityScheduler
+{
+    public:
+        PriorityScheduler(const PriorityWeights &weights = {});
+        ~PriorityScheduler() = default;
+
+        // Function to set the position from which distances are measured
+        void SetViewer(const Loc1 &position) { viewer = position; }
+
+        // Function to record that an object has changed
+        void Update(const GSObject &value);
+
+        // Function to discard any pending change to an object
+        bool Remove(std::uint64_t id);
+
+        // Function to accrue priority and encode the highest priority
+        // objects within the given number of octets
+        EncodeResult Encode(DataBuffer &data_buffer, std::size_t budget);
+
+        // Function to return the number of objects awaiting transmission
+        std::size_t GetPendingCount() const { return pending.GetCount(); }
+
+        // Function to return the priority accrued by a pending object
+        double GetPriority(std::uint64_t id) const;
+
+    protected:
+        // Columns of the pending object store
+        enum Column : std::size_t
+        {
+            Priority,                           // Accrued priority
+            Type_Weight,                        // Weight of object's type
+            Position,                           // Object position
+            Length,                             // Encoded length
+            Value                               // Latest object value
+        };
+
+        double GetWeight(const GSObject &value) const;
+
+        Encoder encoder;                        // Encoder object
+        PriorityWeights weights;                // Configured weights
+        Loc1 viewer;                            // Viewer position
+
+        // Pending objects, held in columns so that the per-tick accrual
+        // touches only the values it needs
+        ObjectStore<double, double, Loc1, std::size_t, GSObject> pending;
+        std::vector<double> accrued;            // Priority after this tick
+        std::vector<std::size_t> heap;          // Selection heap
+        std::vector<std::size_t> sent;          // Indices of sent objects
+};
+
+} // namespace gs
+
+#endif // PRIORITY_SCHEDULER_H
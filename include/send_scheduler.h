@@ -0,0 +1,130 @@
+/*
+ *  send_scheduler.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines the SendScheduler object, which holds the objects to
+ *      be sent along with the period at which each is to be sent, and returns
+ *      the objects due on each tick using a hierarchical timing wheel.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SEND_SCHEDULER_H
+#define SEND_SCHEDULER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "data_buffer.h"
+#include "object_table.h"
+
+namespace gs
+{
+
+// Number of levels in the timing wheel and log2 of the slots in each level
+constexpr std::size_t Wheel_Levels = 4;
+constexpr std::size_t Wheel_Slot_Bits = 8;
+
+// SendScheduler object declaration
+class SendScheduler
+{
+    public:
+        SendScheduler();
+        ~SendScheduler() = default;
+
+        // Function to schedule an object to be sent every period ticks,
+        // first on the tick following the given delay
+        void Insert(const GSObject &value,
+                    std::uint64_t period,
+                    std::uint64_t delay = 0);
+
+        // Function to replace the value of a scheduled object
+        bool Update(const GSObject &value);
+
+        // Function to stop sending an object
+        bool Remove(std::uint64_t id);
+
+        // Function to advance one tick and return the IDs of objects due
+        const std::vector<std::uint64_t> &Advance();
+
+        // Function to advance one tick and encode the objects due
+        EncodeResult Encode(DataBuffer &data_buffer);
+
+        // Function to return the current tick
+        std::uint64_t GetTick() const { return tick; }
+
+        // Function to return the number of scheduled objects
+        std::size_t GetCount() const { return indices.GetCount(); }
+
+    protected:
+        static constexpr std::size_t Slot_Count = 1 << Wheel_Slot_Bits;
+        static constexpr std::size_t No_Entry = static_cast<std::size_t>(-1);
+
+        // Scheduled object, linked into the list for its slot
+        struct Entry
+        {
+            std::uint64_t id;
+            std::uint64_t period;
+            std::uint64_t due;
+            std::size_t slot;
+            std::size_t previous;
+            std::size_t next;
+            GSObject value;
+        };
+
+        std::uint64_t GetID(const GSObject &value) const;
+        void Link(std::size_t entry);
+        void Unlink(std::size_t entry);
+        std::size_t Detach(std::size_t slot);
+        void Cascade(std::size_t level);
+
+        Encoder encoder;                        // Encoder object
+        std::uint64_t tick;                     // Current tick
+        std::vector<Entry> entries;             // Scheduled objects
+        std::array<std::size_t, Wheel_Levels * Slot_Count> slots;
+                                                // First entry in each slot
+        ObjectTable indices;                    // Entry for each object ID
+        std::vector<std::size_t> due;           // Entries due this tick
+        std::vector<std::uint64_t> due_ids;     // Object IDs due this tick
+};
+
+} // namespace gs
+
+#endif // SEND_SCHEDULER_H
@@ -0,0 +1,375 @@
+/*
+ *  bit_stream.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the BitWriter and BitReader objects, which allow
+ *      values of arbitrary bit width to be packed into and unpacked from a
+ *      DataBuffer.  Bits are accumulated in a 64-bit register and moved to or
+ *      from the DataBuffer eight octets at a time where space permits.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "bit_stream.h"
+
+namespace gs
+{
+
+/*
+ *  BitWriter::BitWriter
+ *
+ *  Description:
+ *      Constructor for the BitWriter object.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer to which bits shall be appended.  If the buffer is
+ *          of zero length, bits are only counted and not written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Bits are appended following any data already in the buffer.  The
+ *      data buffer should not be modified by other means until Flush() is
+ *      called.
+ */
+BitWriter::BitWriter(DataBuffer &data_buffer) :
+    data_buffer{data_buffer},
+    accumulator{0},
+    accumulated{0},
+    bit_length{0}
+{
+}
+
+/*
+ *  BitWriter::Write
+ *
+ *  Description:
+ *      Write the low-order bits of the given value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value to write.  Bits above the given width are ignored.
+ *
+ *      bits [in]
+ *          The number of bits to write, which must not exceed 64.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A DataBufferException is thrown if the bit count is invalid or if
+ *      the data buffer has insufficient space.
+ */
+void BitWriter::Write(std::uint64_t value, unsigned bits)
+{
+    if (bits > 64) throw DataBufferException("Invalid bit count");
+
+    // Ensure there is room for the value after flushing full octets
+    if (bits > 56)
+    {
+        Write(value >> 32, bits - 32);
+        value &= 0xffffffff;
+        bits = 32;
+    }
+
+    if (bits == 0) return;
+
+    if ((accumulated + bits) > 64) FlushOctets();
+
+    // Place the value immediately below the bits already accumulated
+    value &= ~std::uint64_t(0) >> (64 - bits);
+    accumulator |= value << (64 - accumulated - bits);
+    accumulated += bits;
+    bit_length += bits;
+}
+
+/*
+ *  BitWriter::WriteBoolean
+ *
+ *  Description:
+ *      Write a Boolean value as a single bit.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The value to write.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void BitWriter::WriteBoolean(bool value)
+{
+    Write(value ? 1 : 0, 1);
+}
+
+/*
+ *  BitWriter::Flush
+ *
+ *  Description:
+ *      Write all accumulated bits to the data buffer, padding the final
+ *      octet with zero bits.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets written (or that would have been written if the
+ *      data buffer is of zero length) since the BitWriter was constructed.
+ *
+ *  Comments:
+ *      Writing may continue after calling this function, in which case
+ *      subsequent bits begin at the next octet boundary.
+ */
+std::size_t BitWriter::Flush()
+{
+    // Pad to an octet boundary
+    const unsigned padding = (8 - (accumulated & 7)) & 7;
+    accumulated += padding;
+    bit_length += padding;
+
+    FlushOctets();
+
+    return bit_length / 8;
+}
+
+/*
+ *  BitWriter::GetBitLength
+ *
+ *  Description:
+ *      Return the number of bits written, including any padding inserted
+ *      by calls to Flush().
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of bits written.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t BitWriter::GetBitLength() const
+{
+    return bit_length;
+}
+
+/*
+ *  BitWriter::FlushOctets
+ *
+ *  Description:
+ *      Move all complete octets from the accumulator to the data buffer.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      When the data buffer has room, the whole accumulator is stored with
+ *      a single 64-bit write and the data length is advanced over only the
+ *      complete octets.  Octets beyond the new data length are overwritten
+ *      by subsequent flushes.
+ */
+void BitWriter::FlushOctets()
+{
+    const unsigned octets = accumulated >> 3;
+    const std::size_t data_length = data_buffer.GetDataLength();
+
+    if (data_buffer.GetBufferSize() > 0)
+    {
+        if ((data_length + sizeof(std::uint64_t)) <=
+            data_buffer.GetBufferSize())
+        {
+            data_buffer.SetValue(accumulator, data_length);
+        }
+        else
+        {
+            for (unsigned i = 0; i < octets; i++)
+            {
+                data_buffer.SetValue(
+                    static_cast<std::uint8_t>(accumulator >> (56 - i * 8)),
+                    data_length + i);
+            }
+        }
+
+        data_buffer.SetDataLength(data_length + octets);
+    }
+
+    // Discard the octets written (two shifts, as octets may be 8)
+    accumulator = (accumulator << (octets * 4)) << (octets * 4);
+    accumulated &= 7;
+}
+
+/*
+ *  BitReader::BitReader
+ *
+ *  Description:
+ *      Constructor for the BitReader object.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which bits shall be read, starting at the
+ *          current read position.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The read position of the data buffer is not advanced until Align()
+ *      is called.
+ */
+BitReader::BitReader(DataBuffer &data_buffer) :
+    data_buffer{data_buffer},
+    offset{data_buffer.GetReadLength()},
+    position{0}
+{
+}
+
+/*
+ *  BitReader::Read
+ *
+ *  Description:
+ *      Read a value of the given bit width.
+ *
+ *  Parameters:
+ *      bits [in]
+ *          The number of bits to read, which must not exceed 64.
+ *
+ *  Returns:
+ *      The value read, held in the low-order bits.
+ *
+ *  Comments:
+ *      A DataBufferException is thrown if the bit count is invalid or if
+ *      reading would go beyond the data length.
+ */
+std::uint64_t BitReader::Read(unsigned bits)
+{
+    std::uint64_t window{};
+
+    if (bits > 64) throw DataBufferException("Invalid bit count");
+
+    // Ensure the window below holds all of the requested bits
+    if (bits > 56)
+    {
+        const std::uint64_t high = Read(bits - 32);
+        return (high << 32) | Read(32);
+    }
+
+    if (bits == 0) return 0;
+
+    const std::size_t data_length = data_buffer.GetDataLength();
+    const std::size_t octet = offset + (position >> 3);
+
+    if (((position + bits + 7) >> 3) > (data_length - offset))
+    {
+        throw DataBufferException("Attempt to read beyond data length");
+    }
+
+    // Load the 64 bits starting at the octet holding the next bit
+    if ((octet + sizeof(std::uint64_t)) <= data_length)
+    {
+        data_buffer.GetValue(window, octet);
+    }
+    else
+    {
+        for (std::size_t i = octet; i < octet + sizeof(std::uint64_t); i++)
+        {
+            window = (window << 8) | ((i < data_length) ? data_buffer[i] : 0);
+        }
+    }
+
+    window <<= (position & 7);
+    position += bits;
+
+    return window >> (64 - bits);
+}
+
+/*
+ *  BitReader::ReadBoolean
+ *
+ *  Description:
+ *      Read a Boolean value held in a single bit.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The value read.
+ *
+ *  Comments:
+ *      None.
+ */
+bool BitReader::ReadBoolean()
+{
+    return Read(1) != 0;
+}
+
+/*
+ *  BitReader::Align
+ *
+ *  Description:
+ *      Advance the read position of the data buffer past all octets from
+ *      which bits have been read.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The number of octets consumed since the BitReader was constructed or
+ *      Align() was last called.
+ *
+ *  Comments:
+ *      Reading may continue after calling this function, in which case
+ *      subsequent bits are read from the next unread octet.
+ */
+std::size_t BitReader::Align()
+{
+    const std::size_t octets = (position + 7) >> 3;
+
+    data_buffer.AdvanceReadLength(octets);
+    offset += octets;
+    position = 0;
+
+    return octets;
+}
+
+} // namespace gs
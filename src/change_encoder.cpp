@@ -0,0 +1,493 @@
+/*
+ *  change_encoder.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the ChangeEncoder object, which remembers the
+ *      last state sent for each object and encodes only those objects whose
+ *      state has since changed.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <variant>
+#include "change_encoder.h"
+#include "object_access.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// FNV-1a parameters used to hash meshes
+constexpr std::uint64_t FNV_Offset_Basis = 0xcbf29ce484222325;
+constexpr std::uint64_t FNV_Prime = 0x00000100000001b3;
+
+/*
+ *  Unchanged
+ *
+ *  Description:
+ *      These functions will determine whether an object's state is unchanged
+ *      from the state last sent, ignoring the object's time.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The state last sent.
+ *
+ *      b [in]
+ *          The current state.
+ *
+ *      epsilon [in]
+ *          The largest difference permitted in floating point fields.
+ *
+ *  Returns:
+ *      True if the state is unchanged, false otherwise.
+ *
+ *  Comments:
+ *      Objects having no state that is compared are always changed.
+ */
+template<typename T>
+bool Unchanged(const T &, const T &, float)
+{
+    return false;
+}
+
+bool Unchanged(const Object1 &a, const Object1 &b, float epsilon)
+{
+    return Near(a.position, b.position, epsilon) &&
+           Near(a.rotation, b.rotation, epsilon) &&
+           Near(a.scale, b.scale, epsilon) && (a.active == b.active) &&
+           (a.parent.has_value() == b.parent.has_value()) &&
+           (!a.parent || (a.parent->value == b.parent->value));
+}
+
+bool Unchanged(const Head1 &a, const Head1 &b, float epsilon)
+{
+    return Near(a.location, b.location, epsilon) &&
+           Near(a.rotation, b.rotation, epsilon) &&
+           (a.ipd.has_value() == b.ipd.has_value()) &&
+           (!a.ipd || Near(a.ipd->ipd, b.ipd->ipd, epsilon));
+}
+
+bool Unchanged(const Hand1 &a, const Hand1 &b, float epsilon)
+{
+    return (a.left == b.left) && Near(a.location, b.location, epsilon) &&
+           Near(a.rotation, b.rotation, epsilon);
+}
+
+bool Unchanged(const Hand2 &a, const Hand2 &b, float epsilon)
+{
+    return (a.left == b.left) && Near(a.location, b.location, epsilon) &&
+           Near(a.rotation, b.rotation, epsilon) &&
+           Near(a.wrist, b.wrist, epsilon) &&
+           Near(a.thumb, b.thumb, epsilon) &&
+           Near(a.index, b.index, epsilon) &&
+           Near(a.middle, b.middle, epsilon) &&
+           Near(a.ring, b.ring, epsilon) &&
+           Near(a.pinky, b.pinky, epsilon);
+}
+
+/*
+ *  HashValue
+ *
+ *  Description:
+ *      Add a value to an FNV-1a hash, one octet at a time.
+ *
+ *  Parameters:
+ *      hash [in/out]
+ *          The hash to update.
+ *
+ *      value [in]
+ *          The value to add to the hash.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Floating point values are hashed using their bit patterns.
+ */
+template<typename T>
+inline void HashValue(std::uint64_t &hash, T value)
+{
+    unsigned char octets[sizeof(T)];
+
+    std::memcpy(octets, &value, sizeof(T));
+    for (const unsigned char octet : octets)
+    {
+        hash = (hash ^ octet) * FNV_Prime;
+    }
+}
+
+/*
+ *  HashMesh
+ *
+ *  Description:
+ *      Produce a hash of the contents of a mesh.
+ *
+ *  Parameters:
+ *      mesh [in]
+ *          The mesh to hash.
+ *
+ *  Returns:
+ *      The hash of the mesh.
+ *
+ *  Comments:
+ *      The length of each vector is included so that elements cannot move
+ *      from one vector to another without changing the hash.
+ */
+std::uint64_t HashMesh(const Mesh1 &mesh)
+{
+    std::uint64_t hash = FNV_Offset_Basis;
+
+    HashValue(hash, mesh.vertices.size());
+    for (const auto &vertex : mesh.vertices)
+    {
+        HashValue(hash, vertex.x);
+        HashValue(hash, vertex.y);
+        HashValue(hash, vertex.z);
+    }
+    HashValue(hash, mesh.normals.size());
+    for (const auto &normal : mesh.normals)
+    {
+        HashValue(hash, normal.x.value);
+        HashValue(hash, normal.y.value);
+        HashValue(hash, normal.z.value);
+    }
+    HashValue(hash, mesh.textures.size());
+    for (const auto &texture : mesh.textures)
+    {
+        HashValue(hash, texture.u.value);
+        HashValue(hash, texture.v.value);
+    }
+    HashValue(hash, mesh.triangles.size());
+    for (const auto &index : mesh.triangles) HashValue(hash, index.value);
+
+    return hash;
+}
+
+} // namespace
+
+/*
+ *  ChangeEncoder::ChangeEncoder
+ *
+ *  Description:
+ *      Constructor for the ChangeEncoder object.
+ *
+ *  Parameters:
+ *      epsilon [in]
+ *          The largest difference in any floating point field of an object,
+ *          relative to the state last sent, for the object to be considered
+ *          unchanged.  A value of zero requires the fields to be identical.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+ChangeEncoder::ChangeEncoder(float epsilon) :
+    epsilon{epsilon},
+    unchanged_count{}
+{
+}
+
+/*
+ *  ChangeEncoder::Encode
+ *
+ *  Description:
+ *      This function will encode those of the given objects whose state has
+ *      changed since last sent, appending them to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the objects shall be written.  If
+ *          given a buffer of zero-length, this call will just return the
+ *          octets required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The objects to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.  Unchanged objects count as
+ *      processed, so a value less than the number of objects indicates
+ *      there was no more room for additional objects in the data buffer.
+ *
+ *  Comments:
+ *      An object's time is not compared, so an object whose other fields
+ *      are unchanged is not sent even if its time has advanced.  Objects
+ *      lacking an object ID are always sent.  Meshes are compared using a
+ *      hash of their contents and must be identical to be unchanged.  The
+ *      state sent is remembered only when the data buffer is not of
+ *      zero-length.
+ */
+EncodeResult ChangeEncoder::Encode(DataBuffer &data_buffer,
+                                   const GSObjects &value)
+{
+    EncodeResult result{};
+
+    unchanged_count = 0;
+
+    for (const auto &object : value)
+    {
+        const EncodeResult encoded = EncodeObject(data_buffer, object);
+        if (encoded.first == 0) break;
+
+        result.first += encoded.first;
+        result.second += encoded.second;
+    }
+
+    return result;
+}
+
+/*
+ *  ChangeEncoder::Encode
+ *
+ *  Description:
+ *      This function will encode the given object if its state has changed
+ *      since last sent, appending it to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the object shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.  An unchanged object is
+ *      processed without serializing any octets, while a value of zero
+ *      objects indicates there was no room for the object.
+ *
+ *  Comments:
+ *      See the comments for encoding a vector of objects.
+ */
+EncodeResult ChangeEncoder::Encode(DataBuffer &data_buffer,
+                                   const GSObject &value)
+{
+    unchanged_count = 0;
+
+    return EncodeObject(data_buffer, value);
+}
+
+/*
+ *  ChangeEncoder::EncodeObject
+ *
+ *  Description:
+ *      This function will encode the given object if its state has changed
+ *      since last sent and remember the state sent.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the object shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.
+ *
+ *  Comments:
+ *      The count of unchanged objects is incremented if the object is not
+ *      sent because it is unchanged.
+ */
+EncodeResult ChangeEncoder::EncodeObject(DataBuffer &data_buffer,
+                                         const GSObject &value)
+{
+    std::uint64_t mesh_hash{};
+
+    if (!HasChanged(value, mesh_hash))
+    {
+        unchanged_count++;
+        return {1, 0};
+    }
+
+    const EncodeResult result = encoder.Encode(data_buffer, value);
+
+    if ((result.first > 0) && data_buffer.GetBufferSize())
+    {
+        Record(value, mesh_hash);
+    }
+
+    return result;
+}
+
+/*
+ *  ChangeEncoder::Invalidate
+ *
+ *  Description:
+ *      This function will forget the state last sent for an object, so that
+ *      it will be sent again even if unchanged.  This might be used when a
+ *      packet carrying the object is known to have been lost.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object to forget.
+ *
+ *  Returns:
+ *      True if a state had been sent for the object, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool ChangeEncoder::Invalidate(std::uint64_t id)
+{
+    return last_sent.Remove(id);
+}
+
+/*
+ *  ChangeEncoder::Reset
+ *
+ *  Description:
+ *      This function will forget the state last sent for all objects, such
+ *      as when a new receiver joins.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ChangeEncoder::Reset()
+{
+    last_sent.Clear();
+}
+
+/*
+ *  ChangeEncoder::HasChanged
+ *
+ *  Description:
+ *      This function will determine whether an object's state differs from
+ *      that last sent.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object to check.
+ *
+ *      mesh_hash [out]
+ *          The hash of the object if it is a mesh, to be passed to Record().
+ *
+ *  Returns:
+ *      True if the object has changed or was never sent, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool ChangeEncoder::HasChanged(const GSObject &value,
+                               std::uint64_t &mesh_hash) const
+{
+    const std::optional<std::uint64_t> id = GetObjectID(value);
+
+    if (!id) return true;
+
+    const std::size_t index = last_sent.Find(*id);
+
+    if (std::holds_alternative<Mesh1>(value))
+    {
+        mesh_hash = HashMesh(std::get<Mesh1>(value));
+
+        if (index == ObjectTable::Not_Found) return true;
+
+        const std::optional<std::uint64_t> &last = last_sent.Get<1>(index);
+
+        return !last || (*last != mesh_hash);
+    }
+
+    if (index == ObjectTable::Not_Found) return true;
+
+    const std::optional<GSObject> &last = last_sent.Get<0>(index);
+
+    if (!last || (last->index() != value.index())) return true;
+
+    return !std::visit(
+        [&](const auto &last) -> bool
+        {
+            using T = std::decay_t<decltype(last)>;
+            return Unchanged(last, std::get<T>(value), epsilon);
+        },
+        *last);
+}
+
+/*
+ *  ChangeEncoder::Record
+ *
+ *  Description:
+ *      This function will remember the state sent for an object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object sent.
+ *
+ *      mesh_hash [in]
+ *          The hash of the object if it is a mesh.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Objects lacking an object ID are not remembered.
+ */
+void ChangeEncoder::Record(const GSObject &value, std::uint64_t mesh_hash)
+{
+    const std::optional<std::uint64_t> id = GetObjectID(value);
+
+    if (!id) return;
+
+    const std::size_t index = last_sent.Insert(*id);
+
+    if (std::holds_alternative<Mesh1>(value))
+    {
+        last_sent.Get<0>(index).reset();
+        last_sent.Get<1>(index) = mesh_hash;
+        return;
+    }
+
+    last_sent.Get<0>(index) = value;
+    last_sent.Get<1>(index).reset();
+}
+
+} // namespace gs
@@ -0,0 +1,649 @@
+/*
+ *  compressor.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Implementation of the Compressor object, which compresses packets of
+ *      encoded objects using a byte-oriented LZ77-class algorithm similar to
+ *      LZ4, favoring speed over compression ratio.
+ *
+ *      A compressed block is a series of sequences, each beginning with a token
+ *      octet.  The upper four bits of the token hold the number of literal
+ *      octets that follow and the lower four bits hold the match length minus
+ *      four.  A value of 15 in either field indicates that the length continues
+ *      in following octets, each added to the length, until an octet other than
+ *      255 is found.  The literals are followed by the match offset as a 16-bit
+ *      integer in network byte order and then any match length continuation
+ *      octets.  The final sequence contains only literals and ends the block.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "compressor.h"
+#include "gs_serializer.h"
+#include "gs_deserializer.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// Number of bits in the hash of four octets used to find matches
+constexpr unsigned Hash_Bits = 12;
+
+// Shortest match that is encoded and the largest offset to a match
+constexpr std::size_t Min_Match = 4;
+constexpr std::size_t Max_Offset = 65535;
+
+// Token field value indicating the length continues in following octets
+constexpr std::size_t Token_Length_Max = 15;
+
+/*
+ *  ReadQuad
+ *
+ *  Description:
+ *      Read four octets in host byte order, used only for hashing and
+ *      comparisons.
+ *
+ *  Parameters:
+ *      p [in]
+ *          Pointer to the first of the octets to read.
+ *
+ *  Returns:
+ *      The octets as a 32-bit value.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint32_t ReadQuad(const unsigned char *p)
+{
+    std::uint32_t value;
+
+    std::memcpy(&value, p, sizeof(value));
+
+    return value;
+}
+
+/*
+ *  HashQuad
+ *
+ *  Description:
+ *      Produce an index into the hash table from four octets.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The four octets as returned by ReadQuad().
+ *
+ *  Returns:
+ *      The hash table index.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::uint32_t HashQuad(std::uint32_t value)
+{
+    return (value * 2654435761U) >> (32 - Hash_Bits);
+}
+
+/*
+ *  WriteLength
+ *
+ *  Description:
+ *      Write the continuation octets of a literal or match length.
+ *
+ *  Parameters:
+ *      output [in]
+ *          Pointer to the location at which to write.
+ *
+ *      length [in]
+ *          The portion of the length not held in the token.
+ *
+ *  Returns:
+ *      Pointer to the location following the octets written.
+ *
+ *  Comments:
+ *      None.
+ */
+inline unsigned char *WriteLength(unsigned char *output, std::size_t length)
+{
+    while (length >= 255)
+    {
+        *output++ = 255;
+        length -= 255;
+    }
+    *output++ = static_cast<unsigned char>(length);
+
+    return output;
+}
+
+/*
+ *  ReadLength
+ *
+ *  Description:
+ *      Read the continuation octets of a literal or match length.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The compressed block.
+ *
+ *      length [in]
+ *          The length of the compressed block.
+ *
+ *      position [in/out]
+ *          The position within the block at which to read, which is
+ *          advanced past the octets read.
+ *
+ *  Returns:
+ *      The portion of the length not held in the token.
+ *
+ *  Comments:
+ *      A CompressorException is thrown if the block ends prematurely.
+ */
+inline std::size_t ReadLength(const unsigned char *input,
+                              std::size_t length,
+                              std::size_t &position)
+{
+    std::size_t value{};
+    unsigned char octet;
+
+    do
+    {
+        if (position >= length)
+        {
+            throw CompressorException("Truncated compressed block");
+        }
+        octet = input[position++];
+        value += octet;
+    } while (octet == 255);
+
+    return value;
+}
+
+} // namespace
+
+/*
+ *  Compressor::Compressor
+ *
+ *  Description:
+ *      Constructor for the Compressor object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The hash table and scratch buffer are retained between calls so that
+ *      compressing a packet does not require memory allocation once the
+ *      scratch buffer has grown to the largest packet size.
+ */
+Compressor::Compressor() : hash_table(std::size_t(1) << Hash_Bits)
+{
+}
+
+/*
+ *  Compressor::Compress
+ *
+ *  Description:
+ *      Compress the data in the input buffer, appending a framed packet to
+ *      the output buffer.  The frame begins with a CompressionMethod octet.
+ *      For stored packets, the original data follows.  For compressed
+ *      packets, the original length follows as a VarUint and then the
+ *      compressed block.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The data buffer holding the packet to compress.
+ *
+ *      output [in/out]
+ *          The data buffer to which the framed packet shall be appended.
+ *
+ *      options [in]
+ *          The options controlling when compression is applied.
+ *
+ *  Returns:
+ *      The number of octets appended to the output buffer or zero if the
+ *      output buffer has insufficient space, in which case nothing is
+ *      appended.
+ *
+ *  Comments:
+ *      The packet is stored without compression if it is shorter than the
+ *      minimum length or if compression does not reduce its length to the
+ *      given percentage of the original.  Entropy coding is attempted only
+ *      if requested and an entropy coder has been set.
+ */
+std::size_t Compressor::Compress(const DataBuffer &input,
+                                 DataBuffer &output,
+                                 const CompressionOptions &options)
+{
+    const std::size_t length = input.GetDataLength();
+    const unsigned char *data = input.GetBufferPointer();
+    const std::size_t available = output.GetBufferSize() -
+                                  output.GetDataLength();
+
+    // Attempt compression only if the packet is large enough
+    if (length && (length >= options.min_length))
+    {
+        DataBuffer null_buffer;
+        Serializer serializer;
+        const VarUint original_length{length};
+        CompressionMethod method = CompressionMethod::LZ;
+
+        // Compress the packet into the scratch buffer
+        block.resize(GetMaxBlockLength(length));
+        std::size_t block_length = CompressBlock(data, length, block.data());
+
+        // Entropy code the packet if requested, keeping the smaller result
+        if (options.entropy_coding && entropy_coder.has_value())
+        {
+            coded.resize(EntropyCoder::GetMaxEncodedLength(length));
+            const std::size_t coded_length =
+                entropy_coder->Encode(data, length, coded.data(), coded.size());
+
+            if (coded_length < block_length)
+            {
+                method = CompressionMethod::Entropy;
+                block.swap(coded);
+                block_length = coded_length;
+            }
+        }
+
+        const std::size_t frame_length =
+            1 + serializer.Write(null_buffer, original_length) + block_length;
+
+        // Use the compressed block only if it is sufficiently smaller
+        if (static_cast<std::uint64_t>(frame_length) * 100 <=
+            static_cast<std::uint64_t>(length) * options.max_percent)
+        {
+            if (frame_length > available) return 0;
+
+            output.AppendValue(static_cast<std::uint8_t>(method));
+            serializer.Write(output, original_length);
+            output.AppendValue(block.data(), block_length);
+
+            return frame_length;
+        }
+    }
+
+    // Store the packet unchanged
+    if ((length + 1) > available) return 0;
+
+    output.AppendValue(static_cast<std::uint8_t>(CompressionMethod::Stored));
+    if (length) output.AppendValue(data, length);
+
+    return length + 1;
+}
+
+/*
+ *  Compressor::Decompress
+ *
+ *  Description:
+ *      Decompress a framed packet produced by Compress(), appending the
+ *      original data to the output buffer.
+ *
+ *  Parameters:
+ *      input [in/out]
+ *          The data buffer holding the framed packet, which is read from the
+ *          current read position to the end of the data.  The read position
+ *          is advanced to the end of the data.
+ *
+ *      output [in/out]
+ *          The data buffer to which the original data shall be appended.
+ *
+ *  Returns:
+ *      The number of octets appended to the output buffer.
+ *
+ *  Comments:
+ *      A CompressorException is thrown if the frame is malformed or if the
+ *      output buffer has insufficient space.  An EntropyCoderException is
+ *      thrown if entropy coded data is corrupt.
+ */
+std::size_t Compressor::Decompress(DataBuffer &input, DataBuffer &output)
+{
+    std::uint8_t method;
+    VarUint original_length;
+    Deserializer deserializer;
+
+    if (input.GetReadLength() >= input.GetDataLength())
+    {
+        throw CompressorException("Missing compression method");
+    }
+
+    input.ReadValue(method);
+
+    switch (static_cast<CompressionMethod>(method))
+    {
+        case CompressionMethod::Stored:
+            original_length.value =
+                input.GetDataLength() - input.GetReadLength();
+            break;
+
+        case CompressionMethod::LZ:
+            deserializer.Read(input, original_length);
+            break;
+
+        case CompressionMethod::Entropy:
+            if (!entropy_coder.has_value())
+            {
+                throw CompressorException("No entropy coder to decompress");
+            }
+            deserializer.Read(input, original_length);
+            break;
+
+        default:
+            throw CompressorException("Unsupported compression method");
+    }
+
+    // Ensure the original data will fit in the output buffer
+    if (original_length.value >
+        (output.GetBufferSize() - output.GetDataLength()))
+    {
+        throw CompressorException("Insufficient space to decompress packet");
+    }
+
+    const std::size_t length = original_length;
+    const std::size_t input_length =
+        input.GetDataLength() - input.GetReadLength();
+
+    if (static_cast<CompressionMethod>(method) == CompressionMethod::Stored)
+    {
+        if (length)
+        {
+            output.AppendValue(input.GetBufferPointer(input.GetReadLength()),
+                               length);
+        }
+    }
+    else
+    {
+        if (!input_length)
+        {
+            throw CompressorException("Truncated compressed block");
+        }
+
+        const unsigned char *block_data =
+            input.GetBufferPointer(input.GetReadLength());
+        unsigned char *original =
+            output.GetMutableBufferPointer(output.GetDataLength());
+
+        if (static_cast<CompressionMethod>(method) == CompressionMethod::LZ)
+        {
+            DecompressBlock(block_data, input_length, original, length);
+        }
+        else
+        {
+            entropy_coder->Decode(block_data, input_length, original, length);
+        }
+        output.SetDataLength(output.GetDataLength() + length);
+    }
+
+    input.AdvanceReadLength(input_length);
+
+    return length;
+}
+
+/*
+ *  Compressor::GetMaxBlockLength
+ *
+ *  Description:
+ *      Return the largest possible length of a compressed block.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the data to be compressed.
+ *
+ *  Returns:
+ *      The largest possible length of the compressed block, which occurs
+ *      when the data contains no matches.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Compressor::GetMaxBlockLength(std::size_t length)
+{
+    return length + (length / 255) + 16;
+}
+
+/*
+ *  Compressor::CompressBlock
+ *
+ *  Description:
+ *      Compress the given data into a block of sequences.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The data to compress.
+ *
+ *      length [in]
+ *          The length of the data to compress.
+ *
+ *      output [out]
+ *          The location into which to write the block, which must have room
+ *          for at least GetMaxBlockLength() octets.
+ *
+ *  Returns:
+ *      The length of the compressed block.
+ *
+ *  Comments:
+ *      Matches are found greedily using a hash of the next four octets.
+ *      When no match is found for a while, the search skips ahead faster
+ *      so that incompressible data is passed over quickly.
+ */
+std::size_t Compressor::CompressBlock(const unsigned char *input,
+                                      std::size_t length,
+                                      unsigned char *output)
+{
+    unsigned char *op = output;
+    std::size_t position{};
+    std::size_t anchor{};
+
+    // Forget positions from any previous packet
+    std::fill(hash_table.begin(), hash_table.end(), 0);
+
+    while ((position + Min_Match) <= length)
+    {
+        const std::uint32_t quad = ReadQuad(input + position);
+        std::uint32_t &entry = hash_table[HashQuad(quad)];
+        const std::size_t candidate = entry;
+        entry = static_cast<std::uint32_t>(position);
+
+        // Is there a match at a usable offset?
+        if ((candidate >= position) ||
+            ((position - candidate) > Max_Offset) ||
+            (ReadQuad(input + candidate) != quad))
+        {
+            position += 1 + ((position - anchor) >> 6);
+            continue;
+        }
+
+        // Extend the match as far as possible
+        std::size_t match_length = Min_Match;
+        while (((position + match_length) < length) &&
+               (input[candidate + match_length] ==
+                input[position + match_length]))
+        {
+            match_length++;
+        }
+
+        // Write the token, literals, offset, and match length
+        const std::size_t literals = position - anchor;
+        const std::size_t match_extra = match_length - Min_Match;
+        const std::size_t offset = position - candidate;
+        *op++ = static_cast<unsigned char>(
+            (std::min(literals, Token_Length_Max) << 4) |
+            std::min(match_extra, Token_Length_Max));
+        if (literals >= Token_Length_Max)
+        {
+            op = WriteLength(op, literals - Token_Length_Max);
+        }
+        std::memcpy(op, input + anchor, literals);
+        op += literals;
+        *op++ = static_cast<unsigned char>(offset >> 8);
+        *op++ = static_cast<unsigned char>(offset);
+        if (match_extra >= Token_Length_Max)
+        {
+            op = WriteLength(op, match_extra - Token_Length_Max);
+        }
+
+        position += match_length;
+        anchor = position;
+    }
+
+    // Write the final sequence holding the remaining literals
+    const std::size_t literals = length - anchor;
+    *op++ = static_cast<unsigned char>(std::min(literals, Token_Length_Max)
+                                       << 4);
+    if (literals >= Token_Length_Max)
+    {
+        op = WriteLength(op, literals - Token_Length_Max);
+    }
+    std::memcpy(op, input + anchor, literals);
+    op += literals;
+
+    return static_cast<std::size_t>(op - output);
+}
+
+/*
+ *  Compressor::DecompressBlock
+ *
+ *  Description:
+ *      Decompress a block of sequences.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The compressed block.
+ *
+ *      length [in]
+ *          The length of the compressed block.
+ *
+ *      output [out]
+ *          The location into which to write the original data.
+ *
+ *      output_length [in]
+ *          The length of the original data.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Every length and offset is checked against the bounds of the input
+ *      and output, and a CompressorException is thrown if the block is
+ *      malformed or does not produce exactly the expected length.
+ */
+void Compressor::DecompressBlock(const unsigned char *input,
+                                 std::size_t length,
+                                 unsigned char *output,
+                                 std::size_t output_length)
+{
+    std::size_t position{};
+    std::size_t written{};
+
+    while (true)
+    {
+        if (position >= length)
+        {
+            throw CompressorException("Truncated compressed block");
+        }
+        const unsigned token = input[position++];
+
+        // Copy the literals
+        std::size_t literals = token >> 4;
+        if (literals == Token_Length_Max)
+        {
+            literals += ReadLength(input, length, position);
+        }
+        if ((literals > (length - position)) ||
+            (literals > (output_length - written)))
+        {
+            throw CompressorException("Invalid literal length");
+        }
+        if (literals) std::memcpy(output + written, input + position, literals);
+        position += literals;
+        written += literals;
+
+        // The final sequence ends the block
+        if (position == length) break;
+
+        // Copy the match
+        if ((length - position) < 2)
+        {
+            throw CompressorException("Truncated compressed block");
+        }
+        const std::size_t offset = (std::size_t(input[position]) << 8) |
+                                   input[position + 1];
+        position += 2;
+        if (!offset || (offset > written))
+        {
+            throw CompressorException("Invalid match offset");
+        }
+        std::size_t match_length = token & 0x0f;
+        if (match_length == Token_Length_Max)
+        {
+            match_length += ReadLength(input, length, position);
+        }
+        match_length += Min_Match;
+        if (match_length > (output_length - written))
+        {
+            throw CompressorException("Invalid match length");
+        }
+
+        // Overlapping matches repeat the most recent octets
+        if (offset >= match_length)
+        {
+            std::memcpy(output + written,
+                        output + written - offset,
+                        match_length);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < match_length; i++)
+            {
+                output[written + i] = output[written - offset + i];
+            }
+        }
+        written += match_length;
+    }
+
+    if (written != output_length)
+    {
+        throw CompressorException("Compressed block length mismatch");
+    }
+}
+
+} // namespace gs
@@ -0,0 +1,562 @@
+/*
+ *  dead_reckoning.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the DeadReckoningEncoder object, which suppresses
+ *      updates to heads and hands whose position is predicted by their last
+ *      sent velocity, and the DeadReckoningExtrapolator object, which makes the
+ *      same predictions at the receiver.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <type_traits>
+#include <variant>
+#include "dead_reckoning.h"
+#include "object_access.h"
+#include "half_float.h"
+
+namespace gs
+{
+
+namespace
+{
+
+/*
+ *  GetMotion
+ *
+ *  Description:
+ *      Retrieve the location, including velocity, and time of an object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose location is to be retrieved.
+ *
+ *      location [out]
+ *          The object's location.
+ *
+ *      time [out]
+ *          The object's time.
+ *
+ *  Returns:
+ *      True if the object carries a velocity, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool GetMotion(const GSObject &value, Loc2 &location, Time1 &time)
+{
+    if (const auto head1 = std::get_if<Head1>(&value))
+    {
+        location = head1->location;
+        time = head1->time;
+        return true;
+    }
+    if (const auto hand1 = std::get_if<Hand1>(&value))
+    {
+        location = hand1->location;
+        time = hand1->time;
+        return true;
+    }
+    if (const auto hand2 = std::get_if<Hand2>(&value))
+    {
+        location = hand2->location;
+        time = hand2->time;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ *  RoundVelocity
+ *
+ *  Description:
+ *      Round the velocity of an object's location to the precision with
+ *      which it is serialized, so that the sender predicts from the same
+ *      velocity the receiver decodes.
+ *
+ *  Parameters:
+ *      value [in/out]
+ *          The object whose velocity is to be rounded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void RoundVelocity(GSObject &value)
+{
+    Loc2 *location = nullptr;
+
+    if (auto head1 = std::get_if<Head1>(&value)) location = &head1->location;
+    if (auto hand1 = std::get_if<Hand1>(&value)) location = &hand1->location;
+    if (auto hand2 = std::get_if<Hand2>(&value)) location = &hand2->location;
+    if (location == nullptr) return;
+
+    for (Float16 *velocity : {&location->vx, &location->vy, &location->vz})
+    {
+        velocity->value = HalfFloatToFloat(FloatToHalfFloat(velocity->value));
+    }
+}
+
+/*
+ *  SameShape
+ *
+ *  Description:
+ *      These functions will determine whether the fields of a head or hand
+ *      other than its location and time are unchanged from the state last
+ *      sent, within the given thresholds.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The state last sent.
+ *
+ *      b [in]
+ *          The current state.
+ *
+ *      thresholds [in]
+ *          The thresholds for rotations and joints.
+ *
+ *  Returns:
+ *      True if the fields are unchanged, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SameShape(const Head1 &a,
+               const Head1 &b,
+               const DeadReckoningThresholds &thresholds)
+{
+    return Near(a.rotation, b.rotation, thresholds.rotation) &&
+           (a.ipd.has_value() == b.ipd.has_value()) &&
+           (!a.ipd || Near(a.ipd->ipd, b.ipd->ipd, thresholds.position));
+}
+
+bool SameShape(const Hand1 &a,
+               const Hand1 &b,
+               const DeadReckoningThresholds &thresholds)
+{
+    return (a.left == b.left) &&
+           Near(a.rotation, b.rotation, thresholds.rotation);
+}
+
+bool SameShape(const Hand2 &a,
+               const Hand2 &b,
+               const DeadReckoningThresholds &thresholds)
+{
+    return (a.left == b.left) &&
+           Near(a.rotation, b.rotation, thresholds.rotation) &&
+           Near(a.wrist, b.wrist, thresholds.position) &&
+           Near(a.thumb, b.thumb, thresholds.position) &&
+           Near(a.index, b.index, thresholds.position) &&
+           Near(a.middle, b.middle, thresholds.position) &&
+           Near(a.ring, b.ring, thresholds.position) &&
+           Near(a.pinky, b.pinky, thresholds.position);
+}
+
+} // namespace
+
+/*
+ *  PredictLocation
+ *
+ *  Description:
+ *      This function will predict the position of an object from a location
+ *      and the velocity it carries.
+ *
+ *  Parameters:
+ *      location [in]
+ *          The location, including velocity in meters per second.
+ *
+ *      from [in]
+ *          The time of the location in milliseconds.
+ *
+ *      to [in]
+ *          The time at which the position is to be predicted.
+ *
+ *  Returns:
+ *      The predicted position.
+ *
+ *  Comments:
+ *      Times wrap, so the elapsed time is taken to be the signed 16-bit
+ *      difference between them, allowing prediction up to about 32 seconds
+ *      either side of the location's time.  The DeadReckoningEncoder and
+ *      DeadReckoningExtrapolator both use this function so that the sender
+ *      and receiver make identical predictions.
+ */
+Loc1 PredictLocation(const Loc2 &location, Time1 from, Time1 to)
+{
+    const auto elapsed =
+        static_cast<std::int16_t>(static_cast<Time1>(to - from));
+    const float seconds = static_cast<float>(elapsed) / 1000.0f;
+
+    return {location.x + location.vx.value * seconds,
+            location.y + location.vy.value * seconds,
+            location.z + location.vz.value * seconds};
+}
+
+/*
+ *  DeadReckoningEncoder::DeadReckoningEncoder
+ *
+ *  Description:
+ *      Constructor for the DeadReckoningEncoder object.
+ *
+ *  Parameters:
+ *      thresholds [in]
+ *          The thresholds beyond which an update is sent.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Since the elapsed time is measured across the wrap of Time1, the
+ *      maximum interval may not exceed 32767 ms.  An EncoderException is
+ *      thrown if it does.
+ */
+DeadReckoningEncoder::DeadReckoningEncoder(
+                                const DeadReckoningThresholds &thresholds) :
+    thresholds{thresholds},
+    suppressed_count{}
+{
+    if (thresholds.max_interval > std::numeric_limits<std::int16_t>::max())
+    {
+        throw EncoderException("Maximum update interval exceeds 32767 ms");
+    }
+}
+
+/*
+ *  DeadReckoningEncoder::Encode
+ *
+ *  Description:
+ *      This function will encode those of the given objects whose state is
+ *      not predicted by the state last sent, appending them to the data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the objects shall be written.  If
+ *          given a buffer of zero-length, this call will just return the
+ *          octets required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The objects to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.  Suppressed objects count as
+ *      processed, so a value less than the number of objects indicates
+ *      there was no more room for additional objects in the data buffer.
+ *
+ *  Comments:
+ *      A head or hand is suppressed if the position predicted from the
+ *      location and velocity last sent is within the position threshold of
+ *      its position, its rotation and joints are within their thresholds of
+ *      those last sent, and no more than max_interval has passed since it
+ *      was last sent.  Objects without a velocity are always sent.  The
+ *      velocity last sent is rounded to Float16 precision before use, as it
+ *      would be by the receiver.  The state sent is remembered only when the
+ *      data buffer is not of zero-length.
+ */
+EncodeResult DeadReckoningEncoder::Encode(DataBuffer &data_buffer,
+                                          const GSObjects &value)
+{
+    EncodeResult result{};
+
+    suppressed_count = 0;
+
+    for (const auto &object : value)
+    {
+        const EncodeResult encoded = EncodeObject(data_buffer, object);
+        if (encoded.first == 0) break;
+
+        result.first += encoded.first;
+        result.second += encoded.second;
+    }
+
+    return result;
+}
+
+/*
+ *  DeadReckoningEncoder::Encode
+ *
+ *  Description:
+ *      This function will encode the given object if its state is not
+ *      predicted by the state last sent, appending it to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the object shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.  A suppressed object is
+ *      processed without serializing any octets, while a value of zero
+ *      objects indicates there was no room for the object.
+ *
+ *  Comments:
+ *      See the comments for encoding a vector of objects.
+ */
+EncodeResult DeadReckoningEncoder::Encode(DataBuffer &data_buffer,
+                                          const GSObject &value)
+{
+    suppressed_count = 0;
+
+    return EncodeObject(data_buffer, value);
+}
+
+/*
+ *  DeadReckoningEncoder::Invalidate
+ *
+ *  Description:
+ *      This function will forget the state last sent for an object, so that
+ *      it will be sent again.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object to forget.
+ *
+ *  Returns:
+ *      True if a state had been sent for the object, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool DeadReckoningEncoder::Invalidate(std::uint64_t id)
+{
+    return last_sent.Remove(id);
+}
+
+/*
+ *  DeadReckoningEncoder::EncodeObject
+ *
+ *  Description:
+ *      This function will encode the given object if its state is not
+ *      predicted by the state last sent and remember the state sent.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the object shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects processed and number of
+ *      octets serialized onto the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+EncodeResult DeadReckoningEncoder::EncodeObject(DataBuffer &data_buffer,
+                                                const GSObject &value)
+{
+    if (IsPredicted(value))
+    {
+        suppressed_count++;
+        return {1, 0};
+    }
+
+    const EncodeResult result = encoder.Encode(data_buffer, value);
+
+    Loc2 location{};
+    Time1 time{};
+    if ((result.first > 0) && data_buffer.GetBufferSize() &&
+        GetMotion(value, location, time))
+    {
+        const std::size_t index = last_sent.Insert(*GetObjectID(value));
+        GSObject &last = last_sent.Get<0>(index);
+
+        last = value;
+        RoundVelocity(last);
+    }
+
+    return result;
+}
+
+/*
+ *  DeadReckoningEncoder::IsPredicted
+ *
+ *  Description:
+ *      This function will determine whether the receiver's prediction of
+ *      an object from the state last sent is within the thresholds.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The current state of the object.
+ *
+ *  Returns:
+ *      True if the object need not be sent, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool DeadReckoningEncoder::IsPredicted(const GSObject &value) const
+{
+    Loc2 location{};
+    Loc2 last_location{};
+    Time1 time{};
+    Time1 last_time{};
+
+    if (!GetMotion(value, location, time)) return false;
+
+    const std::size_t index = last_sent.Find(*GetObjectID(value));
+    if (index == ObjectTable::Not_Found) return false;
+
+    const GSObject &last = last_sent.Get<0>(index);
+    if (last.index() != value.index()) return false;
+    if (!GetMotion(last, last_location, last_time)) return false;
+
+    // Send periodically even if the prediction remains accurate
+    const auto elapsed =
+        static_cast<std::int16_t>(static_cast<Time1>(time - last_time));
+    if (thresholds.max_interval &&
+        (std::abs(static_cast<int>(elapsed)) >= thresholds.max_interval))
+    {
+        return false;
+    }
+
+    // Compare the position with that predicted by the receiver
+    const Loc1 predicted = PredictLocation(last_location, last_time, time);
+    const float dx = location.x - predicted.x;
+    const float dy = location.y - predicted.y;
+    const float dz = location.z - predicted.z;
+    if (std::sqrt(dx * dx + dy * dy + dz * dz) > thresholds.position)
+    {
+        return false;
+    }
+
+    return std::visit(
+        [&](const auto &last) -> bool
+        {
+            using T = std::decay_t<decltype(last)>;
+            if constexpr (std::is_same_v<T, Head1> ||
+                          std::is_same_v<T, Hand1> ||
+                          std::is_same_v<T, Hand2>)
+            {
+                return SameShape(last, std::get<T>(value), thresholds);
+            }
+            return false;
+        },
+        last);
+}
+
+/*
+ *  DeadReckoningExtrapolator::Update
+ *
+ *  Description:
+ *      This function will record the location and time of a received object
+ *      for use in later predictions.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object received.
+ *
+ *  Returns:
+ *      True if the state was recorded, false if it was ignored.
+ *
+ *  Comments:
+ *      Objects without a velocity are ignored.  So are states not newer than
+ *      the state already recorded for the object, as when packets arrive out
+ *      of order, so that predictions continue from the newest state sent.
+ *      Times are compared across the wrap of Time1.
+ */
+bool DeadReckoningExtrapolator::Update(const GSObject &value)
+{
+    State state{};
+
+    if (!GetMotion(value, state.location, state.time)) return false;
+
+    const std::uint64_t id = *GetObjectID(value);
+    const std::size_t index = received.Find(id);
+    if (index != ObjectTable::Not_Found)
+    {
+        State &last = received.Get<0>(index);
+        const auto elapsed = static_cast<std::int16_t>(
+            static_cast<Time1>(state.time - last.time));
+        if (elapsed <= 0) return false;
+
+        last = state;
+        return true;
+    }
+
+    received.Get<0>(received.Insert(id)) = state;
+
+    return true;
+}
+
+/*
+ *  DeadReckoningExtrapolator::Predict
+ *
+ *  Description:
+ *      This function will predict the position of an object at the given
+ *      time from the location and velocity last received.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object whose position is to be predicted.
+ *
+ *      time [in]
+ *          The time at which the position is to be predicted.
+ *
+ *  Returns:
+ *      The predicted position or no value if the object is unknown.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<Loc1> DeadReckoningExtrapolator::Predict(std::uint64_t id,
+                                                       Time1 time) const
+{
+    const std::size_t index = received.Find(id);
+
+    if (index == ObjectTable::Not_Found) return {};
+
+    const State &state = received.Get<0>(index);
+
+    return PredictLocation(state.location, state.time, time);
+}
+
+} // namespace gs
@@ -0,0 +1,404 @@
+/*
+ *  entropy_coder.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      Implementation of the EntropyCoder object, which codes octets using
+ *      range asymmetric numeral systems (rANS) with a static symbol frequency
+ *      table.
+ *
+ *      Two rANS states are interleaved, with even-numbered octets coded using
+ *      the first state and odd-numbered octets using the second, which allows
+ *      the decoder to work on two independent dependency chains at once.  The
+ *      coded form holds the two final encoder states as 32-bit integers in
+ *      network byte order followed by the renormalization octets in the order
+ *      the decoder consumes them.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "entropy_coder.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// Lower bound of the normalized rANS state interval
+constexpr std::uint32_t Lower_Bound = std::uint32_t(1) << 23;
+
+// Total of the scaled frequencies and mask to extract a slot
+constexpr std::uint32_t Total_Frequency =
+    std::uint32_t(1) << EntropyCoder::Scale_Bits;
+constexpr std::uint32_t Slot_Mask = Total_Frequency - 1;
+
+// Number of interleaved rANS states
+constexpr std::size_t State_Count = 2;
+
+} // namespace
+
+/*
+ *  EntropyCoder::EntropyCoder
+ *
+ *  Description:
+ *      Constructor for the EntropyCoder object, which produces a coder
+ *      assigning the same frequency to all octet values.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+EntropyCoder::EntropyCoder() : frequency{}, cumulative{}, symbol{}
+{
+    frequency.fill(Total_Frequency / 256);
+
+    BuildTables();
+}
+
+/*
+ *  EntropyCoder::EntropyCoder
+ *
+ *  Description:
+ *      Constructor for the EntropyCoder object, which produces a coder
+ *      whose frequency table is scaled from the given symbol counts.
+ *
+ *  Parameters:
+ *      counts [in]
+ *          The number of times each octet value was observed in training
+ *          data.  If the counts are already scaled (i.e., each is at least
+ *          one and they sum to 1 << Scale_Bits), they are used unchanged,
+ *          so a table returned by GetFrequencies() reproduces the coder.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Every octet value is assigned a frequency of at least one so that
+ *      data not resembling the training data can still be coded.
+ */
+EntropyCoder::EntropyCoder(const SymbolCounts &counts) :
+    frequency{},
+    cumulative{},
+    symbol{}
+{
+    std::uint64_t total{};
+    bool scaled = true;
+
+    for (const auto count : counts)
+    {
+        total += count;
+        if (!count) scaled = false;
+    }
+
+    if (scaled && (total == Total_Frequency))
+    {
+        // Use the counts as given
+        for (std::size_t i = 0; i < counts.size(); i++)
+        {
+            frequency[i] = static_cast<std::uint16_t>(counts[i]);
+        }
+    }
+    else if (!total)
+    {
+        // With no training data, assume all octets are equally likely
+        frequency.fill(Total_Frequency / 256);
+    }
+    else
+    {
+        // Distribute the slots beyond the minimum of one per symbol
+        const double spare = Total_Frequency - counts.size();
+        std::uint32_t assigned{};
+
+        for (std::size_t i = 0; i < counts.size(); i++)
+        {
+            frequency[i] = static_cast<std::uint16_t>(
+                1 + static_cast<std::uint32_t>(
+                        (static_cast<double>(counts[i]) * spare) /
+                        static_cast<double>(total)));
+            assigned += frequency[i];
+        }
+
+        // Give any slots lost to rounding to the most frequent symbol
+        const std::size_t most_frequent = static_cast<std::size_t>(
+            std::max_element(counts.begin(), counts.end()) - counts.begin());
+        frequency[most_frequent] = static_cast<std::uint16_t>(
+            frequency[most_frequent] + (Total_Frequency - assigned));
+    }
+
+    BuildTables();
+}
+
+/*
+ *  EntropyCoder::CountSymbols
+ *
+ *  Description:
+ *      Add the number of times each octet value appears in the data buffer
+ *      to the given counts, which is used to train a frequency table.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer holding training data.
+ *
+ *      counts [in/out]
+ *          The counts to which to add.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void EntropyCoder::CountSymbols(const DataBuffer &data_buffer,
+                                SymbolCounts &counts)
+{
+    const std::size_t length = data_buffer.GetDataLength();
+
+    for (std::size_t i = 0; i < length; i++) counts[data_buffer[i]]++;
+}
+
+/*
+ *  EntropyCoder::GetMaxEncodedLength
+ *
+ *  Description:
+ *      Return the largest possible length of the coded form of data.
+ *
+ *  Parameters:
+ *      length [in]
+ *          The length of the data to be coded.
+ *
+ *  Returns:
+ *      The largest possible coded length.
+ *
+ *  Comments:
+ *      A symbol with the smallest frequency costs Scale_Bits bits, which
+ *      never requires more than two renormalization octets.
+ */
+std::size_t EntropyCoder::GetMaxEncodedLength(std::size_t length)
+{
+    return (length * 2) + (State_Count * sizeof(std::uint32_t));
+}
+
+/*
+ *  EntropyCoder::Encode
+ *
+ *  Description:
+ *      Encode the given octets.
+ *
+ *  Parameters:
+ *      input [in]
+ *          The octets to encode.
+ *
+ *      length [in]
+ *          The number of octets to encode.
+ *
+ *      output [out]
+ *          The location into which to write the coded form.
+ *
+ *      output_size [in]
+ *          The space available at the output location.
+ *
+ *  Returns:
+ *      The length of the coded form.
+ *
+ *  Comments:
+ *      rANS encodes in reverse, so the coded form is produced at the end of
+ *      the output space and then moved to the start.  An
+ *      EntropyCoderException is thrown if the output space is insufficient,
+ *      which cannot happen if it is at least GetMaxEncodedLength() octets.
+ */
+std::size_t EntropyCoder::Encode(const unsigned char *input,
+                                 std::size_t length,
+                                 unsigned char *output,
+                                 std::size_t output_size) const
+{
+    std::uint32_t state[State_Count] = {Lower_Bound, Lower_Bound};
+    unsigned char *p = output + output_size;
+
+    for (std::size_t i = length; i-- > 0;)
+    {
+        std::uint32_t &x = state[i % State_Count];
+        const std::uint32_t f = frequency[input[i]];
+        const std::uint32_t x_max = ((Lower_Bound >> Scale_Bits) << 8) * f;
+
+        // Renormalize so that the state remains in range after coding
+        while (x >= x_max)
+        {
+            if (p == output)
+            {
+                throw EntropyCoderException("Insufficient space to encode");
+            }
+            *--p = static_cast<unsigned char>(x);
+            x >>= 8;
+        }
+
+        x = ((x / f) << Scale_Bits) + (x % f) + cumulative[input[i]];
+    }
+
+    // Write the states so that the decoder reads the first state first
+    for (std::size_t i = State_Count; i-- > 0;)
+    {
+        if (static_cast<std::size_t>(p - output) < sizeof(std::uint32_t))
+        {
+            throw EntropyCoderException("Insufficient space to encode");
+        }
+        for (std::size_t j = 0; j < sizeof(std::uint32_t); j++)
+        {
+            *--p = static_cast<unsigned char>(state[i] >> (8 * j));
+        }
+    }
+
+    const std::size_t encoded_length =
+        static_cast<std::size_t>(output + output_size - p);
+    std::memmove(output, p, encoded_length);
+
+    return encoded_length;
+}
+
+/*
+ *  EntropyCoder::Decode
+ *
+ *  Description:
+ *      Decode the coded form of data produced by Encode().
+ *
+ *  Parameters:
+ *      input [in]
+ *          The coded form.
+ *
+ *      length [in]
+ *          The length of the coded form.
+ *
+ *      output [out]
+ *          The location into which to write the decoded octets.
+ *
+ *      output_length [in]
+ *          The number of octets to decode.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The coder must use the same frequency table as the encoder.  An
+ *      EntropyCoderException is thrown if the coded form is truncated or
+ *      if the final states are not the encoder's initial states, which
+ *      indicates that the data is corrupt or a different table was used.
+ */
+void EntropyCoder::Decode(const unsigned char *input,
+                          std::size_t length,
+                          unsigned char *output,
+                          std::size_t output_length) const
+{
+    std::uint32_t state[State_Count]{};
+    std::size_t position{};
+
+    if (length < (State_Count * sizeof(std::uint32_t)))
+    {
+        throw EntropyCoderException("Truncated entropy coded data");
+    }
+
+    for (auto &x : state)
+    {
+        for (std::size_t j = 0; j < sizeof(std::uint32_t); j++)
+        {
+            x = (x << 8) | input[position++];
+        }
+    }
+
+    for (std::size_t i = 0; i < output_length; i++)
+    {
+        std::uint32_t &x = state[i % State_Count];
+        const std::uint32_t slot = x & Slot_Mask;
+        const std::uint8_t s = symbol[slot];
+
+        output[i] = s;
+        x = (frequency[s] * (x >> Scale_Bits)) + slot - cumulative[s];
+
+        // Renormalize, reading octets until the state is back in range
+        while (x < Lower_Bound)
+        {
+            if (position >= length)
+            {
+                throw EntropyCoderException("Truncated entropy coded data");
+            }
+            x = (x << 8) | input[position++];
+        }
+    }
+
+    if ((position != length) || (state[0] != Lower_Bound) ||
+        (state[1] != Lower_Bound))
+    {
+        throw EntropyCoderException("Corrupt entropy coded data");
+    }
+}
+
+/*
+ *  EntropyCoder::BuildTables
+ *
+ *  Description:
+ *      Build the cumulative frequency and slot lookup tables from the
+ *      scaled frequency table.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void EntropyCoder::BuildTables()
+{
+    std::uint32_t start{};
+
+    for (std::size_t i = 0; i < frequency.size(); i++)
+    {
+        cumulative[i] = static_cast<std::uint16_t>(start);
+        std::fill(symbol.begin() + start,
+                  symbol.begin() + start + frequency[i],
+                  static_cast<std::uint8_t>(i));
+        start += frequency[i];
+    }
+}
+
+} // namespace gs
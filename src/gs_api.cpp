@@ -486,6 +486,7 @@ int CALL GSDecoderInit(GS_Decoder_Context **gs_decoder_context,
                 gs::Decoder(),
                 gs::DataBuffer(buffer, data_length, data_length),
                 {},
+                {},
                 {}
             }
         };
@@ -525,7 +526,8 @@ int CALL GSDecoderInit(GS_Decoder_Context **gs_decoder_context,
  *      0 if successful, -1 if there is an error.
  *
  *  Comments:
- *      None.
+ *      Any objects expanded from a compound object in the previous buffer
+ *      and not yet returned are discarded.
  */
 int CALL GSDecoderSetBuffer(GS_Decoder_Context *gs_decoder_context,
                             unsigned char *buffer,
@@ -544,6 +546,9 @@ int CALL GSDecoderSetBuffer(GS_Decoder_Context *gs_decoder_context,
         // Clear the error string
         gs_decoder_context->context.error.clear();
 
+        // Discard objects remaining from the previous buffer
+        gs_decoder_context->context.pending_objects.clear();
+
         // Assign the new buffer to the context's DataBuffer
         gs_decoder_context->context.data_buffer.SetBuffer(buffer,
                                                           data_length,
@@ -585,7 +590,8 @@ int CALL GSDecoderSetBuffer(GS_Decoder_Context *gs_decoder_context,
  *      0 if successful, -1 if there is an error.
  *
  *  Comments:
- *      None.
+ *      As with GSDecoderSetBuffer(), any objects expanded from a compound
+ *      object and not yet returned are discarded.
  */
 int CALL GSDecoderResetBuffer(GS_Decoder_Context *gs_decoder_context,
                               size_t data_length)
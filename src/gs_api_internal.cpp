@@ -957,22 +957,34 @@ constexpr void DeserializeCopy(const gs::Finger &finger,
  *      -1 if there is an error.
  *
  *  Comments:
- *      None.
+ *      The objects following the first in a compound object are held in
+ *      the context and returned by subsequent calls.
  */
 int GSDeserializeObject(GS_Decoder_Context_Internal &context, GS_Object &object)
 {
     int result = -1;
     gs::GSObject decoded_object{};
 
-    // If there are no more objects to decode, return 0
-    if (context.data_buffer.GetReadLength() >=
-        context.data_buffer.GetDataLength())
+    if (!context.pending_objects.empty())
     {
-        return 0;
+        // Return the next object expanded from a compound object
+        decoded_object = std::move(context.pending_objects.front());
+        context.pending_objects.erase(context.pending_objects.begin());
     }
+    else
+    {
+        // If there are no more objects to decode, return 0
+        if (context.data_buffer.GetReadLength() >=
+            context.data_buffer.GetDataLength())
+        {
+            return 0;
+        }
 
-    // Decode one object from the buffer
-    context.decoder.Decode(context.data_buffer, decoded_object);
+        // Decode one object from the buffer
+        context.decoder.Decode(context.data_buffer,
+                               decoded_object,
+                               context.pending_objects);
+    }
 
     // Zero the memory associated with the receiving object
     std::memset(&object, 0, sizeof(GS_Object));
@@ -71,6 +71,8 @@ typedef struct
     gs::DataBuffer data_buffer;                 // DataBuffer object
     std::string error;                          // Text for last error
     std::vector<std::uint8_t *> allocations;    // Memory allocations
+    gs::GSObjects pending_objects;              // Objects expanded from a
+                                                // compound object
 } GS_Decoder_Context_Internal;
 
 // Functions to perform object conversion and serialization
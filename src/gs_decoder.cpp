@@ -44,6 +44,12 @@
  */
 
 #include "gs_decoder.h"
+#include "mesh_coding.h"
+#include "rotation_coding.h"
+#include "parallel_coding.h"
+#include <algorithm>
+#include <limits>
+#include <cmath>
 
 namespace gs
 {
@@ -62,6 +68,10 @@ namespace gs
  *      value [out]
  *          The objects deserialized from the given DataBuffer.
  *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex (true by default).
+ *
  *  Returns:
  *      Number of octets consumed from the data buffer.  Additionally, the
  *      GSObjects vector will contain any objects found.  An exception will be
@@ -69,22 +79,150 @@ namespace gs
  *      considered invalid.
  *
  *  Comments:
- *      None.
+ *      A DecoderException is thrown if validating and a mesh has a triangle
+ *      index that does not refer to a vertex, so such a mesh never reaches
+ *      the caller.  Callers that check indices themselves may pass false.
+ */
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            GSObjects &value,
+                            bool validate)
+{
+    std::size_t read_length{};
+
+    // Loop until all data in the buffer is consumed, decoding objects serially
+    while (data_buffer.GetReadLength() < data_buffer.GetDataLength())
+    {
+        value.push_back({});
+        read_length += DecodeObject(data_buffer,
+                                    value.back(),
+                                    &value,
+                                    nullptr,
+                                    validate);
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Decode
+ *
+ *  Description:
+ *      This function will read all of the objects from the given buffer,
+ *      appending each object found to the GSObjects vector, and return the
+ *      bounding box of each mesh found.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the objects shall be decoded.
+ *
+ *      value [out]
+ *          The objects deserialized from the given DataBuffer.
+ *
+ *      bounds [out]
+ *          The bounding box of each object in the GSObjects vector, such that
+ *          bounds[i] corresponds to value[i].  Objects other than meshes
+ *          have no bounding box.  Entries for objects already in the vector
+ *          before the call are left unchanged.
+ *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex (true by default).
+ *
+ *  Returns:
+ *      Number of octets consumed from the data buffer.  An exception will be
+ *      thrown if there is an error, in which case the vectors should be
+ *      considered invalid.
+ *
+ *  Comments:
+ *      The bounding box of each mesh is computed as its vertices are read,
+ *      so the bounds of every mesh in a packet are available without a
+ *      further pass over the vertices.
  */
-std::size_t Decoder::Decode(DataBuffer &data_buffer, GSObjects &value)
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            GSObjects &value,
+                            std::vector<std::optional<MeshBounds>> &bounds,
+                            bool validate)
 {
     std::size_t read_length{};
 
+    bounds.resize(value.size());
+
     // Loop until all data in the buffer is consumed, decoding objects serially
     while (data_buffer.GetReadLength() < data_buffer.GetDataLength())
     {
+        const std::size_t index = value.size();
+        MeshBounds mesh_bounds;
+
         value.push_back({});
-        read_length += Decode(data_buffer, value.back());
+        read_length += DecodeObject(data_buffer,
+                                    value.back(),
+                                    &value,
+                                    &mesh_bounds,
+                                    validate);
+
+        bounds.resize(value.size());
+        if (std::holds_alternative<Mesh1>(value[index]))
+        {
+            bounds[index] = mesh_bounds;
+        }
     }
 
     return read_length;
 }
 
+/*
+ *  Decoder::Decode
+ *
+ *  Description:
+ *      This function will read all of the objects from the given buffer,
+ *      appending each object found to the GSObjects vector, and return the
+ *      dense handle assigned to each object by the given mapper.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the objects shall be decoded.
+ *
+ *      value [out]
+ *          The objects deserialized from the given DataBuffer.
+ *
+ *      mapper [in/out]
+ *          The mapper assigning dense indices to object IDs, which assigns
+ *          an index to each object seen for the first time.
+ *
+ *      handles [out]
+ *          The handle for each object in the GSObjects vector, such that
+ *          handles[i] corresponds to value[i].  Objects having no object ID
+ *          are given an invalid handle.  Only the objects decoded by this
+ *          call are mapped; entries for objects already in the vector are
+ *          left unchanged.
+ *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex (true by default).
+ *
+ *  Returns:
+ *      Number of octets consumed from the data buffer.  An exception will be
+ *      thrown if there is an error, in which case the vector should be
+ *      considered invalid.
+ *
+ *  Comments:
+ *      Receivers may use the handles to index arrays of object state
+ *      directly rather than looking up each object ID in a hash map.
+ */
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            GSObjects &value,
+                            ObjectIDMapper &mapper,
+                            std::vector<ObjectHandle> &handles,
+                            bool validate)
+{
+    const std::size_t first = value.size();
+    const std::size_t read_length = Decode(data_buffer, value, validate);
+
+    mapper.Map(value, handles, first);
+
+    return read_length;
+}
+
 /*
  *  Decoder::Decode
  *
@@ -100,18 +238,113 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, GSObjects &value)
  *      value [out]
  *          The object deserialized from the given DataBuffer.
  *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex (true by default).
+ *
  *  Returns:
  *      The number of octets consumed from the data buffer when decoding
  *      the object.
  *
  *  Comments:
- *      None.
+ *      A compound object, such as a PlayerFrame1, cannot be returned as a
+ *      single object, so a DecoderException is thrown if one is found.  The
+ *      read position is then restored to the start of the object, so the
+ *      caller may decode it with the overload returning expanded objects.
+ */
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            GSObject &value,
+                            bool validate)
+{
+    return DecodeObject(data_buffer, value, nullptr, nullptr, validate);
+}
+
+/*
+ *  Decoder::Decode
+ *
+ *  Description:
+ *      This function will read a single object from the given buffer,
+ *      appending any further objects carried with it in a compound object
+ *      to the given vector.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the objects shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.
+ *
+ *      expanded [out]
+ *          The vector to which any further objects are appended.
+ *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex (true by default).
+ *
+ *  Returns:
+ *      The number of octets consumed from the data buffer when decoding
+ *      the object.
+ *
+ *  Comments:
+ *      A PlayerFrame1 is expanded into a Head1, which is returned, followed
+ *      by its left and right Hand2, which are appended to the vector.  The
+ *      caller holds any objects not yet consumed, so the decoder retains
+ *      no state between calls.
+ */
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            GSObject &value,
+                            GSObjects &expanded,
+                            bool validate)
+{
+    return DecodeObject(data_buffer, value, &expanded, nullptr, validate);
+}
+
+/*
+ *  Decoder::DecodeObject
+ *
+ *  Description:
+ *      This function will read a single object from the given buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the objects shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.
+ *
+ *      expanded [out]
+ *          The vector to which objects following the first in a compound
+ *          object are appended, or nullptr if compound objects are not
+ *          accepted.  This may be the vector holding value, since value is
+ *          not accessed after objects are appended.
+ *
+ *      mesh_bounds [out]
+ *          The bounding box of the vertices if a mesh is decoded, or nullptr
+ *          if not required.
+ *
+ *      validate [in]
+ *          Whether to check that each mesh triangle index refers to a
+ *          vertex.
+ *
+ *  Returns:
+ *      The number of octets consumed from the data buffer when decoding
+ *      the object.
+ *
+ *  Comments:
+ *      A DecoderException is thrown if a compound object is found and
+ *      expanded is nullptr, leaving the buffer's read position at the start
+ *      of the object.
  */
-std::size_t Decoder::Decode(DataBuffer &data_buffer, GSObject &value)
+std::size_t Decoder::DecodeObject(DataBuffer &data_buffer,
+                                  GSObject &value,
+                                  GSObjects *expanded,
+                                  MeshBounds *mesh_bounds,
+                                  bool validate)
 {
     Tag tag;
     VarUint raw_tag;
     std::size_t read_length;
+    const std::size_t start = data_buffer.GetReadLength();
 
     // Deserialize the object tag value
     read_length = Deserialize(data_buffer, tag, raw_tag);
@@ -158,7 +391,10 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, GSObject &value)
             {
                 value = Mesh1{};
                 Mesh1 &mesh1 = std::get<Mesh1>(value);
-                read_length += Decode(data_buffer, mesh1);
+                read_length += Decode(data_buffer,
+                                      mesh1,
+                                      mesh_bounds,
+                                      validate);
             }
             break;
 
@@ -188,6 +424,75 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, GSObject &value)
                 read_length += Decode(data_buffer, object1);
             }
             break;
+
+        case Tag::CompactMesh1:
+            // Deserialize a compactly encoded Mesh1
+            {
+                value = Mesh1{};
+                Mesh1 &mesh1 = std::get<Mesh1>(value);
+                read_length += DecodeCompact(data_buffer,
+                                             mesh1,
+                                             mesh_bounds,
+                                             validate);
+            }
+            break;
+
+        case Tag::CompactObject1:
+            // Deserialize a compactly encoded Object1
+            {
+                value = Object1{};
+                Object1 &object1 = std::get<Object1>(value);
+                read_length += DecodeCompact(data_buffer, object1);
+            }
+            break;
+
+        case Tag::CompactHead1:
+            // Deserialize a compactly encoded Head1
+            {
+                value = Head1{};
+                Head1 &head1 = std::get<Head1>(value);
+                read_length += DecodeCompact(data_buffer, head1);
+            }
+            break;
+
+        case Tag::CompactHand2:
+            // Deserialize a compactly encoded Hand2
+            {
+                value = Hand2{};
+                Hand2 &hand2 = std::get<Hand2>(value);
+                read_length += DecodeCompact(data_buffer, hand2);
+            }
+            break;
+
+        case Tag::CompactHand1:
+            // Deserialize a compactly encoded Hand1
+            {
+                value = Hand1{};
+                Hand1 &hand1 = std::get<Hand1>(value);
+                read_length += DecodeCompact(data_buffer, hand1);
+            }
+            break;
+
+        case Tag::PlayerFrame1:
+            // Deserialize a PlayerFrame1, appending the hands after the head
+            {
+                if (expanded == nullptr)
+                {
+                    // Leave the object unread so the caller may decode it
+                    // using the overload accepting expanded objects
+                    data_buffer.ResetReadLength();
+                    data_buffer.AdvanceReadLength(start);
+                    throw DecoderException(
+                        "Cannot decode a PlayerFrame1 as a single object");
+                }
+
+                PlayerFrame1 player_frame1{};
+                read_length += DecodeCompact(data_buffer, player_frame1);
+                value = std::move(player_frame1.head);
+                expanded->emplace_back(std::move(player_frame1.left));
+                expanded->emplace_back(std::move(player_frame1.right));
+            }
+            break;
     }
 
     return read_length;
@@ -404,13 +709,25 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, Hand2 &value)
  *      value [out]
  *          The object deserialized from the given DataBuffer.
  *
+ *      mesh_bounds [out]
+ *          The bounding box of the vertices, or nullptr if not required.
+ *
+ *      validate [in]
+ *          Whether to check that each triangle index refers to a vertex.
+ *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
- *      None.
+ *      The bounding box of the vertices is computed if requested and, if
+ *      validating, each triangle index is checked as the vectors are read,
+ *      rather than in separate passes.  An exception
+ *      is thrown if an index does not refer to a vertex.
  */
-std::size_t Decoder::Decode(DataBuffer &data_buffer, Mesh1 &value)
+std::size_t Decoder::Decode(DataBuffer &data_buffer,
+                            Mesh1 &value,
+                            MeshBounds *mesh_bounds,
+                            bool validate)
 {
     VarUint extracted_length;
     std::size_t read_length;
@@ -423,10 +740,15 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, Mesh1 &value)
 
     // Read all of the required fields (evaluation order matters)
     read_length += Deserialize(data_buffer, value.id);
-    read_length += Deserialize(data_buffer, value.vertices);
+    read_length += DeserializeVertices(data_buffer,
+                                       value.vertices,
+                                       mesh_bounds);
     read_length += Deserialize(data_buffer, value.normals);
     read_length += Deserialize(data_buffer, value.textures);
-    read_length += Deserialize(data_buffer, value.triangles);
+    read_length += DeserializeIndices(data_buffer,
+                                      value.triangles,
+                                      value.vertices.size(),
+                                      validate);
 
     // Discard any octets not understood
     if ((read_length - length_field) < length)
@@ -597,158 +919,1653 @@ std::size_t Decoder::Decode(DataBuffer &data_buffer, Object1 &value)
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DecodeCompact
  *
  *  Description:
- *      This function will deserialize an object tag from the provided data
- *      buffer.
+ *      This function will decode a CompactMesh1 object type from the data
+ *      buffer, producing a Mesh1.  The tag value would have been read
+ *      already, so this function reads the length field and balance of the
+ *      octets.
  *
  *  Parameters:
  *      data_buffer [in]
- *          The data buffer from which the value shall be read.
+ *          The data buffer from which the object shall be decoded.
  *
  *      value [out]
- *          The interpreted tag value read from the buffer.
+ *          The object deserialized from the given DataBuffer.
  *
- *      raw_value [out]
- *          The raw tag value, which is useful in the case that the tag
- *          value read is unknown.
+ *      mesh_bounds [out]
+ *          The bounding box of the vertices, or nullptr if not required.
+ *
+ *      validate [in]
+ *          Whether to check that each triangle index refers to a vertex.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
- *      None.
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding that is not understood, since the balance of the object
+ *      could not then be interpreted.  As with Mesh1, the bounding box may
+ *      be computed and the triangle indices checked; this is done as the
+ *      vectors are read or reconstructed rather than in separate passes.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer,
-                                 Tag &value,
-                                 VarUint &raw_value)
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer,
+                                   Mesh1 &value,
+                                   MeshBounds *mesh_bounds,
+                                   bool validate)
 {
+    VarUint extracted_length;
+    VarUint flags;
     std::size_t read_length;
-    VarUint tag_value{};
+    std::size_t length_field;
 
-    // Read the tag value from the buffer
-    read_length = Deserialize(data_buffer, tag_value);
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
 
-    // Set the raw tag value to the value read
-    raw_value = tag_value;
+    // Read all of the required fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.id);
+    read_length += Deserialize(data_buffer, flags);
+
+    // Ensure all of the indicated encodings are understood
+    if (flags.value & ~static_cast<std::uint64_t>(
+                          CompactMesh_Delta_Indices |
+                          CompactMesh_Quantized_Positions |
+                          CompactMesh_Octahedral_Normals |
+                          CompactMesh_Predicted_Positions))
+    {
+        throw DecoderException("Unsupported compact mesh encoding");
+    }
 
-    switch (tag_value.value)
+    // Predicted positions are quantized and follow the triangles
+    const bool predicted = (flags.value & CompactMesh_Predicted_Positions);
+    if (predicted && !(flags.value & CompactMesh_Quantized_Positions))
     {
-        case 0x00:
-            throw DecoderException("Invalid object tag in data buffer");
-            break;
+        throw DecoderException("Predicted vertex positions must be quantized");
+    }
 
-        case 0x01:
-            value = Tag::Head1;
-            break;
+    const bool quantized = (flags.value & CompactMesh_Quantized_Positions);
+    if (!quantized)
+    {
+        read_length += DeserializeVertices(data_buffer,
+                                           value.vertices,
+                                           mesh_bounds);
+    }
+    else if (!predicted)
+    {
+        read_length += DeserializeQuantized(data_buffer,
+                                            value.vertices,
+                                            mesh_bounds);
+    }
 
-        case 0x02:
-            value = Tag::Hand1;
-            break;
+    if (flags.value & CompactMesh_Octahedral_Normals)
+    {
+        read_length += DeserializeOctahedral(data_buffer, value.normals);
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.normals);
+    }
 
-        case 0x03:
-            value = Tag::Object1;
-            break;
+    read_length += Deserialize(data_buffer, value.textures);
 
-        case 0x8000:
-            value = Tag::Mesh1;
-            break;
+    const bool delta = (flags.value & CompactMesh_Delta_Indices);
+    if (delta)
+    {
+        // Indices for predicted positions are checked as those are read
+        read_length += DeserializeDeltas(data_buffer,
+                                         value.triangles,
+                                         value.vertices.size(),
+                                         validate && !predicted);
+    }
+    else if (!predicted)
+    {
+        read_length += DeserializeIndices(data_buffer,
+                                          value.triangles,
+                                          value.vertices.size(),
+                                          validate);
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.triangles);
+    }
 
-        case 0x8001:
-            value = Tag::Hand2;
-            break;
+    // Predicted positions are reconstructed only from valid indices
+    if (predicted)
+    {
+        read_length += DeserializePredicted(data_buffer,
+                                            value.vertices,
+                                            value.triangles,
+                                            mesh_bounds);
+    }
 
-        case 0x8002:
-            value = Tag::HeadIPD1;
-            break;
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
 
-        default:
-            value = Tag::Invalid;
-            break;
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
     }
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DecodeCompact
  *
  *  Description:
- *      This function will deserialize a Loc1 structure from the provided data
- *      buffer.
+ *      This function will decode a CompactObject1 object type from the data
+ *      buffer, producing an Object1.  The tag value would have been read
+ *      already, so this function reads the length field and balance of the
+ *      octets.
  *
  *  Parameters:
  *      data_buffer [in]
- *          The data buffer from which the value shall be read.
+ *          The data buffer from which the object shall be decoded.
  *
  *      value [out]
- *          The value read from the buffer.
+ *          The object deserialized from the given DataBuffer.  This must be
+ *          value-initialized, as fields omitted from the encoding are left
+ *          unchanged when the default value is zero.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
- *      None.
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding or field that is not understood.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Loc1 &value)
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer, Object1 &value)
 {
-    std::size_t read_length{};
-
-    read_length = Deserialize(data_buffer, value.x);
-    read_length += Deserialize(data_buffer, value.y);
-    read_length += Deserialize(data_buffer, value.z);
+    VarUint extracted_length;
+    VarUint flags;
+    VarUint presence;
+    std::uint8_t rotation_bits{};
+    std::size_t read_length;
+    std::size_t length_field;
 
-    return read_length;
-}
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
 
-/*
+    // Read all of the required fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.id);
+    read_length += DeserializeObjectFlags(data_buffer,
+                                          CompactPresence_Position |
+                                              CompactPresence_Rotation |
+                                              CompactPresence_Scale |
+                                              CompactPresence_Parent |
+                                              CompactPresence_Active,
+                                          flags,
+                                          rotation_bits,
+                                          presence);
+    read_length += Deserialize(data_buffer, value.time);
+
+    if (presence.value & CompactPresence_Position)
+    {
+        read_length += Deserialize(data_buffer, value.position);
+    }
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        read_length += DeserializeRotation(data_buffer,
+                                           value.rotation,
+                                           rotation_bits);
+    }
+
+    if (presence.value & CompactPresence_Scale)
+    {
+        read_length += Deserialize(data_buffer, value.scale);
+    }
+    else
+    {
+        value.scale = {1.0f, 1.0f, 1.0f};
+    }
+
+    if (flags.value & CompactObject_Field_Presence)
+    {
+        value.active = (presence.value & CompactPresence_Active) != 0;
+
+        if (presence.value & CompactPresence_Parent)
+        {
+            ObjectID parent;
+            read_length += Deserialize(data_buffer, parent);
+            value.parent = parent;
+        }
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.active);
+
+        // Is the optional parent present?
+        if ((read_length - length_field) < length)
+        {
+            ObjectID parent;
+            read_length += Deserialize(data_buffer, parent);
+            value.parent = parent;
+        }
+    }
+
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
+
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DecodeCompact
+ *
+ *  Description:
+ *      This function will decode a CompactHead1 object type from the data
+ *      buffer, producing a Head1.  The tag value would have been read
+ *      already, so this function reads the length field and balance of the
+ *      octets.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the object shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.  This must be
+ *          value-initialized, as fields omitted from the encoding are left
+ *          unchanged when the default value is zero.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding or field that is not understood.
+ */
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer, Head1 &value)
+{
+    VarUint extracted_length;
+    VarUint flags;
+    VarUint presence;
+    std::uint8_t rotation_bits{};
+    std::size_t read_length;
+    std::size_t length_field;
+
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
+
+    // Read all of the required fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.id);
+    read_length += DeserializeObjectFlags(data_buffer,
+                                          CompactPresence_Position |
+                                              CompactPresence_Velocity |
+                                              CompactPresence_Rotation |
+                                              CompactPresence_IPD,
+                                          flags,
+                                          rotation_bits,
+                                          presence);
+    read_length += Deserialize(data_buffer, value.time);
+    read_length += DeserializeFields(data_buffer,
+                                     value,
+                                     rotation_bits,
+                                     presence);
+
+    // Is the optional HeadIPD1 object present?
+    if ((flags.value & CompactObject_Field_Presence) ?
+            (presence.value & CompactPresence_IPD) :
+            ((read_length - length_field) < length))
+    {
+        GSObject object;
+        read_length += Decode(data_buffer, object);
+
+        // Ensure this is actually an HeadIPD1 object
+        if (!std::holds_alternative<HeadIPD1>(object))
+        {
+            throw DecoderException("Unexpected optional object type found "
+                                   "decoding CompactHead1");
+        }
+
+        value.ipd = std::get<HeadIPD1>(object);
+    }
+
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
+
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DecodeCompact
+ *
+ *  Description:
+ *      This function will decode a CompactHand1 object type from the data
+ *      buffer, producing a Hand1.  The tag value would have been read
+ *      already, so this function reads the length field and balance of the
+ *      octets.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the object shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.  This must be
+ *          value-initialized, as fields omitted from the encoding are left
+ *          unchanged when the default value is zero.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding or field that is not understood.
+ */
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer, Hand1 &value)
+{
+    VarUint extracted_length;
+    VarUint flags;
+    VarUint presence;
+    std::uint8_t rotation_bits{};
+    std::size_t read_length;
+    std::size_t length_field;
+
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
+
+    // Read all of the required fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.id);
+    read_length += DeserializeObjectFlags(data_buffer,
+                                          CompactPresence_Position |
+                                              CompactPresence_Velocity |
+                                              CompactPresence_Rotation |
+                                              CompactPresence_Left,
+                                          flags,
+                                          rotation_bits,
+                                          presence);
+    read_length += Deserialize(data_buffer, value.time);
+
+    if (flags.value & CompactObject_Field_Presence)
+    {
+        value.left = (presence.value & CompactPresence_Left) != 0;
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.left);
+    }
+
+    read_length += DeserializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        read_length += DeserializeRotation(data_buffer,
+                                           value.rotation,
+                                           rotation_bits);
+    }
+
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
+
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DecodeCompact
+ *
+ *  Description:
+ *      This function will decode a CompactHand2 object type from the data
+ *      buffer, producing a Hand2.  The tag value would have been read
+ *      already, so this function reads the length field and balance of the
+ *      octets.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the object shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.  This must be
+ *          value-initialized, as fields omitted from the encoding are left
+ *          unchanged when the default value is zero.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding or field that is not understood.
+ */
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer, Hand2 &value)
+{
+    VarUint extracted_length;
+    VarUint flags;
+    VarUint presence;
+    std::uint8_t rotation_bits{};
+    std::size_t read_length;
+    std::size_t length_field;
+
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
+
+    // Read all of the required fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.id);
+    read_length += DeserializeObjectFlags(data_buffer,
+                                          CompactPresence_Position |
+                                              CompactPresence_Velocity |
+                                              CompactPresence_Rotation |
+                                              CompactPresence_Left,
+                                          flags,
+                                          rotation_bits,
+                                          presence);
+    read_length += Deserialize(data_buffer, value.time);
+
+    if (flags.value & CompactObject_Field_Presence)
+    {
+        value.left = (presence.value & CompactPresence_Left) != 0;
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.left);
+    }
+
+    read_length += DeserializeFields(data_buffer,
+                                     value,
+                                     flags,
+                                     rotation_bits,
+                                     presence);
+
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
+
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DecodeCompact
+ *
+ *  Description:
+ *      This function will decode a PlayerFrame1 object type from the data
+ *      buffer, producing a Head1 and two Hand2 objects.  The tag value would
+ *      have been read already, so this function reads the length field and
+ *      balance of the octets.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the object shall be decoded.
+ *
+ *      value [out]
+ *          The object deserialized from the given DataBuffer.  This must be
+ *          value-initialized, as fields omitted from the encoding are left
+ *          unchanged when the default value is zero.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      The time value and encoding flags of the head apply to both hands.
+ *      An exception is thrown if the object indicates the use of an
+ *      encoding or field that is not understood.
+ */
+std::size_t Decoder::DecodeCompact(DataBuffer &data_buffer,
+                                   PlayerFrame1 &value)
+{
+    VarUint extracted_length;
+    VarUint flags;
+    VarUint presence;
+    std::uint8_t rotation_bits{};
+    std::size_t read_length;
+    std::size_t length_field;
+
+    // Read the object length
+    length_field = read_length = Deserialize(data_buffer, extracted_length);
+    if (!extracted_length.value) throw DecoderException("Invalid object length");
+    const std::size_t length = extracted_length;
+
+    // Read the head fields (evaluation order matters)
+    read_length += Deserialize(data_buffer, value.head.id);
+    read_length += DeserializeObjectFlags(data_buffer,
+                                          CompactPresence_Position |
+                                              CompactPresence_Velocity |
+                                              CompactPresence_Rotation |
+                                              CompactPresence_IPD,
+                                          flags,
+                                          rotation_bits,
+                                          presence);
+
+    // Presence masks are required to interpret the balance of the object
+    if (!(flags.value & CompactObject_Field_Presence))
+    {
+        throw DecoderException("PlayerFrame1 lacks field presence masks");
+    }
+
+    read_length += Deserialize(data_buffer, value.head.time);
+    read_length += DeserializeFields(data_buffer,
+                                     value.head,
+                                     rotation_bits,
+                                     presence);
+
+    // Is the optional HeadIPD1 object present?
+    if (presence.value & CompactPresence_IPD)
+    {
+        GSObject object;
+        read_length += Decode(data_buffer, object);
+
+        // Ensure this is actually an HeadIPD1 object
+        if (!std::holds_alternative<HeadIPD1>(object))
+        {
+            throw DecoderException("Unexpected optional object type found "
+                                   "decoding PlayerFrame1");
+        }
+
+        value.head.ipd = std::get<HeadIPD1>(object);
+    }
+
+    // Read the hand fields
+    for (Hand2 *hand : {&value.left, &value.right})
+    {
+        VarInt id_delta;
+
+        read_length += Deserialize(data_buffer, id_delta);
+        read_length += DeserializePresence(data_buffer,
+                                           CompactPresence_Position |
+                                               CompactPresence_Velocity |
+                                               CompactPresence_Rotation |
+                                               CompactPresence_Left,
+                                           presence);
+
+        // Object IDs are unsigned, so the sum wraps as needed
+        hand->id.value = value.head.id.value +
+                         static_cast<std::uint64_t>(id_delta.value);
+        hand->time = value.head.time;
+        hand->left = (presence.value & CompactPresence_Left) != 0;
+
+        read_length += DeserializeFields(data_buffer,
+                                         *hand,
+                                         flags,
+                                         rotation_bits,
+                                         presence);
+    }
+
+    // Discard any octets not understood
+    if ((read_length - length_field) < length)
+    {
+        data_buffer.AdvanceReadLength(length - (read_length - length_field));
+
+        // Update the read_length
+        read_length += length - (read_length - length_field);
+    }
+
+    // Did we read more octets than we should have?
+    if ((read_length - length_field) > length)
+    {
+        throw DecoderException("Encoded object length error");
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize an object tag from the provided data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The interpreted tag value read from the buffer.
+ *
+ *      raw_value [out]
+ *          The raw tag value, which is useful in the case that the tag
+ *          value read is unknown.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer,
+                                 Tag &value,
+                                 VarUint &raw_value)
+{
+    std::size_t read_length;
+    VarUint tag_value{};
+
+    // Read the tag value from the buffer
+    read_length = Deserialize(data_buffer, tag_value);
+
+    // Set the raw tag value to the value read
+    raw_value = tag_value;
+
+    switch (tag_value.value)
+    {
+        case 0x00:
+            throw DecoderException("Invalid object tag in data buffer");
+            break;
+
+        case 0x01:
+            value = Tag::Head1;
+            break;
+
+        case 0x02:
+            value = Tag::Hand1;
+            break;
+
+        case 0x03:
+            value = Tag::Object1;
+            break;
+
+        case 0x8000:
+            value = Tag::Mesh1;
+            break;
+
+        case 0x8001:
+            value = Tag::Hand2;
+            break;
+
+        case 0x8002:
+            value = Tag::HeadIPD1;
+            break;
+
+        case 0x8003:
+            value = Tag::CompactMesh1;
+            break;
+
+        case 0x8004:
+            value = Tag::CompactObject1;
+            break;
+
+        case 0x8005:
+            value = Tag::CompactHead1;
+            break;
+
+        case 0x8006:
+            value = Tag::CompactHand2;
+            break;
+
+        case 0x8007:
+            value = Tag::CompactHand1;
+            break;
+
+        case 0x8008:
+            value = Tag::PlayerFrame1;
+            break;
+
+        default:
+            value = Tag::Invalid;
+            break;
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Loc1 structure from the provided data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Loc1 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.x);
+    read_length += Deserialize(data_buffer, value.y);
+    read_length += Deserialize(data_buffer, value.z);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Loc2 structure from the provided data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Loc2 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.x);
+    read_length += Deserialize(data_buffer, value.y);
+    read_length += Deserialize(data_buffer, value.z);
+    read_length += Deserialize(data_buffer, value.vx);
+    read_length += Deserialize(data_buffer, value.vy);
+    read_length += Deserialize(data_buffer, value.vz);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Norm1 structure from the provided data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Norm1 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.x);
+    read_length += Deserialize(data_buffer, value.y);
+    read_length += Deserialize(data_buffer, value.z);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a TextureUV1 structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, TextureUV1 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.u);
+    read_length += Deserialize(data_buffer, value.v);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Rot1 structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot1 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.i);
+    read_length += Deserialize(data_buffer, value.j);
+    read_length += Deserialize(data_buffer, value.k);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Rot2 structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot2 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.si);
+    read_length += Deserialize(data_buffer, value.sj);
+    read_length += Deserialize(data_buffer, value.sk);
+    read_length += Deserialize(data_buffer, value.ei);
+    read_length += Deserialize(data_buffer, value.ej);
+    read_length += Deserialize(data_buffer, value.ek);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Transform1 structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Transform1 &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.tx);
+    read_length += Deserialize(data_buffer, value.ty);
+    read_length += Deserialize(data_buffer, value.tz);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::Deserialize
+ *
+ *  Description:
+ *      This function will deserialize a Thumb structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Thumb &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.tip);
+    read_length += Deserialize(data_buffer, value.ip);
+    read_length += Deserialize(data_buffer, value.mcp);
+    read_length += Deserialize(data_buffer, value.cmc);
+
+    return read_length;
+}
+
+/*
  *  Decoder::Deserialize
  *
  *  Description:
- *      This function will deserialize a Loc2 structure from the provided data
- *      buffer.
+ *      This function will deserialize a Finger structure from the provided
+ *      data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Finger &value)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, value.tip);
+    read_length += Deserialize(data_buffer, value.dip);
+    read_length += Deserialize(data_buffer, value.pip);
+    read_length += Deserialize(data_buffer, value.mcp);
+    read_length += Deserialize(data_buffer, value.cmc);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DeserializeVertices
+ *
+ *  Description:
+ *      This function will deserialize a vector of mesh vertices from the
+ *      provided data buffer, computing their axis-aligned bounding box as
+ *      they are read if requested.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector of vertices read from the buffer.
+ *
+ *      bounds [out]
+ *          The bounding box of the vertices, or nullptr if not required.
+ *          NaN components are ignored, and along any axis having no other
+ *          components (including when there are no vertices) the bounds are
+ *          zero.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      The bounds of each block of vertices are computed while the block is
+ *      in cache.  Each chunk deserialized by a different thread extends its
+ *      own bounds, which are merged once all chunks are read.
+ */
+std::size_t Decoder::DeserializeVertices(DataBuffer &data_buffer,
+                                         std::vector<Loc1> &values,
+                                         MeshBounds *bounds)
+{
+    if (!bounds) return Deserialize(data_buffer, values);
+
+    std::vector<MeshBounds> chunk_bounds(GetThreadCount(max_threads));
+
+    for (auto &chunk : chunk_bounds) ClearBounds(chunk.min, chunk.max);
+
+    const std::size_t read_length = DeserializeVector(
+        data_buffer,
+        values,
+        [&](std::size_t chunk, const Loc1 *block, std::size_t count)
+        {
+            ExtendBounds(block,
+                         count,
+                         chunk_bounds[chunk].min,
+                         chunk_bounds[chunk].max);
+        });
+
+    // Merge the bounds of each chunk
+    ClearBounds(bounds->min, bounds->max);
+    for (const auto &chunk : chunk_bounds)
+    {
+        bounds->min.x = std::min(bounds->min.x, chunk.min.x);
+        bounds->min.y = std::min(bounds->min.y, chunk.min.y);
+        bounds->min.z = std::min(bounds->min.z, chunk.min.z);
+        bounds->max.x = std::max(bounds->max.x, chunk.max.x);
+        bounds->max.y = std::max(bounds->max.y, chunk.max.y);
+        bounds->max.z = std::max(bounds->max.z, chunk.max.z);
+    }
+    FinishBounds(bounds->min, bounds->max);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DeserializeIndices
+ *
+ *  Description:
+ *      This function will deserialize a vector of triangle indices from the
+ *      provided data buffer, optionally ensuring each refers to an existing
+ *      vertex as they are read.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector of indices read from the buffer.
+ *
+ *      vertex_count [in]
+ *          The number of vertices in the mesh.
+ *
+ *      validate [in]
+ *          Whether to check the indices.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if validating and any index is not less than
+ *      vertex_count.
+ */
+std::size_t Decoder::DeserializeIndices(DataBuffer &data_buffer,
+                                        std::vector<VarUint> &values,
+                                        std::size_t vertex_count,
+                                        bool validate)
+{
+    if (!validate) return Deserialize(data_buffer, values);
+
+    return DeserializeVector(
+        data_buffer,
+        values,
+        [&](std::size_t, const VarUint *block, std::size_t count)
+        {
+            ValidateIndices(block, count, vertex_count);
+        });
+}
+
+/*
+ *  Decoder::ValidateIndices
+ *
+ *  Description:
+ *      This function will ensure that each of the given triangle indices
+ *      refers to an existing vertex.
+ *
+ *  Parameters:
+ *      values [in]
+ *          The triangle indices to check.
+ *
+ *      count [in]
+ *          The number of indices.
+ *
+ *      vertex_count [in]
+ *          The number of vertices in the mesh.
+ *
+ *  Returns:
+ *      Nothing.  An exception is thrown if any index is not less than
+ *      vertex_count.
+ *
+ *  Comments:
+ *      The largest index is found without branching on each index so that
+ *      the loop may be vectorized.
+ */
+void Decoder::ValidateIndices(const VarUint *values,
+                              std::size_t count,
+                              std::size_t vertex_count)
+{
+    std::uint64_t largest{};
+
+    if (!count) return;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        largest = std::max(largest, values[i].value);
+    }
+
+    if (largest >= vertex_count)
+    {
+        throw DecoderException("Triangle index exceeds vertex count");
+    }
+}
+
+/*
+ *  Decoder::DeserializeDeltas
+ *
+ *  Description:
+ *      This function will deserialize a vector of delta-coded indices from
+ *      the provided data buffer, reconstructing the original index values.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector of indices read from the buffer.
+ *
+ *      vertex_count [in]
+ *          The number of vertices in the mesh.
+ *
+ *      validate [in]
+ *          Whether to ensure each index refers to an existing vertex.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      Each VarInt read is the difference from the previous index, with the
+ *      first index relative to zero.  Sums use modular 64-bit arithmetic to
+ *      mirror the encoder.  Each index is checked as it is reconstructed and
+ *      an exception is thrown if validating and an index is not less than
+ *      vertex_count.
+ */
+std::size_t Decoder::DeserializeDeltas(DataBuffer &data_buffer,
+                                       std::vector<VarUint> &values,
+                                       std::size_t vertex_count,
+                                       bool validate)
+{
+    std::size_t read_length;
+    VarUint expected_vector_length;
+    std::uint64_t previous{};
+    VarInt delta{};
+
+    // Read the number of indices that will follow
+    read_length = Deserialize(data_buffer, expected_vector_length);
+
+    // If the vector is empty, just return
+    if (expected_vector_length.value == 0) return read_length;
+
+    // Reconstruct each index from the difference
+    for (std::size_t i = 0; i < expected_vector_length.value; i++)
+    {
+        read_length += Deserialize(data_buffer, delta);
+        previous += static_cast<std::uint64_t>(delta.value);
+        if (validate && (previous >= vertex_count))
+        {
+            throw DecoderException("Triangle index exceeds vertex count");
+        }
+        values.push_back({previous});
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DeserializeQuantized
+ *
+ *  Description:
+ *      This function will deserialize a vector of quantized vertices from
+ *      the provided data buffer, converting them to floating point values.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector of vertices read from the buffer.
+ *
+ *      bounds [out]
+ *          The bounding box of the vertices, or nullptr if not required.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      The quantized components are converted directly from the data
+ *      buffer and bounded in a single pass.
+ */
+std::size_t Decoder::DeserializeQuantized(DataBuffer &data_buffer,
+                                          std::vector<Loc1> &values,
+                                          MeshBounds *bounds)
+{
+    std::size_t read_length;
+    VarUint expected_vector_length;
+    std::uint8_t bits{};
+    Loc1 min{};
+    Loc1 max{};
+
+    // Read the number of vertices and the quantization parameters
+    read_length = Deserialize(data_buffer, expected_vector_length);
+    read_length += Deserialize(data_buffer, bits);
+    read_length += Deserialize(data_buffer, min);
+    read_length += Deserialize(data_buffer, max);
+
+    if ((bits == 0) || (bits > 16))
+    {
+        throw DecoderException("Invalid vertex position quantization bits");
+    }
+
+    if (bounds) ClearBounds(bounds->min, bounds->max);
+
+    // If the vector is empty, just return
+    if (expected_vector_length.value == 0)
+    {
+        if (bounds) FinishBounds(bounds->min, bounds->max);
+        return read_length;
+    }
+
+    // Ensure the buffer holds all of the quantized components
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    const std::size_t available =
+        data_buffer.GetDataLength() - data_buffer.GetReadLength();
+    if (expected_vector_length.value > (available / (3 * width)))
+    {
+        throw DecoderException("Quantized vertex data exceeds buffer length");
+    }
+    const std::size_t count = expected_vector_length;
+    const std::size_t octets = count * 3 * width;
+
+    // Convert the components straight from the buffer
+    values.resize(count);
+    DequantizePositions(
+        data_buffer.GetBufferPointer(data_buffer.GetReadLength()),
+        count,
+        bits,
+        min,
+        max,
+        values.data(),
+        bounds ? &bounds->min : nullptr,
+        bounds ? &bounds->max : nullptr);
+    data_buffer.AdvanceReadLength(octets);
+
+    if (bounds) FinishBounds(bounds->min, bounds->max);
+
+    return read_length + octets;
+}
+
+/*
+ *  Decoder::DeserializePredicted
+ *
+ *  Description:
+ *      This function will deserialize a vector of vertices sent as
+ *      parallelogram prediction residuals of quantized components.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vertices read from the buffer.
+ *
+ *      triangles [in]
+ *          The mesh's triangle index vector, which determines the order in
+ *          which vertices were predicted.
+ *
+ *      bounds [out]
+ *          The bounding box of the vertices, or nullptr if not required.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if a triangle index does not refer to a
+ *      vertex or if a residual yields a component outside the quantized
+ *      range.
+ */
+std::size_t Decoder::DeserializePredicted(DataBuffer &data_buffer,
+                                          std::vector<Loc1> &values,
+                                          const std::vector<VarUint> &triangles,
+                                          MeshBounds *bounds)
+{
+    std::size_t read_length;
+    VarUint expected_vector_length;
+    std::uint8_t bits{};
+    Loc1 min{};
+    Loc1 max{};
+
+    // Read the number of vertices and the quantization parameters
+    read_length = Deserialize(data_buffer, expected_vector_length);
+    read_length += Deserialize(data_buffer, bits);
+    read_length += Deserialize(data_buffer, min);
+    read_length += Deserialize(data_buffer, max);
+
+    if ((bits == 0) || (bits > 16))
+    {
+        throw DecoderException("Invalid vertex position quantization bits");
+    }
+
+    // Ensure the buffer could hold all of the residuals
+    const std::size_t available =
+        data_buffer.GetDataLength() - data_buffer.GetReadLength();
+    if (expected_vector_length.value > (available / 3))
+    {
+        throw DecoderException("Predicted vertex data exceeds buffer length");
+    }
+    const std::size_t count = expected_vector_length;
+
+    // The triangles must refer only to the vertices sent
+    if ((triangles.size() % 3) != 0)
+    {
+        throw DecoderException("Triangle index count is not a multiple of "
+                               "three");
+    }
+    for (const auto &index : triangles)
+    {
+        if (index.value >= count)
+        {
+            throw DecoderException("Triangle index exceeds vertex count");
+        }
+    }
+
+    // Read the residuals
+    const std::int64_t max_residual = (std::int64_t(1) << bits) - 1;
+    std::vector<std::int32_t> residuals(count * 3);
+    for (auto &residual : residuals)
+    {
+        VarInt value;
+
+        read_length += Deserialize(data_buffer, value);
+        if ((value.value < -max_residual) || (value.value > max_residual))
+        {
+            throw DecoderException("Invalid vertex prediction residual");
+        }
+        residual = static_cast<std::int32_t>(value.value);
+    }
+
+    // Reconstruct the quantized components and convert them to positions
+    std::vector<std::uint16_t> quantized(count * 3);
+    if (!ReconstructPositions(triangles,
+                              count,
+                              bits,
+                              residuals.data(),
+                              quantized.data()))
+    {
+        throw DecoderException("Invalid vertex prediction residual");
+    }
+
+    values.resize(count);
+    if (bounds) ClearBounds(bounds->min, bounds->max);
+    DequantizePositions(quantized.data(),
+                        count,
+                        bits,
+                        min,
+                        max,
+                        values.data(),
+                        bounds ? &bounds->min : nullptr,
+                        bounds ? &bounds->max : nullptr);
+    if (bounds) FinishBounds(bounds->min, bounds->max);
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DeserializeOctahedral
+ *
+ *  Description:
+ *      This function will deserialize a vector of octahedral-coded normals
+ *      from the provided data buffer, converting them to unit vectors.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector of normals read from the buffer.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      The coordinates are decoded directly from the data buffer in a
+ *      single pass.
+ */
+std::size_t Decoder::DeserializeOctahedral(DataBuffer &data_buffer,
+                                           std::vector<Norm1> &values)
+{
+    std::size_t read_length;
+    VarUint expected_vector_length;
+    std::uint8_t bits{};
+
+    // Read the number of normals and the quantization parameter
+    read_length = Deserialize(data_buffer, expected_vector_length);
+    read_length += Deserialize(data_buffer, bits);
+
+    if ((bits == 0) || (bits > 16))
+    {
+        throw DecoderException("Invalid normal quantization bits");
+    }
+
+    // If the vector is empty, just return
+    if (expected_vector_length.value == 0) return read_length;
+
+    // Ensure the buffer holds all of the coordinates
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    const std::size_t available =
+        data_buffer.GetDataLength() - data_buffer.GetReadLength();
+    if (expected_vector_length.value > (available / (2 * width)))
+    {
+        throw DecoderException("Octahedral normal data exceeds buffer length");
+    }
+    const std::size_t count = expected_vector_length;
+    const std::size_t octets = count * 2 * width;
+
+    // Convert the coordinates straight from the buffer
+    values.resize(count);
+    DecodeOctahedral(data_buffer.GetBufferPointer(data_buffer.GetReadLength()),
+                     count,
+                     bits,
+                     values.data());
+    data_buffer.AdvanceReadLength(octets);
+
+    return read_length + octets;
+}
+
+/*
+ *  Decoder::DeserializeObjectFlags
+ *
+ *  Description:
+ *      This function will deserialize the flags found in compact objects,
+ *      along with any encoding parameters and the field presence mask that
+ *      follow the flags.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      fields [in]
+ *          The field presence bits understood for the type of object being
+ *          decoded.
+ *
+ *      flags [out]
+ *          The flags indicating which encodings are used.
+ *
+ *      rotation_bits [out]
+ *          The number of bits per compressed rotation component or zero if
+ *          rotations are not compressed.
+ *
+ *      presence [out]
+ *          The field presence mask.  If the object does not contain a mask,
+ *          this is set to the given fields value, indicating that all fields
+ *          are present.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      An exception is thrown if the flags indicate the use of an encoding
+ *      or the presence mask indicates a field that is not understood, since
+ *      the balance of the object could not then be interpreted.
+ */
+std::size_t Decoder::DeserializeObjectFlags(DataBuffer &data_buffer,
+                                            std::uint64_t fields,
+                                            VarUint &flags,
+                                            std::uint8_t &rotation_bits,
+                                            VarUint &presence)
+{
+    std::size_t read_length{};
+
+    read_length = Deserialize(data_buffer, flags);
+
+    // Ensure all of the indicated encodings are understood
+    if (flags.value & ~static_cast<std::uint64_t>(
+                          CompactObject_Compressed_Rotation |
+                          CompactObject_Quantized_Joints |
+                          CompactObject_Field_Presence))
+    {
+        throw DecoderException("Unsupported compact object encoding");
+    }
+
+    rotation_bits = 0;
+
+    if (flags.value & CompactObject_Compressed_Rotation)
+    {
+        read_length += Deserialize(data_buffer, rotation_bits);
+
+        if ((rotation_bits < Min_Rotation_Bits) ||
+            (rotation_bits > Max_Rotation_Bits))
+        {
+            throw DecoderException("Invalid rotation compression bits");
+        }
+    }
+
+    presence.value = fields;
+
+    if (flags.value & CompactObject_Field_Presence)
+    {
+        read_length += DeserializePresence(data_buffer, fields, presence);
+    }
+
+    return read_length;
+}
+
+/*
+ *  Decoder::DeserializePresence
+ *
+ *  Description:
+ *      This function will deserialize a compact object field presence mask
+ *      and ensure that all of the fields it indicates are understood.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer from which the value shall be read.
  *
- *      value [out]
- *          The value read from the buffer.
+ *      fields [in]
+ *          The field presence bits understood for the type of object being
+ *          decoded.
+ *
+ *      presence [out]
+ *          The field presence mask.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
- *      None.
+ *      An exception is thrown if the mask indicates a field that is not
+ *      understood.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Loc2 &value)
+std::size_t Decoder::DeserializePresence(DataBuffer &data_buffer,
+                                         std::uint64_t fields,
+                                         VarUint &presence)
 {
     std::size_t read_length{};
 
-    read_length = Deserialize(data_buffer, value.x);
-    read_length += Deserialize(data_buffer, value.y);
-    read_length += Deserialize(data_buffer, value.z);
-    read_length += Deserialize(data_buffer, value.vx);
-    read_length += Deserialize(data_buffer, value.vy);
-    read_length += Deserialize(data_buffer, value.vz);
+    read_length = Deserialize(data_buffer, presence);
+
+    // Ensure all of the indicated fields are understood
+    if (presence.value & ~fields)
+    {
+        throw DecoderException("Unsupported compact object field");
+    }
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeFields
  *
  *  Description:
- *      This function will deserialize a Norm1 structure from the provided data
- *      buffer.
+ *      These functions will deserialize the location, rotation, and, for a
+ *      Hand2, joint fields shared by the compact head and hand objects and
+ *      the PlayerFrame1 object.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer from which the value shall be read.
  *
  *      value [out]
- *          The value read from the buffer.
+ *          The object holding the fields to read.  Fields not present are
+ *          left unchanged.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *      rotation_bits [in]
+ *          The number of bits per compressed rotation component or zero if
+ *          rotations are not compressed.
+ *
+ *      presence [in]
+ *          The field presence mask of the object.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
@@ -756,30 +2573,76 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Loc2 &value)
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Norm1 &value)
+std::size_t Decoder::DeserializeFields(DataBuffer &data_buffer,
+                                       Head1 &value,
+                                       std::uint8_t rotation_bits,
+                                       const VarUint &presence)
 {
     std::size_t read_length{};
 
-    read_length = Deserialize(data_buffer, value.x);
-    read_length += Deserialize(data_buffer, value.y);
-    read_length += Deserialize(data_buffer, value.z);
+    read_length = DeserializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        read_length += DeserializeRotation(data_buffer,
+                                           value.rotation,
+                                           rotation_bits);
+    }
+
+    return read_length;
+}
+
+std::size_t Decoder::DeserializeFields(DataBuffer &data_buffer,
+                                       Hand2 &value,
+                                       const VarUint &flags,
+                                       std::uint8_t rotation_bits,
+                                       const VarUint &presence)
+{
+    std::size_t read_length{};
+
+    read_length = DeserializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        read_length += DeserializeRotation(data_buffer,
+                                           value.rotation,
+                                           rotation_bits);
+    }
+
+    if (flags.value & CompactObject_Quantized_Joints)
+    {
+        read_length += DeserializeJoints(data_buffer, value);
+    }
+    else
+    {
+        read_length += Deserialize(data_buffer, value.wrist);
+        read_length += Deserialize(data_buffer, value.thumb);
+        read_length += Deserialize(data_buffer, value.index);
+        read_length += Deserialize(data_buffer, value.middle);
+        read_length += Deserialize(data_buffer, value.ring);
+        read_length += Deserialize(data_buffer, value.pinky);
+    }
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeLocation
  *
  *  Description:
- *      This function will deserialize a TextureUV1 structure from the provided
- *      data buffer.
+ *      This function will deserialize the position and velocity portions of
+ *      a Loc2 structure if indicated as present.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer from which the value shall be read.
  *
  *      value [out]
- *          The value read from the buffer.
+ *          The value read from the buffer.  Portions not present are left
+ *          unchanged.
+ *
+ *      presence [in]
+ *          The field presence mask of the object holding the value.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
@@ -787,22 +2650,35 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Norm1 &value)
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, TextureUV1 &value)
+std::size_t Decoder::DeserializeLocation(DataBuffer &data_buffer,
+                                         Loc2 &value,
+                                         const VarUint &presence)
 {
     std::size_t read_length{};
 
-    read_length = Deserialize(data_buffer, value.u);
-    read_length += Deserialize(data_buffer, value.v);
+    if (presence.value & CompactPresence_Position)
+    {
+        read_length += Deserialize(data_buffer, value.x);
+        read_length += Deserialize(data_buffer, value.y);
+        read_length += Deserialize(data_buffer, value.z);
+    }
+
+    if (presence.value & CompactPresence_Velocity)
+    {
+        read_length += Deserialize(data_buffer, value.vx);
+        read_length += Deserialize(data_buffer, value.vy);
+        read_length += Deserialize(data_buffer, value.vz);
+    }
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeRotation
  *
  *  Description:
- *      This function will deserialize a Rot1 structure from the provided
- *      data buffer.
+ *      This function will deserialize a Rot1 structure from the provided data
+ *      buffer, decompressing it if a number of bits is given.
  *
  *  Parameters:
  *      data_buffer [in]
@@ -811,29 +2687,31 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, TextureUV1 &value)
  *      value [out]
  *          The value read from the buffer.
  *
+ *      bits [in]
+ *          The number of bits per smallest-three component or zero if the
+ *          rotation was serialized as Float16 values.
+ *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot1 &value)
+std::size_t Decoder::DeserializeRotation(DataBuffer &data_buffer,
+                                         Rot1 &value,
+                                         std::uint8_t bits)
 {
-    std::size_t read_length{};
+    if (!bits) return Deserialize(data_buffer, value);
 
-    read_length = Deserialize(data_buffer, value.i);
-    read_length += Deserialize(data_buffer, value.j);
-    read_length += Deserialize(data_buffer, value.k);
-
-    return read_length;
+    return DeserializeCompressed(data_buffer, &value, 1, bits);
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeRotation
  *
  *  Description:
- *      This function will deserialize a Rot2 structure from the provided
- *      data buffer.
+ *      This function will deserialize a Rot2 structure from the provided data
+ *      buffer, decompressing it if a number of bits is given.
  *
  *  Parameters:
  *      data_buffer [in]
@@ -842,39 +2720,56 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot1 &value)
  *      value [out]
  *          The value read from the buffer.
  *
+ *      bits [in]
+ *          The number of bits per smallest-three component or zero if the
+ *          rotation was serialized as Float16 values.
+ *
  *  Returns:
  *      The number of octets consumed in the data buffer.
  *
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot2 &value)
+std::size_t Decoder::DeserializeRotation(DataBuffer &data_buffer,
+                                         Rot2 &value,
+                                         std::uint8_t bits)
 {
     std::size_t read_length{};
+    Rot1 rotations[2];
 
-    read_length = Deserialize(data_buffer, value.si);
-    read_length += Deserialize(data_buffer, value.sj);
-    read_length += Deserialize(data_buffer, value.sk);
-    read_length += Deserialize(data_buffer, value.ei);
-    read_length += Deserialize(data_buffer, value.ej);
-    read_length += Deserialize(data_buffer, value.ek);
+    if (!bits) return Deserialize(data_buffer, value);
+
+    read_length = DeserializeCompressed(data_buffer, rotations, 2, bits);
+
+    value.si = rotations[0].i;
+    value.sj = rotations[0].j;
+    value.sk = rotations[0].k;
+    value.ei = rotations[1].i;
+    value.ej = rotations[1].j;
+    value.ek = rotations[1].k;
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeCompressed
  *
  *  Description:
- *      This function will deserialize a Transform1 structure from the provided
- *      data buffer.
+ *      This function will deserialize an array of rotations that were
+ *      serialized using the smallest-three representation.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer from which the value shall be read.
  *
- *      value [out]
- *          The value read from the buffer.
+ *      values [out]
+ *          The array into which the rotations shall be written.
+ *
+ *      count [in]
+ *          The number of rotations to read.
+ *
+ *      bits [in]
+ *          The number of bits per smallest-three component.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
@@ -882,30 +2777,51 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Rot2 &value)
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Transform1 &value)
+std::size_t Decoder::DeserializeCompressed(DataBuffer &data_buffer,
+                                           Rot1 *values,
+                                           std::size_t count,
+                                           std::uint8_t bits)
 {
     std::size_t read_length{};
+    std::uint64_t packed[2];
+    const std::size_t octets = CompressedRotationLength(bits);
 
-    read_length = Deserialize(data_buffer, value.tx);
-    read_length += Deserialize(data_buffer, value.ty);
-    read_length += Deserialize(data_buffer, value.tz);
+    // Decompress the rotations in batches
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        const std::size_t batch = std::min<std::size_t>(count - i, 2);
+
+        for (std::size_t n = 0; n < batch; n++)
+        {
+            packed[n] = 0;
+
+            for (std::size_t octet = 0; octet < octets; octet++)
+            {
+                std::uint8_t value{};
+                read_length += Deserialize(data_buffer, value);
+                packed[n] = (packed[n] << 8) | value;
+            }
+        }
+
+        DecompressRotations(packed, batch, bits, values + i);
+    }
 
     return read_length;
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeJoints
  *
  *  Description:
- *      This function will deserialize a Thumb structure from the provided
- *      data buffer.
+ *      This function will deserialize the wrist and finger joints of a Hand2
+ *      object that were quantized and packed by the encoder.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer from which the value shall be read.
  *
  *      value [out]
- *          The value read from the buffer.
+ *          The object whose joints are to be read from the data buffer.
  *
  *  Returns:
  *      The number of octets consumed in the data buffer.
@@ -913,49 +2829,160 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Transform1 &value)
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Thumb &value)
+std::size_t Decoder::DeserializeJoints(DataBuffer &data_buffer, Hand2 &value)
 {
     std::size_t read_length{};
+    std::uint8_t bits{};
+    Float16 range{};
 
-    read_length = Deserialize(data_buffer, value.tip);
-    read_length += Deserialize(data_buffer, value.ip);
-    read_length += Deserialize(data_buffer, value.mcp);
-    read_length += Deserialize(data_buffer, value.cmc);
+    // Read the quantization parameters
+    read_length = Deserialize(data_buffer, bits);
+    read_length += Deserialize(data_buffer, range);
 
-    return read_length;
+    if ((bits < 1) || (bits > 16))
+    {
+        throw DecoderException("Invalid joint quantization bits");
+    }
+    if (!(range.value > 0.0f) || !std::isfinite(range.value))
+    {
+        throw DecoderException("Invalid joint quantization range");
+    }
+
+    // Unpack each of the quantized joint components
+    BitReader reader(data_buffer);
+    const float step =
+        2.0f * range.value / static_cast<float>((1u << bits) - 1);
+    DeserializeJoint(reader, value.wrist, bits, range.value, step);
+    DeserializeJoint(reader, value.thumb, bits, range.value, step);
+    DeserializeJoint(reader, value.index, bits, range.value, step);
+    DeserializeJoint(reader, value.middle, bits, range.value, step);
+    DeserializeJoint(reader, value.ring, bits, range.value, step);
+    DeserializeJoint(reader, value.pinky, bits, range.value, step);
+
+    return read_length + reader.Align();
 }
 
 /*
- *  Decoder::Deserialize
+ *  Decoder::DeserializeJoint
  *
  *  Description:
- *      This function will deserialize a Finger structure from the provided
- *      data buffer.
+ *      This function will unpack and dequantize the components of a
+ *      Transform1 structure using the given bit reader.
  *
  *  Parameters:
- *      data_buffer [in]
- *          The data buffer from which the value shall be read.
+ *      reader [in]
+ *          The bit reader from which the value shall be read.
  *
  *      value [out]
- *          The value read from the buffer.
+ *          The value read.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      range [in]
+ *          Components were quantized over the range [-range, range].
+ *
+ *      step [in]
+ *          The distance between adjacent quantized values.
  *
  *  Returns:
- *      The number of octets consumed in the data buffer.
+ *      Nothing.
  *
  *  Comments:
  *      None.
  */
-std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Finger &value)
+void Decoder::DeserializeJoint(BitReader &reader,
+                               Transform1 &value,
+                               std::uint8_t bits,
+                               float range,
+                               float step)
 {
-    std::size_t read_length{};
+    value.tx.value = static_cast<float>(reader.Read(bits)) * step - range;
+    value.ty.value = static_cast<float>(reader.Read(bits)) * step - range;
+    value.tz.value = static_cast<float>(reader.Read(bits)) * step - range;
+}
 
-    read_length = Deserialize(data_buffer, value.tip);
-    read_length += Deserialize(data_buffer, value.dip);
-    read_length += Deserialize(data_buffer, value.pip);
-    read_length += Deserialize(data_buffer, value.mcp);
-    read_length += Deserialize(data_buffer, value.cmc);
+/*
+ *  Decoder::DeserializeJoint
+ *
+ *  Description:
+ *      This function will unpack and dequantize the joints of a Thumb
+ *      structure using the given bit reader.
+ *
+ *  Parameters:
+ *      reader [in]
+ *          The bit reader from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      range [in]
+ *          Components were quantized over the range [-range, range].
+ *
+ *      step [in]
+ *          The distance between adjacent quantized values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Decoder::DeserializeJoint(BitReader &reader,
+                               Thumb &value,
+                               std::uint8_t bits,
+                               float range,
+                               float step)
+{
+    DeserializeJoint(reader, value.tip, bits, range, step);
+    DeserializeJoint(reader, value.ip, bits, range, step);
+    DeserializeJoint(reader, value.mcp, bits, range, step);
+    DeserializeJoint(reader, value.cmc, bits, range, step);
+}
 
-    return read_length;
+/*
+ *  Decoder::DeserializeJoint
+ *
+ *  Description:
+ *      This function will unpack and dequantize the joints of a Finger
+ *      structure using the given bit reader.
+ *
+ *  Parameters:
+ *      reader [in]
+ *          The bit reader from which the value shall be read.
+ *
+ *      value [out]
+ *          The value read.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      range [in]
+ *          Components were quantized over the range [-range, range].
+ *
+ *      step [in]
+ *          The distance between adjacent quantized values.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Decoder::DeserializeJoint(BitReader &reader,
+                               Finger &value,
+                               std::uint8_t bits,
+                               float range,
+                               float step)
+{
+    DeserializeJoint(reader, value.tip, bits, range, step);
+    DeserializeJoint(reader, value.dip, bits, range, step);
+    DeserializeJoint(reader, value.pip, bits, range, step);
+    DeserializeJoint(reader, value.mcp, bits, range, step);
+    DeserializeJoint(reader, value.cmc, bits, range, step);
 }
 
 /*
@@ -981,6 +3008,48 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer, Finger &value)
 template <typename T>
 std::size_t Decoder::Deserialize(DataBuffer &data_buffer,
                                  std::vector<T> &values)
+{
+    return DeserializeVector(data_buffer,
+                             values,
+                             [](std::size_t, const T *, std::size_t) {});
+}
+
+/*
+ *  Decoder::DeserializeVector
+ *
+ *  Description:
+ *      This function will deserialize a vector of elements from the provided
+ *      data buffer, calling the given function for each block of elements
+ *      as soon as the block is deserialized.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      value [out]
+ *          The vector of elements read from the buffer.
+ *
+ *      visit [in]
+ *          The function to call with the index of the chunk holding, a
+ *          pointer to, and number of elements in, each block of up to
+ *          Visit_Block_Length elements.  It may throw an exception to reject
+ *          the elements.
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer.
+ *
+ *  Comments:
+ *      Vectors large enough to benefit are deserialized using multiple
+ *      threads if permitted by SetMaxThreads(), in which case the visiting
+ *      function is called concurrently for blocks in different chunks.
+ *      There are never more chunks than GetThreadCount() returns, and all
+ *      blocks are in chunk zero when one thread is used.  Visiting each
+ *      block while it is still in cache avoids a later pass over the vector.
+ */
+template <typename T, typename V>
+std::size_t Decoder::DeserializeVector(DataBuffer &data_buffer,
+                                       std::vector<T> &values,
+                                       const V &visit)
 {
     std::size_t read_length;
     VarUint expected_vector_length;
@@ -991,14 +3060,172 @@ std::size_t Decoder::Deserialize(DataBuffer &data_buffer,
     // If the vector is empty, just return
     if (expected_vector_length.value == 0) return read_length;
 
+    // Divide large vectors among multiple threads where possible
+    if (expected_vector_length.value <= std::numeric_limits<std::size_t>::max())
+    {
+        const std::size_t count = expected_vector_length;
+        const std::size_t chunks = GetChunkCount(count, max_threads);
+
+        if (chunks > 1)
+        {
+            const std::size_t length = DeserializeParallel(data_buffer,
+                                                           values,
+                                                           count,
+                                                           chunks,
+                                                           visit);
+            if (length) return read_length + length;
+        }
+    }
+
     // Deserialize each member of the vector from the buffer
+    std::size_t block = values.size();
     for (std::size_t i = 0; i < expected_vector_length.value; i++)
     {
         values.push_back({});
         read_length += Deserialize(data_buffer, values.back());
+
+        if ((values.size() - block) == Visit_Block_Length)
+        {
+            visit(0, values.data() + block, Visit_Block_Length);
+            block = values.size();
+        }
+    }
+    if (values.size() > block)
+    {
+        visit(0, values.data() + block, values.size() - block);
     }
 
     return read_length;
 }
 
+/*
+ *  Decoder::DeserializeParallel
+ *
+ *  Description:
+ *      This function will deserialize the elements of a vector from the
+ *      provided data buffer, dividing the work among multiple threads.  The
+ *      offset of each chunk of elements in the buffer is determined first
+ *      and then each chunk is deserialized directly into its place in the
+ *      vector.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer from which the value shall be read.
+ *
+ *      values [out]
+ *          The vector to which the elements read from the buffer are
+ *          appended.
+ *
+ *      count [in]
+ *          The number of elements to read.
+ *
+ *      chunks [in]
+ *          The number of chunks into which to divide the elements.
+ *
+ *      visit [in]
+ *          The function to call for each block of elements, as described
+ *          for DeserializeVector().
+ *
+ *  Returns:
+ *      The number of octets consumed in the data buffer or zero if the
+ *      elements could not be divided into chunks, in which case nothing is
+ *      consumed and the values are unchanged.
+ *
+ *  Comments:
+ *      The offsets of elements having a fixed length are computed directly.
+ *      For elements composed of VarUint values, the buffer is scanned using
+ *      only the first octet of each VarUint.  If the buffer is too short or
+ *      holds an invalid VarUint, zero is returned so that the caller will
+ *      report the error when deserializing the elements in turn.
+ */
+template <typename T, typename V>
+std::size_t Decoder::DeserializeParallel(DataBuffer &data_buffer,
+                                         std::vector<T> &values,
+                                         std::size_t count,
+                                         std::size_t chunks,
+                                         const V &visit)
+{
+    const std::size_t start = data_buffer.GetReadLength();
+    const std::size_t available = data_buffer.GetDataLength() - start;
+    std::vector<std::size_t> offsets(chunks + 1);
+
+    if (!available) return 0;
+    const unsigned char *data = data_buffer.GetBufferPointer(start);
+
+    // Determine the offset of each chunk relative to the first
+    if constexpr (FixedLength<T>::value != 0)
+    {
+        if (count > (available / FixedLength<T>::value)) return 0;
+
+        for (std::size_t chunk = 0; chunk <= chunks; chunk++)
+        {
+            offsets[chunk] = GetChunkBegin(count, chunks, chunk) *
+                             FixedLength<T>::value;
+        }
+    }
+    else if constexpr (VarUintCount<T>::value != 0)
+    {
+        std::size_t offset{};
+
+        if (count > (available / VarUintCount<T>::value)) return 0;
+
+        for (std::size_t chunk = 0; chunk < chunks; chunk++)
+        {
+            const std::size_t end = GetChunkBegin(count, chunks, chunk + 1) *
+                                    VarUintCount<T>::value;
+
+            offsets[chunk] = offset;
+            for (std::size_t i = GetChunkBegin(count, chunks, chunk) *
+                                 VarUintCount<T>::value;
+                 i < end;
+                 i++)
+            {
+                if (offset >= available) return 0;
+                const std::size_t length = VarUintLength(data[offset]);
+                if (!length) return 0;
+                offset += length;
+            }
+        }
+        if (offset > available) return 0;
+        offsets[chunks] = offset;
+    }
+    else
+    {
+        return 0;
+    }
+
+    // Deserialize each chunk directly into its place in the vector (the
+    // chunk buffers are only read, so the const_cast is safe)
+    const std::size_t base = values.size();
+    values.resize(base + count);
+    ParallelFor(count,
+                chunks,
+                [&](std::size_t chunk, std::size_t begin, std::size_t end)
+                {
+                    const std::size_t length = offsets[chunk + 1] -
+                                               offsets[chunk];
+                    DataBuffer chunk_buffer(
+                        const_cast<unsigned char *>(data + offsets[chunk]),
+                        length,
+                        length);
+                    for (std::size_t block = begin;
+                         block < end;
+                         block += Visit_Block_Length)
+                    {
+                        const std::size_t block_end =
+                            std::min(end, block + Visit_Block_Length);
+                        for (std::size_t i = block; i < block_end; i++)
+                        {
+                            Deserialize(chunk_buffer, values[base + i]);
+                        }
+                        visit(chunk,
+                              values.data() + base + block,
+                              block_end - block);
+                    }
+                });
+    data_buffer.AdvanceReadLength(offsets[chunks]);
+
+    return offsets[chunks];
+}
+
 } // namespace gs
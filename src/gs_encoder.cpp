@@ -50,11 +50,20 @@
  */
 
 #include "gs_encoder.h"
+#include "mesh_coding.h"
+#include "rotation_coding.h"
+#include "half_float.h"
+#include "parallel_coding.h"
 #include <limits>
+#include <algorithm>
+#include <cmath>
 
 namespace gs
 {
 
+// Number of components in the wrist and finger joints of a Hand2
+constexpr std::size_t Hand2_Joint_Components = 25 * 3;
+
 /*
  *  Encoder::Encode
  *
@@ -442,6 +451,108 @@ EncodeResult Encoder::Encode(DataBuffer &data_buffer, const Mesh1 &value)
     return {1, total_length};
 }
 
+/*
+ *  Encoder::Encode
+ *
+ *  Description:
+ *      This function will write a Mesh1 object whose elements are obtained
+ *      from producer functions to the given buffer, appending the data to
+ *      the end.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The element counts and producers of the mesh to serialize to the
+ *          end of the DataBuffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
+ *
+ *  Comments:
+ *      The encoded object is identical to that produced for a Mesh1 holding
+ *      the same elements, but no element vectors are constructed.  Since
+ *      vertices and normals have a fixed size, their producers are called
+ *      only while writing; the texture coordinate and index producers are
+ *      called twice per element, once to determine the object length and
+ *      once while writing.
+ */
+EncodeResult Encoder::Encode(DataBuffer &data_buffer, const MeshSource &value)
+{
+    std::size_t total_length{};
+    Length data_length{};
+
+    // Ensure there is a producer for each non-empty element sequence
+    if ((value.vertex_count && !value.vertex) ||
+        (value.normal_count && !value.normal) ||
+        (value.texture_count && !value.texture) ||
+        (value.triangle_count && !value.triangle))
+    {
+        throw EncoderException("Mesh element producer missing");
+    }
+
+    // Determine space required for this object
+    const std::uint64_t vertices_length =
+        Serialize(null_buffer, VarUint{value.vertex_count}) +
+        std::uint64_t(value.vertex_count) * Serialize(null_buffer, Loc1{});
+    const std::uint64_t normals_length =
+        Serialize(null_buffer, VarUint{value.normal_count}) +
+        std::uint64_t(value.normal_count) * Serialize(null_buffer, Norm1{});
+    data_length.value = Serialize(null_buffer, value.id) +
+                        vertices_length +
+                        normals_length +
+                        Serialize(null_buffer,
+                                  value.texture_count,
+                                  value.texture) +
+                        Serialize(null_buffer,
+                                  value.triangle_count,
+                                  value.triangle);
+
+    // Compute the total space required
+    const std::uint64_t size_check = Serialize(null_buffer, Tag::Mesh1) +
+                                     Serialize(null_buffer, data_length) +
+                                     data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::Mesh1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += Serialize(data_buffer, value.id);
+    total_length += Serialize(data_buffer, value.vertex_count, value.vertex);
+    total_length += Serialize(data_buffer, value.normal_count, value.normal);
+    total_length += Serialize(data_buffer,
+                              value.texture_count,
+                              value.texture);
+    total_length += Serialize(data_buffer,
+                              value.triangle_count,
+                              value.triangle);
+
+    return {1, total_length};
+}
+
 /*
  *  Encoder::Encode
  *
@@ -633,244 +744,2083 @@ EncodeResult Encoder::Encode(DataBuffer &data_buffer,
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::Encode
  *
  *  Description:
- *      This function will serialize a Tag value to the data buffer.
+ *      This function will write a Mesh1 object to the given buffer using
+ *      the CompactMesh1 encoding, appending the data to the end.
  *
  *  Parameters:
  *      data_buffer [in]
- *          The data buffer into which the value shall be written.
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the mesh is to be encoded.
  *
  *  Returns:
- *      The number of octets appended to the data buffer or would have been
- *      appended if the data_buffer contains a zero-sized buffer.
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
  *
  *  Comments:
- *      None.
+ *      When delta coding is enabled, each triangle index is serialized as a
+ *      VarInt holding the difference from the previous index.  Reordering
+ *      the triangles (which requires a copy of the index vector) generally
+ *      makes those differences smaller.  When vertex quantization is enabled,
+ *      vertex positions are sent relative to the mesh's bounding box.  When
+ *      position prediction is also enabled, each quantized vertex is instead
+ *      sent as its difference from a prediction formed from neighboring
+ *      vertices, following the triangles.  When octahedral normals are
+ *      enabled, each normal is sent as a pair of quantized coordinates.  When
+ *      welding is enabled, the mesh is first copied and duplicate vertices
+ *      are merged, which shrinks the vertex, normal, and texture vectors.
+ *      If none of delta coding, quantization, and octahedral normals is
+ *      enabled, the (possibly welded or reordered) mesh is sent as a plain
+ *      Mesh1 rather than a CompactMesh1, so that welding may be used with
+ *      receivers that understand only Mesh1.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer, Tag value)
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const Mesh1 &value,
+                             const MeshEncoding &encoding)
 {
-    VarUint tag{};
+    std::size_t total_length{};
+    Length data_length{};
+    VarUint flags{};
+    Loc1 min{};
+    Loc1 max{};
+    std::vector<VarUint> reordered_triangles;
+    const std::vector<VarUint> *triangles = &value.triangles;
+    std::vector<std::int32_t> residuals;
+
+    // Merge duplicate vertices in a copy of the mesh if requested
+    if (encoding.weld_vertices)
+    {
+        Mesh1 welded = value;
+        MeshEncoding welded_encoding = encoding;
 
-    switch (value)
+        WeldVertices(welded.vertices,
+                     welded.normals,
+                     welded.textures,
+                     welded.triangles);
+        welded_encoding.weld_vertices = false;
+
+        return Encode(data_buffer, welded, welded_encoding);
+    }
+
+    // Ensure the quantization parameters are valid
+    if (encoding.position_bits > 16)
     {
-        case Tag::Invalid:
-            tag.value = 0x00;
-            break;
+        throw EncoderException("Invalid vertex position quantization bits");
+    }
+    if (encoding.predict_positions && !encoding.position_bits)
+    {
+        throw EncoderException("Position prediction requires quantized "
+                               "vertex positions");
+    }
+    if (encoding.normal_bits > 16)
+    {
+        throw EncoderException("Invalid normal quantization bits");
+    }
 
-        case Tag::Head1:
-            tag.value = 0x01;
-            break;
+    // Determine the bounding box used to quantize vertices
+    if (encoding.position_bits)
+    {
+        ComputeBounds(value.vertices, min, max);
+        if (!std::isfinite(min.x) || !std::isfinite(min.y) ||
+            !std::isfinite(min.z) || !std::isfinite(max.x) ||
+            !std::isfinite(max.y) || !std::isfinite(max.z))
+        {
+            throw EncoderException("Cannot quantize non-finite vertex "
+                                   "positions");
+        }
+    }
 
-        case Tag::Hand1:
-            tag.value = 0x02;
-            break;
+    // Reorder the triangles if requested
+    if (encoding.reorder_triangles)
+    {
+        if ((value.triangles.size() % 3) != 0)
+        {
+            throw EncoderException("Triangle index count is not a multiple "
+                                   "of three");
+        }
+        reordered_triangles = value.triangles;
+        ReorderTriangles(reordered_triangles);
+        triangles = &reordered_triangles;
+    }
 
-        case Tag::Object1:
-            tag.value = 0x03;
-            break;
+    // Send a plain Mesh1, which every receiver understands, if no compact
+    // encoding is requested
+    if (!encoding.delta_indices && !encoding.position_bits &&
+        !encoding.normal_bits)
+    {
+        if (!encoding.reorder_triangles) return Encode(data_buffer, value);
 
-        case Tag::Mesh1:
-            tag.value = 0x8000;
-            break;
+        Mesh1 reordered = value;
+        reordered.triangles = std::move(reordered_triangles);
 
-        case Tag::Hand2:
-            tag.value = 0x8001;
-            break;
+        return Encode(data_buffer, reordered);
+    }
 
-        case Tag::HeadIPD1:
-            tag.value = 0x8002;
-            break;
+    // Compute the vertex prediction residuals if requested
+    if (encoding.predict_positions)
+    {
+        if ((triangles->size() % 3) != 0)
+        {
+            throw EncoderException("Triangle index count is not a multiple "
+                                   "of three");
+        }
+        for (const auto &index : *triangles)
+        {
+            if (index.value >= value.vertices.size())
+            {
+                throw EncoderException("Triangle index exceeds vertex count");
+            }
+        }
+
+        const unsigned bits = encoding.position_bits;
+        std::vector<std::uint16_t> quantized(value.vertices.size() * 3);
+        for (std::size_t i = 0; i < value.vertices.size(); i++)
+        {
+            const Loc1 &vertex = value.vertices[i];
+            quantized[i * 3] = QuantizeComponent(vertex.x, min.x, max.x, bits);
+            quantized[i * 3 + 1] =
+                QuantizeComponent(vertex.y, min.y, max.y, bits);
+            quantized[i * 3 + 2] =
+                QuantizeComponent(vertex.z, min.z, max.z, bits);
+        }
+
+        residuals.resize(quantized.size());
+        PredictPositions(*triangles,
+                         value.vertices.size(),
+                         encoding.position_bits,
+                         quantized.data(),
+                         residuals.data());
+    }
 
-        default:
-            tag.value = 0x00;
-            break;
+    // Indicate which encodings are used
+    if (encoding.delta_indices) flags.value |= CompactMesh_Delta_Indices;
+    if (encoding.position_bits)
+    {
+        flags.value |= CompactMesh_Quantized_Positions;
+    }
+    if (encoding.normal_bits) flags.value |= CompactMesh_Octahedral_Normals;
+    if (encoding.predict_positions)
+    {
+        flags.value |= CompactMesh_Predicted_Positions;
     }
 
-    // It is invalid to encode an "Invalid" tag type
-    if (tag.value == 0) throw EncoderException("Invalid object tag value");
+    // Determine space required for this object
+    data_length.value = Serialize(null_buffer, value.id) +
+                        Serialize(null_buffer, flags) +
+                        Serialize(null_buffer, value.textures);
 
-    return Serialize(data_buffer, tag);
+    if (encoding.normal_bits)
+    {
+        data_length.value += SerializeOctahedral(null_buffer,
+                                                 value.normals,
+                                                 encoding.normal_bits);
+    }
+    else
+    {
+        data_length.value += Serialize(null_buffer, value.normals);
+    }
+
+    if (encoding.predict_positions)
+    {
+        data_length.value += SerializePredicted(null_buffer,
+                                                residuals,
+                                                encoding.position_bits,
+                                                min,
+                                                max);
+    }
+    else if (encoding.position_bits)
+    {
+        data_length.value += SerializeQuantized(null_buffer,
+                                                value.vertices,
+                                                encoding.position_bits,
+                                                min,
+                                                max);
+    }
+    else
+    {
+        data_length.value += Serialize(null_buffer, value.vertices);
+    }
+
+    if (encoding.delta_indices)
+    {
+        data_length.value += SerializeDeltas(null_buffer, *triangles);
+    }
+    else
+    {
+        data_length.value += Serialize(null_buffer, *triangles);
+    }
+
+    // Compute the total space required
+    const std::uint64_t size_check = Serialize(null_buffer, Tag::CompactMesh1) +
+                                     Serialize(null_buffer, data_length) +
+                                     data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::CompactMesh1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += Serialize(data_buffer, value.id);
+    total_length += Serialize(data_buffer, flags);
+
+    // Predicted vertices instead follow the triangles, since the decoder
+    // needs the triangles in order to form the same predictions
+    if (!encoding.position_bits)
+    {
+        total_length += Serialize(data_buffer, value.vertices);
+    }
+    else if (!encoding.predict_positions)
+    {
+        total_length += SerializeQuantized(data_buffer,
+                                           value.vertices,
+                                           encoding.position_bits,
+                                           min,
+                                           max);
+    }
+
+    if (encoding.normal_bits)
+    {
+        total_length += SerializeOctahedral(data_buffer,
+                                            value.normals,
+                                            encoding.normal_bits);
+    }
+    else
+    {
+        total_length += Serialize(data_buffer, value.normals);
+    }
+
+    total_length += Serialize(data_buffer, value.textures);
+
+    if (encoding.delta_indices)
+    {
+        total_length += SerializeDeltas(data_buffer, *triangles);
+    }
+    else
+    {
+        total_length += Serialize(data_buffer, *triangles);
+    }
+
+    if (encoding.predict_positions)
+    {
+        total_length += SerializePredicted(data_buffer,
+                                           residuals,
+                                           encoding.position_bits,
+                                           min,
+                                           max);
+    }
+
+    return {1, total_length};
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::Encode
  *
  *  Description:
- *      This function will write a Head1 object to the given buffer, appending
- *      the data to the end.
+ *      This function will write an Object1 object to the given buffer using
+ *      the CompactObject1 encoding, appending the data to the end.
  *
  *  Parameters:
  *      data_buffer [in]
- *          The data buffer into which the value shall be written.
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
  *
  *      value [in]
  *          The object to serialize to the end of the DataBuffer.
  *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
  *  Returns:
- *      The number of octets appended to the data buffer or would have been
- *      appended if the data_buffer contains a zero-sized buffer.
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
  *
  *  Comments:
- *      None.
+ *      When rotation compression is enabled, the rotation is sent using the
+ *      smallest-three representation.  When default values are omitted, a
+ *      field presence mask follows the flags and fields holding default
+ *      values are not serialized.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const HeadIPD1 &value)
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const Object1 &value,
+                             const ObjectEncoding &encoding)
 {
     std::size_t total_length{};
-
     Length data_length{};
+    const VarUint flags = GetObjectFlags(encoding);
 
     // Determine space required for this object
-    data_length.value = Serialize(null_buffer, value.ipd);
+    data_length.value = SerializeCompact(null_buffer, value, encoding, flags);
+
+    // Compute the total space required
+    const std::uint64_t size_check =
+        Serialize(null_buffer, Tag::CompactObject1) +
+        Serialize(null_buffer, data_length) + data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
 
     // Serialize the object (evaluation order matters)
-    total_length = Serialize(data_buffer, Tag::HeadIPD1);
+    total_length = Serialize(data_buffer, Tag::CompactObject1);
     total_length += Serialize(data_buffer, data_length);
-    total_length += Serialize(data_buffer, value.ipd);
+    total_length += SerializeCompact(data_buffer, value, encoding, flags);
 
-    return total_length;
+    return {1, total_length};
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::Encode
  *
  *  Description:
- *      This function will serialize a Loc1 structure to the data buffer.
+ *      This function will write a Head1 object to the given buffer using
+ *      the CompactHead1 encoding, appending the data to the end.
  *
  *  Parameters:
  *      data_buffer [in]
- *          The data buffer into which the value shall be written.
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object to serialize to the end of the DataBuffer.
  *
- *  Returns:
- *      The number of octets appended to the data buffer or would have been
- *      appended if the data_buffer contains a zero-sized buffer.
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
+ *
+ *  Comments:
+ *      When rotation compression is enabled, each half of the Rot2 value is
+ *      sent using the smallest-three representation.  When default values
+ *      are omitted, a field presence mask follows the flags and fields
+ *      holding default values are not serialized.
+ */
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const Head1 &value,
+                             const ObjectEncoding &encoding)
+{
+    std::size_t total_length{};
+    Length data_length{};
+    const VarUint flags = GetObjectFlags(encoding);
+
+    // Determine space required for this object
+    data_length.value = SerializeCompact(null_buffer, value, encoding, flags);
+
+    // Compute the total space required
+    const std::uint64_t size_check =
+        Serialize(null_buffer, Tag::CompactHead1) +
+        Serialize(null_buffer, data_length) + data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::CompactHead1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += SerializeCompact(data_buffer, value, encoding, flags);
+
+    return {1, total_length};
+}
+
+/*
+ *  Encoder::Encode
+ *
+ *  Description:
+ *      This function will write a Hand1 object to the given buffer using
+ *      the CompactHand1 encoding, appending the data to the end.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
+ *
+ *  Comments:
+ *      When rotation compression is enabled, each half of the Rot2 value is
+ *      sent using the smallest-three representation.  When default values
+ *      are omitted, a field presence mask follows the flags and fields
+ *      holding default values are not serialized.
+ */
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const Hand1 &value,
+                             const ObjectEncoding &encoding)
+{
+    std::size_t total_length{};
+    Length data_length{};
+    const VarUint flags = GetObjectFlags(encoding);
+
+    // Determine space required for this object
+    data_length.value = SerializeCompact(null_buffer, value, encoding, flags);
+
+    // Compute the total space required
+    const std::uint64_t size_check =
+        Serialize(null_buffer, Tag::CompactHand1) +
+        Serialize(null_buffer, data_length) + data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::CompactHand1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += SerializeCompact(data_buffer, value, encoding, flags);
+
+    return {1, total_length};
+}
+
+/*
+ *  Encoder::Encode
+ *
+ *  Description:
+ *      This function will write a Hand2 object to the given buffer using
+ *      the CompactHand2 encoding, appending the data to the end.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
+ *
+ *  Comments:
+ *      When rotation compression is enabled, each half of the Rot2 value is
+ *      sent using the smallest-three representation.  When default values
+ *      are omitted, a field presence mask follows the flags and fields
+ *      holding default values are not serialized.
+ *      When joint quantization is enabled, the wrist and finger joints are
+ *      quantized relative to a fixed range and bit-packed.
+ */
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const Hand2 &value,
+                             const ObjectEncoding &encoding)
+{
+    std::size_t total_length{};
+    Length data_length{};
+    const VarUint flags = GetHandFlags(encoding);
+
+    // Determine space required for this object
+    data_length.value = SerializeCompact(null_buffer, value, encoding, flags);
+
+    // Compute the total space required
+    const std::uint64_t size_check =
+        Serialize(null_buffer, Tag::CompactHand2) +
+        Serialize(null_buffer, data_length) + data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::CompactHand2);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += SerializeCompact(data_buffer, value, encoding, flags);
+
+    return {1, total_length};
+}
+
+/*
+ *  Encoder::Encode
+ *
+ *  Description:
+ *      This function will write a user's head and hands to the given buffer
+ *      as a single PlayerFrame1 object, appending the data to the end.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.  If given
+ *          a buffer of zero-length, this call will just return the octets
+ *          required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than expected number of
+ *      objects would indicate there was no more room for additional objects
+ *      in the data buffer.  If the given data buffer is of zero-length,
+ *      this function will just return a count of objects and octets without
+ *      actually encoding to allow one to predetermine the space requirements.
+ *
+ *  Comments:
+ *      The head, left hand, and right hand must have the same time value,
+ *      which is serialized once.  The head's object ID is serialized in
+ *      full and each hand's object ID as a difference from it.  A field
+ *      presence mask is always sent for each of the three, so default values
+ *      are omitted regardless of the encoding options.
+ */
+EncodeResult Encoder::Encode(DataBuffer &data_buffer,
+                             const PlayerFrame1 &value,
+                             const ObjectEncoding &encoding)
+{
+    std::size_t total_length{};
+    Length data_length{};
+    VarUint flags = GetHandFlags(encoding);
+
+    // The frame carries only one time value
+    if ((value.left.time != value.head.time) ||
+        (value.right.time != value.head.time))
+    {
+        throw EncoderException("Player frame objects must share a time value");
+    }
+
+    // Presence masks convey the optional and Boolean fields
+    flags.value |= CompactObject_Field_Presence;
+
+    // Determine space required for this object
+    data_length.value = SerializeFrame(null_buffer, value, encoding, flags);
+
+    // Compute the total space required
+    const std::uint64_t size_check =
+        Serialize(null_buffer, Tag::PlayerFrame1) +
+        Serialize(null_buffer, data_length) + data_length.value;
+    if (size_check > std::numeric_limits<std::size_t>::max())
+    {
+        throw EncoderException("Object exceeds max size");
+    }
+    total_length = static_cast<std::size_t>(size_check);
+
+    // Ensure the data buffer has sufficient space
+    if ((data_buffer.GetDataLength() + total_length) >
+        data_buffer.GetBufferSize())
+    {
+        // If the buffer is zero-length, just return sizing data
+        if (data_buffer.GetBufferSize() == 0) return {1, total_length};
+
+        // Indicate an encoding error
+        return {0, 0};
+    }
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::PlayerFrame1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += SerializeFrame(data_buffer, value, encoding, flags);
+
+    return {1, total_length};
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Tag value to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer, Tag value)
+{
+    VarUint tag{};
+
+    switch (value)
+    {
+        case Tag::Invalid:
+            tag.value = 0x00;
+            break;
+
+        case Tag::Head1:
+            tag.value = 0x01;
+            break;
+
+        case Tag::Hand1:
+            tag.value = 0x02;
+            break;
+
+        case Tag::Object1:
+            tag.value = 0x03;
+            break;
+
+        case Tag::Mesh1:
+            tag.value = 0x8000;
+            break;
+
+        case Tag::Hand2:
+            tag.value = 0x8001;
+            break;
+
+        case Tag::HeadIPD1:
+            tag.value = 0x8002;
+            break;
+
+        case Tag::CompactMesh1:
+            tag.value = 0x8003;
+            break;
+
+        case Tag::CompactObject1:
+            tag.value = 0x8004;
+            break;
+
+        case Tag::CompactHead1:
+            tag.value = 0x8005;
+            break;
+
+        case Tag::CompactHand2:
+            tag.value = 0x8006;
+            break;
+
+        case Tag::CompactHand1:
+            tag.value = 0x8007;
+            break;
+
+        case Tag::PlayerFrame1:
+            tag.value = 0x8008;
+            break;
+
+        default:
+            tag.value = 0x00;
+            break;
+    }
+
+    // It is invalid to encode an "Invalid" tag type
+    if (tag.value == 0) throw EncoderException("Invalid object tag value");
+
+    return Serialize(data_buffer, tag);
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will write a Head1 object to the given buffer, appending
+ *      the data to the end.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const HeadIPD1 &value)
+{
+    std::size_t total_length{};
+
+    Length data_length{};
+
+    // Determine space required for this object
+    data_length.value = Serialize(null_buffer, value.ipd);
+
+    // Serialize the object (evaluation order matters)
+    total_length = Serialize(data_buffer, Tag::HeadIPD1);
+    total_length += Serialize(data_buffer, data_length);
+    total_length += Serialize(data_buffer, value.ipd);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Loc1 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Loc1 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.x);
+    total_length += Serialize(data_buffer, value.y);
+    total_length += Serialize(data_buffer, value.z);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Loc2 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Loc2 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.x);
+    total_length += Serialize(data_buffer, value.y);
+    total_length += Serialize(data_buffer, value.z);
+    total_length += Serialize(data_buffer, value.vx);
+    total_length += Serialize(data_buffer, value.vy);
+    total_length += Serialize(data_buffer, value.vz);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Norm1 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Norm1 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.x);
+    total_length += Serialize(data_buffer, value.y);
+    total_length += Serialize(data_buffer, value.z);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a TextureUV1 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const TextureUV1 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.u);
+    total_length += Serialize(data_buffer, value.v);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Rot1 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Rot1 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.i);
+    total_length += Serialize(data_buffer, value.j);
+    total_length += Serialize(data_buffer, value.k);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Rot2 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Rot2 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.si);
+    total_length += Serialize(data_buffer, value.sj);
+    total_length += Serialize(data_buffer, value.sk);
+    total_length += Serialize(data_buffer, value.ei);
+    total_length += Serialize(data_buffer, value.ej);
+    total_length += Serialize(data_buffer, value.ek);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Transform1 structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Transform1 &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.tx);
+    total_length += Serialize(data_buffer, value.ty);
+    total_length += Serialize(data_buffer, value.tz);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Thumb structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Thumb &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.tip);
+    total_length += Serialize(data_buffer, value.ip);
+    total_length += Serialize(data_buffer, value.mcp);
+    total_length += Serialize(data_buffer, value.cmc);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a Finger structure to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                                      const Finger &value)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, value.tip);
+    total_length += Serialize(data_buffer, value.dip);
+    total_length += Serialize(data_buffer, value.pip);
+    total_length += Serialize(data_buffer, value.mcp);
+    total_length += Serialize(data_buffer, value.cmc);
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeDeltas
+ *
+ *  Description:
+ *      This function will serialize a vector of indices to the end of the
+ *      specified data buffer, with each index coded as a VarInt holding the
+ *      difference between it and the index preceding it.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      values [in]
+ *          The vector of indices to write to the data buffer.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      The first index is coded relative to zero.  Differences are computed
+ *      using modular 64-bit arithmetic so that any index value round-trips.
+ */
+std::size_t Encoder::SerializeDeltas(DataBuffer &data_buffer,
+                                     const std::vector<VarUint> &values)
+{
+    std::size_t total_length{};
+    std::uint64_t previous{};
+
+    // Write out the number of vector elements that will follow
+    total_length = Serialize(data_buffer, VarUint{values.size()});
+
+    // Write each index as the difference from the previous index
+    for (auto &item : values)
+    {
+        total_length += Serialize(
+            data_buffer,
+            VarInt{static_cast<std::int64_t>(item.value - previous)});
+        previous = item.value;
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeQuantized
+ *
+ *  Description:
+ *      This function will serialize a vector of vertices to the end of the
+ *      specified data buffer, with each component quantized to the given
+ *      number of bits relative to the given bounding box.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      values [in]
+ *          The vector of vertices to write to the data buffer.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      min [in]
+ *          The minimum corner of the bounding box enclosing all vertices.
+ *
+ *      max [in]
+ *          The maximum corner of the bounding box enclosing all vertices.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      The vertex count is followed by the number of bits, the bounding box
+ *      as two Loc1 values, and then the x, y, z components of each vertex.
+ *      Each component occupies one octet if bits is 8 or fewer or two octets
+ *      otherwise.
+ */
+std::size_t Encoder::SerializeQuantized(DataBuffer &data_buffer,
+                                        const std::vector<Loc1> &values,
+                                        std::uint8_t bits,
+                                        const Loc1 &min,
+                                        const Loc1 &max)
+{
+    std::size_t total_length{};
+    const std::size_t width = (bits > 8) ? 2 : 1;
+
+    // Write out the number of vertices and the quantization parameters
+    total_length = Serialize(data_buffer, VarUint{values.size()});
+    total_length += Serialize(data_buffer, bits);
+    total_length += Serialize(data_buffer, min);
+    total_length += Serialize(data_buffer, max);
+
+    // If only computing the length, there is no need to quantize
+    if (!data_buffer.GetBufferSize())
+    {
+        return total_length + values.size() * 3 * width;
+    }
+
+    // Write each quantized vertex component
+    for (auto &vertex : values)
+    {
+        const std::uint16_t q[3] =
+        {
+            QuantizeComponent(vertex.x, min.x, max.x, bits),
+            QuantizeComponent(vertex.y, min.y, max.y, bits),
+            QuantizeComponent(vertex.z, min.z, max.z, bits)
+        };
+
+        for (auto component : q)
+        {
+            if (width == 2)
+            {
+                total_length += Serialize(data_buffer, component);
+            }
+            else
+            {
+                total_length += Serialize(data_buffer,
+                                          static_cast<std::uint8_t>(component));
+            }
+        }
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializePredicted
+ *
+ *  Description:
+ *      This function will serialize the parallelogram prediction residuals
+ *      of a vector of quantized vertices to the end of the specified data
+ *      buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      values [in]
+ *          The residuals, three per vertex, as produced by
+ *          PredictPositions().
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      min [in]
+ *          The minimum corner of the bounding box enclosing all vertices.
+ *
+ *      max [in]
+ *          The maximum corner of the bounding box enclosing all vertices.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      The vertex count is followed by the number of bits, the bounding box
+ *      as two Loc1 values, and then each residual as a VarInt.
+ */
+std::size_t Encoder::SerializePredicted(DataBuffer &data_buffer,
+                                        const std::vector<std::int32_t> &values,
+                                        std::uint8_t bits,
+                                        const Loc1 &min,
+                                        const Loc1 &max)
+{
+    std::size_t total_length{};
+
+    // Write out the number of vertices and the quantization parameters
+    total_length = Serialize(data_buffer, VarUint{values.size() / 3});
+    total_length += Serialize(data_buffer, bits);
+    total_length += Serialize(data_buffer, min);
+    total_length += Serialize(data_buffer, max);
+
+    for (const auto residual : values)
+    {
+        total_length += Serialize(data_buffer, VarInt{residual});
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeOctahedral
+ *
+ *  Description:
+ *      This function will serialize a vector of normals to the end of the
+ *      specified data buffer, with each normal mapped to a pair of quantized
+ *      octahedral coordinates.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      values [in]
+ *          The vector of normals to write to the data buffer.
+ *
+ *      bits [in]
+ *          The number of bits per octahedral coordinate (1 to 16).
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      The normal count is followed by the number of bits and then the
+ *      coordinates of each normal.  Each coordinate occupies one octet if
+ *      bits is 8 or fewer or two octets otherwise.  The coordinates are
+ *      encoded directly into the data buffer.
+ */
+std::size_t Encoder::SerializeOctahedral(DataBuffer &data_buffer,
+                                         const std::vector<Norm1> &values,
+                                         std::uint8_t bits)
+{
+    std::size_t total_length{};
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    const std::size_t octets = values.size() * 2 * width;
+
+    // Write out the number of normals and the quantization parameter
+    total_length = Serialize(data_buffer, VarUint{values.size()});
+    total_length += Serialize(data_buffer, bits);
+
+    // If only computing the length or there are no normals, return
+    if (!data_buffer.GetBufferSize() || values.empty())
+    {
+        return total_length + octets;
+    }
+
+    // Ensure the data buffer has sufficient space
+    const std::size_t offset = data_buffer.GetDataLength();
+    if ((offset + octets) > data_buffer.GetBufferSize())
+    {
+        throw EncoderException("Insufficient space to encode normals");
+    }
+
+    // Encode the normals directly into the data buffer
+    EncodeOctahedral(values.data(),
+                     values.size(),
+                     bits,
+                     data_buffer.GetMutableBufferPointer(offset));
+    data_buffer.SetDataLength(offset + octets);
+
+    return total_length + octets;
+}
+
+/*
+ *  Encoder::GetObjectFlags
+ *
+ *  Description:
+ *      This function will validate the given compact object encoding options
+ *      and return the flags indicating which encodings are used.
+ *
+ *  Parameters:
+ *      encoding [in]
+ *          The options that control how an object is to be encoded.
+ *
+ *  Returns:
+ *      The flags value to serialize within the compact object.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the options are not valid.
+ */
+VarUint Encoder::GetObjectFlags(const ObjectEncoding &encoding)
+{
+    VarUint flags{};
+
+    // Ensure the rotation bit budget is valid
+    if (encoding.rotation_bits &&
+        ((encoding.rotation_bits < Min_Rotation_Bits) ||
+         (encoding.rotation_bits > Max_Rotation_Bits)))
+    {
+        throw EncoderException("Invalid rotation compression bits");
+    }
+
+    // Velocities are omitted using the field presence mask
+    if (encoding.omit_velocity && !encoding.omit_defaults)
+    {
+        throw EncoderException("Omitting velocities requires a field "
+                               "presence mask");
+    }
+
+    // Indicate which encodings are used
+    if (encoding.rotation_bits)
+    {
+        flags.value |= CompactObject_Compressed_Rotation;
+    }
+    if (encoding.omit_defaults) flags.value |= CompactObject_Field_Presence;
+
+    return flags;
+}
+
+/*
+ *  Encoder::GetHandFlags
+ *
+ *  Description:
+ *      This function will validate the given compact object encoding options,
+ *      including those applying only to Hand2 joints, and return the flags
+ *      indicating which encodings are used.
+ *
+ *  Parameters:
+ *      encoding [in]
+ *          The options that control how an object is to be encoded.
+ *
+ *  Returns:
+ *      The flags value to serialize within the compact object.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the options are not valid.
+ */
+VarUint Encoder::GetHandFlags(const ObjectEncoding &encoding)
+{
+    VarUint flags = GetObjectFlags(encoding);
+
+    // Ensure the joint quantization parameters are valid
+    if (encoding.joint_bits)
+    {
+        if (encoding.joint_bits > 16)
+        {
+            throw EncoderException("Invalid joint quantization bits");
+        }
+
+        // The range is sent as a Float16, so check the value as sent
+        const float joint_range =
+            HalfFloatToFloat(FloatToHalfFloat(encoding.joint_range));
+        if (!(joint_range > 0.0f) || !std::isfinite(joint_range))
+        {
+            throw EncoderException("Invalid joint quantization range");
+        }
+
+        flags.value |= CompactObject_Quantized_Joints;
+    }
+
+    return flags;
+}
+
+/*
+ *  Encoder::SerializeObjectFlags
+ *
+ *  Description:
+ *      This function will serialize the flags found in compact objects,
+ *      along with any encoding parameters and the field presence mask that
+ *      follow the flags.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      presence [in]
+ *          The field presence mask, which is serialized only if the flags
+ *          indicate that default values are omitted.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Encoder::SerializeObjectFlags(DataBuffer &data_buffer,
+                                          const VarUint &flags,
+                                          const ObjectEncoding &encoding,
+                                          const VarUint &presence)
+{
+    std::size_t total_length{};
+
+    total_length = Serialize(data_buffer, flags);
+
+    if (flags.value & CompactObject_Compressed_Rotation)
+    {
+        total_length += Serialize(data_buffer, encoding.rotation_bits);
+    }
+
+    if (flags.value & CompactObject_Field_Presence)
+    {
+        total_length += Serialize(data_buffer, presence);
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeLocation
+ *
+ *  Description:
+ *      This function will serialize the position and velocity portions of a
+ *      Loc2 structure if indicated as present.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to serialize to the end of the DataBuffer.
+ *
+ *      presence [in]
+ *          The field presence mask of the object holding the value.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      If both portions are present, the serialized form is identical to
+ *      that of a Loc2.
+ */
+std::size_t Encoder::SerializeLocation(DataBuffer &data_buffer,
+                                       const Loc2 &value,
+                                       const VarUint &presence)
+{
+    std::size_t total_length{};
+
+    if (presence.value & CompactPresence_Position)
+    {
+        total_length += Serialize(data_buffer, value.x);
+        total_length += Serialize(data_buffer, value.y);
+        total_length += Serialize(data_buffer, value.z);
+    }
+
+    if (presence.value & CompactPresence_Velocity)
+    {
+        total_length += Serialize(data_buffer, value.vx);
+        total_length += Serialize(data_buffer, value.vy);
+        total_length += Serialize(data_buffer, value.vz);
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::GetPresence
+ *
+ *  Description:
+ *      These functions will return the field presence mask for a compact
+ *      object, which has a bit set for each field holding a value other than
+ *      the default value and, for Boolean fields, holds the field's value.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object to be serialized.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded (head
+ *          and hand objects only).
+ *
+ *  Returns:
+ *      The field presence mask.  If default values are not to be omitted,
+ *      all bits are set.
+ *
+ *  Comments:
+ *      The default values are zero for positions, velocities, and
+ *      rotations, one for scale factors, and false for Boolean fields.
+ *      Velocities are treated as holding the default value if the encoding
+ *      omits them.
+ */
+VarUint Encoder::GetPresence(const Object1 &value, const VarUint &flags)
+{
+    VarUint presence{};
+
+    if (!(flags.value & CompactObject_Field_Presence)) return {~Uint64{}};
+
+    if ((value.position.x != 0.0f) || (value.position.y != 0.0f) ||
+        (value.position.z != 0.0f))
+    {
+        presence.value |= CompactPresence_Position;
+    }
+    if ((value.rotation.i.value != 0.0f) || (value.rotation.j.value != 0.0f) ||
+        (value.rotation.k.value != 0.0f))
+    {
+        presence.value |= CompactPresence_Rotation;
+    }
+    if ((value.scale.x != 1.0f) || (value.scale.y != 1.0f) ||
+        (value.scale.z != 1.0f))
+    {
+        presence.value |= CompactPresence_Scale;
+    }
+    if (value.parent.has_value()) presence.value |= CompactPresence_Parent;
+    if (value.active) presence.value |= CompactPresence_Active;
+
+    return presence;
+}
+
+VarUint Encoder::GetPresence(const Head1 &value,
+                             const VarUint &flags,
+                             const ObjectEncoding &encoding)
+{
+    VarUint presence{};
+
+    if (!(flags.value & CompactObject_Field_Presence)) return {~Uint64{}};
+
+    presence.value = GetPresence(value.location, encoding) |
+                     GetPresence(value.rotation);
+    if (value.ipd.has_value()) presence.value |= CompactPresence_IPD;
+
+    return presence;
+}
+
+VarUint Encoder::GetPresence(const Hand1 &value,
+                             const VarUint &flags,
+                             const ObjectEncoding &encoding)
+{
+    VarUint presence{};
+
+    if (!(flags.value & CompactObject_Field_Presence)) return {~Uint64{}};
+
+    presence.value = GetPresence(value.location, encoding) |
+                     GetPresence(value.rotation);
+    if (value.left) presence.value |= CompactPresence_Left;
+
+    return presence;
+}
+
+VarUint Encoder::GetPresence(const Hand2 &value,
+                             const VarUint &flags,
+                             const ObjectEncoding &encoding)
+{
+    VarUint presence{};
+
+    if (!(flags.value & CompactObject_Field_Presence)) return {~Uint64{}};
+
+    presence.value = GetPresence(value.location, encoding) |
+                     GetPresence(value.rotation);
+    if (value.left) presence.value |= CompactPresence_Left;
+
+    return presence;
+}
+
+/*
+ *  Encoder::GetPresence
+ *
+ *  Description:
+ *      These functions will return the field presence bits for the Loc2 and
+ *      Rot2 fields common to the head and hand objects.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The field to be serialized.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded (Loc2
+ *          only).
+ *
+ *  Returns:
+ *      The field presence bits for the given field.
+ *
+ *  Comments:
+ *      Velocities are never present if they are to be omitted.
+ */
+std::uint64_t Encoder::GetPresence(const Loc2 &value,
+                                   const ObjectEncoding &encoding)
+{
+    std::uint64_t presence{};
+
+    if ((value.x != 0.0f) || (value.y != 0.0f) || (value.z != 0.0f))
+    {
+        presence |= CompactPresence_Position;
+    }
+    if (!encoding.omit_velocity &&
+        ((value.vx.value != 0.0f) || (value.vy.value != 0.0f) ||
+         (value.vz.value != 0.0f)))
+    {
+        presence |= CompactPresence_Velocity;
+    }
+
+    return presence;
+}
+
+std::uint64_t Encoder::GetPresence(const Rot2 &value)
+{
+    if ((value.si.value != 0.0f) || (value.sj.value != 0.0f) ||
+        (value.sk.value != 0.0f) || (value.ei.value != 0.0f) ||
+        (value.ej.value != 0.0f) || (value.ek.value != 0.0f))
+    {
+        return CompactPresence_Rotation;
+    }
+
+    return 0;
+}
+
+/*
+ *  Encoder::SerializeCompact
+ *
+ *  Description:
+ *      This function will serialize the contents of a CompactObject1 object
+ *      (i.e., all but the tag and length) to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      When a presence mask is used, the active field is conveyed in the
+ *      mask rather than serialized as a Boolean.
+ */
+std::size_t Encoder::SerializeCompact(DataBuffer &data_buffer,
+                                      const Object1 &value,
+                                      const ObjectEncoding &encoding,
+                                      const VarUint &flags)
+{
+    std::size_t total_length{};
+    const VarUint presence = GetPresence(value, flags);
+
+    total_length = Serialize(data_buffer, value.id);
+    total_length += SerializeObjectFlags(data_buffer,
+                                         flags,
+                                         encoding,
+                                         presence);
+    total_length += Serialize(data_buffer, value.time);
+
+    if (presence.value & CompactPresence_Position)
+    {
+        total_length += Serialize(data_buffer, value.position);
+    }
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        total_length += SerializeRotation(data_buffer,
+                                          value.rotation,
+                                          encoding.rotation_bits);
+    }
+
+    if (presence.value & CompactPresence_Scale)
+    {
+        total_length += Serialize(data_buffer, value.scale);
+    }
+
+    if (!(flags.value & CompactObject_Field_Presence))
+    {
+        total_length += Serialize(data_buffer, value.active);
+    }
+
+    if (value.parent.has_value())
+    {
+        total_length += Serialize(data_buffer, value.parent.value());
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeCompact
+ *
+ *  Description:
+ *      This function will serialize the contents of a CompactHead1 object
+ *      (i.e., all but the tag and length) to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t Encoder::SerializeCompact(DataBuffer &data_buffer,
+                                      const Head1 &value,
+                                      const ObjectEncoding &encoding,
+                                      const VarUint &flags)
+{
+    std::size_t total_length{};
+    const VarUint presence = GetPresence(value, flags, encoding);
+
+    total_length = Serialize(data_buffer, value.id);
+    total_length += SerializeObjectFlags(data_buffer,
+                                         flags,
+                                         encoding,
+                                         presence);
+    total_length += Serialize(data_buffer, value.time);
+    total_length += SerializeFields(data_buffer, value, encoding, presence);
+
+    if (value.ipd.has_value())
+    {
+        total_length += Serialize(data_buffer, value.ipd.value());
+    }
+
+    return total_length;
+}
+
+/*
+ *  Encoder::SerializeCompact
+ *
+ *  Description:
+ *      This function will serialize the contents of a CompactHand1 object
+ *      (i.e., all but the tag and length) to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      When a presence mask is used, the left field is conveyed in the mask
+ *      rather than serialized as a Boolean.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Loc1 &value)
+std::size_t Encoder::SerializeCompact(DataBuffer &data_buffer,
+                                      const Hand1 &value,
+                                      const ObjectEncoding &encoding,
+                                      const VarUint &flags)
 {
     std::size_t total_length{};
+    const VarUint presence = GetPresence(value, flags, encoding);
 
-    total_length = Serialize(data_buffer, value.x);
-    total_length += Serialize(data_buffer, value.y);
-    total_length += Serialize(data_buffer, value.z);
+    total_length = Serialize(data_buffer, value.id);
+    total_length += SerializeObjectFlags(data_buffer,
+                                         flags,
+                                         encoding,
+                                         presence);
+    total_length += Serialize(data_buffer, value.time);
+
+    if (!(flags.value & CompactObject_Field_Presence))
+    {
+        total_length += Serialize(data_buffer, value.left);
+    }
+
+    total_length += SerializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        total_length += SerializeRotation(data_buffer,
+                                          value.rotation,
+                                          encoding.rotation_bits);
+    }
 
     return total_length;
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeCompact
  *
  *  Description:
- *      This function will serialize a Loc2 structure to the data buffer.
+ *      This function will serialize the contents of a CompactHand2 object
+ *      (i.e., all but the tag and length) to the data buffer.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer into which the value shall be written.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
  *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      When a presence mask is used, the left field is conveyed in the mask
+ *      rather than serialized as a Boolean.  The wrist and finger joints are
+ *      always present.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Loc2 &value)
+std::size_t Encoder::SerializeCompact(DataBuffer &data_buffer,
+                                      const Hand2 &value,
+                                      const ObjectEncoding &encoding,
+                                      const VarUint &flags)
 {
     std::size_t total_length{};
+    const VarUint presence = GetPresence(value, flags, encoding);
 
-    total_length = Serialize(data_buffer, value.x);
-    total_length += Serialize(data_buffer, value.y);
-    total_length += Serialize(data_buffer, value.z);
-    total_length += Serialize(data_buffer, value.vx);
-    total_length += Serialize(data_buffer, value.vy);
-    total_length += Serialize(data_buffer, value.vz);
+    total_length = Serialize(data_buffer, value.id);
+    total_length += SerializeObjectFlags(data_buffer,
+                                         flags,
+                                         encoding,
+                                         presence);
+    total_length += Serialize(data_buffer, value.time);
+
+    if (!(flags.value & CompactObject_Field_Presence))
+    {
+        total_length += Serialize(data_buffer, value.left);
+    }
+
+    total_length += SerializeFields(data_buffer,
+                                    value,
+                                    encoding,
+                                    flags,
+                                    presence);
 
     return total_length;
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeFrame
  *
  *  Description:
- *      This function will serialize a Norm1 structure to the data buffer.
+ *      This function will serialize the contents of a PlayerFrame1 object
+ *      (i.e., all but the tag and length) to the data buffer.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer into which the value shall be written.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used, which must
+ *          indicate the use of field presence masks.
  *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      The head is serialized exactly as the body of a CompactHead1.  Each
+ *      hand follows as its object ID difference, presence mask, and the
+ *      fields of a CompactHand2 that follow the time value.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Norm1 &value)
+std::size_t Encoder::SerializeFrame(DataBuffer &data_buffer,
+                                    const PlayerFrame1 &value,
+                                    const ObjectEncoding &encoding,
+                                    const VarUint &flags)
 {
     std::size_t total_length{};
 
-    total_length = Serialize(data_buffer, value.x);
-    total_length += Serialize(data_buffer, value.y);
-    total_length += Serialize(data_buffer, value.z);
+    total_length = SerializeCompact(data_buffer, value.head, encoding, flags);
+
+    for (const Hand2 *hand : {&value.left, &value.right})
+    {
+        // Object IDs are unsigned, so the difference wraps as needed
+        const VarInt id_delta{
+            static_cast<std::int64_t>(hand->id.value - value.head.id.value)};
+        const VarUint presence = GetPresence(*hand, flags, encoding);
+
+        total_length += Serialize(data_buffer, id_delta);
+        total_length += Serialize(data_buffer, presence);
+        total_length += SerializeFields(data_buffer,
+                                        *hand,
+                                        encoding,
+                                        flags,
+                                        presence);
+    }
 
     return total_length;
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeFields
  *
  *  Description:
- *      This function will serialize a TextureUV1 structure to the data buffer.
+ *      These functions will serialize the location, rotation, and, for a
+ *      Hand2, joint fields shared by the compact head and hand objects and
+ *      the PlayerFrame1 object.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer into which the value shall be written.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object holding the fields to serialize.
+ *
+ *      encoding [in]
+ *          The options that control how the object is to be encoded.
+ *
+ *      flags [in]
+ *          The flags indicating which encodings are used.
+ *
+ *      presence [in]
+ *          The field presence mask of the object.
  *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      The wrist and finger joints are always present.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const TextureUV1 &value)
+std::size_t Encoder::SerializeFields(DataBuffer &data_buffer,
+                                     const Head1 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &presence)
 {
     std::size_t total_length{};
 
-    total_length = Serialize(data_buffer, value.u);
-    total_length += Serialize(data_buffer, value.v);
+    total_length = SerializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        total_length += SerializeRotation(data_buffer,
+                                          value.rotation,
+                                          encoding.rotation_bits);
+    }
+
+    return total_length;
+}
+
+std::size_t Encoder::SerializeFields(DataBuffer &data_buffer,
+                                     const Hand2 &value,
+                                     const ObjectEncoding &encoding,
+                                     const VarUint &flags,
+                                     const VarUint &presence)
+{
+    std::size_t total_length{};
+
+    total_length = SerializeLocation(data_buffer, value.location, presence);
+
+    if (presence.value & CompactPresence_Rotation)
+    {
+        total_length += SerializeRotation(data_buffer,
+                                          value.rotation,
+                                          encoding.rotation_bits);
+    }
+
+    if (flags.value & CompactObject_Quantized_Joints)
+    {
+        total_length += SerializeJoints(
+            data_buffer,
+            value,
+            encoding.joint_bits,
+            HalfFloatToFloat(FloatToHalfFloat(encoding.joint_range)));
+    }
+    else
+    {
+        total_length += Serialize(data_buffer, value.wrist);
+        total_length += Serialize(data_buffer, value.thumb);
+        total_length += Serialize(data_buffer, value.index);
+        total_length += Serialize(data_buffer, value.middle);
+        total_length += Serialize(data_buffer, value.ring);
+        total_length += Serialize(data_buffer, value.pinky);
+    }
 
     return total_length;
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeRotation
  *
  *  Description:
- *      This function will serialize a Rot1 structure to the data buffer.
+ *      This function will serialize a Rot1 structure to the data buffer,
+ *      compressing it if a number of bits is given.
  *
  *  Parameters:
  *      data_buffer [in]
@@ -879,6 +2829,10 @@ inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
  *      value [in]
  *          The data to serialize to the end of the DataBuffer.
  *
+ *      bits [in]
+ *          The number of bits per smallest-three component or zero to
+ *          serialize the rotation as Float16 values.
+ *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
@@ -886,23 +2840,21 @@ inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
  *  Comments:
  *      None.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Rot1 &value)
+std::size_t Encoder::SerializeRotation(DataBuffer &data_buffer,
+                                       const Rot1 &value,
+                                       std::uint8_t bits)
 {
-    std::size_t total_length{};
-
-    total_length = Serialize(data_buffer, value.i);
-    total_length += Serialize(data_buffer, value.j);
-    total_length += Serialize(data_buffer, value.k);
+    if (!bits) return Serialize(data_buffer, value);
 
-    return total_length;
+    return SerializeCompressed(data_buffer, &value, 1, bits);
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeRotation
  *
  *  Description:
- *      This function will serialize a Rot2 structure to the data buffer.
+ *      This function will serialize a Rot2 structure to the data buffer,
+ *      compressing it if a number of bits is given.
  *
  *  Parameters:
  *      data_buffer [in]
@@ -911,125 +2863,263 @@ inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
  *      value [in]
  *          The data to serialize to the end of the DataBuffer.
  *
+ *      bits [in]
+ *          The number of bits per smallest-three component or zero to
+ *          serialize the rotation as Float16 values.
+ *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      The two quaternions held by the Rot2 are compressed independently.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Rot2 &value)
+std::size_t Encoder::SerializeRotation(DataBuffer &data_buffer,
+                                       const Rot2 &value,
+                                       std::uint8_t bits)
 {
-    std::size_t total_length{};
+    if (!bits) return Serialize(data_buffer, value);
 
-    total_length = Serialize(data_buffer, value.si);
-    total_length += Serialize(data_buffer, value.sj);
-    total_length += Serialize(data_buffer, value.sk);
-    total_length += Serialize(data_buffer, value.ei);
-    total_length += Serialize(data_buffer, value.ej);
-    total_length += Serialize(data_buffer, value.ek);
+    const Rot1 rotations[2] =
+    {
+        {value.si, value.sj, value.sk},
+        {value.ei, value.ej, value.ek}
+    };
 
-    return total_length;
+    return SerializeCompressed(data_buffer, rotations, 2, bits);
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeCompressed
  *
  *  Description:
- *      This function will serialize a Transform1 structure to the data buffer.
+ *      This function will serialize an array of rotations to the end of the
+ *      specified data buffer using the smallest-three representation.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer into which the value shall be written.
  *
- *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *      values [in]
+ *          The array of rotations to write to the data buffer.
+ *
+ *      count [in]
+ *          The number of rotations in the array.
+ *
+ *      bits [in]
+ *          The number of bits per smallest-three component.
  *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      Each compressed rotation is written in network byte order using the
+ *      fewest whole octets that hold 2 + 3 * bits bits.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Transform1 &value)
+std::size_t Encoder::SerializeCompressed(DataBuffer &data_buffer,
+                                         const Rot1 *values,
+                                         std::size_t count,
+                                         std::uint8_t bits)
 {
     std::size_t total_length{};
+    std::uint64_t packed[2];
+    const std::size_t octets = CompressedRotationLength(bits);
 
-    total_length = Serialize(data_buffer, value.tx);
-    total_length += Serialize(data_buffer, value.ty);
-    total_length += Serialize(data_buffer, value.tz);
+    // If only computing the length, there is no need to compress
+    if (!data_buffer.GetBufferSize()) return count * octets;
+
+    // Compress the rotations in batches
+    for (std::size_t i = 0; i < count; i += 2)
+    {
+        const std::size_t batch = std::min<std::size_t>(count - i, 2);
+
+        CompressRotations(values + i, batch, bits, packed);
+
+        for (std::size_t n = 0; n < batch; n++)
+        {
+            for (std::size_t octet = octets; octet-- > 0;)
+            {
+                total_length += Serialize(
+                    data_buffer,
+                    static_cast<std::uint8_t>(packed[n] >> (octet * 8)));
+            }
+        }
+    }
 
     return total_length;
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeJoints
  *
  *  Description:
- *      This function will serialize a Thumb structure to the data buffer.
+ *      This function will serialize the wrist and finger joints of a Hand2
+ *      object to the end of the specified data buffer, with each component
+ *      quantized and packed using the given number of bits.
  *
  *  Parameters:
  *      data_buffer [in]
  *          The data buffer into which the value shall be written.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The object whose joints are to be written to the data buffer.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      range [in]
+ *          Components are quantized over the range [-range, range].  This
+ *          must be exactly representable as a Float16.
  *
  *  Returns:
  *      The number of octets appended to the data buffer or would have been
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      The number of bits and the range (as a Float16) are followed by the
+ *      packed components of the wrist, thumb, index, middle, ring, and pinky
+ *      joints in the same order as the Hand2 encoding, padded to an octet
+ *      boundary.  Components outside of the range are clamped.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Thumb &value)
+std::size_t Encoder::SerializeJoints(DataBuffer &data_buffer,
+                                     const Hand2 &value,
+                                     std::uint8_t bits,
+                                     float range)
 {
     std::size_t total_length{};
 
-    total_length = Serialize(data_buffer, value.tip);
-    total_length += Serialize(data_buffer, value.ip);
-    total_length += Serialize(data_buffer, value.mcp);
-    total_length += Serialize(data_buffer, value.cmc);
+    // Write out the quantization parameters
+    total_length = Serialize(data_buffer, bits);
+    total_length += Serialize(data_buffer, Float16{range});
 
-    return total_length;
+    // If only computing the length, there is no need to quantize
+    if (!data_buffer.GetBufferSize())
+    {
+        return total_length + (Hand2_Joint_Components * bits + 7) / 8;
+    }
+
+    // Pack each of the quantized joint components
+    BitWriter writer(data_buffer);
+    SerializeJoint(writer, value.wrist, bits, range);
+    SerializeJoint(writer, value.thumb, bits, range);
+    SerializeJoint(writer, value.index, bits, range);
+    SerializeJoint(writer, value.middle, bits, range);
+    SerializeJoint(writer, value.ring, bits, range);
+    SerializeJoint(writer, value.pinky, bits, range);
+
+    return total_length + writer.Flush();
 }
 
 /*
- *  Encoder::Serialize
+ *  Encoder::SerializeJoint
  *
  *  Description:
- *      This function will serialize a Finger structure to the data buffer.
+ *      This function will quantize and pack the components of a Transform1
+ *      structure using the given bit writer.
  *
  *  Parameters:
- *      data_buffer [in]
- *          The data buffer into which the value shall be written.
+ *      writer [in]
+ *          The bit writer into which the value shall be written.
  *
  *      value [in]
- *          The data to serialize to the end of the DataBuffer.
+ *          The data to write.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      range [in]
+ *          Components are quantized over the range [-range, range].
  *
  *  Returns:
- *      The number of octets appended to the data buffer or would have been
- *      appended if the data_buffer contains a zero-sized buffer.
+ *      Nothing.
  *
  *  Comments:
  *      None.
  */
-inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
-                                      const Finger &value)
+void Encoder::SerializeJoint(BitWriter &writer,
+                             const Transform1 &value,
+                             std::uint8_t bits,
+                             float range)
 {
-    std::size_t total_length{};
+    writer.Write(QuantizeComponent(value.tx.value, -range, range, bits), bits);
+    writer.Write(QuantizeComponent(value.ty.value, -range, range, bits), bits);
+    writer.Write(QuantizeComponent(value.tz.value, -range, range, bits), bits);
+}
 
-    total_length = Serialize(data_buffer, value.tip);
-    total_length += Serialize(data_buffer, value.dip);
-    total_length += Serialize(data_buffer, value.pip);
-    total_length += Serialize(data_buffer, value.mcp);
-    total_length += Serialize(data_buffer, value.cmc);
+/*
+ *  Encoder::SerializeJoint
+ *
+ *  Description:
+ *      This function will quantize and pack the joints of a Thumb structure
+ *      using the given bit writer.
+ *
+ *  Parameters:
+ *      writer [in]
+ *          The bit writer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to write.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      range [in]
+ *          Components are quantized over the range [-range, range].
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Encoder::SerializeJoint(BitWriter &writer,
+                             const Thumb &value,
+                             std::uint8_t bits,
+                             float range)
+{
+    SerializeJoint(writer, value.tip, bits, range);
+    SerializeJoint(writer, value.ip, bits, range);
+    SerializeJoint(writer, value.mcp, bits, range);
+    SerializeJoint(writer, value.cmc, bits, range);
+}
 
-    return total_length;
+/*
+ *  Encoder::SerializeJoint
+ *
+ *  Description:
+ *      This function will quantize and pack the joints of a Finger structure
+ *      using the given bit writer.
+ *
+ *  Parameters:
+ *      writer [in]
+ *          The bit writer into which the value shall be written.
+ *
+ *      value [in]
+ *          The data to write.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component (1 to 16).
+ *
+ *      range [in]
+ *          Components are quantized over the range [-range, range].
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void Encoder::SerializeJoint(BitWriter &writer,
+                             const Finger &value,
+                             std::uint8_t bits,
+                             float range)
+{
+    SerializeJoint(writer, value.tip, bits, range);
+    SerializeJoint(writer, value.dip, bits, range);
+    SerializeJoint(writer, value.pip, bits, range);
+    SerializeJoint(writer, value.mcp, bits, range);
+    SerializeJoint(writer, value.cmc, bits, range);
 }
 
 /*
@@ -1051,7 +3141,8 @@ inline std::size_t Encoder::Serialize(DataBuffer &data_buffer,
  *      appended if the data_buffer contains a zero-sized buffer.
  *
  *  Comments:
- *      None.
+ *      Vectors large enough to benefit are serialized using multiple threads
+ *      if permitted by SetMaxThreads().
  */
 template<typename T>
 std::size_t Encoder::Serialize(DataBuffer &data_buffer,
@@ -1066,10 +3157,154 @@ std::size_t Encoder::Serialize(DataBuffer &data_buffer,
     // If the string is empty, just return
     if (value.empty()) return total_length;
 
+    // Divide large vectors among multiple threads
+    const std::size_t chunks = GetChunkCount(value.size(), max_threads);
+    if (chunks > 1)
+    {
+        return total_length + SerializeParallel(data_buffer, value, chunks);
+    }
+
     // Write each member of the vector in turn
     for (auto &item : value) total_length += Serialize(data_buffer, item);
 
     return total_length;
 }
 
+/*
+ *  Encoder::SerializeParallel
+ *
+ *  Description:
+ *      This function will serialize the elements of a vector to the end of
+ *      the specified data buffer, dividing the work among multiple threads.
+ *      The length of each chunk of elements is determined first, from which
+ *      the offset of each chunk in the buffer follows, and then each chunk is
+ *      written directly into its place in the buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      values [in]
+ *          The vector of values to write to the data buffer.
+ *
+ *      chunks [in]
+ *          The number of chunks into which to divide the elements.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      The number of elements is not written.  Elements having a fixed length
+ *      need not be examined to determine chunk lengths.  The serializer is
+ *      stateless, so threads may share it.
+ */
+template<typename T>
+std::size_t Encoder::SerializeParallel(DataBuffer &data_buffer,
+                                       const std::vector<T> &values,
+                                       std::size_t chunks)
+{
+    std::vector<std::size_t> offsets(chunks + 1);
+
+    // Determine the offset of each chunk relative to the first
+    if constexpr (FixedLength<T>::value != 0)
+    {
+        for (std::size_t chunk = 0; chunk <= chunks; chunk++)
+        {
+            offsets[chunk] = GetChunkBegin(values.size(), chunks, chunk) *
+                             FixedLength<T>::value;
+        }
+    }
+    else
+    {
+        ParallelFor(values.size(),
+                    chunks,
+                    [&](std::size_t chunk, std::size_t begin, std::size_t end)
+                    {
+                        std::size_t length{};
+                        for (std::size_t i = begin; i < end; i++)
+                        {
+                            length += Serialize(null_buffer, values[i]);
+                        }
+                        offsets[chunk + 1] = length;
+                    });
+        for (std::size_t chunk = 1; chunk <= chunks; chunk++)
+        {
+            offsets[chunk] += offsets[chunk - 1];
+        }
+    }
+
+    // If only determining the length or the data will not fit, return
+    const std::size_t start = data_buffer.GetDataLength();
+    if (!data_buffer.GetBufferSize()) return offsets[chunks];
+    if (offsets[chunks] > (data_buffer.GetBufferSize() - start))
+    {
+        throw DataBufferException("Data buffer too short for vector");
+    }
+
+    // Write each chunk directly into its place in the buffer
+    ParallelFor(values.size(),
+                chunks,
+                [&](std::size_t chunk, std::size_t begin, std::size_t end)
+                {
+                    DataBuffer chunk_buffer(
+                        data_buffer.GetMutableBufferPointer(start +
+                                                            offsets[chunk]),
+                        offsets[chunk + 1] - offsets[chunk],
+                        0);
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        Serialize(chunk_buffer, values[i]);
+                    }
+                });
+    data_buffer.SetDataLength(start + offsets[chunks]);
+
+    return offsets[chunks];
+}
+
+/*
+ *  Encoder::Serialize
+ *
+ *  Description:
+ *      This function will serialize a sequence of elements obtained from a
+ *      producer function to the end of the specified data buffer, using the
+ *      same representation as a vector of those elements.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the value shall be written.
+ *
+ *      count [in]
+ *          The number of elements in the sequence.
+ *
+ *      producer [in]
+ *          The function returning the element having the given index.
+ *
+ *  Returns:
+ *      The number of octets appended to the data buffer or would have been
+ *      appended if the data_buffer contains a zero-sized buffer.
+ *
+ *  Comments:
+ *      None.
+ */
+template<typename T>
+std::size_t Encoder::Serialize(DataBuffer &data_buffer,
+                               std::size_t count,
+                               const std::function<T(std::size_t)> &producer)
+{
+    std::size_t total_length{};
+
+    // Write out the number of elements that will follow
+    VarUint size{count};
+    total_length = Serialize(data_buffer, size);
+
+    // Write each element in turn
+    for (std::size_t i = 0; i < count; i++)
+    {
+        total_length += Serialize(data_buffer, producer(i));
+    }
+
+    return total_length;
+}
+
 } // namespace gs
@@ -0,0 +1,647 @@
+/*
+ *  interest_manager.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the InterestManager object, which places
+ *      objects into the cells of a uniform grid as their positions are
+ *      updated so that the objects near each recipient can be found by
+ *      examining only the cells around that recipient.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "interest_manager.h"
+#include "gs_encoder.h"
+#include "object_access.h"
+#include "parallel_coding.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// Minimum number of objects whose cells are computed by each thread
+constexpr std::size_t Update_Min_Chunk = 4096;
+
+// Minimum number of recipients queried by each thread
+constexpr std::size_t Query_Min_Chunk = 4;
+
+// Grid coordinates are held in 21 bits, so the grid spans 2^21 cells along
+// each axis, centered on the origin; positions beyond are clamped
+constexpr std::int64_t Cell_Limit = std::int64_t(1) << 20;
+
+// Cell value for an object not yet placed in the grid
+constexpr std::uint64_t No_Cell = ~std::uint64_t(0);
+
+/*
+ *  GetCoordinate
+ *
+ *  Description:
+ *      This function will return the grid coordinate of the cell containing
+ *      the given value along one axis.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The position along the axis.
+ *
+ *      cell_size [in]
+ *          The length of each cell's edge.
+ *
+ *  Returns:
+ *      The grid coordinate, clamped to the extent of the grid.
+ *
+ *  Comments:
+ *      Values that are not a number are placed in the first cell.
+ */
+std::int64_t GetCoordinate(double value, double cell_size)
+{
+    const double coordinate = std::floor(value / cell_size);
+
+    if (!(coordinate >= -Cell_Limit)) return -Cell_Limit;
+    if (coordinate >= Cell_Limit) return Cell_Limit - 1;
+
+    return static_cast<std::int64_t>(coordinate);
+}
+
+/*
+ *  PackCell
+ *
+ *  Description:
+ *      This function will combine the grid coordinates of a cell into a
+ *      single key.
+ *
+ *  Parameters:
+ *      x [in]
+ *          The grid coordinate along the x axis.
+ *
+ *      y [in]
+ *          The grid coordinate along the y axis.
+ *
+ *      z [in]
+ *          The grid coordinate along the z axis.
+ *
+ *  Returns:
+ *      The key identifying the cell.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t PackCell(std::int64_t x, std::int64_t y, std::int64_t z)
+{
+    return (static_cast<std::uint64_t>(x + Cell_Limit) << 42) |
+           (static_cast<std::uint64_t>(y + Cell_Limit) << 21) |
+           static_cast<std::uint64_t>(z + Cell_Limit);
+}
+
+} // namespace
+
+/*
+ *  InterestManager::InterestManager
+ *
+ *  Description:
+ *      Constructor for the InterestManager object.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The grid cell size and default radius of interest.  The cell size
+ *          is best set near the typical radius of interest, so that a query
+ *          examines few cells each holding few distant objects.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the cell size is not positive.
+ */
+InterestManager::InterestManager(const InterestOptions &options) :
+    options{options}
+{
+    if (!(options.cell_size > 0.0f))
+    {
+        throw EncoderException("Interest cell size must be positive");
+    }
+}
+
+/*
+ *  InterestManager::Update
+ *
+ *  Description:
+ *      This function will record the positions of the given objects, such as
+ *      all of the objects to be sent on a tick.
+ *
+ *  Parameters:
+ *      objects [in]
+ *          The objects whose positions are to be recorded.  Objects without
+ *          an object ID or position (e.g., meshes) are ignored.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The grid cell of each object is computed concurrently when permitted
+ *      by SetMaxThreads().  Only objects that have moved to another cell are
+ *      then relinked in the grid, which is done serially.
+ */
+void InterestManager::Update(const GSObjects &objects)
+{
+    std::vector<std::size_t> indices;
+    std::vector<Loc1> updates;
+    std::vector<std::uint64_t> new_cells;
+
+    // Assign an index to each object having a position
+    indices.reserve(objects.size());
+    updates.reserve(objects.size());
+    for (const GSObject &object : objects)
+    {
+        const std::optional<std::uint64_t> id = GetObjectID(object);
+        const std::optional<Loc1> position = GetObjectPosition(object);
+
+        if (!id || !position) continue;
+
+        indices.push_back(this->objects.Insert(*id));
+        updates.push_back(*position);
+    }
+
+    const std::size_t limit = this->objects.GetIndexLimit();
+    positions.resize(limit);
+    cell_of.resize(limit, No_Cell);
+    cell_slot.resize(limit);
+
+    // Compute the cell of each object
+    new_cells.resize(updates.size());
+    const std::size_t chunks = GetChunkCount(updates.size(),
+                                             max_threads,
+                                             Update_Min_Chunk);
+
+    ParallelFor(updates.size(),
+                chunks,
+                [&](std::size_t, std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        new_cells[i] = GetCell(updates[i]);
+                    }
+                });
+
+    // Record positions and move objects between cells
+    for (std::size_t i = 0; i < updates.size(); i++)
+    {
+        positions[indices[i]] = updates[i];
+        if (cell_of[indices[i]] != new_cells[i]) Move(indices[i], new_cells[i]);
+    }
+}
+
+/*
+ *  InterestManager::Update
+ *
+ *  Description:
+ *      This function will record the position of a single object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *      position [in]
+ *          The position of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void InterestManager::Update(std::uint64_t id, const Loc1 &position)
+{
+    const std::size_t index = objects.Insert(id);
+
+    if (index >= positions.size())
+    {
+        positions.resize(index + 1);
+        cell_of.resize(index + 1, No_Cell);
+        cell_slot.resize(index + 1);
+    }
+
+    positions[index] = position;
+
+    const std::uint64_t cell = GetCell(position);
+    if (cell_of[index] != cell) Move(index, cell);
+}
+
+/*
+ *  InterestManager::Remove
+ *
+ *  Description:
+ *      This function will stop tracking the given object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      True if the object was removed, false if it was not tracked.
+ *
+ *  Comments:
+ *      None.
+ */
+bool InterestManager::Remove(std::uint64_t id)
+{
+    const std::size_t index = objects.Find(id);
+
+    if (index == ObjectTable::Not_Found) return false;
+
+    if (cell_of[index] != No_Cell) Unlink(index);
+
+    return objects.Remove(id);
+}
+
+/*
+ *  InterestManager::UpdateRecipient
+ *
+ *  Description:
+ *      This function will add a recipient of objects or move an existing
+ *      recipient.
+ *
+ *  Parameters:
+ *      recipient [in]
+ *          An identifier for the recipient (e.g., the ID of the recipient's
+ *          head object or a client identifier).
+ *
+ *      position [in]
+ *          The position of the recipient.
+ *
+ *      radius [in]
+ *          The distance within which objects are of interest.  If not given,
+ *          the default radius of interest is used.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void InterestManager::UpdateRecipient(std::uint64_t recipient,
+                                      const Loc1 &position)
+{
+    UpdateRecipient(recipient, position, options.radius);
+}
+
+void InterestManager::UpdateRecipient(std::uint64_t recipient,
+                                      const Loc1 &position,
+                                      float radius)
+{
+    const std::size_t index = recipient_table.Insert(recipient);
+
+    if (index >= recipients.size()) recipients.resize(index + 1);
+
+    recipients[index] = Recipient{recipient, position, radius};
+}
+
+/*
+ *  InterestManager::RemoveRecipient
+ *
+ *  Description:
+ *      This function will stop tracking the given recipient.
+ *
+ *  Parameters:
+ *      recipient [in]
+ *          The identifier of the recipient.
+ *
+ *  Returns:
+ *      True if the recipient was removed, false if it was not tracked.
+ *
+ *  Comments:
+ *      None.
+ */
+bool InterestManager::RemoveRecipient(std::uint64_t recipient)
+{
+    return recipient_table.Remove(recipient);
+}
+
+/*
+ *  InterestManager::Query
+ *
+ *  Description:
+ *      This function will return the objects of interest to each recipient.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      A set of interest for each recipient, holding the IDs of the objects
+ *      within the recipient's radius of interest in ascending order.
+ *
+ *  Comments:
+ *      This is intended to be called once per tick after positions are
+ *      updated.  Recipients are queried concurrently when permitted by
+ *      SetMaxThreads().
+ */
+std::vector<InterestSet> InterestManager::Query() const
+{
+    std::vector<std::size_t> active;
+    std::vector<InterestSet> result;
+
+    for (std::size_t i = 0; i < recipient_table.GetIndexLimit(); i++)
+    {
+        if (recipient_table.IsValid(i)) active.push_back(i);
+    }
+
+    result.resize(active.size());
+
+    const std::size_t chunks = GetChunkCount(active.size(),
+                                             max_threads,
+                                             Query_Min_Chunk);
+
+    ParallelFor(active.size(),
+                chunks,
+                [&](std::size_t, std::size_t begin, std::size_t end)
+                {
+                    for (std::size_t i = begin; i < end; i++)
+                    {
+                        const Recipient &recipient = recipients[active[i]];
+                        result[i].recipient = recipient.id;
+                        Search(recipient.position,
+                               recipient.radius,
+                               result[i].ids);
+                    }
+                });
+
+    return result;
+}
+
+/*
+ *  InterestManager::Query
+ *
+ *  Description:
+ *      This function will return the objects within a radius of a position.
+ *
+ *  Parameters:
+ *      position [in]
+ *          The position about which to search.
+ *
+ *      radius [in]
+ *          The distance within which to return objects.
+ *
+ *  Returns:
+ *      The IDs of the objects found in ascending order.
+ *
+ *  Comments:
+ *      None.
+ */
+std::vector<std::uint64_t> InterestManager::Query(const Loc1 &position,
+                                                  float radius) const
+{
+    std::vector<std::uint64_t> ids;
+
+    Search(position, radius, ids);
+
+    return ids;
+}
+
+/*
+ *  InterestManager::Select
+ *
+ *  Description:
+ *      This function will select from the given objects those to be encoded
+ *      for a recipient.
+ *
+ *  Parameters:
+ *      objects [in]
+ *          The objects that might be sent.
+ *
+ *      interest [in]
+ *          The recipient's set of interest returned by Query().
+ *
+ *  Returns:
+ *      The objects in the set of interest, along with any objects whose
+ *      positions are not tracked (e.g., meshes), in their original order.
+ *
+ *  Comments:
+ *      None.
+ */
+GSObjects InterestManager::Select(const GSObjects &objects,
+                                  const InterestSet &interest) const
+{
+    GSObjects selected;
+
+    for (const GSObject &object : objects)
+    {
+        const std::optional<std::uint64_t> id = GetObjectID(object);
+
+        if (id && (this->objects.Find(*id) != ObjectTable::Not_Found) &&
+            !std::binary_search(interest.ids.begin(), interest.ids.end(), *id))
+        {
+            continue;
+        }
+
+        selected.push_back(object);
+    }
+
+    return selected;
+}
+
+/*
+ *  InterestManager::GetCell
+ *
+ *  Description:
+ *      This function will return the key of the grid cell containing the
+ *      given position.
+ *
+ *  Parameters:
+ *      position [in]
+ *          The position.
+ *
+ *  Returns:
+ *      The key of the cell.
+ *
+ *  Comments:
+ *      None.
+ */
+std::uint64_t InterestManager::GetCell(const Loc1 &position) const
+{
+    return PackCell(GetCoordinate(position.x, options.cell_size),
+                    GetCoordinate(position.y, options.cell_size),
+                    GetCoordinate(position.z, options.cell_size));
+}
+
+/*
+ *  InterestManager::Move
+ *
+ *  Description:
+ *      This function will move an object into the given grid cell.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index of the object.
+ *
+ *      cell [in]
+ *          The key of the cell.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void InterestManager::Move(std::size_t index, std::uint64_t cell)
+{
+    if (cell_of[index] != No_Cell) Unlink(index);
+
+    std::vector<std::size_t> &members = cells[cell];
+
+    cell_slot[index] = members.size();
+    cell_of[index] = cell;
+    members.push_back(index);
+}
+
+/*
+ *  InterestManager::Unlink
+ *
+ *  Description:
+ *      This function will remove an object from its grid cell.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The last object in the cell takes the place of the removed object,
+ *      so removal takes constant time.  Empty cells are discarded.
+ */
+void InterestManager::Unlink(std::size_t index)
+{
+    const auto it = cells.find(cell_of[index]);
+    std::vector<std::size_t> &members = it->second;
+    const std::size_t last = members.back();
+
+    members[cell_slot[index]] = last;
+    cell_slot[last] = cell_slot[index];
+    members.pop_back();
+
+    if (members.empty()) cells.erase(it);
+
+    cell_of[index] = No_Cell;
+}
+
+/*
+ *  InterestManager::Search
+ *
+ *  Description:
+ *      This function will find the objects within a radius of a position.
+ *
+ *  Parameters:
+ *      position [in]
+ *          The position about which to search.
+ *
+ *      radius [in]
+ *          The distance within which to find objects.
+ *
+ *      ids [out]
+ *          The IDs of the objects found in ascending order.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the cells overlapping the cube enclosing the sphere of interest
+ *      are examined, unless there are more such cells than occupied cells,
+ *      in which case every occupied cell is examined instead.
+ */
+void InterestManager::Search(const Loc1 &position,
+                             float radius,
+                             std::vector<std::uint64_t> &ids) const
+{
+    const double r = std::max(radius, 0.0f);
+    const double r_squared = r * r;
+
+    ids.clear();
+
+    // Append the objects in a cell within the radius
+    auto search_cell = [&](const std::vector<std::size_t> &members)
+    {
+        for (const std::size_t index : members)
+        {
+            const double dx = positions[index].x - position.x;
+            const double dy = positions[index].y - position.y;
+            const double dz = positions[index].z - position.z;
+
+            if (dx * dx + dy * dy + dz * dz <= r_squared)
+            {
+                ids.push_back(objects.GetID(index));
+            }
+        }
+    };
+
+    const std::int64_t x0 = GetCoordinate(position.x - r, options.cell_size);
+    const std::int64_t x1 = GetCoordinate(position.x + r, options.cell_size);
+    const std::int64_t y0 = GetCoordinate(position.y - r, options.cell_size);
+    const std::int64_t y1 = GetCoordinate(position.y + r, options.cell_size);
+    const std::int64_t z0 = GetCoordinate(position.z - r, options.cell_size);
+    const std::int64_t z1 = GetCoordinate(position.z + r, options.cell_size);
+    const double range = double(x1 - x0 + 1) *
+                         double(y1 - y0 + 1) *
+                         double(z1 - z0 + 1);
+
+    if (range > double(cells.size()))
+    {
+        for (const auto &[cell, members] : cells) search_cell(members);
+    }
+    else
+    {
+        for (std::int64_t x = x0; x <= x1; x++)
+        {
+            for (std::int64_t y = y0; y <= y1; y++)
+            {
+                for (std::int64_t z = z0; z <= z1; z++)
+                {
+                    const auto it = cells.find(PackCell(x, y, z));
+                    if (it != cells.end()) search_cell(it->second);
+                }
+            }
+        }
+    }
+
+    std::sort(ids.begin(), ids.end());
+}
+
+} // namespace gs
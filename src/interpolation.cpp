@@ -0,0 +1,457 @@
+/*
+ *  interpolation.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements functions used by the Interpolator to blend
+ *      arrays of state components, each array holding one component of many
+ *      objects.  SSE2 intrinsics are used where the compiler indicates they are
+ *      available, with scalar code processing any remaining elements.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GS_INTERPOLATION_SSE2
+#endif
+#include "interpolation.h"
+
+namespace gs
+{
+
+namespace
+{
+
+/*
+ *  Clamp
+ *
+ *  Description:
+ *      Limit an interpolation fraction to the range [0, 1].
+ *
+ *  Parameters:
+ *      s [in]
+ *          The fraction to limit.
+ *
+ *  Returns:
+ *      The limited fraction.
+ *
+ *  Comments:
+ *      A NaN fraction becomes zero, as it does in the SSE2 path, since
+ *      std::max returns its first argument when the comparison fails.
+ */
+inline float Clamp(float s)
+{
+    return std::min(std::max(0.0f, s), 1.0f);
+}
+
+#ifdef GS_INTERPOLATION_SSE2
+inline __m128 Clamp(__m128 s)
+{
+    return _mm_min_ps(_mm_max_ps(s, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+/*
+ *  Select
+ *
+ *  Description:
+ *      Select lanes from one of two registers according to a mask.
+ *
+ *  Parameters:
+ *      mask [in]
+ *          The mask having all bits set in lanes to take from a.
+ *
+ *      a [in]
+ *          The lanes to select where the mask is set.
+ *
+ *      b [in]
+ *          The lanes to select where the mask is clear.
+ *
+ *  Returns:
+ *      The selected lanes.
+ *
+ *  Comments:
+ *      None.
+ */
+inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+#endif
+
+/*
+ *  Nlerp
+ *
+ *  Description:
+ *      Interpolate between the vector parts of two unit quaternions having
+ *      non-negative real parts.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The vector part of the first quaternion.
+ *
+ *      b [in]
+ *          The vector part of the second quaternion.
+ *
+ *      s [in]
+ *          The interpolation fraction, already limited to [0, 1].
+ *
+ *      result [out]
+ *          The vector part of the interpolated quaternion.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      See NlerpArrays().
+ */
+inline void Nlerp(const float a[3], const float b[3], float s, float result[3])
+{
+    const float aw = std::sqrt(
+        std::max(0.0f, 1.0f - (a[0] * a[0] + a[1] * a[1] + a[2] * a[2])));
+    const float bw = std::sqrt(
+        std::max(0.0f, 1.0f - (b[0] * b[0] + b[1] * b[1] + b[2] * b[2])));
+    const float dot = aw * bw + a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    const float sb = (dot < 0.0f) ? -s : s;
+    const float sa = 1.0f - s;
+    float q[4] = {aw * sa + bw * sb,
+                  a[0] * sa + b[0] * sb,
+                  a[1] * sa + b[1] * sb,
+                  a[2] * sa + b[2] * sb};
+    const float norm =
+        std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+
+    if (!(norm > 0.0f))
+    {
+        result[0] = b[0];
+        result[1] = b[1];
+        result[2] = b[2];
+        return;
+    }
+
+    // Scale to unit length, keeping the real part non-negative
+    const float scale = (std::signbit(q[0]) ? -1.0f : 1.0f) / norm;
+    result[0] = q[1] * scale;
+    result[1] = q[2] * scale;
+    result[2] = q[3] * scale;
+}
+
+} // namespace
+
+/*
+ *  LerpArrays
+ *
+ *  Description:
+ *      This function will linearly interpolate between corresponding
+ *      elements of two arrays.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The values at fraction zero.
+ *
+ *      b [in]
+ *          The values at fraction one.
+ *
+ *      s [in]
+ *          The fraction for each element.  Fractions outside of [0, 1] are
+ *          limited to that range.
+ *
+ *      result [out]
+ *          The interpolated values, which may be the same array as a or b.
+ *
+ *      count [in]
+ *          The number of elements in each array.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void LerpArrays(const float *a,
+                const float *b,
+                const float *s,
+                float *result,
+                std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef GS_INTERPOLATION_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 va = _mm_loadu_ps(a + i);
+        const __m128 vb = _mm_loadu_ps(b + i);
+        const __m128 vs = Clamp(_mm_loadu_ps(s + i));
+
+        _mm_storeu_ps(result + i,
+                      _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vs)));
+    }
+#endif
+
+    for (; i < count; i++) result[i] = a[i] + (b[i] - a[i]) * Clamp(s[i]);
+}
+
+/*
+ *  HermiteArrays
+ *
+ *  Description:
+ *      This function will interpolate positions along a cubic Hermite
+ *      curve whose end points are the given positions and whose tangents
+ *      are the given velocities.
+ *
+ *  Parameters:
+ *      p0 [in]
+ *          The positions at fraction zero.
+ *
+ *      v0 [in]
+ *          The velocities at fraction zero, in units per second.
+ *
+ *      p1 [in]
+ *          The positions at fraction one.
+ *
+ *      v1 [in]
+ *          The velocities at fraction one, in units per second.
+ *
+ *      s [in]
+ *          The fraction for each element.
+ *
+ *      duration [in]
+ *          The time in seconds between fraction zero and fraction one.
+ *
+ *      result [out]
+ *          The interpolated positions.
+ *
+ *      count [in]
+ *          The number of elements in each array.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Beyond fraction one, as when the next state is late, positions are
+ *      extrapolated along the final velocity, which continues the curve's
+ *      tangent.  Fractions below zero, as well as NaN fractions, are
+ *      limited to zero.
+ */
+void HermiteArrays(const float *p0,
+                   const float *v0,
+                   const float *p1,
+                   const float *v1,
+                   const float *s,
+                   const float *duration,
+                   float *result,
+                   std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef GS_INTERPOLATION_SSE2
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 vp0 = _mm_loadu_ps(p0 + i);
+        const __m128 vv0 = _mm_loadu_ps(v0 + i);
+        const __m128 vp1 = _mm_loadu_ps(p1 + i);
+        const __m128 vv1 = _mm_loadu_ps(v1 + i);
+        const __m128 vd = _mm_loadu_ps(duration + i);
+        const __m128 vs = _mm_max_ps(_mm_loadu_ps(s + i), _mm_setzero_ps());
+        const __m128 t = _mm_min_ps(vs, one);
+        const __m128 t2 = _mm_mul_ps(t, t);
+        const __m128 t3 = _mm_mul_ps(t2, t);
+
+        // Hermite basis functions
+        const __m128 h01 =
+            _mm_sub_ps(_mm_mul_ps(three, t2), _mm_mul_ps(two, t3));
+        const __m128 h00 = _mm_sub_ps(one, h01);
+        const __m128 h10 =
+            _mm_add_ps(_mm_sub_ps(t3, _mm_mul_ps(two, t2)), t);
+        const __m128 h11 = _mm_sub_ps(t3, t2);
+
+        const __m128 curve = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(h00, vp0), _mm_mul_ps(h01, vp1)),
+            _mm_mul_ps(vd, _mm_add_ps(_mm_mul_ps(h10, vv0),
+                                      _mm_mul_ps(h11, vv1))));
+        const __m128 beyond = _mm_add_ps(
+            vp1,
+            _mm_mul_ps(vv1, _mm_mul_ps(_mm_sub_ps(vs, one), vd)));
+
+        _mm_storeu_ps(result + i, Select(_mm_cmpgt_ps(vs, one), beyond, curve));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float fraction = std::max(0.0f, s[i]);
+
+        if (fraction > 1.0f)
+        {
+            result[i] = p1[i] + v1[i] * (fraction - 1.0f) * duration[i];
+            continue;
+        }
+
+        const float t2 = fraction * fraction;
+        const float t3 = t2 * fraction;
+        const float h01 = 3.0f * t2 - 2.0f * t3;
+        const float h00 = 1.0f - h01;
+        const float h10 = t3 - 2.0f * t2 + fraction;
+        const float h11 = t3 - t2;
+
+        result[i] = h00 * p0[i] + h01 * p1[i] +
+                    duration[i] * (h10 * v0[i] + h11 * v1[i]);
+    }
+}
+
+/*
+ *  NlerpArrays
+ *
+ *  Description:
+ *      This function will interpolate between corresponding unit
+ *      quaternions, given as the three arrays of each quaternion's vector
+ *      part, by normalizing their linear interpolation.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The i, j, and k components at fraction zero.
+ *
+ *      b [in]
+ *          The i, j, and k components at fraction one.
+ *
+ *      s [in]
+ *          The fraction for each element.  Fractions outside of [0, 1] are
+ *          limited to that range.
+ *
+ *      result [out]
+ *          The i, j, and k components of the interpolated quaternions.
+ *
+ *      count [in]
+ *          The number of elements in each array.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The real part of each quaternion is recovered from the vector part,
+ *      as it is not transmitted.  The second quaternion is negated if
+ *      necessary so that interpolation follows the shorter arc, and the
+ *      result is negated if necessary to keep its real part non-negative.
+ *      For the small rotations between successive states, normalized linear
+ *      interpolation closely approximates spherical interpolation at much
+ *      lower cost.  If the interpolated quaternion has zero length, the
+ *      second quaternion is returned.
+ */
+void NlerpArrays(const float *const a[3],
+                 const float *const b[3],
+                 const float *s,
+                 float *const result[3],
+                 std::size_t count)
+{
+    std::size_t i = 0;
+
+#ifdef GS_INTERPOLATION_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 ai = _mm_loadu_ps(a[0] + i);
+        const __m128 aj = _mm_loadu_ps(a[1] + i);
+        const __m128 ak = _mm_loadu_ps(a[2] + i);
+        const __m128 bi = _mm_loadu_ps(b[0] + i);
+        const __m128 bj = _mm_loadu_ps(b[1] + i);
+        const __m128 bk = _mm_loadu_ps(b[2] + i);
+        const __m128 vs = Clamp(_mm_loadu_ps(s + i));
+
+        // Recover the real parts
+        const __m128 a2 = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(ai, ai), _mm_mul_ps(aj, aj)),
+            _mm_mul_ps(ak, ak));
+        const __m128 b2 = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(bi, bi), _mm_mul_ps(bj, bj)),
+            _mm_mul_ps(bk, bk));
+        const __m128 aw = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, a2)));
+        const __m128 bw = _mm_sqrt_ps(_mm_max_ps(zero, _mm_sub_ps(one, b2)));
+
+        // Negate the second fraction if the quaternions are more than a
+        // half turn apart
+        const __m128 dot = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ai, bi)),
+            _mm_add_ps(_mm_mul_ps(aj, bj), _mm_mul_ps(ak, bk)));
+        const __m128 sb =
+            _mm_xor_ps(vs, _mm_and_ps(_mm_cmplt_ps(dot, zero), sign));
+        const __m128 sa = _mm_sub_ps(one, vs);
+
+        const __m128 qw = _mm_add_ps(_mm_mul_ps(aw, sa), _mm_mul_ps(bw, sb));
+        const __m128 qi = _mm_add_ps(_mm_mul_ps(ai, sa), _mm_mul_ps(bi, sb));
+        const __m128 qj = _mm_add_ps(_mm_mul_ps(aj, sa), _mm_mul_ps(bj, sb));
+        const __m128 qk = _mm_add_ps(_mm_mul_ps(ak, sa), _mm_mul_ps(bk, sb));
+        const __m128 norm = _mm_sqrt_ps(_mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(qw, qw), _mm_mul_ps(qi, qi)),
+            _mm_add_ps(_mm_mul_ps(qj, qj), _mm_mul_ps(qk, qk))));
+
+        // Scale to unit length, keeping the real part non-negative
+        const __m128 scale = _mm_xor_ps(_mm_div_ps(one, norm),
+                                        _mm_and_ps(qw, sign));
+        const __m128 valid = _mm_cmpgt_ps(norm, zero);
+
+        _mm_storeu_ps(result[0] + i,
+                      Select(valid, _mm_mul_ps(qi, scale), bi));
+        _mm_storeu_ps(result[1] + i,
+                      Select(valid, _mm_mul_ps(qj, scale), bj));
+        _mm_storeu_ps(result[2] + i,
+                      Select(valid, _mm_mul_ps(qk, scale), bk));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const float qa[3] = {a[0][i], a[1][i], a[2][i]};
+        const float qb[3] = {b[0][i], b[1][i], b[2][i]};
+        float q[3];
+
+        Nlerp(qa, qb, Clamp(s[i]), q);
+        result[0][i] = q[0];
+        result[1][i] = q[1];
+        result[2][i] = q[2];
+    }
+}
+
+} // namespace gs
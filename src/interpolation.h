@@ -0,0 +1,83 @@
+/*
+ *  interpolation.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines functions used by the Interpolator to blend arrays
+ *      of state components, each array holding one component of many objects.
+ *      SSE2 intrinsics are used where the compiler indicates they are
+ *      available, with scalar code processing any remaining elements.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INTERPOLATION_H
+#define INTERPOLATION_H
+
+#include <cstddef>
+
+namespace gs
+{
+
+// Function to linearly interpolate arrays, limiting fractions to [0, 1]
+void LerpArrays(const float *a,
+                const float *b,
+                const float *s,
+                float *result,
+                std::size_t count);
+
+// Function to interpolate positions using a cubic Hermite curve whose
+// tangents are the velocities, extrapolating linearly beyond the end
+void HermiteArrays(const float *p0,
+                   const float *v0,
+                   const float *p1,
+                   const float *v1,
+                   const float *s,
+                   const float *duration,
+                   float *result,
+                   std::size_t count);
+
+// Function to interpolate the vector parts of unit quaternions having a
+// non-negative real part, limiting fractions to [0, 1]
+void NlerpArrays(const float *const a[3],
+                 const float *const b[3],
+                 const float *s,
+                 float *const result[3],
+                 std::size_t count);
+
+} // namespace gs
+
+#endif // INTERPOLATION_H
@@ -0,0 +1,601 @@
+/*
+ *  interpolator.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the Interpolator object, which blends batches of
+ *      decoded object states for rendering.  Each batch is divided into blocks
+ *      whose fields are gathered into one array per component, so that each
+ *      component of many objects is blended at once using SIMD instructions.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "interpolator.h"
+#include "interpolation.h"
+#include "parallel_coding.h"
+#include "gs_decoder.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// Minimum number of objects interpolated by each thread
+constexpr std::size_t Interpolate_Min_Chunk = 1024;
+
+// Number of objects whose components are gathered together
+constexpr std::size_t Interpolate_Block = 256;
+
+/*
+ *  Value
+ *
+ *  Description:
+ *      Return a reference to the floating point value of a field.
+ *
+ *  Parameters:
+ *      field [in]
+ *          The Float32 or Float16 field.
+ *
+ *  Returns:
+ *      A reference to the field's value.
+ *
+ *  Comments:
+ *      None.
+ */
+template <typename F>
+auto &Value(F &field)
+{
+    if constexpr (std::is_same_v<std::remove_const_t<F>, Float16>)
+    {
+        return field.value;
+    }
+    else
+    {
+        return field;
+    }
+}
+
+/*
+ *  Layout
+ *
+ *  Description:
+ *      These structures describe how the fields of each object type are
+ *      interpolated.  Linear fields are interpolated linearly, rotations
+ *      are given as the three components of each quaternion's vector part,
+ *      and types having a location are interpolated along a Hermite curve
+ *      formed from the location's velocity.  Other fields are taken from
+ *      the later state.
+ *
+ *  Comments:
+ *      The functions visiting fields accept both const and non-const
+ *      objects, so that one description serves both to gather and to
+ *      scatter the fields.
+ */
+template <typename T> struct Layout;
+
+template <> struct Layout<Object1>
+{
+    static constexpr std::size_t Linear = 6;
+    static constexpr std::size_t Rotations = 1;
+    static constexpr bool Has_Location = false;
+
+    template <typename V, typename F> static void ForLinear(V &v, F &&f)
+    {
+        f(v.position.x);
+        f(v.position.y);
+        f(v.position.z);
+        f(v.scale.x);
+        f(v.scale.y);
+        f(v.scale.z);
+    }
+
+    template <typename V, typename F> static void ForRotations(V &v, F &&f)
+    {
+        f(v.rotation.i, v.rotation.j, v.rotation.k);
+    }
+};
+
+template <> struct Layout<Head1>
+{
+    static constexpr std::size_t Linear = 0;
+    static constexpr std::size_t Rotations = 2;
+    static constexpr bool Has_Location = true;
+
+    template <typename V, typename F> static void ForLinear(V &, F &&)
+    {
+    }
+
+    template <typename V, typename F> static void ForRotations(V &v, F &&f)
+    {
+        f(v.rotation.si, v.rotation.sj, v.rotation.sk);
+        f(v.rotation.ei, v.rotation.ej, v.rotation.ek);
+    }
+};
+
+template <> struct Layout<Hand1>
+{
+    static constexpr std::size_t Linear = 0;
+    static constexpr std::size_t Rotations = 2;
+    static constexpr bool Has_Location = true;
+
+    template <typename V, typename F> static void ForLinear(V &, F &&)
+    {
+    }
+
+    template <typename V, typename F> static void ForRotations(V &v, F &&f)
+    {
+        Layout<Head1>::ForRotations(v, f);
+    }
+};
+
+template <> struct Layout<Hand2>
+{
+    static constexpr std::size_t Linear = 75;
+    static constexpr std::size_t Rotations = 2;
+    static constexpr bool Has_Location = true;
+
+    template <typename V, typename F> static void ForTransform(V &t, F &f)
+    {
+        f(t.tx);
+        f(t.ty);
+        f(t.tz);
+    }
+
+    template <typename V, typename F> static void ForFinger(V &finger, F &f)
+    {
+        ForTransform(finger.tip, f);
+        ForTransform(finger.dip, f);
+        ForTransform(finger.pip, f);
+        ForTransform(finger.mcp, f);
+        ForTransform(finger.cmc, f);
+    }
+
+    template <typename V, typename F> static void ForLinear(V &v, F &&f)
+    {
+        ForTransform(v.wrist, f);
+        ForTransform(v.thumb.tip, f);
+        ForTransform(v.thumb.ip, f);
+        ForTransform(v.thumb.mcp, f);
+        ForTransform(v.thumb.cmc, f);
+        ForFinger(v.index, f);
+        ForFinger(v.middle, f);
+        ForFinger(v.ring, f);
+        ForFinger(v.pinky, f);
+    }
+
+    template <typename V, typename F> static void ForRotations(V &v, F &&f)
+    {
+        Layout<Head1>::ForRotations(v, f);
+    }
+};
+
+// Arrays holding the gathered components of a block of objects, where
+// component c of object i is found at index c * Interpolate_Block + i
+struct Components
+{
+    std::vector<float> linear_from;
+    std::vector<float> linear_to;
+    std::vector<float> rotation_from;
+    std::vector<float> rotation_to;
+    std::vector<float> rotation_result;
+    std::vector<float> position_from;
+    std::vector<float> velocity_from;
+    std::vector<float> position_to;
+    std::vector<float> velocity_to;
+    std::vector<float> duration;
+};
+
+/*
+ *  GetDuration
+ *
+ *  Description:
+ *      Return the time in seconds between two states.
+ *
+ *  Parameters:
+ *      from [in]
+ *          The earlier state.
+ *
+ *      to [in]
+ *          The later state.
+ *
+ *  Returns:
+ *      The time between the states, treating Time1 as wrapping
+ *      milliseconds.
+ *
+ *  Comments:
+ *      None.
+ */
+template <typename T>
+float GetDuration(const T &from, const T &to)
+{
+    const auto elapsed =
+        static_cast<std::int16_t>(static_cast<Time1>(to.time - from.time));
+
+    return static_cast<float>(elapsed) / 1000.0f;
+}
+
+/*
+ *  InterpolateBlock
+ *
+ *  Description:
+ *      Interpolate a block of no more than Interpolate_Block objects.
+ *
+ *  Parameters:
+ *      from [in]
+ *          The earlier states.
+ *
+ *      to [in]
+ *          The later states.
+ *
+ *      fractions [in]
+ *          The fraction of the time between the states for each object.
+ *
+ *      result [out]
+ *          The interpolated states.
+ *
+ *      count [in]
+ *          The number of objects in the block.
+ *
+ *      components [in]
+ *          Arrays into which the components are gathered.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The time of each result is interpolated from the states' times.
+ *      Fractions below zero, as well as NaN fractions, are limited to zero,
+ *      while fractions beyond one extrapolate the time.
+ */
+template <typename T>
+void InterpolateBlock(const T *from,
+                      const T *to,
+                      const float *fractions,
+                      T *result,
+                      std::size_t count,
+                      Components &components)
+{
+    using L = Layout<T>;
+    constexpr std::size_t B = Interpolate_Block;
+    Components &c = components;
+
+    // Gather the components of each object
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::size_t k = 0;
+
+        L::ForLinear(from[i], [&](const auto &f)
+        {
+            c.linear_from[B * k++ + i] = Value(f);
+        });
+        k = 0;
+        L::ForLinear(to[i], [&](const auto &f)
+        {
+            c.linear_to[B * k++ + i] = Value(f);
+        });
+        k = 0;
+        L::ForRotations(from[i],
+                        [&](const auto &qi, const auto &qj, const auto &qk)
+                        {
+                            c.rotation_from[B * k++ + i] = Value(qi);
+                            c.rotation_from[B * k++ + i] = Value(qj);
+                            c.rotation_from[B * k++ + i] = Value(qk);
+                        });
+        k = 0;
+        L::ForRotations(to[i],
+                        [&](const auto &qi, const auto &qj, const auto &qk)
+                        {
+                            c.rotation_to[B * k++ + i] = Value(qi);
+                            c.rotation_to[B * k++ + i] = Value(qj);
+                            c.rotation_to[B * k++ + i] = Value(qk);
+                        });
+
+        if constexpr (L::Has_Location)
+        {
+            const Loc2 &l0 = from[i].location;
+            const Loc2 &l1 = to[i].location;
+
+            c.position_from[i] = l0.x;
+            c.position_from[B + i] = l0.y;
+            c.position_from[2 * B + i] = l0.z;
+            c.velocity_from[i] = l0.vx.value;
+            c.velocity_from[B + i] = l0.vy.value;
+            c.velocity_from[2 * B + i] = l0.vz.value;
+            c.position_to[i] = l1.x;
+            c.position_to[B + i] = l1.y;
+            c.position_to[2 * B + i] = l1.z;
+            c.velocity_to[i] = l1.vx.value;
+            c.velocity_to[B + i] = l1.vy.value;
+            c.velocity_to[2 * B + i] = l1.vz.value;
+            c.duration[i] = GetDuration(from[i], to[i]);
+        }
+    }
+
+    // Blend each component across the block; results overwrite the
+    // components of the earlier states
+    for (std::size_t k = 0; k < L::Linear; k++)
+    {
+        LerpArrays(&c.linear_from[B * k],
+                   &c.linear_to[B * k],
+                   fractions,
+                   &c.linear_from[B * k],
+                   count);
+    }
+    for (std::size_t r = 0; r < L::Rotations; r++)
+    {
+        const float *const a[3] = {&c.rotation_from[B * (3 * r)],
+                                   &c.rotation_from[B * (3 * r + 1)],
+                                   &c.rotation_from[B * (3 * r + 2)]};
+        const float *const b[3] = {&c.rotation_to[B * (3 * r)],
+                                   &c.rotation_to[B * (3 * r + 1)],
+                                   &c.rotation_to[B * (3 * r + 2)]};
+        float *const q[3] = {&c.rotation_result[B * (3 * r)],
+                             &c.rotation_result[B * (3 * r + 1)],
+                             &c.rotation_result[B * (3 * r + 2)]};
+
+        NlerpArrays(a, b, fractions, q, count);
+    }
+    if constexpr (L::Has_Location)
+    {
+        for (std::size_t axis = 0; axis < 3; axis++)
+        {
+            float *p0 = &c.position_from[B * axis];
+            float *v0 = &c.velocity_from[B * axis];
+
+            HermiteArrays(p0,
+                          v0,
+                          &c.position_to[B * axis],
+                          &c.velocity_to[B * axis],
+                          fractions,
+                          c.duration.data(),
+                          p0,
+                          count);
+            LerpArrays(v0, &c.velocity_to[B * axis], fractions, v0, count);
+        }
+    }
+
+    // Scatter the components into the results
+    for (std::size_t i = 0; i < count; i++)
+    {
+        T &value = result[i];
+        std::size_t k = 0;
+
+        // Limit the fraction as the kernels do, so that NaN and negative
+        // fractions give the earlier state's time
+        const float fraction = std::max(0.0f, fractions[i]);
+
+        value = to[i];
+        value.time = static_cast<Time1>(
+            from[i].time +
+            static_cast<std::int32_t>(std::lround(
+                fraction * GetDuration(from[i], to[i]) * 1000.0f)));
+
+        L::ForLinear(value, [&](auto &f)
+        {
+            Value(f) = c.linear_from[B * k++ + i];
+        });
+        k = 0;
+        L::ForRotations(value,
+                        [&](auto &qi, auto &qj, auto &qk)
+                        {
+                            Value(qi) = c.rotation_result[B * k++ + i];
+                            Value(qj) = c.rotation_result[B * k++ + i];
+                            Value(qk) = c.rotation_result[B * k++ + i];
+                        });
+
+        if constexpr (L::Has_Location)
+        {
+            Loc2 &l = value.location;
+
+            l.x = c.position_from[i];
+            l.y = c.position_from[B + i];
+            l.z = c.position_from[2 * B + i];
+            l.vx.value = c.velocity_from[i];
+            l.vy.value = c.velocity_from[B + i];
+            l.vz.value = c.velocity_from[2 * B + i];
+        }
+
+        if constexpr (std::is_same_v<T, Head1>)
+        {
+            if (from[i].ipd && to[i].ipd)
+            {
+                LerpArrays(&from[i].ipd->ipd.value,
+                           &to[i].ipd->ipd.value,
+                           fractions + i,
+                           &value.ipd->ipd.value,
+                           1);
+            }
+        }
+    }
+}
+
+} // namespace
+
+/*
+ *  Interpolator::Interpolate
+ *
+ *  Description:
+ *      These functions will interpolate between pairs of object states.
+ *
+ *  Parameters:
+ *      from [in]
+ *          The earlier state of each object.
+ *
+ *      to [in]
+ *          The later state of each object.
+ *
+ *      fractions [in]
+ *          The fraction of the time between the states at which each object
+ *          is to be interpolated, where zero gives the earlier state and one
+ *          the later.
+ *
+ *      result [out]
+ *          The interpolated states.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Positions and scale factors, as well as hand joints, are
+ *      interpolated linearly, and rotations by normalized linear
+ *      interpolation of quaternions.  Head and hand positions follow a
+ *      cubic Hermite curve whose tangents are the states' velocities.
+ *      Fractions greater than one are permitted when the next state is
+ *      late: head and hand positions are then extrapolated along the later
+ *      velocity, while other fields hold the later state.  Object IDs and
+ *      other discrete fields are taken from the later state.  A
+ *      DecoderException is thrown if the vectors differ in length.
+ */
+void Interpolator::Interpolate(const std::vector<Object1> &from,
+                               const std::vector<Object1> &to,
+                               const std::vector<float> &fractions,
+                               std::vector<Object1> &result)
+{
+    InterpolateStates(from, to, fractions, result);
+}
+
+void Interpolator::Interpolate(const std::vector<Head1> &from,
+                               const std::vector<Head1> &to,
+                               const std::vector<float> &fractions,
+                               std::vector<Head1> &result)
+{
+    InterpolateStates(from, to, fractions, result);
+}
+
+void Interpolator::Interpolate(const std::vector<Hand1> &from,
+                               const std::vector<Hand1> &to,
+                               const std::vector<float> &fractions,
+                               std::vector<Hand1> &result)
+{
+    InterpolateStates(from, to, fractions, result);
+}
+
+void Interpolator::Interpolate(const std::vector<Hand2> &from,
+                               const std::vector<Hand2> &to,
+                               const std::vector<float> &fractions,
+                               std::vector<Hand2> &result)
+{
+    InterpolateStates(from, to, fractions, result);
+}
+
+/*
+ *  Interpolator::InterpolateStates
+ *
+ *  Description:
+ *      This function will interpolate between pairs of object states,
+ *      dividing large batches among threads.
+ *
+ *  Parameters:
+ *      from [in]
+ *          The earlier state of each object.
+ *
+ *      to [in]
+ *          The later state of each object.
+ *
+ *      fractions [in]
+ *          The fraction of the time between the states for each object.
+ *
+ *      result [out]
+ *          The interpolated states.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each thread gathers blocks of objects into its own component arrays.
+ */
+template <typename T>
+void Interpolator::InterpolateStates(const std::vector<T> &from,
+                                     const std::vector<T> &to,
+                                     const std::vector<float> &fractions,
+                                     std::vector<T> &result)
+{
+    using L = Layout<T>;
+    constexpr std::size_t B = Interpolate_Block;
+
+    if ((from.size() != to.size()) || (from.size() != fractions.size()))
+    {
+        throw DecoderException("Interpolated vectors differ in length");
+    }
+
+    result.resize(from.size());
+
+    const std::size_t chunks = GetChunkCount(from.size(),
+                                             max_threads,
+                                             Interpolate_Min_Chunk);
+
+    ParallelFor(from.size(),
+                chunks,
+                [&](std::size_t, std::size_t begin, std::size_t end)
+                {
+                    Components c;
+
+                    c.linear_from.resize(B * L::Linear);
+                    c.linear_to.resize(B * L::Linear);
+                    c.rotation_from.resize(B * 3 * L::Rotations);
+                    c.rotation_to.resize(B * 3 * L::Rotations);
+                    c.rotation_result.resize(B * 3 * L::Rotations);
+                    if constexpr (L::Has_Location)
+                    {
+                        c.position_from.resize(B * 3);
+                        c.velocity_from.resize(B * 3);
+                        c.position_to.resize(B * 3);
+                        c.velocity_to.resize(B * 3);
+                        c.duration.resize(B);
+                    }
+
+                    for (std::size_t i = begin; i < end; i += B)
+                    {
+                        const std::size_t count = std::min(B, end - i);
+
+                        InterpolateBlock(from.data() + i,
+                                         to.data() + i,
+                                         fractions.data() + i,
+                                         result.data() + i,
+                                         count,
+                                         c);
+                    }
+                });
+}
+
+} // namespace gs
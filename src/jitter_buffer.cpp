@@ -0,0 +1,335 @@
+/*
+ *  jitter_buffer.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the JitterBuffer object, which holds recently
+ *      received states for each object, ordered by their unwrapped time, and
+ *      releases them after an adaptive playout delay.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+#include "jitter_buffer.h"
+#include "gs_decoder.h"
+#include "object_access.h"
+
+namespace gs
+{
+
+// Weight given to each new transit time variation in the jitter estimate
+constexpr double Jitter_Gain = 1.0 / 16.0;
+
+/*
+ *  TimeUnwrapper::Unwrap
+ *
+ *  Description:
+ *      This function will convert a 16-bit time that wraps every 65,536
+ *      milliseconds into a 64-bit time that does not wrap.
+ *
+ *  Parameters:
+ *      time [in]
+ *          The wrapping time.
+ *
+ *  Returns:
+ *      The unwrapped time.
+ *
+ *  Comments:
+ *      The first time given is returned unchanged.  Each subsequent time is
+ *      taken to be the one nearest the latest time unwrapped so far, so
+ *      times may arrive out of order provided they are within about 32
+ *      seconds of the latest time.  Times earlier than the first may be
+ *      negative.
+ */
+std::int64_t TimeUnwrapper::Unwrap(Time1 time)
+{
+    if (!initialized)
+    {
+        initialized = true;
+        latest = time;
+        return latest;
+    }
+
+    const auto delta = static_cast<std::int16_t>(
+        static_cast<Time1>(time - static_cast<Time1>(latest)));
+    const std::int64_t unwrapped = latest + delta;
+
+    latest = std::max(latest, unwrapped);
+
+    return unwrapped;
+}
+
+/*
+ *  JitterBuffer::JitterBuffer
+ *
+ *  Description:
+ *      Constructor for the JitterBuffer object.
+ *
+ *  Parameters:
+ *      options [in]
+ *          The options controlling the buffer.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A capacity of zero is treated as one.  A DecoderException is thrown
+ *      if the minimum playout delay exceeds the maximum.
+ */
+JitterBuffer::JitterBuffer(const JitterBufferOptions &options) :
+    options{options}
+{
+    if (options.min_delay > options.max_delay)
+    {
+        throw DecoderException("Minimum playout delay exceeds the maximum");
+    }
+
+    this->options.capacity = std::max<std::size_t>(options.capacity, 1);
+}
+
+/*
+ *  JitterBuffer::Insert
+ *
+ *  Description:
+ *      This function will insert a received object into the buffer for its
+ *      object ID.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object received.
+ *
+ *      arrival_time [in]
+ *          The local time in milliseconds at which the object was received.
+ *
+ *  Returns:
+ *      True if the object was inserted, false if it was discarded because a
+ *      later state of the object has already been played out, the buffer
+ *      is full of later states, or a state having the same time is already
+ *      buffered.
+ *
+ *  Comments:
+ *      States are held in a fixed-size ring ordered by time, starting at
+ *      the head slot.  A state later than every buffered state is written
+ *      to the slot after the last, so inserts in time order take constant
+ *      time.  A late state is placed by moving only the states later than
+ *      it back one slot, so its cost depends on how far out of order it
+ *      arrived rather than on the capacity.  Once the ring is full, the
+ *      earliest state at the head is replaced, so a late state never evicts
+ *      a later one that has yet to be played out.  Duplicate states are
+ *      discarded before the statistics are updated, so that a repeated
+ *      delivery neither occupies a slot nor inflates the jitter.  The jitter
+ *      is estimated from the variation in transit time (the arrival time
+ *      less the object's time) as described in RFC 3550.  A
+ *      DecoderException is thrown if the object has no object ID or time.
+ */
+bool JitterBuffer::Insert(const GSObject &value, std::int64_t arrival_time)
+{
+    const std::optional<std::uint64_t> id = GetObjectID(value);
+    const std::optional<Time1> time = GetObjectTime(value);
+
+    if (!id) throw DecoderException("Object has no object ID");
+    if (!time) throw DecoderException("Object has no time");
+
+    ObjectBuffer &buffer = buffers.Get<0>(buffers.Insert(*id));
+    const std::size_t capacity = options.capacity;
+    const std::int64_t unwrapped = buffer.unwrapper.Unwrap(*time);
+
+    // Discard states older than the one already played out
+    if (buffer.played && (unwrapped <= *buffer.played)) return false;
+
+    // Discard the state if the ring is full of later states
+    if ((buffer.count == capacity) &&
+        (unwrapped <= buffer.ring[buffer.head].time))
+    {
+        return false;
+    }
+
+    // Discard a duplicate of a buffered state
+    for (std::size_t position = buffer.count; position > 0; position--)
+    {
+        const Entry &entry =
+            buffer.ring[(buffer.head + position - 1) % capacity];
+        if (entry.time < unwrapped) break;
+        if (entry.time == unwrapped) return false;
+    }
+
+    // Update the transit time statistics
+    const std::int64_t transit = arrival_time - unwrapped;
+    if (!buffer.received)
+    {
+        buffer.received = true;
+        buffer.min_transit = transit;
+        buffer.ring.resize(capacity);
+    }
+    else
+    {
+        const auto variation =
+            static_cast<double>(std::llabs(transit - buffer.last_transit));
+        buffer.jitter += (variation - buffer.jitter) * Jitter_Gain;
+        buffer.min_transit = std::min(buffer.min_transit, transit);
+    }
+    buffer.last_transit = transit;
+
+    // Evict the earliest state if the ring is full
+    if (buffer.count == capacity)
+    {
+        buffer.head = (buffer.head + 1) % capacity;
+        buffer.count--;
+    }
+
+    // Move any later states back one slot and write the state in order
+    std::size_t position = buffer.count;
+    while (position > 0)
+    {
+        Entry &previous = buffer.ring[(buffer.head + position - 1) % capacity];
+        if (previous.time <= unwrapped) break;
+        buffer.ring[(buffer.head + position) % capacity] = std::move(previous);
+        position--;
+    }
+    buffer.ring[(buffer.head + position) % capacity] = {unwrapped, value};
+    buffer.count++;
+
+    return true;
+}
+
+/*
+ *  JitterBuffer::Playout
+ *
+ *  Description:
+ *      This function will return the latest state of an object that is due
+ *      for playout at the given local time.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *      local_time [in]
+ *          The current local time in milliseconds.
+ *
+ *  Returns:
+ *      The latest state due for playout or no value if the object is
+ *      unknown or no state later than the one last returned is due.
+ *
+ *  Comments:
+ *      A state is due once the local time reaches the object's time plus
+ *      the smallest transit time observed and the playout delay.  States
+ *      are read from the head of the ring and removed as they come due, so
+ *      earlier states that were not returned are skipped and each state is
+ *      visited only once.
+ */
+std::optional<GSObject> JitterBuffer::Playout(std::uint64_t id,
+                                              std::int64_t local_time)
+{
+    const std::size_t index = buffers.Find(id);
+
+    if (index == ObjectTable::Not_Found) return {};
+
+    ObjectBuffer &buffer = buffers.Get<0>(index);
+    const std::int64_t due_time =
+        local_time - buffer.min_transit - GetDelay(buffer);
+    Entry *latest = nullptr;
+
+    while ((buffer.count > 0) && (buffer.ring[buffer.head].time <= due_time))
+    {
+        latest = &buffer.ring[buffer.head];
+        buffer.head = (buffer.head + 1) % options.capacity;
+        buffer.count--;
+    }
+
+    if (latest == nullptr) return {};
+
+    buffer.played = latest->time;
+
+    return std::move(latest->value);
+}
+
+/*
+ *  JitterBuffer::GetPlayoutDelay
+ *
+ *  Description:
+ *      This function will return the current playout delay for an object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The playout delay in milliseconds, or the minimum delay if the
+ *      object is unknown.
+ *
+ *  Comments:
+ *      None.
+ */
+std::int64_t JitterBuffer::GetPlayoutDelay(std::uint64_t id) const
+{
+    const std::size_t index = buffers.Find(id);
+
+    if (index == ObjectTable::Not_Found) return options.min_delay;
+
+    return GetDelay(buffers.Get<0>(index));
+}
+
+/*
+ *  JitterBuffer::GetDelay
+ *
+ *  Description:
+ *      This function will compute the playout delay from the jitter
+ *      observed for an object.
+ *
+ *  Parameters:
+ *      buffer [in]
+ *          The object's buffer.
+ *
+ *  Returns:
+ *      The playout delay in milliseconds.
+ *
+ *  Comments:
+ *      The delay is the jitter multiplied by the jitter multiplier, limited
+ *      to the range given by the minimum and maximum delays.
+ */
+std::int64_t JitterBuffer::GetDelay(const ObjectBuffer &buffer) const
+{
+    const auto delay = static_cast<std::int64_t>(
+        std::llround(buffer.jitter * options.jitter_multiplier));
+
+    return std::clamp(delay, options.min_delay, options.max_delay);
+}
+
+} // namespace gs
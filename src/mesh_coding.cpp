@@ -0,0 +1,1507 @@
+/*
+ *  mesh_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements utility functions used by the Game State Encoder
+ *      and Decoder when producing or consuming the compact mesh encoding.
+ *      These functions operate on the machine representation of a Mesh1 and
+ *      do not read from or write to a DataBuffer.
+ *
+ *  Portability Issues:
+ *      SSE2 intrinsics are used where the compiler indicates they are
+ *      available; otherwise, portable scalar code is used.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define GS_MESH_CODING_SSE2
+#endif
+#include "mesh_coding.h"
+#include "parallel_coding.h"
+
+namespace gs
+{
+
+/*
+ *  ReorderTriangles
+ *
+ *  Description:
+ *      This function will reorder the triangles in the given index vector
+ *      to improve the locality of the indices.  Each triangle is first
+ *      rotated so that its smallest index comes first (which preserves the
+ *      winding order) and then the triangles are sorted.  The result is that
+ *      triangles sharing vertices tend to be adjacent and consecutive indices
+ *      tend to be numerically close, which makes delta coding effective.
+ *
+ *  Parameters:
+ *      triangles [in/out]
+ *          The triangle index vector to reorder.  The number of elements
+ *          must be a multiple of three.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the number of indices is not a multiple of three, the vector is
+ *      left unchanged since it cannot be interpreted as a triangle list.
+ */
+void ReorderTriangles(std::vector<VarUint> &triangles)
+{
+    typedef std::array<std::uint64_t, 3> Triangle;
+    std::vector<Triangle> ordered;
+
+    if ((triangles.size() % 3) != 0) return;
+
+    ordered.reserve(triangles.size() / 3);
+
+    // Rotate each triangle so the smallest index is first
+    for (std::size_t i = 0; i < triangles.size(); i += 3)
+    {
+        const std::uint64_t a = triangles[i].value;
+        const std::uint64_t b = triangles[i + 1].value;
+        const std::uint64_t c = triangles[i + 2].value;
+
+        if ((a <= b) && (a <= c))
+        {
+            ordered.push_back({a, b, c});
+        }
+        else if (b <= c)
+        {
+            ordered.push_back({b, c, a});
+        }
+        else
+        {
+            ordered.push_back({c, a, b});
+        }
+    }
+
+    // Sort triangles so those sharing a low index are adjacent
+    std::stable_sort(ordered.begin(), ordered.end());
+
+    // Write the reordered triangles back to the index vector
+    for (std::size_t i = 0; i < ordered.size(); i++)
+    {
+        triangles[i * 3].value = ordered[i][0];
+        triangles[i * 3 + 1].value = ordered[i][1];
+        triangles[i * 3 + 2].value = ordered[i][2];
+    }
+}
+
+/*
+ *  WeldVertices
+ *
+ *  Description:
+ *      This function will remove duplicate vertices from a mesh.  Two
+ *      vertices are duplicates when their position, normal, and texture
+ *      coordinates (where present) are bitwise identical.  Each unique
+ *      vertex is retained at its first occurrence and the triangle indices
+ *      are remapped to refer to the retained vertices.
+ *
+ *  Parameters:
+ *      vertices [in/out]
+ *          The vertex positions.
+ *
+ *      normals [in/out]
+ *          The vertex normals, which must either be empty or have one entry
+ *          per vertex.
+ *
+ *      textures [in/out]
+ *          The vertex texture coordinates, which must either be empty or have
+ *          one entry per vertex.
+ *
+ *      triangles [in/out]
+ *          The triangle index vector.
+ *
+ *  Returns:
+ *      The number of vertices removed.
+ *
+ *  Comments:
+ *      If the normals or texture coordinates are not per-vertex attributes
+ *      or if any triangle index exceeds the vertex count, the mesh cannot be
+ *      safely rewritten and is left unchanged.  Since only bitwise identical
+ *      attributes are merged, the decoded mesh renders identically.
+ */
+std::size_t WeldVertices(std::vector<Loc1> &vertices,
+                         std::vector<Norm1> &normals,
+                         std::vector<TextureUV1> &textures,
+                         std::vector<VarUint> &triangles)
+{
+    typedef std::array<std::uint64_t, 5> Key;
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const
+        {
+            std::uint64_t hash = 0xcbf29ce484222325;
+            for (auto value : key)
+            {
+                hash = (hash ^ value) * 0x100000001b3;
+                hash ^= hash >> 29;
+            }
+            return static_cast<std::size_t>(hash);
+        }
+    };
+    const bool has_normals = !normals.empty();
+    const bool has_textures = !textures.empty();
+    std::unordered_map<Key, std::uint64_t, KeyHash> unique;
+    std::vector<std::uint64_t> remap(vertices.size());
+    std::size_t count{};
+
+    // Ensure the mesh can be rewritten
+    if ((has_normals && (normals.size() != vertices.size())) ||
+        (has_textures && (textures.size() != vertices.size())))
+    {
+        return 0;
+    }
+    for (const auto &index : triangles)
+    {
+        if (index.value >= vertices.size()) return 0;
+    }
+
+    // Helper to get the bit pattern of a floating point value
+    auto bits = [](float value) -> std::uint64_t
+    {
+        std::uint32_t result;
+        std::memcpy(&result, &value, sizeof(result));
+        return result;
+    };
+
+    unique.reserve(vertices.size());
+
+    // Assign each vertex to the first vertex having identical attributes,
+    // compacting the attribute vectors in place
+    for (std::size_t i = 0; i < vertices.size(); i++)
+    {
+        Key key{};
+
+        key[0] = (bits(vertices[i].x) << 32) | bits(vertices[i].y);
+        key[1] = bits(vertices[i].z) << 32;
+        if (has_normals)
+        {
+            key[1] |= bits(normals[i].x.value);
+            key[2] = (bits(normals[i].y.value) << 32) |
+                     bits(normals[i].z.value);
+        }
+        if (has_textures)
+        {
+            key[3] = textures[i].u.value;
+            key[4] = textures[i].v.value;
+        }
+
+        auto result = unique.emplace(key, count);
+        if (!result.second)
+        {
+            remap[i] = result.first->second;
+            continue;
+        }
+
+        remap[i] = count;
+        vertices[count] = vertices[i];
+        if (has_normals) normals[count] = normals[i];
+        if (has_textures) textures[count] = textures[i];
+        count++;
+    }
+
+    // Remap the triangle indices to the retained vertices
+    for (auto &index : triangles) index.value = remap[index.value];
+
+    const std::size_t removed = vertices.size() - count;
+
+    vertices.resize(count);
+    if (has_normals) normals.resize(count);
+    if (has_textures) textures.resize(count);
+
+    return removed;
+}
+
+/*
+ *  ComputeBounds
+ *
+ *  Description:
+ *      This function will compute the axis-aligned bounding box that
+ *      encloses all of the given vertices.
+ *
+ *  Parameters:
+ *      vertices [in]
+ *          The vertices for which to compute the bounding box.
+ *
+ *      min [out]
+ *          The minimum coordinate along each axis.
+ *
+ *      max [out]
+ *          The maximum coordinate along each axis.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      NaN vertex components are ignored.  Along any axis having no other
+ *      components (including when there are no vertices), both min and max
+ *      are set to zero.
+ */
+void ComputeBounds(const std::vector<Loc1> &vertices, Loc1 &min, Loc1 &max)
+{
+    ClearBounds(min, max);
+    ExtendBounds(vertices.data(), vertices.size(), min, max);
+    FinishBounds(min, max);
+}
+
+/*
+ *  ClearBounds
+ *
+ *  Description:
+ *      This function will initialize an axis-aligned bounding box so that it
+ *      encloses nothing, ready to be extended by ExtendBounds().
+ *
+ *  Parameters:
+ *      min [out]
+ *          The minimum coordinate along each axis.
+ *
+ *      max [out]
+ *          The maximum coordinate along each axis.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The minimum is set to positive infinity and the maximum to negative
+ *      infinity rather than to the first vertex, which might contain NaN.
+ */
+void ClearBounds(Loc1 &min, Loc1 &max)
+{
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    min = {infinity, infinity, infinity};
+    max = {-infinity, -infinity, -infinity};
+}
+
+/*
+ *  FinishBounds
+ *
+ *  Description:
+ *      This function will set to zero each axis of a bounding box along
+ *      which the box was not extended by any vertex component.
+ *
+ *  Parameters:
+ *      min [in/out]
+ *          The minimum coordinate along each axis.
+ *
+ *      max [in/out]
+ *          The maximum coordinate along each axis.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Such an axis still has the minimum greater than the maximum, as left
+ *      by ClearBounds().
+ */
+void FinishBounds(Loc1 &min, Loc1 &max)
+{
+    if (min.x > max.x) min.x = max.x = 0.0f;
+    if (min.y > max.y) min.y = max.y = 0.0f;
+    if (min.z > max.z) min.z = max.z = 0.0f;
+}
+
+#ifdef GS_MESH_CODING_SSE2
+/*
+ *  CombineBoundsLanes
+ *
+ *  Description:
+ *      This function will combine the minimum and maximum components held
+ *      in registers whose lanes hold components in a rotating x, y, z order
+ *      into the given bounding box.
+ *
+ *  Parameters:
+ *      min0, min1, min2 [in]
+ *          The minimum components of four vertices.
+ *
+ *      max0, max1, max2 [in]
+ *          The maximum components of four vertices.
+ *
+ *      min [out]
+ *          The minimum coordinate along each axis.
+ *
+ *      max [out]
+ *          The maximum coordinate along each axis.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The registers are expected to have been seeded from min and max.
+ */
+static void CombineBoundsLanes(__m128 min0,
+                               __m128 min1,
+                               __m128 min2,
+                               __m128 max0,
+                               __m128 max1,
+                               __m128 max2,
+                               Loc1 &min,
+                               Loc1 &max)
+{
+    alignas(16) float lanes[6][4];
+
+    _mm_store_ps(lanes[0], min0);
+    _mm_store_ps(lanes[1], min1);
+    _mm_store_ps(lanes[2], min2);
+    _mm_store_ps(lanes[3], max0);
+    _mm_store_ps(lanes[4], max1);
+    _mm_store_ps(lanes[5], max2);
+    min.x = std::min({lanes[0][0], lanes[0][3], lanes[1][2], lanes[2][1]});
+    min.y = std::min({lanes[0][1], lanes[1][0], lanes[1][3], lanes[2][2]});
+    min.z = std::min({lanes[0][2], lanes[1][1], lanes[2][0], lanes[2][3]});
+    max.x = std::max({lanes[3][0], lanes[3][3], lanes[4][2], lanes[5][1]});
+    max.y = std::max({lanes[3][1], lanes[4][0], lanes[4][3], lanes[5][2]});
+    max.z = std::max({lanes[3][2], lanes[4][1], lanes[5][0], lanes[5][3]});
+}
+#endif
+
+/*
+ *  ExtendBounds
+ *
+ *  Description:
+ *      This function will extend an axis-aligned bounding box so that it
+ *      encloses the given vertices.
+ *
+ *  Parameters:
+ *      vertices [in]
+ *          The vertices to enclose.
+ *
+ *      count [in]
+ *          The number of vertices.
+ *
+ *      min [in/out]
+ *          The minimum coordinate along each axis.
+ *
+ *      max [in/out]
+ *          The maximum coordinate along each axis.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      A NaN vertex component does not affect the bounds.  Where SSE2 is
+ *      available, four vertices are processed at a time, with each of three
+ *      registers holding components in a rotating x, y, z order.
+ */
+void ExtendBounds(const Loc1 *vertices,
+                  std::size_t count,
+                  Loc1 &min,
+                  Loc1 &max)
+{
+    std::size_t i = 0;
+
+#ifdef GS_MESH_CODING_SSE2
+    if (count >= 4)
+    {
+        __m128 min0 = _mm_setr_ps(min.x, min.y, min.z, min.x);
+        __m128 min1 = _mm_setr_ps(min.y, min.z, min.x, min.y);
+        __m128 min2 = _mm_setr_ps(min.z, min.x, min.y, min.z);
+        __m128 max0 = _mm_setr_ps(max.x, max.y, max.z, max.x);
+        __m128 max1 = _mm_setr_ps(max.y, max.z, max.x, max.y);
+        __m128 max2 = _mm_setr_ps(max.z, max.x, max.y, max.z);
+        alignas(16) float block[12];
+
+        static_assert(sizeof(Loc1) * 4 == sizeof(block));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            // Copy the components of four vertices
+            std::memcpy(block, vertices + i, sizeof(block));
+            const __m128 f0 = _mm_load_ps(block);
+            const __m128 f1 = _mm_load_ps(block + 4);
+            const __m128 f2 = _mm_load_ps(block + 8);
+
+            // The accumulated value is returned if a component is NaN
+            min0 = _mm_min_ps(f0, min0);
+            min1 = _mm_min_ps(f1, min1);
+            min2 = _mm_min_ps(f2, min2);
+            max0 = _mm_max_ps(f0, max0);
+            max1 = _mm_max_ps(f1, max1);
+            max2 = _mm_max_ps(f2, max2);
+        }
+
+        // Combine the lanes holding each component
+        CombineBoundsLanes(min0, min1, min2, max0, max1, max2, min, max);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        const Loc1 &vertex = vertices[i];
+        min.x = std::min(min.x, vertex.x);
+        min.y = std::min(min.y, vertex.y);
+        min.z = std::min(min.z, vertex.z);
+        max.x = std::max(max.x, vertex.x);
+        max.y = std::max(max.y, vertex.y);
+        max.z = std::max(max.z, vertex.z);
+    }
+}
+
+/*
+ *  QuantizeComponent
+ *
+ *  Description:
+ *      This function will map a vertex component within the range [min, max]
+ *      onto an unsigned integer having the specified number of bits.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The component value to quantize.
+ *
+ *      min [in]
+ *          The minimum value of the component range.
+ *
+ *      max [in]
+ *          The maximum value of the component range.
+ *
+ *      bits [in]
+ *          The number of bits in the quantized value (1 to 16).
+ *
+ *  Returns:
+ *      The quantized value, rounded to the nearest step.
+ *
+ *  Comments:
+ *      Values outside of the range are clamped.  If the range is empty or
+ *      the value is not a number, the result is zero.
+ */
+std::uint16_t QuantizeComponent(float value,
+                                float min,
+                                float max,
+                                unsigned bits)
+{
+    const float levels = static_cast<float>((1u << bits) - 1);
+    const float range = max - min;
+
+    if (!(range > 0.0f)) return 0;
+
+    // Normalize into the range [0, 1], mapping NaN to zero
+    float t = (value - min) / range;
+    if (!(t > 0.0f)) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+
+    return static_cast<std::uint16_t>(t * levels + 0.5f);
+}
+
+/*
+ *  DequantizePositions
+ *
+ *  Description:
+ *      This function will convert an array of quantized vertex components,
+ *      as found in a data buffer, into floating point vertex positions.
+ *      Components are ordered x, y, z for each vertex and are stored in
+ *      network byte order using one octet if bits is 8 or fewer and two
+ *      octets otherwise.
+ *
+ *  Parameters:
+ *      data [in]
+ *          Pointer to the first octet of the quantized components.
+ *
+ *      count [in]
+ *          The number of vertices to dequantize.
+ *
+ *      bits [in]
+ *          The number of bits in each quantized component (1 to 16).
+ *
+ *      min [in]
+ *          The minimum corner of the bounding box used for quantization.
+ *
+ *      max [in]
+ *          The maximum corner of the bounding box used for quantization.
+ *
+ *      vertices [out]
+ *          The array into which count vertices shall be written.
+ *
+ *      bounds_min [in/out]
+ *          The minimum coordinate along each axis of a bounding box to
+ *          extend so that it encloses the vertices, or nullptr if not
+ *          required.
+ *
+ *      bounds_max [in/out]
+ *          The maximum coordinate along each axis of the bounding box, or
+ *          nullptr if not required.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Where SSE2 is available, four vertices (twelve components) are
+ *      converted per iteration.  The twelve components span three vector
+ *      registers with the x/y/z pattern rotating across them, so the scale
+ *      and offset vectors are rotated to match.  Remaining vertices are
+ *      converted using the scalar path, which produces identical results.
+ *      The bounding box is extended from the converted registers in the
+ *      same loop as ExtendBounds() would, rather than in a further pass.
+ */
+void DequantizePositions(const unsigned char *data,
+                         std::size_t count,
+                         unsigned bits,
+                         const Loc1 &min,
+                         const Loc1 &max,
+                         Loc1 *vertices,
+                         Loc1 *bounds_min,
+                         Loc1 *bounds_max)
+{
+    const float levels = static_cast<float>((1u << bits) - 1);
+    const float sx = (max.x - min.x) / levels;
+    const float sy = (max.y - min.y) / levels;
+    const float sz = (max.z - min.z) / levels;
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    const bool bounded = (bounds_min != nullptr) && (bounds_max != nullptr);
+    std::size_t i = 0;
+
+#ifdef GS_MESH_CODING_SSE2
+    Loc1 lower{};
+    Loc1 upper{};
+    if (bounded)
+    {
+        lower = *bounds_min;
+        upper = *bounds_max;
+    }
+    __m128 min0 = _mm_setr_ps(lower.x, lower.y, lower.z, lower.x);
+    __m128 min1 = _mm_setr_ps(lower.y, lower.z, lower.x, lower.y);
+    __m128 min2 = _mm_setr_ps(lower.z, lower.x, lower.y, lower.z);
+    __m128 max0 = _mm_setr_ps(upper.x, upper.y, upper.z, upper.x);
+    __m128 max1 = _mm_setr_ps(upper.y, upper.z, upper.x, upper.y);
+    __m128 max2 = _mm_setr_ps(upper.z, upper.x, upper.y, upper.z);
+    const __m128 scale0 = _mm_setr_ps(sx, sy, sz, sx);
+    const __m128 scale1 = _mm_setr_ps(sy, sz, sx, sy);
+    const __m128 scale2 = _mm_setr_ps(sz, sx, sy, sz);
+    const __m128 offset0 = _mm_setr_ps(min.x, min.y, min.z, min.x);
+    const __m128 offset1 = _mm_setr_ps(min.y, min.z, min.x, min.y);
+    const __m128 offset2 = _mm_setr_ps(min.z, min.x, min.y, min.z);
+    const __m128i zero = _mm_setzero_si128();
+    alignas(16) unsigned char block[32]{};
+    alignas(16) float result[12];
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i lo;
+        __m128i hi;
+
+        // Copy the components for four vertices to avoid over-reading
+        std::memcpy(block, data + i * 3 * width, 12 * width);
+
+        if (width == 2)
+        {
+            // Load 16-bit components and swap from network byte order
+            lo = _mm_load_si128(reinterpret_cast<const __m128i *>(block));
+            hi = _mm_load_si128(reinterpret_cast<const __m128i *>(block + 16));
+            lo = _mm_or_si128(_mm_slli_epi16(lo, 8), _mm_srli_epi16(lo, 8));
+            hi = _mm_or_si128(_mm_slli_epi16(hi, 8), _mm_srli_epi16(hi, 8));
+        }
+        else
+        {
+            // Widen 8-bit components to 16 bits
+            __m128i octets =
+                _mm_load_si128(reinterpret_cast<const __m128i *>(block));
+            lo = _mm_unpacklo_epi8(octets, zero);
+            hi = _mm_unpackhi_epi8(octets, zero);
+        }
+
+        // Widen to 32 bits and convert to floating point
+        __m128 f0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero));
+        __m128 f1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero));
+        __m128 f2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero));
+
+        // Scale and offset each component
+        f0 = _mm_add_ps(_mm_mul_ps(f0, scale0), offset0);
+        f1 = _mm_add_ps(_mm_mul_ps(f1, scale1), offset1);
+        f2 = _mm_add_ps(_mm_mul_ps(f2, scale2), offset2);
+        _mm_store_ps(result, f0);
+        _mm_store_ps(result + 4, f1);
+        _mm_store_ps(result + 8, f2);
+
+        // Extend the bounds, keeping the accumulated value for NaN
+        if (bounded)
+        {
+            min0 = _mm_min_ps(f0, min0);
+            min1 = _mm_min_ps(f1, min1);
+            min2 = _mm_min_ps(f2, min2);
+            max0 = _mm_max_ps(f0, max0);
+            max1 = _mm_max_ps(f1, max1);
+            max2 = _mm_max_ps(f2, max2);
+        }
+
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            vertices[i + j].x = result[j * 3];
+            vertices[i + j].y = result[j * 3 + 1];
+            vertices[i + j].z = result[j * 3 + 2];
+        }
+    }
+
+    if (bounded && (i > 0))
+    {
+        CombineBoundsLanes(min0,
+                           min1,
+                           min2,
+                           max0,
+                           max1,
+                           max2,
+                           *bounds_min,
+                           *bounds_max);
+    }
+#endif
+
+    // Convert the remaining vertices
+    for (; i < count; i++)
+    {
+        const unsigned char *p = data + i * 3 * width;
+        float q[3];
+
+        for (std::size_t j = 0; j < 3; j++)
+        {
+            if (width == 2)
+            {
+                q[j] = static_cast<float>((p[j * 2] << 8) | p[j * 2 + 1]);
+            }
+            else
+            {
+                q[j] = static_cast<float>(p[j]);
+            }
+        }
+
+        vertices[i].x = q[0] * sx + min.x;
+        vertices[i].y = q[1] * sy + min.y;
+        vertices[i].z = q[2] * sz + min.z;
+
+        if (bounded) ExtendBounds(vertices + i, 1, *bounds_min, *bounds_max);
+    }
+}
+
+/*
+ *  DequantizePositions
+ *
+ *  Description:
+ *      This function will convert quantized vertex components held in an
+ *      array back into vertex positions.
+ *
+ *  Parameters:
+ *      quantized [in]
+ *          The quantized components, three per vertex.
+ *
+ *      count [in]
+ *          The number of vertices.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      min [in]
+ *          The minimum corner of the bounding box used for quantization.
+ *
+ *      max [in]
+ *          The maximum corner of the bounding box used for quantization.
+ *
+ *      vertices [out]
+ *          The vertices to populate, which must have room for count
+ *          elements.
+ *
+ *      bounds_min [in/out]
+ *          The minimum coordinate along each axis of a bounding box to
+ *          extend so that it encloses the vertices, or nullptr if not
+ *          required.
+ *
+ *      bounds_max [in/out]
+ *          The maximum coordinate along each axis of the bounding box, or
+ *          nullptr if not required.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Each block of vertices is bounded by ExtendBounds() as soon as it is
+ *      converted, while it is still in cache.
+ */
+void DequantizePositions(const std::uint16_t *quantized,
+                         std::size_t count,
+                         unsigned bits,
+                         const Loc1 &min,
+                         const Loc1 &max,
+                         Loc1 *vertices,
+                         Loc1 *bounds_min,
+                         Loc1 *bounds_max)
+{
+    const float levels = static_cast<float>((1u << bits) - 1);
+    const float sx = (max.x - min.x) / levels;
+    const float sy = (max.y - min.y) / levels;
+    const float sz = (max.z - min.z) / levels;
+    const bool bounded = (bounds_min != nullptr) && (bounds_max != nullptr);
+
+    for (std::size_t block = 0; block < count; block += Visit_Block_Length)
+    {
+        const std::size_t end = std::min(count, block + Visit_Block_Length);
+
+        for (std::size_t i = block; i < end; i++)
+        {
+            const std::uint16_t *q = quantized + i * 3;
+
+            vertices[i].x = static_cast<float>(q[0]) * sx + min.x;
+            vertices[i].y = static_cast<float>(q[1]) * sy + min.y;
+            vertices[i].z = static_cast<float>(q[2]) * sz + min.z;
+        }
+
+        if (bounded)
+        {
+            ExtendBounds(vertices + block,
+                         end - block,
+                         *bounds_min,
+                         *bounds_max);
+        }
+    }
+}
+
+/*
+ *  TraverseVertices
+ *
+ *  Description:
+ *      This function will visit each vertex in the order in which it is
+ *      first referenced by the triangle list, followed by any vertices not
+ *      referenced, and form a prediction of each vertex's quantized
+ *      components from vertices already visited.
+ *
+ *      When a vertex completes a triangle whose other two vertices share an
+ *      edge with an earlier triangle, the prediction is the parallelogram
+ *      formed by that edge and the earlier triangle's opposite vertex.
+ *      Otherwise, it is a vertex already visited in the same triangle or,
+ *      failing that, the previous vertex visited.
+ *
+ *  Parameters:
+ *      triangles [in]
+ *          The triangle index vector, whose indices must all be less than
+ *          the number of vertices.
+ *
+ *      count [in]
+ *          The number of vertices.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      quantized [in]
+ *          The quantized components, three per vertex.  Those of a vertex
+ *          must be valid by the time the visit function returns.
+ *
+ *      visit [in]
+ *          Function called with each vertex index and its prediction.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Only the complete triangles are used if the number of indices is
+ *      not a multiple of three.  Edges are held in a compressed sparse row
+ *      array built from the index list before the traversal: each edge is
+ *      listed once under its lower vertex, in triangle order, alongside the
+ *      position of the corner that begins it.  Looking up an edge scans the
+ *      few edges of one vertex, and the first match that belongs to an
+ *      earlier triangle gives the opposite vertex.  No hashing is involved,
+ *      so vertex indices of any size are handled exactly.
+ */
+template <typename Visit>
+static void TraverseVertices(const std::vector<VarUint> &triangles,
+                             std::size_t count,
+                             unsigned bits,
+                             const std::uint16_t *quantized,
+                             Visit visit)
+{
+    const std::int32_t max_value = static_cast<std::int32_t>((1u << bits) - 1);
+    const std::size_t length = triangles.size() - (triangles.size() % 3);
+    std::vector<unsigned char> visited(count);
+    std::vector<std::size_t> first(count + 1);
+    std::size_t previous = count;
+
+    // An edge listed under its lower vertex
+    struct Edge
+    {
+        std::size_t other;                      // Higher vertex
+        std::size_t corner;                     // Index of the corner
+                                                // beginning the edge
+    };
+
+    // Return the index of a corner's triangle vertex
+    const auto vertex = [&](std::size_t corner) -> std::size_t
+    {
+        return static_cast<std::size_t>(triangles[corner].value);
+    };
+
+    // Return the index of the corner following the given one in its
+    // triangle
+    const auto next = [](std::size_t corner) -> std::size_t
+    {
+        return (corner % 3 == 2) ? corner - 2 : corner + 1;
+    };
+
+    // Count the edges listed under each vertex
+    for (std::size_t c = 0; c < length; c++)
+    {
+        first[std::min(vertex(c), vertex(next(c)))]++;
+    }
+    for (std::size_t v = 1; v < count; v++) first[v] += first[v - 1];
+    if (count) first[count] = first[count - 1];
+
+    // Place the edges in reverse so each vertex's edges are in corner order
+    std::vector<Edge> edges(length);
+    for (std::size_t c = length; c-- > 0;)
+    {
+        const std::size_t a = vertex(c);
+        const std::size_t b = vertex(next(c));
+
+        edges[--first[std::min(a, b)]] = {std::max(a, b), c};
+    }
+
+    // Find the vertex opposite an edge in a triangle before the one
+    // beginning at corner t, returning count if there is none
+    const auto opposite = [&](std::size_t a,
+                              std::size_t b,
+                              std::size_t t) -> std::size_t
+    {
+        const std::size_t low = std::min(a, b);
+        const std::size_t high = std::max(a, b);
+
+        for (std::size_t i = first[low]; i < first[low + 1]; i++)
+        {
+            if (edges[i].other != high) continue;
+            if (edges[i].corner >= t) break;
+            return vertex(next(next(edges[i].corner)));
+        }
+
+        return count;
+    };
+
+    // Predict each component from a vertex already visited
+    const auto copy = [&](std::size_t from, std::int32_t prediction[3])
+    {
+        for (std::size_t j = 0; j < 3; j++)
+        {
+            prediction[j] = (from < count) ? quantized[from * 3 + j] : 0;
+        }
+    };
+
+    for (std::size_t t = 0; t < length; t += 3)
+    {
+        const std::size_t corner[3] =
+        {
+            static_cast<std::size_t>(triangles[t].value),
+            static_cast<std::size_t>(triangles[t + 1].value),
+            static_cast<std::size_t>(triangles[t + 2].value)
+        };
+
+        for (std::size_t k = 0; k < 3; k++)
+        {
+            const std::size_t v = corner[k];
+            const std::size_t u = corner[(k + 1) % 3];
+            const std::size_t w = corner[(k + 2) % 3];
+            std::int32_t prediction[3];
+
+            if (visited[v]) continue;
+
+            if (visited[u] && visited[w])
+            {
+                const std::size_t o = opposite(u, w, t);
+
+                if (o < count)
+                {
+                    for (std::size_t j = 0; j < 3; j++)
+                    {
+                        prediction[j] = std::clamp(
+                            std::int32_t(quantized[u * 3 + j]) +
+                                std::int32_t(quantized[w * 3 + j]) -
+                                std::int32_t(quantized[o * 3 + j]),
+                            std::int32_t(0),
+                            max_value);
+                    }
+                }
+                else
+                {
+                    copy(w, prediction);
+                }
+            }
+            else if (visited[u])
+            {
+                copy(u, prediction);
+            }
+            else if (visited[w])
+            {
+                copy(w, prediction);
+            }
+            else
+            {
+                copy(previous, prediction);
+            }
+
+            visit(v, prediction);
+            visited[v] = 1;
+            previous = v;
+        }
+    }
+
+    // Visit vertices not referenced by any triangle
+    for (std::size_t v = 0; v < count; v++)
+    {
+        std::int32_t prediction[3];
+
+        if (visited[v]) continue;
+
+        copy(previous, prediction);
+        visit(v, prediction);
+        previous = v;
+    }
+}
+
+/*
+ *  PredictPositions
+ *
+ *  Description:
+ *      This function will compute the difference between each quantized
+ *      vertex component and its parallelogram prediction.
+ *
+ *  Parameters:
+ *      triangles [in]
+ *          The triangle index vector, whose indices must all be less than
+ *          the number of vertices.
+ *
+ *      count [in]
+ *          The number of vertices.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      quantized [in]
+ *          The quantized components, three per vertex.
+ *
+ *      residuals [out]
+ *          The residuals, three per vertex, in the order in which the
+ *          vertices are reached by traversing the triangles.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void PredictPositions(const std::vector<VarUint> &triangles,
+                      std::size_t count,
+                      unsigned bits,
+                      const std::uint16_t *quantized,
+                      std::int32_t *residuals)
+{
+    TraverseVertices(triangles,
+                     count,
+                     bits,
+                     quantized,
+                     [&](std::size_t v, const std::int32_t prediction[3])
+                     {
+                         for (std::size_t j = 0; j < 3; j++)
+                         {
+                             *residuals++ = std::int32_t(quantized[v * 3 + j]) -
+                                            prediction[j];
+                         }
+                     });
+}
+
+/*
+ *  ReconstructPositions
+ *
+ *  Description:
+ *      This function will reconstruct quantized vertex components from the
+ *      residuals produced by PredictPositions().
+ *
+ *  Parameters:
+ *      triangles [in]
+ *          The triangle index vector, whose indices must all be less than
+ *          the number of vertices.
+ *
+ *      count [in]
+ *          The number of vertices.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *      residuals [in]
+ *          The residuals, three per vertex.
+ *
+ *      quantized [out]
+ *          The quantized components, three per vertex.
+ *
+ *  Returns:
+ *      True if successful or false if a reconstructed component is outside
+ *      the range of the given number of bits, which indicates the residuals
+ *      are corrupt.
+ *
+ *  Comments:
+ *      None.
+ */
+bool ReconstructPositions(const std::vector<VarUint> &triangles,
+                          std::size_t count,
+                          unsigned bits,
+                          const std::int32_t *residuals,
+                          std::uint16_t *quantized)
+{
+    const std::int64_t max_value = (std::int64_t(1) << bits) - 1;
+    bool valid = true;
+
+    TraverseVertices(triangles,
+                     count,
+                     bits,
+                     quantized,
+                     [&](std::size_t v, const std::int32_t prediction[3])
+                     {
+                         for (std::size_t j = 0; j < 3; j++)
+                         {
+                             const std::int64_t value =
+                                 std::int64_t(prediction[j]) + *residuals++;
+
+                             if ((value < 0) || (value > max_value))
+                             {
+                                 valid = false;
+                             }
+                             quantized[v * 3 + j] =
+                                 static_cast<std::uint16_t>(value);
+                         }
+                     });
+
+    return valid;
+}
+
+/*
+ *  OctahedralEncode
+ *
+ *  Description:
+ *      This function will map a normal vector onto the octahedron and then
+ *      unfold it onto the square [-1, 1] x [-1, 1], quantizing the resulting
+ *      coordinates to the specified number of bits.
+ *
+ *  Parameters:
+ *      x, y, z [in]
+ *          The components of the normal vector.
+ *
+ *      bits [in]
+ *          The number of bits in each quantized coordinate (1 to 16).
+ *
+ *      u, v [out]
+ *          The quantized octahedral coordinates.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The sequence of operations mirrors the vectorized code in
+ *      EncodeOctahedral() so that both produce identical results.  NaN
+ *      components are treated as zero, and a zero vector is mapped to the
+ *      center of the square.  The comparisons are written so that any NaN
+ *      arising from infinite components selects the same operand as the
+ *      corresponding SSE2 instruction.
+ */
+static void OctahedralEncode(float x,
+                             float y,
+                             float z,
+                             unsigned bits,
+                             std::uint16_t &u,
+                             std::uint16_t &v)
+{
+    const float levels = static_cast<float>((1u << bits) - 1);
+
+    // Treat NaN components as zero
+    if (std::isnan(x)) x = 0.0f;
+    if (std::isnan(y)) y = 0.0f;
+    if (std::isnan(z)) z = 0.0f;
+
+    // Project onto the octahedron (a NaN sum selects the minimum, as does
+    // _mm_max_ps)
+    float l1 = std::fabs(x) + std::fabs(y) + std::fabs(z);
+    l1 = (l1 > std::numeric_limits<float>::min()) ?
+             l1 :
+             std::numeric_limits<float>::min();
+    float px = x / l1;
+    float py = y / l1;
+
+    // Fold the lower hemisphere over the upper one
+    if (z < 0.0f)
+    {
+        const float fx = (1.0f - std::fabs(py)) * std::copysign(1.0f, px);
+        const float fy = (1.0f - std::fabs(px)) * std::copysign(1.0f, py);
+        px = fx;
+        py = fy;
+    }
+
+    // Quantize the coordinates
+    float qu = (px * 0.5f + 0.5f) * levels + 0.5f;
+    float qv = (py * 0.5f + 0.5f) * levels + 0.5f;
+    qu = (qu > 0.0f) ? qu : 0.0f;
+    qv = (qv > 0.0f) ? qv : 0.0f;
+    qu = (qu < levels) ? qu : levels;
+    qv = (qv < levels) ? qv : levels;
+
+    u = static_cast<std::uint16_t>(qu);
+    v = static_cast<std::uint16_t>(qv);
+}
+
+/*
+ *  OctahedralDecode
+ *
+ *  Description:
+ *      This function will convert quantized octahedral coordinates back into
+ *      a unit normal vector.
+ *
+ *  Parameters:
+ *      u, v [in]
+ *          The quantized octahedral coordinates.
+ *
+ *      bits [in]
+ *          The number of bits in each quantized coordinate (1 to 16).
+ *
+ *      normal [out]
+ *          The decoded unit normal vector.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The sequence of operations mirrors the vectorized code in
+ *      DecodeOctahedral() so that both produce identical results.
+ */
+static void OctahedralDecode(std::uint16_t u,
+                             std::uint16_t v,
+                             unsigned bits,
+                             Norm1 &normal)
+{
+    const float step = 2.0f / static_cast<float>((1u << bits) - 1);
+    float x = static_cast<float>(u) * step - 1.0f;
+    float y = static_cast<float>(v) * step - 1.0f;
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+
+    // Unfold the lower hemisphere
+    const float t = ((0.0f - z) > 0.0f) ? (0.0f - z) : 0.0f;
+    x += (x >= 0.0f) ? (0.0f - t) : t;
+    y += (y >= 0.0f) ? (0.0f - t) : t;
+
+    // Normalize the vector
+    const float length = std::sqrt(x * x + y * y + z * z);
+
+    normal.x.value = x / length;
+    normal.y.value = y / length;
+    normal.z.value = z / length;
+}
+
+/*
+ *  EncodeOctahedral
+ *
+ *  Description:
+ *      This function will encode an array of normal vectors as pairs of
+ *      quantized octahedral coordinates.  Coordinates are written in
+ *      network byte order using one octet if bits is 8 or fewer and two
+ *      octets otherwise, so each normal occupies two or four octets.
+ *
+ *  Parameters:
+ *      normals [in]
+ *          The normal vectors to encode.  These need not be unit length.
+ *
+ *      count [in]
+ *          The number of normal vectors to encode.
+ *
+ *      bits [in]
+ *          The number of bits in each quantized coordinate (1 to 16).
+ *
+ *      data [out]
+ *          Pointer to the buffer into which the coordinates shall be
+ *          written.  It must have room for count * 2 coordinates.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Where SSE2 is available, four normals are encoded per iteration
+ *      using masks in place of the branches in OctahedralEncode().
+ */
+void EncodeOctahedral(const Norm1 *normals,
+                      std::size_t count,
+                      unsigned bits,
+                      unsigned char *data)
+{
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    std::uint16_t u[4];
+    std::uint16_t v[4];
+    std::size_t i = 0;
+
+#ifdef GS_MESH_CODING_SSE2
+    const float levels = static_cast<float>((1u << bits) - 1);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 max_level = _mm_set1_ps(levels);
+    const __m128 min_l1 = _mm_set1_ps(std::numeric_limits<float>::min());
+    alignas(16) std::int32_t qu[4];
+    alignas(16) std::int32_t qv[4];
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const Norm1 *n = normals + i;
+        __m128 x = _mm_setr_ps(n[0].x.value, n[1].x.value,
+                               n[2].x.value, n[3].x.value);
+        __m128 y = _mm_setr_ps(n[0].y.value, n[1].y.value,
+                               n[2].y.value, n[3].y.value);
+        __m128 z = _mm_setr_ps(n[0].z.value, n[1].z.value,
+                               n[2].z.value, n[3].z.value);
+
+        // Treat NaN components as zero
+        x = _mm_and_ps(x, _mm_cmpord_ps(x, x));
+        y = _mm_and_ps(y, _mm_cmpord_ps(y, y));
+        z = _mm_and_ps(z, _mm_cmpord_ps(z, z));
+
+        // Project onto the octahedron
+        __m128 l1 = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign_mask, x),
+                                          _mm_andnot_ps(sign_mask, y)),
+                               _mm_andnot_ps(sign_mask, z));
+        l1 = _mm_max_ps(l1, min_l1);
+        __m128 px = _mm_div_ps(x, l1);
+        __m128 py = _mm_div_ps(y, l1);
+
+        // Fold the lower hemisphere over the upper one
+        const __m128 lower = _mm_cmplt_ps(z, zero);
+        const __m128 fx = _mm_mul_ps(
+            _mm_sub_ps(one, _mm_andnot_ps(sign_mask, py)),
+            _mm_or_ps(one, _mm_and_ps(sign_mask, px)));
+        const __m128 fy = _mm_mul_ps(
+            _mm_sub_ps(one, _mm_andnot_ps(sign_mask, px)),
+            _mm_or_ps(one, _mm_and_ps(sign_mask, py)));
+        px = _mm_or_ps(_mm_and_ps(lower, fx), _mm_andnot_ps(lower, px));
+        py = _mm_or_ps(_mm_and_ps(lower, fy), _mm_andnot_ps(lower, py));
+
+        // Quantize the coordinates
+        __m128 fu = _mm_add_ps(
+            _mm_mul_ps(_mm_add_ps(_mm_mul_ps(px, half), half), max_level),
+            half);
+        __m128 fv = _mm_add_ps(
+            _mm_mul_ps(_mm_add_ps(_mm_mul_ps(py, half), half), max_level),
+            half);
+        fu = _mm_min_ps(_mm_max_ps(fu, zero), max_level);
+        fv = _mm_min_ps(_mm_max_ps(fv, zero), max_level);
+        _mm_store_si128(reinterpret_cast<__m128i *>(qu), _mm_cvttps_epi32(fu));
+        _mm_store_si128(reinterpret_cast<__m128i *>(qv), _mm_cvttps_epi32(fv));
+
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            u[j] = static_cast<std::uint16_t>(qu[j]);
+            v[j] = static_cast<std::uint16_t>(qv[j]);
+        }
+
+        // Write the coordinates in network byte order
+        unsigned char *p = data + i * 2 * width;
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            if (width == 2)
+            {
+                *p++ = static_cast<unsigned char>(u[j] >> 8);
+                *p++ = static_cast<unsigned char>(u[j] & 0xff);
+                *p++ = static_cast<unsigned char>(v[j] >> 8);
+                *p++ = static_cast<unsigned char>(v[j] & 0xff);
+            }
+            else
+            {
+                *p++ = static_cast<unsigned char>(u[j]);
+                *p++ = static_cast<unsigned char>(v[j]);
+            }
+        }
+    }
+#endif
+
+    // Encode the remaining normals
+    for (; i < count; i++)
+    {
+        unsigned char *p = data + i * 2 * width;
+
+        OctahedralEncode(normals[i].x.value,
+                         normals[i].y.value,
+                         normals[i].z.value,
+                         bits,
+                         u[0],
+                         v[0]);
+
+        if (width == 2)
+        {
+            *p++ = static_cast<unsigned char>(u[0] >> 8);
+            *p++ = static_cast<unsigned char>(u[0] & 0xff);
+            *p++ = static_cast<unsigned char>(v[0] >> 8);
+            *p = static_cast<unsigned char>(v[0] & 0xff);
+        }
+        else
+        {
+            *p++ = static_cast<unsigned char>(u[0]);
+            *p = static_cast<unsigned char>(v[0]);
+        }
+    }
+}
+
+/*
+ *  DecodeOctahedral
+ *
+ *  Description:
+ *      This function will decode an array of quantized octahedral
+ *      coordinates, as produced by EncodeOctahedral(), into unit normals.
+ *
+ *  Parameters:
+ *      data [in]
+ *          Pointer to the first octet of the quantized coordinates.
+ *
+ *      count [in]
+ *          The number of normals to decode.
+ *
+ *      bits [in]
+ *          The number of bits in each quantized coordinate (1 to 16).
+ *
+ *      normals [out]
+ *          The array into which count normals shall be written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Where SSE2 is available, four normals are decoded per iteration.
+ */
+void DecodeOctahedral(const unsigned char *data,
+                      std::size_t count,
+                      unsigned bits,
+                      Norm1 *normals)
+{
+    const std::size_t width = (bits > 8) ? 2 : 1;
+    std::size_t i = 0;
+
+#ifdef GS_MESH_CODING_SSE2
+    const float step = 2.0f / static_cast<float>((1u << bits) - 1);
+    const __m128 sign_mask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 scale = _mm_set1_ps(step);
+    alignas(16) std::int32_t qu[4];
+    alignas(16) std::int32_t qv[4];
+    alignas(16) float nx[4];
+    alignas(16) float ny[4];
+    alignas(16) float nz[4];
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const unsigned char *p = data + i * 2 * width;
+
+        // Read the coordinates from network byte order
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            if (width == 2)
+            {
+                qu[j] = (p[0] << 8) | p[1];
+                qv[j] = (p[2] << 8) | p[3];
+                p += 4;
+            }
+            else
+            {
+                qu[j] = p[0];
+                qv[j] = p[1];
+                p += 2;
+            }
+        }
+
+        __m128 x = _mm_sub_ps(
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_load_si128(
+                           reinterpret_cast<const __m128i *>(qu))),
+                       scale),
+            one);
+        __m128 y = _mm_sub_ps(
+            _mm_mul_ps(_mm_cvtepi32_ps(_mm_load_si128(
+                           reinterpret_cast<const __m128i *>(qv))),
+                       scale),
+            one);
+        const __m128 z = _mm_sub_ps(_mm_sub_ps(one,
+                                               _mm_andnot_ps(sign_mask, x)),
+                                    _mm_andnot_ps(sign_mask, y));
+
+        // Unfold the lower hemisphere, moving x and y toward zero by t
+        const __m128 t = _mm_max_ps(_mm_sub_ps(zero, z), zero);
+        const __m128 x_positive = _mm_cmpge_ps(x, zero);
+        const __m128 y_positive = _mm_cmpge_ps(y, zero);
+        x = _mm_add_ps(x, _mm_or_ps(_mm_and_ps(x_positive,
+                                               _mm_sub_ps(zero, t)),
+                                    _mm_andnot_ps(x_positive, t)));
+        y = _mm_add_ps(y, _mm_or_ps(_mm_and_ps(y_positive,
+                                               _mm_sub_ps(zero, t)),
+                                    _mm_andnot_ps(y_positive, t)));
+
+        // Normalize the vectors
+        const __m128 length = _mm_sqrt_ps(
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)),
+                       _mm_mul_ps(z, z)));
+        _mm_store_ps(nx, _mm_div_ps(x, length));
+        _mm_store_ps(ny, _mm_div_ps(y, length));
+        _mm_store_ps(nz, _mm_div_ps(z, length));
+
+        for (std::size_t j = 0; j < 4; j++)
+        {
+            normals[i + j].x.value = nx[j];
+            normals[i + j].y.value = ny[j];
+            normals[i + j].z.value = nz[j];
+        }
+    }
+#endif
+
+    // Decode the remaining normals
+    for (; i < count; i++)
+    {
+        const unsigned char *p = data + i * 2 * width;
+
+        if (width == 2)
+        {
+            OctahedralDecode(static_cast<std::uint16_t>((p[0] << 8) | p[1]),
+                             static_cast<std::uint16_t>((p[2] << 8) | p[3]),
+                             bits,
+                             normals[i]);
+        }
+        else
+        {
+            OctahedralDecode(p[0], p[1], bits, normals[i]);
+        }
+    }
+}
+
+} // namespace gs
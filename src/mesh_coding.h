@@ -0,0 +1,140 @@
+/*
+ *  mesh_coding.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines utility functions used by the Game State Encoder
+ *      and Decoder when producing or consuming the compact mesh encoding.
+ *      These functions operate on the machine representation of a Mesh1 and
+ *      do not read from or write to a DataBuffer.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef MESH_CODING_H
+#define MESH_CODING_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// Function to reorder triangles so that nearby indices are encoded together
+void ReorderTriangles(std::vector<VarUint> &triangles);
+
+// Function to remove duplicate vertices and remap the triangle indices
+std::size_t WeldVertices(std::vector<Loc1> &vertices,
+                         std::vector<Norm1> &normals,
+                         std::vector<TextureUV1> &textures,
+                         std::vector<VarUint> &triangles);
+
+// Function to compute the axis-aligned bounding box of a set of vertices
+void ComputeBounds(const std::vector<Loc1> &vertices, Loc1 &min, Loc1 &max);
+
+// Function to initialize an axis-aligned bounding box enclosing nothing
+void ClearBounds(Loc1 &min, Loc1 &max);
+
+// Function to set axes of a bounding box enclosing nothing to the origin
+void FinishBounds(Loc1 &min, Loc1 &max);
+
+// Function to extend an axis-aligned bounding box to enclose vertices
+void ExtendBounds(const Loc1 *vertices,
+                  std::size_t count,
+                  Loc1 &min,
+                  Loc1 &max);
+
+// Function to quantize a vertex component within the given range
+std::uint16_t QuantizeComponent(float value,
+                                float min,
+                                float max,
+                                unsigned bits);
+
+// Function to dequantize a packed array of quantized vertex components,
+// extending a bounding box to enclose them if given
+void DequantizePositions(const unsigned char *data,
+                         std::size_t count,
+                         unsigned bits,
+                         const Loc1 &min,
+                         const Loc1 &max,
+                         Loc1 *vertices,
+                         Loc1 *bounds_min = nullptr,
+                         Loc1 *bounds_max = nullptr);
+
+// Function to dequantize an array of quantized vertex components,
+// extending a bounding box to enclose them if given
+void DequantizePositions(const std::uint16_t *quantized,
+                         std::size_t count,
+                         unsigned bits,
+                         const Loc1 &min,
+                         const Loc1 &max,
+                         Loc1 *vertices,
+                         Loc1 *bounds_min = nullptr,
+                         Loc1 *bounds_max = nullptr);
+
+// Function to compute parallelogram prediction residuals for quantized
+// vertex components, in the order the vertices are reached
+void PredictPositions(const std::vector<VarUint> &triangles,
+                      std::size_t count,
+                      unsigned bits,
+                      const std::uint16_t *quantized,
+                      std::int32_t *residuals);
+
+// Function to reconstruct quantized vertex components from parallelogram
+// prediction residuals
+bool ReconstructPositions(const std::vector<VarUint> &triangles,
+                          std::size_t count,
+                          unsigned bits,
+                          const std::int32_t *residuals,
+                          std::uint16_t *quantized);
+
+// Function to encode unit normals as packed octahedral coordinates
+void EncodeOctahedral(const Norm1 *normals,
+                      std::size_t count,
+                      unsigned bits,
+                      unsigned char *data);
+
+// Function to decode packed octahedral coordinates into unit normals
+void DecodeOctahedral(const unsigned char *data,
+                      std::size_t count,
+                      unsigned bits,
+                      Norm1 *normals);
+
+} // namespace gs
+
+#endif // MESH_CODING_H
@@ -0,0 +1,254 @@
+/*
+ *  object_access.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements utility functions that return fields common to
+ *      several object types, such as the object ID and position, from a
+ *      GSObject variant, and that compare fields within a tolerance.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <variant>
+#include "object_access.h"
+
+namespace gs
+{
+
+/*
+ *  GetObjectID
+ *
+ *  Description:
+ *      This function will return the ID of the given object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose ID is to be returned.
+ *
+ *  Returns:
+ *      The object's ID or no value if the object type has no object ID.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<std::uint64_t> GetObjectID(const GSObject &value)
+{
+    if (std::holds_alternative<Object1>(value))
+    {
+        return std::get<Object1>(value).id.value;
+    }
+    if (std::holds_alternative<Head1>(value))
+    {
+        return std::get<Head1>(value).id.value;
+    }
+    if (std::holds_alternative<Hand1>(value))
+    {
+        return std::get<Hand1>(value).id.value;
+    }
+    if (std::holds_alternative<Hand2>(value))
+    {
+        return std::get<Hand2>(value).id.value;
+    }
+    if (std::holds_alternative<Mesh1>(value))
+    {
+        return std::get<Mesh1>(value).id.value;
+    }
+
+    return {};
+}
+
+/*
+ *  GetObjectTime
+ *
+ *  Description:
+ *      This function will return the time of the given object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose time is to be returned.
+ *
+ *  Returns:
+ *      The object's time or no value if the object type has no time.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<Time1> GetObjectTime(const GSObject &value)
+{
+    if (std::holds_alternative<Object1>(value))
+    {
+        return std::get<Object1>(value).time;
+    }
+    if (std::holds_alternative<Head1>(value))
+    {
+        return std::get<Head1>(value).time;
+    }
+    if (std::holds_alternative<Hand1>(value))
+    {
+        return std::get<Hand1>(value).time;
+    }
+    if (std::holds_alternative<Hand2>(value))
+    {
+        return std::get<Hand2>(value).time;
+    }
+
+    return {};
+}
+
+/*
+ *  GetObjectPosition
+ *
+ *  Description:
+ *      This function will return the position of the given object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose position is to be returned.
+ *
+ *  Returns:
+ *      The object's position or no value if the object type has no
+ *      position.
+ *
+ *  Comments:
+ *      The velocity held in the location of heads and hands is not returned.
+ */
+std::optional<Loc1> GetObjectPosition(const GSObject &value)
+{
+    const Loc2 *location = nullptr;
+
+    if (std::holds_alternative<Object1>(value))
+    {
+        return std::get<Object1>(value).position;
+    }
+    if (std::holds_alternative<Head1>(value))
+    {
+        location = &std::get<Head1>(value).location;
+    }
+    if (std::holds_alternative<Hand1>(value))
+    {
+        location = &std::get<Hand1>(value).location;
+    }
+    if (std::holds_alternative<Hand2>(value))
+    {
+        location = &std::get<Hand2>(value).location;
+    }
+
+    if (location == nullptr) return {};
+
+    return Loc1{location->x, location->y, location->z};
+}
+
+/*
+ *  Near
+ *
+ *  Description:
+ *      These functions will determine whether each floating point value
+ *      within a pair of values differs by no more than the given tolerance.
+ *
+ *  Parameters:
+ *      a [in]
+ *          The first value to compare.
+ *
+ *      b [in]
+ *          The second value to compare.
+ *
+ *      epsilon [in]
+ *          The largest difference permitted.
+ *
+ *  Returns:
+ *      True if the values are within the tolerance, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool Near(float a, float b, float epsilon)
+{
+    return std::fabs(a - b) <= epsilon;
+}
+
+bool Near(const Float16 &a, const Float16 &b, float epsilon)
+{
+    return Near(a.value, b.value, epsilon);
+}
+
+bool Near(const Loc1 &a, const Loc1 &b, float epsilon)
+{
+    return Near(a.x, b.x, epsilon) && Near(a.y, b.y, epsilon) &&
+           Near(a.z, b.z, epsilon);
+}
+
+bool Near(const Loc2 &a, const Loc2 &b, float epsilon)
+{
+    return Near(a.x, b.x, epsilon) && Near(a.y, b.y, epsilon) &&
+           Near(a.z, b.z, epsilon) && Near(a.vx, b.vx, epsilon) &&
+           Near(a.vy, b.vy, epsilon) && Near(a.vz, b.vz, epsilon);
+}
+
+bool Near(const Rot1 &a, const Rot1 &b, float epsilon)
+{
+    return Near(a.i, b.i, epsilon) && Near(a.j, b.j, epsilon) &&
+           Near(a.k, b.k, epsilon);
+}
+
+bool Near(const Rot2 &a, const Rot2 &b, float epsilon)
+{
+    return Near(a.si, b.si, epsilon) && Near(a.sj, b.sj, epsilon) &&
+           Near(a.sk, b.sk, epsilon) && Near(a.ei, b.ei, epsilon) &&
+           Near(a.ej, b.ej, epsilon) && Near(a.ek, b.ek, epsilon);
+}
+
+bool Near(const Transform1 &a, const Transform1 &b, float epsilon)
+{
+    return Near(a.tx, b.tx, epsilon) && Near(a.ty, b.ty, epsilon) &&
+           Near(a.tz, b.tz, epsilon);
+}
+
+bool Near(const Thumb &a, const Thumb &b, float epsilon)
+{
+    return Near(a.tip, b.tip, epsilon) && Near(a.ip, b.ip, epsilon) &&
+           Near(a.mcp, b.mcp, epsilon) && Near(a.cmc, b.cmc, epsilon);
+}
+
+bool Near(const Finger &a, const Finger &b, float epsilon)
+{
+    return Near(a.tip, b.tip, epsilon) && Near(a.dip, b.dip, epsilon) &&
+           Near(a.pip, b.pip, epsilon) && Near(a.mcp, b.mcp, epsilon) &&
+           Near(a.cmc, b.cmc, epsilon);
+}
+
+} // namespace gs
@@ -0,0 +1,78 @@
+/*
+ *  object_access.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines utility functions that return fields common to
+ *      several object types, such as the object ID and position, from a
+ *      GSObject variant, and that compare fields within a tolerance.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OBJECT_ACCESS_H
+#define OBJECT_ACCESS_H
+
+#include <cstdint>
+#include <optional>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// Function to return the ID of an object, if it has one
+std::optional<std::uint64_t> GetObjectID(const GSObject &value);
+
+// Function to return the time of an object, if it has one
+std::optional<Time1> GetObjectTime(const GSObject &value);
+
+// Function to return the position of an object, if it has one
+std::optional<Loc1> GetObjectPosition(const GSObject &value);
+
+// Functions to determine whether values differ by no more than epsilon
+bool Near(float a, float b, float epsilon);
+bool Near(const Float16 &a, const Float16 &b, float epsilon);
+bool Near(const Loc1 &a, const Loc1 &b, float epsilon);
+bool Near(const Loc2 &a, const Loc2 &b, float epsilon);
+bool Near(const Rot1 &a, const Rot1 &b, float epsilon);
+bool Near(const Rot2 &a, const Rot2 &b, float epsilon);
+bool Near(const Transform1 &a, const Transform1 &b, float epsilon);
+bool Near(const Thumb &a, const Thumb &b, float epsilon);
+bool Near(const Finger &a, const Finger &b, float epsilon);
+
+} // namespace gs
+
+#endif // OBJECT_ACCESS_H
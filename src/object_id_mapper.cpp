@@ -0,0 +1,301 @@
+/*
+ *  object_id_mapper.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the ObjectIDMapper object, which assigns dense
+ *      indices to object IDs on first sight so that receivers may keep object
+ *      state in arrays rather than hash maps.  Released indices are reused
+ *      with an incremented generation counter.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include "object_id_mapper.h"
+#include "object_access.h"
+#include "gs_decoder.h"
+
+namespace gs
+{
+
+/*
+ *  ObjectIDMapper::ObjectIDMapper
+ *
+ *  Description:
+ *      Constructor for the ObjectIDMapper object.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The number of objects to size the mapper for initially.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+ObjectIDMapper::ObjectIDMapper(std::size_t capacity) : table{capacity}
+{
+    generations.reserve(capacity);
+}
+
+/*
+ *  ObjectIDMapper::Map
+ *
+ *  Description:
+ *      This function will return the handle for the given object, assigning
+ *      a dense index if the object has not been seen before.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The handle for the object.
+ *
+ *  Comments:
+ *      A DecoderException is thrown if the number of objects mapped at once
+ *      would exceed the range of a 32-bit index, in which case the object is
+ *      not added.
+ */
+ObjectHandle ObjectIDMapper::Map(std::uint64_t id)
+{
+    // Ensure an index is available before adding an object; indices are
+    // reused while any are free, so a new one is needed only when all
+    // assigned indices are in use
+    if ((table.GetCount() >= ObjectHandle::Invalid_Index) &&
+        (table.Find(id) == ObjectTable::Not_Found))
+    {
+        throw DecoderException("Too many objects to map");
+    }
+
+    // Extend the generations first so nothing can fail after the insertion
+    if (generations.size() <= table.GetIndexLimit())
+    {
+        generations.resize(table.GetIndexLimit() + 1);
+    }
+
+    return MakeHandle(table.Insert(id));
+}
+
+/*
+ *  ObjectIDMapper::Map
+ *
+ *  Description:
+ *      This function will return the handle for each of the given objects,
+ *      assigning dense indices to those not seen before.
+ *
+ *  Parameters:
+ *      objects [in]
+ *          The objects to map, such as those decoded from a single frame.
+ *
+ *      handles [out]
+ *          The handle for each object, such that handles[i] corresponds to
+ *          objects[i].  Objects having no object ID are given an invalid
+ *          handle.
+ *
+ *      first [in]
+ *          The position of the first object to map.  Handles for earlier
+ *          objects are left unchanged.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Objects already mapped are located with a single batched lookup, so
+ *      only objects seen for the first time are inserted individually.
+ */
+void ObjectIDMapper::Map(const GSObjects &objects,
+                         std::vector<ObjectHandle> &handles,
+                         std::size_t first)
+{
+    std::vector<std::uint64_t> ids;
+    std::vector<std::size_t> positions;
+    std::vector<std::size_t> indices;
+
+    first = std::min(first, objects.size());
+    handles.resize(objects.size());
+
+    // Gather the IDs of the objects to map
+    for (std::size_t i = first; i < objects.size(); i++)
+    {
+        const std::optional<std::uint64_t> id = GetObjectID(objects[i]);
+
+        handles[i] = ObjectHandle{};
+        if (!id) continue;
+
+        ids.push_back(*id);
+        positions.push_back(i);
+    }
+
+    table.Find(ids, indices);
+
+    for (std::size_t i = 0; i < ids.size(); i++)
+    {
+        handles[positions[i]] = (indices[i] != ObjectTable::Not_Found) ?
+                                    MakeHandle(indices[i]) :
+                                    Map(ids[i]);
+    }
+}
+
+/*
+ *  ObjectIDMapper::Find
+ *
+ *  Description:
+ *      This function will return the handle for the given object without
+ *      assigning one.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The handle for the object or no value if the object is not mapped.
+ *
+ *  Comments:
+ *      None.
+ */
+std::optional<ObjectHandle> ObjectIDMapper::Find(std::uint64_t id) const
+{
+    const std::size_t index = table.Find(id);
+
+    if (index == ObjectTable::Not_Found) return {};
+
+    return MakeHandle(index);
+}
+
+/*
+ *  ObjectIDMapper::Release
+ *
+ *  Description:
+ *      This function will release the index assigned to the given object so
+ *      that it may be assigned to another object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      True if the object was released, false if it was not mapped.
+ *
+ *  Comments:
+ *      The generation of the index is incremented, so handles issued for the
+ *      released object are no longer current.
+ */
+bool ObjectIDMapper::Release(std::uint64_t id)
+{
+    const std::size_t index = table.Find(id);
+
+    if (index == ObjectTable::Not_Found) return false;
+
+    generations[index]++;
+
+    return table.Remove(id);
+}
+
+/*
+ *  ObjectIDMapper::IsCurrent
+ *
+ *  Description:
+ *      This function will determine whether the given handle still refers to
+ *      the object for which it was issued.
+ *
+ *  Parameters:
+ *      handle [in]
+ *          The handle to check.
+ *
+ *  Returns:
+ *      True if the handle is current, false if it is invalid or its object
+ *      has been released.
+ *
+ *  Comments:
+ *      None.
+ */
+bool ObjectIDMapper::IsCurrent(const ObjectHandle &handle) const
+{
+    return table.IsValid(handle.index) &&
+           (generations[handle.index] == handle.generation);
+}
+
+/*
+ *  ObjectIDMapper::Clear
+ *
+ *  Description:
+ *      This function will release all objects.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Generations are retained, so handles issued before clearing are not
+ *      mistaken for handles to objects mapped afterward.
+ */
+void ObjectIDMapper::Clear()
+{
+    for (std::size_t index = 0; index < table.GetIndexLimit(); index++)
+    {
+        if (table.IsValid(index)) generations[index]++;
+    }
+
+    table.Clear();
+}
+
+/*
+ *  ObjectIDMapper::MakeHandle
+ *
+ *  Description:
+ *      This function will return the handle for the given index.
+ *
+ *  Parameters:
+ *      index [in]
+ *          The index assigned to an object.
+ *
+ *  Returns:
+ *      The handle for the index.
+ *
+ *  Comments:
+ *      Map() ensures the index fits in 32 bits and has a generation.
+ */
+ObjectHandle ObjectIDMapper::MakeHandle(std::size_t index) const
+{
+    return ObjectHandle{static_cast<std::uint32_t>(index), generations[index]};
+}
+
+} // namespace gs
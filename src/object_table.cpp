@@ -0,0 +1,476 @@
+/*
+ *  object_table.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the ObjectTable object, an open-addressing hash
+ *      table using linear probing that maps object IDs to stable, densely
+ *      assigned indices.  Removal shifts later entries in a probe sequence
+ *      backward rather than leaving tombstones, so lookups never degrade as
+ *      objects come and go.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include "object_table.h"
+#include "object_access.h"
+
+namespace gs
+{
+
+namespace
+{
+
+// Number of lookups whose slots are fetched together in a batch
+constexpr std::size_t Batch_Size = 16;
+
+// Smallest number of hash table slots
+constexpr std::size_t Min_Slots = 16;
+
+/*
+ *  Prefetch
+ *
+ *  Description:
+ *      This function will hint that the given memory will soon be read.
+ *
+ *  Parameters:
+ *      address [in]
+ *          The address to be read.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      This has no effect on compilers without a prefetch intrinsic.
+ */
+inline void Prefetch([[maybe_unused]] const void *address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#endif
+}
+
+} // namespace
+
+/*
+ *  ObjectTable::ObjectTable
+ *
+ *  Description:
+ *      Constructor for the ObjectTable object.
+ *
+ *  Parameters:
+ *      capacity [in]
+ *          The number of objects to size the table for initially.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The table grows as needed, so the capacity only serves to avoid
+ *      rehashing as objects are added.
+ */
+ObjectTable::ObjectTable(std::size_t capacity) : mask{}, count{}
+{
+    std::size_t slot_count = Min_Slots;
+
+    // Keep the load factor at or below 3/4
+    while (slot_count / 4 * 3 < capacity) slot_count *= 2;
+
+    Resize(slot_count);
+    ids.reserve(capacity);
+    assigned.reserve(capacity);
+}
+
+/*
+ *  ObjectTable::Insert
+ *
+ *  Description:
+ *      This function will return the index assigned to the given object,
+ *      assigning an index if the object is not already in the table.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The index assigned to the object.
+ *
+ *  Comments:
+ *      Indices released by Remove() are reused before new indices are
+ *      assigned, so indices remain less than the peak number of objects.
+ */
+std::size_t ObjectTable::Insert(std::uint64_t id)
+{
+    std::size_t slot = GetHome(id);
+
+    // Look for the object or the first empty slot in its probe sequence
+    while (slots[slot].index != Not_Found)
+    {
+        if (slots[slot].id == id) return slots[slot].index;
+        slot = (slot + 1) & mask;
+    }
+
+    // Grow the table if adding this object would exceed the load factor
+    if ((count + 1) > (slots.size() / 4 * 3))
+    {
+        Resize(slots.size() * 2);
+        slot = GetHome(id);
+        while (slots[slot].index != Not_Found) slot = (slot + 1) & mask;
+    }
+
+    // Assign an index to the object
+    std::size_t index;
+    if (!free_indices.empty())
+    {
+        index = free_indices.back();
+        free_indices.pop_back();
+        ids[index] = id;
+        assigned[index] = 1;
+    }
+    else
+    {
+        index = ids.size();
+        ids.push_back(id);
+        assigned.push_back(1);
+    }
+
+    slots[slot] = {id, index};
+    count++;
+
+    return index;
+}
+
+/*
+ *  ObjectTable::Find
+ *
+ *  Description:
+ *      This function will return the index assigned to the given object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The index assigned to the object or Not_Found if the object is not in
+ *      the table.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ObjectTable::Find(std::uint64_t id) const
+{
+    return Lookup(id, GetHome(id));
+}
+
+/*
+ *  ObjectTable::Find
+ *
+ *  Description:
+ *      This function will return the indices assigned to each of the given
+ *      objects.
+ *
+ *  Parameters:
+ *      ids [in]
+ *          The IDs of the objects.
+ *
+ *      indices [out]
+ *          The index assigned to each object, or Not_Found for those objects
+ *          not in the table.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Slots are located and fetched for a batch of objects before any are
+ *      probed so that the memory accesses for the batch overlap.
+ */
+void ObjectTable::Find(const std::vector<std::uint64_t> &ids,
+                       std::vector<std::size_t> &indices) const
+{
+    std::size_t homes[Batch_Size];
+
+    indices.resize(ids.size());
+
+    for (std::size_t begin = 0; begin < ids.size(); begin += Batch_Size)
+    {
+        const std::size_t end = std::min(begin + Batch_Size, ids.size());
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            homes[i - begin] = GetHome(ids[i]);
+            Prefetch(&slots[homes[i - begin]]);
+        }
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            indices[i] = Lookup(ids[i], homes[i - begin]);
+        }
+    }
+}
+
+/*
+ *  ObjectTable::Find
+ *
+ *  Description:
+ *      This function will return the indices assigned to each of the given
+ *      objects, such as those produced by decoding a single frame.
+ *
+ *  Parameters:
+ *      objects [in]
+ *          The objects to look up.
+ *
+ *      indices [out]
+ *          The index assigned to each object, or Not_Found for those objects
+ *          not in the table or that have no object ID.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void ObjectTable::Find(const GSObjects &objects,
+                       std::vector<std::size_t> &indices) const
+{
+    std::uint64_t batch_ids[Batch_Size];
+    std::size_t homes[Batch_Size];
+    bool has_id[Batch_Size];
+
+    indices.resize(objects.size());
+
+    for (std::size_t begin = 0; begin < objects.size(); begin += Batch_Size)
+    {
+        const std::size_t end = std::min(begin + Batch_Size, objects.size());
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            const auto id = GetObjectID(objects[i]);
+
+            has_id[i - begin] = id.has_value();
+            if (!id) continue;
+
+            batch_ids[i - begin] = *id;
+            homes[i - begin] = GetHome(*id);
+            Prefetch(&slots[homes[i - begin]]);
+        }
+
+        for (std::size_t i = begin; i < end; i++)
+        {
+            indices[i] = has_id[i - begin] ?
+                             Lookup(batch_ids[i - begin], homes[i - begin]) :
+                             Not_Found;
+        }
+    }
+}
+
+/*
+ *  ObjectTable::Remove
+ *
+ *  Description:
+ *      This function will remove the given object from the table, releasing
+ *      its index for reuse.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      True if the object was removed, false if it was not in the table.
+ *
+ *  Comments:
+ *      Rather than marking the slot as deleted, entries following the slot
+ *      in the same probe sequence are shifted back so that every entry
+ *      remains reachable from its home slot without passing an empty slot.
+ */
+bool ObjectTable::Remove(std::uint64_t id)
+{
+    std::size_t hole = GetHome(id);
+
+    // Locate the object
+    while (true)
+    {
+        if (slots[hole].index == Not_Found) return false;
+        if (slots[hole].id == id) break;
+        hole = (hole + 1) & mask;
+    }
+
+    // Release the object's index
+    const std::size_t index = slots[hole].index;
+    assigned[index] = 0;
+    free_indices.push_back(index);
+    count--;
+
+    // Shift back entries that may not be left separated from their home
+    std::size_t slot = hole;
+    while (true)
+    {
+        slot = (slot + 1) & mask;
+        if (slots[slot].index == Not_Found) break;
+
+        // Move the entry if the hole lies between its home and its slot
+        const std::size_t home = GetHome(slots[slot].id);
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
+        {
+            slots[hole] = slots[slot];
+            hole = slot;
+        }
+    }
+
+    slots[hole].index = Not_Found;
+
+    return true;
+}
+
+/*
+ *  ObjectTable::Clear
+ *
+ *  Description:
+ *      This function will remove all objects from the table.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Index assignment starts again from zero.
+ */
+void ObjectTable::Clear()
+{
+    for (Slot &slot : slots) slot.index = Not_Found;
+    ids.clear();
+    assigned.clear();
+    free_indices.clear();
+    count = 0;
+}
+
+/*
+ *  ObjectTable::GetHome
+ *
+ *  Description:
+ *      This function will return the slot at which the probe sequence for
+ *      the given object begins.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *  Returns:
+ *      The home slot of the object.
+ *
+ *  Comments:
+ *      Object IDs are often assigned sequentially, so the ID is mixed (using
+ *      the SplitMix64 finalizer) to spread consecutive IDs across the table.
+ */
+std::size_t ObjectTable::GetHome(std::uint64_t id) const
+{
+    id ^= id >> 30;
+    id *= 0xbf58476d1ce4e5b9ULL;
+    id ^= id >> 27;
+    id *= 0x94d049bb133111ebULL;
+    id ^= id >> 31;
+
+    return static_cast<std::size_t>(id) & mask;
+}
+
+/*
+ *  ObjectTable::Lookup
+ *
+ *  Description:
+ *      This function will probe for the given object starting at its home
+ *      slot.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object.
+ *
+ *      slot [in]
+ *          The home slot of the object.
+ *
+ *  Returns:
+ *      The index assigned to the object or Not_Found.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t ObjectTable::Lookup(std::uint64_t id, std::size_t slot) const
+{
+    while (slots[slot].index != Not_Found)
+    {
+        if (slots[slot].id == id) return slots[slot].index;
+        slot = (slot + 1) & mask;
+    }
+
+    return Not_Found;
+}
+
+/*
+ *  ObjectTable::Resize
+ *
+ *  Description:
+ *      This function will rebuild the hash table with the given number of
+ *      slots.
+ *
+ *  Parameters:
+ *      slot_count [in]
+ *          The number of slots, which must be a power of two.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Indices assigned to objects are unchanged.
+ */
+void ObjectTable::Resize(std::size_t slot_count)
+{
+    std::vector<Slot> old_slots(slot_count, Slot{0, Not_Found});
+
+    slots.swap(old_slots);
+    mask = slot_count - 1;
+
+    for (const Slot &entry : old_slots)
+    {
+        if (entry.index == Not_Found) continue;
+
+        std::size_t slot = GetHome(entry.id);
+        while (slots[slot].index != Not_Found) slot = (slot + 1) & mask;
+        slots[slot] = entry;
+    }
+}
+
+} // namespace gs
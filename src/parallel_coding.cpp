@@ -0,0 +1,260 @@
+/*
+ *  parallel_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines utility functions used by the Game State Encoder
+ *      and Decoder to split the serialization of large element vectors across
+ *      multiple threads.  Elements are divided into contiguous chunks, each of
+ *      which is processed by its own thread.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <vector>
+#include <thread>
+#include <exception>
+#include <system_error>
+#include "parallel_coding.h"
+
+namespace gs
+{
+
+/*
+ *  VarUintLength
+ *
+ *  Description:
+ *      This function will return the number of octets occupied by a
+ *      serialized VarUint, determined from its first octet.
+ *
+ *  Parameters:
+ *      octet [in]
+ *          The first octet of the serialized VarUint.
+ *
+ *  Returns:
+ *      The number of octets in the VarUint or zero if the octet does not
+ *      begin a valid VarUint.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t VarUintLength(std::uint8_t octet)
+{
+    if ((octet & 0b1000'0000) == 0) return 1;
+    if ((octet & 0b1100'0000) == 0b1000'0000) return 2;
+    if ((octet & 0b1110'0000) == 0b1100'0000) return 3;
+    if (octet == 0b1110'0001) return 1 + sizeof(std::uint32_t);
+    if (octet == 0b1110'0010) return 1 + sizeof(std::uint64_t);
+
+    return 0;
+}
+
+/*
+ *  GetThreadCount
+ *
+ *  Description:
+ *      This function will return the number of threads that may be used
+ *      given a limit on the number of threads.
+ *
+ *  Parameters:
+ *      max_threads [in]
+ *          The maximum number of threads to use or zero to use as many
+ *          threads as the hardware supports.
+ *
+ *  Returns:
+ *      The number of threads, which is at least one.  No more chunks than
+ *      this are returned by GetChunkCount().
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t GetThreadCount(std::size_t max_threads)
+{
+    if (!max_threads) max_threads = std::thread::hardware_concurrency();
+
+    return max_threads ? max_threads : 1;
+}
+
+/*
+ *  GetChunkCount
+ *
+ *  Description:
+ *      This function will determine the number of chunks into which a number
+ *      of elements should be divided for concurrent processing.
+ *
+ *  Parameters:
+ *      count [in]
+ *          The number of elements.
+ *
+ *      max_threads [in]
+ *          The maximum number of threads to use or zero to use as many
+ *          threads as the hardware supports.
+ *
+ *      min_chunk [in]
+ *          The minimum number of elements in each chunk.
+ *
+ *  Returns:
+ *      The number of chunks, which is one if the elements should be
+ *      processed by the calling thread alone.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t GetChunkCount(std::size_t count,
+                          std::size_t max_threads,
+                          std::size_t min_chunk)
+{
+    if (!min_chunk) return 1;
+
+    max_threads = GetThreadCount(max_threads);
+
+    const std::size_t chunks = count / min_chunk;
+
+    if (chunks <= 1) return 1;
+
+    return (chunks < max_threads) ? chunks : max_threads;
+}
+
+/*
+ *  GetChunkBegin
+ *
+ *  Description:
+ *      This function will return the index of the first element in the
+ *      given chunk.  Elements are divided as evenly as possible.
+ *
+ *  Parameters:
+ *      count [in]
+ *          The number of elements.
+ *
+ *      chunks [in]
+ *          The number of chunks.
+ *
+ *      chunk [in]
+ *          The chunk index, which may equal the number of chunks in order to
+ *          obtain the end of the last chunk.
+ *
+ *  Returns:
+ *      The index of the first element in the chunk.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t GetChunkBegin(std::size_t count,
+                          std::size_t chunks,
+                          std::size_t chunk)
+{
+    return (count / chunks) * chunk +
+           ((count % chunks) * chunk) / chunks;
+}
+
+/*
+ *  ParallelFor
+ *
+ *  Description:
+ *      This function will divide elements into chunks and call the given
+ *      function once for each chunk, with each call made on its own thread.
+ *
+ *  Parameters:
+ *      count [in]
+ *          The number of elements.
+ *
+ *      chunks [in]
+ *          The number of chunks.
+ *
+ *      function [in]
+ *          The function to call, which receives the chunk index and the
+ *          range of element indices [begin, end) in the chunk.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The first chunk is processed by the calling thread, as are any
+ *      chunks for which a thread could not be created.  This function
+ *      returns once all chunks have been processed.  If any call throws an
+ *      exception, the exception thrown for the lowest chunk index is
+ *      rethrown.
+ */
+void ParallelFor(std::size_t count,
+                 std::size_t chunks,
+                 const std::function<void(std::size_t chunk,
+                                          std::size_t begin,
+                                          std::size_t end)> &function)
+{
+    std::vector<std::exception_ptr> exceptions(chunks);
+    std::vector<std::thread> threads;
+
+    // Helper to process a single chunk, capturing any exception
+    auto process = [&](std::size_t chunk)
+    {
+        try
+        {
+            function(chunk,
+                     GetChunkBegin(count, chunks, chunk),
+                     GetChunkBegin(count, chunks, chunk + 1));
+        }
+        catch (...)
+        {
+            exceptions[chunk] = std::current_exception();
+        }
+    };
+
+    // Start a thread for each chunk but the first, stopping if the system
+    // is unable to create more threads
+    std::size_t chunk = 1;
+    threads.reserve(chunks);
+    try
+    {
+        for (; chunk < chunks; chunk++) threads.emplace_back(process, chunk);
+    }
+    catch (const std::system_error &)
+    {
+        // The remaining chunks are processed by this thread
+    }
+
+    // Process the first chunk and any not given a thread
+    if (chunks) process(0);
+    for (; chunk < chunks; chunk++) process(chunk);
+
+    for (auto &thread : threads) thread.join();
+
+    for (auto &exception : exceptions)
+    {
+        if (exception) std::rethrow_exception(exception);
+    }
+}
+
+} // namespace gs
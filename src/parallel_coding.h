@@ -0,0 +1,119 @@
+/*
+ *  parallel_coding.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines utility functions used by the Game State Encoder
+ *      and Decoder to split the serialization of large element vectors across
+ *      multiple threads.  Elements are divided into contiguous chunks, each of
+ *      which is processed by its own thread.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PARALLEL_CODING_H
+#define PARALLEL_CODING_H
+
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// Minimum number of vector elements processed by each thread
+constexpr std::size_t Parallel_Min_Chunk = 16384;
+
+// Number of vector elements examined together after they are deserialized
+constexpr std::size_t Visit_Block_Length = 1024;
+
+// Serialized length of elements having a fixed length, or zero if the length
+// varies
+template <typename T> struct FixedLength
+{
+    static constexpr std::size_t value = 0;
+};
+template <> struct FixedLength<Loc1>
+{
+    static constexpr std::size_t value = 3 * sizeof(Float32);
+};
+template <> struct FixedLength<Norm1>
+{
+    static constexpr std::size_t value = 3 * sizeof(std::uint16_t);
+};
+
+// Number of VarUint values forming an element of variable length, or zero if
+// the element is not composed solely of VarUint values
+template <typename T> struct VarUintCount
+{
+    static constexpr std::size_t value = 0;
+};
+template <> struct VarUintCount<VarUint>
+{
+    static constexpr std::size_t value = 1;
+};
+template <> struct VarUintCount<TextureUV1>
+{
+    static constexpr std::size_t value = 2;
+};
+
+// Function to return the number of octets in a VarUint given its first octet
+std::size_t VarUintLength(std::uint8_t octet);
+
+// Function to return the number of threads permitted by a thread limit
+std::size_t GetThreadCount(std::size_t max_threads);
+
+// Function to determine the number of chunks into which to divide elements
+std::size_t GetChunkCount(std::size_t count,
+                          std::size_t max_threads,
+                          std::size_t min_chunk = Parallel_Min_Chunk);
+
+// Function to return the index of the first element in a chunk
+std::size_t GetChunkBegin(std::size_t count,
+                          std::size_t chunks,
+                          std::size_t chunk);
+
+// Function to call a function for each chunk of elements concurrently
+void ParallelFor(std::size_t count,
+                 std::size_t chunks,
+                 const std::function<void(std::size_t chunk,
+                                          std::size_t begin,
+                                          std::size_t end)> &function);
+
+} // namespace gs
+
+#endif // PARALLEL_CODING_H
@@ -0,0 +1,358 @@
+/*
+ *  precision_policy.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the PrecisionPolicy object, which encodes a set
+ *      of objects within a per-tick octet budget by selecting coarser compact
+ *      encodings for each type of object as necessary.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <array>
+#include <variant>
+#include <type_traits>
+#include "precision_policy.h"
+
+namespace gs
+{
+
+/*
+ *  PrecisionPolicy::PrecisionPolicy
+ *
+ *  Description:
+ *      Constructor for the PrecisionPolicy object.
+ *
+ *  Parameters:
+ *      ladders [in]
+ *          The successively coarser encodings to use for each type of
+ *          object.  The encodings are validated when first used.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+PrecisionPolicy::PrecisionPolicy(const PrecisionLadders &ladders) :
+    ladders{ladders}
+{
+}
+
+/*
+ *  PrecisionPolicy::Encode
+ *
+ *  Description:
+ *      This function will encode the given objects, appending them to the
+ *      data buffer, using the finest precision that allows the objects to
+ *      fit within the given budget.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the objects shall be written.  If
+ *          given a buffer of zero-length, this call will just return the
+ *          octets required to perform the encoding and not actually encode.
+ *
+ *      value [in]
+ *          The objects to serialize to the end of the DataBuffer.
+ *
+ *      budget [in]
+ *          The maximum number of octets to append to the data buffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.  A value less than the number of
+ *      objects indicates that they could not all be made to fit, even at the
+ *      coarsest precision, in which case encoding stops at the first object
+ *      that does not fit.
+ *
+ *  Comments:
+ *      The length of each object at each level of its type's ladder is
+ *      determined first.  Starting from the standard encodings, the type
+ *      whose next shorter level saves the most octets is moved down its ladder
+ *      until the objects fit or no further savings are possible.  The levels
+ *      selected are available from GetLevels().  Since the compact encodings
+ *      are self-describing, the decoder handles any mix of levels.  The
+ *      budget is reduced to the space remaining in a non-zero-length buffer.
+ */
+EncodeResult PrecisionPolicy::Encode(DataBuffer &data_buffer,
+                                     const GSObjects &value,
+                                     std::size_t budget)
+{
+    std::array<std::vector<std::uint64_t>, Ladder_Count> totals;
+    std::array<std::size_t, Ladder_Count> selected{};
+    std::uint64_t total{};
+    EncodeResult result{};
+
+    // The budget cannot exceed the space remaining in the buffer
+    if (data_buffer.GetBufferSize() &&
+        (budget > data_buffer.GetBufferSize() - data_buffer.GetDataLength()))
+    {
+        budget = data_buffer.GetBufferSize() - data_buffer.GetDataLength();
+    }
+
+    for (std::size_t ladder = 0; ladder < Ladder_Count; ladder++)
+    {
+        totals[ladder].assign(GetLadderLength(ladder) + 1, 0);
+    }
+
+    // Determine the length of each object at each level of its ladder
+    lengths.clear();
+    offsets.clear();
+    for (const auto &object : value)
+    {
+        const std::size_t ladder = GetLadder(object);
+        const std::size_t ladder_length = GetLadderLength(ladder);
+
+        offsets.push_back(lengths.size());
+        for (std::size_t level = 0; level <= ladder_length; level++)
+        {
+            lengths.push_back(Encode(null_buffer, object, level).second);
+            if (ladder < Ladder_Count)
+            {
+                totals[ladder][level] += lengths.back();
+            }
+        }
+        if (ladder == Ladder_Count) total += lengths.back();
+    }
+    for (std::size_t ladder = 0; ladder < Ladder_Count; ladder++)
+    {
+        total += totals[ladder][0];
+    }
+
+    // Move down the ladder offering the largest saving until the objects fit
+    while (total > budget)
+    {
+        std::size_t best = Ladder_Count;
+        std::size_t best_level{};
+        std::uint64_t best_saving{};
+
+        for (std::size_t ladder = 0; ladder < Ladder_Count; ladder++)
+        {
+            const std::size_t current = selected[ladder];
+
+            // Skip over levels that do not reduce the length
+            for (std::size_t level = current + 1;
+                 level <= GetLadderLength(ladder);
+                 level++)
+            {
+                if (totals[ladder][level] >= totals[ladder][current]) continue;
+
+                const std::uint64_t saving = totals[ladder][current] -
+                                             totals[ladder][level];
+                if (saving > best_saving)
+                {
+                    best = ladder;
+                    best_level = level;
+                    best_saving = saving;
+                }
+                break;
+            }
+        }
+
+        if (best == Ladder_Count) break;
+
+        selected[best] = best_level;
+        total -= best_saving;
+    }
+
+    levels.object1 = selected[Object1_Ladder];
+    levels.head1 = selected[Head1_Ladder];
+    levels.hand1 = selected[Hand1_Ladder];
+    levels.hand2 = selected[Hand2_Ladder];
+    levels.mesh1 = selected[Mesh1_Ladder];
+
+    // Encode objects at the selected levels while they fit the budget
+    for (std::size_t i = 0; i < value.size(); i++)
+    {
+        const std::size_t ladder = GetLadder(value[i]);
+        const std::size_t level =
+            (ladder < Ladder_Count) ? selected[ladder] : 0;
+
+        if (lengths[offsets[i] + level] > budget - result.second) break;
+
+        const EncodeResult encoded = Encode(data_buffer, value[i], level);
+        if (encoded.first == 0) break;
+
+        result.first += encoded.first;
+        result.second += encoded.second;
+    }
+
+    return result;
+}
+
+/*
+ *  PrecisionPolicy::GetLadder
+ *
+ *  Description:
+ *      This function will return the ladder that applies to the given
+ *      object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose ladder is to be returned.
+ *
+ *  Returns:
+ *      The ladder applying to the object or Ladder_Count if the object is
+ *      always sent using its standard encoding.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t PrecisionPolicy::GetLadder(const GSObject &value) const
+{
+    if (std::holds_alternative<Object1>(value)) return Object1_Ladder;
+    if (std::holds_alternative<Head1>(value)) return Head1_Ladder;
+    if (std::holds_alternative<Hand1>(value)) return Hand1_Ladder;
+    if (std::holds_alternative<Hand2>(value)) return Hand2_Ladder;
+    if (std::holds_alternative<Mesh1>(value)) return Mesh1_Ladder;
+
+    return Ladder_Count;
+}
+
+/*
+ *  PrecisionPolicy::GetLadderLength
+ *
+ *  Description:
+ *      This function will return the number of encodings in a ladder.
+ *
+ *  Parameters:
+ *      ladder [in]
+ *          The ladder whose length is to be returned.
+ *
+ *  Returns:
+ *      The number of encodings in the ladder, which is zero for objects
+ *      having no ladder.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t PrecisionPolicy::GetLadderLength(std::size_t ladder) const
+{
+    switch (ladder)
+    {
+        case Object1_Ladder:
+            return ladders.object1.size();
+        case Head1_Ladder:
+            return ladders.head1.size();
+        case Hand1_Ladder:
+            return ladders.hand1.size();
+        case Hand2_Ladder:
+            return ladders.hand2.size();
+        case Mesh1_Ladder:
+            return ladders.mesh1.size();
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+/*
+ *  PrecisionPolicy::Encode
+ *
+ *  Description:
+ *      This function will encode a single object at the given level of its
+ *      type's ladder.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the object shall be written.
+ *
+ *      value [in]
+ *          The object to serialize to the end of the DataBuffer.
+ *
+ *      level [in]
+ *          The level at which to encode the object, where zero indicates the
+ *          standard encoding.
+ *
+ *  Returns:
+ *      The result of encoding the object.
+ *
+ *  Comments:
+ *      None.
+ */
+EncodeResult PrecisionPolicy::Encode(DataBuffer &data_buffer,
+                                     const GSObject &value,
+                                     std::size_t level)
+{
+    if (level == 0) return encoder.Encode(data_buffer, value);
+
+    return std::visit(
+        [&](const auto &object) -> EncodeResult
+        {
+            using T = std::decay_t<decltype(object)>;
+
+            if constexpr (std::is_same_v<T, Object1>)
+            {
+                return encoder.Encode(data_buffer,
+                                      object,
+                                      ladders.object1[level - 1]);
+            }
+            else if constexpr (std::is_same_v<T, Head1>)
+            {
+                return encoder.Encode(data_buffer,
+                                      object,
+                                      ladders.head1[level - 1]);
+            }
+            else if constexpr (std::is_same_v<T, Hand1>)
+            {
+                return encoder.Encode(data_buffer,
+                                      object,
+                                      ladders.hand1[level - 1]);
+            }
+            else if constexpr (std::is_same_v<T, Hand2>)
+            {
+                return encoder.Encode(data_buffer,
+                                      object,
+                                      ladders.hand2[level - 1]);
+            }
+            else if constexpr (std::is_same_v<T, Mesh1>)
+            {
+                return encoder.Encode(data_buffer,
+                                      object,
+                                      ladders.mesh1[level - 1]);
+            }
+            else
+            {
+                return encoder.Encode(data_buffer, object);
+            }
+        },
+        value);
+}
+
+} // namespace gs
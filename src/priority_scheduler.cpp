@@ -0,0 +1,305 @@
+/*
+ *  priority_scheduler.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the PriorityScheduler object, which accrues a
+ *      priority for each changed object on every tick and encodes the objects
+ *      having the highest priority within an octet budget.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+#include <variant>
+#include "priority_scheduler.h"
+#include "object_access.h"
+
+namespace gs
+{
+
+/*
+ *  PriorityScheduler::PriorityScheduler
+ *
+ *  Description:
+ *      Constructor for the PriorityScheduler object.
+ *
+ *  Parameters:
+ *      weights [in]
+ *          The weights controlling the rate at which priority accrues.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The viewer is initially positioned at the origin.
+ */
+PriorityScheduler::PriorityScheduler(const PriorityWeights &weights) :
+    weights{weights},
+    viewer{}
+{
+}
+
+/*
+ *  PriorityScheduler::Update
+ *
+ *  Description:
+ *      This function will record that the given object has changed, so that
+ *      it will be considered for transmission on subsequent ticks.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The latest value of the object.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      If the object is already pending, its value is replaced and the
+ *      priority it has accrued is retained, so that an object changing on
+ *      every tick is not starved.  Objects without a position, such as
+ *      meshes, are treated as being at the viewer's position at the time
+ *      they are updated.  An EncoderException is thrown if the object has
+ *      no object ID.
+ */
+void PriorityScheduler::Update(const GSObject &value)
+{
+    const std::optional<std::uint64_t> id = GetObjectID(value);
+
+    if (!id) throw EncoderException("Object has no object ID");
+
+    const Loc1 position = GetObjectPosition(value).value_or(viewer);
+    const std::size_t length = encoder.GetEncodeLength(value).second;
+    const std::size_t index = pending.Insert(*id);
+
+    pending.Get<Type_Weight>(index) = GetWeight(value);
+    pending.Get<Position>(index) = position;
+    pending.Get<Length>(index) = length;
+    pending.Get<Value>(index) = value;
+}
+
+/*
+ *  PriorityScheduler::Remove
+ *
+ *  Description:
+ *      This function will discard any pending change to the given object,
+ *      such as when the object is destroyed.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object to remove.
+ *
+ *  Returns:
+ *      True if the object was pending, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool PriorityScheduler::Remove(std::uint64_t id)
+{
+    return pending.Remove(id);
+}
+
+/*
+ *  PriorityScheduler::Encode
+ *
+ *  Description:
+ *      This function will advance one tick, adding to each pending object's
+ *      priority, and then encode the pending objects in order of decreasing
+ *      priority while they fit within the given budget.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the objects shall be written.
+ *
+ *      budget [in]
+ *          The maximum number of octets to append to the data buffer.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.
+ *
+ *  Comments:
+ *      Each tick, an object's priority grows by its type's weight divided by
+ *      one plus its distance from the viewer in units of distance_scale, so
+ *      priority reflects staleness, distance, and type.  Objects that do not
+ *      fit the remaining budget are skipped in favor of smaller objects of
+ *      lower priority.  Objects that are sent are no longer pending; the
+ *      others retain their priority for the next tick.  Selection uses a
+ *      binary heap built over the pending objects, so a tick costs time
+ *      linear in the number of pending objects plus logarithmic time for
+ *      each object considered.  The budget is reduced to the space
+ *      remaining in the buffer.  If the buffer has no size, the length of
+ *      the objects that would be sent is returned without accruing priority
+ *      or removing any object.
+ */
+EncodeResult PriorityScheduler::Encode(DataBuffer &data_buffer,
+                                       std::size_t budget)
+{
+    std::size_t min_length = std::numeric_limits<std::size_t>::max();
+    EncodeResult result{};
+
+    // The budget cannot exceed the space remaining in the buffer, unless
+    // the buffer has no size and is used only to determine the length
+    if (data_buffer.GetBufferSize())
+    {
+        budget = std::min(budget,
+                          data_buffer.GetBufferSize() -
+                              data_buffer.GetDataLength());
+    }
+
+    // Accrue priority for each pending object
+    const std::vector<double> &priorities = pending.GetColumn<Priority>();
+    const std::vector<double> &type_weights =
+        pending.GetColumn<Type_Weight>();
+    const std::vector<Loc1> &positions = pending.GetColumn<Position>();
+    const std::vector<std::size_t> &lengths = pending.GetColumn<Length>();
+    accrued.assign(pending.GetIndexLimit(), 0.0);
+    heap.clear();
+    for (std::size_t i = 0; i < pending.GetIndexLimit(); i++)
+    {
+        if (!pending.IsValid(i)) continue;
+
+        double rate = type_weights[i];
+
+        if (weights.distance_scale > 0.0)
+        {
+            const double dx = positions[i].x - viewer.x;
+            const double dy = positions[i].y - viewer.y;
+            const double dz = positions[i].z - viewer.z;
+            const double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+            rate /= 1.0 + distance / weights.distance_scale;
+        }
+
+        accrued[i] = priorities[i] + rate;
+        min_length = std::min(min_length, lengths[i]);
+        heap.push_back(i);
+    }
+
+    // Order by priority, breaking ties in favor of the lower object ID
+    const auto lower_priority = [&](std::size_t a, std::size_t b)
+    {
+        if (accrued[a] != accrued[b]) return accrued[a] < accrued[b];
+        return pending.GetID(a) > pending.GetID(b);
+    };
+    std::make_heap(heap.begin(), heap.end(), lower_priority);
+
+    // Encode the highest priority objects that fit
+    sent.clear();
+    while (!heap.empty() && (budget - result.second >= min_length))
+    {
+        std::pop_heap(heap.begin(), heap.end(), lower_priority);
+        const std::size_t index = heap.back();
+        heap.pop_back();
+
+        if (lengths[index] > budget - result.second) continue;
+
+        const EncodeResult encoded =
+            encoder.Encode(data_buffer, pending.Get<Value>(index));
+        if (encoded.first == 0) break;
+
+        result.first += encoded.first;
+        result.second += encoded.second;
+        sent.push_back(index);
+    }
+
+    // Only determining the length leaves the pending objects unchanged
+    if (!data_buffer.GetBufferSize()) return result;
+
+    // Keep the accrued priority and remove sent objects
+    pending.GetColumn<Priority>().swap(accrued);
+    for (const std::size_t index : sent) pending.Remove(pending.GetID(index));
+
+    return result;
+}
+
+/*
+ *  PriorityScheduler::GetPriority
+ *
+ *  Description:
+ *      This function will return the priority accrued by a pending object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object whose priority is to be returned.
+ *
+ *  Returns:
+ *      The priority accrued by the object or zero if it is not pending.
+ *
+ *  Comments:
+ *      None.
+ */
+double PriorityScheduler::GetPriority(std::uint64_t id) const
+{
+    const std::size_t index = pending.Find(id);
+
+    if (index == ObjectTable::Not_Found) return 0.0;
+
+    return pending.Get<Priority>(index);
+}
+
+/*
+ *  PriorityScheduler::GetWeight
+ *
+ *  Description:
+ *      This function will return the weight of the given object's type.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose weight is to be returned.
+ *
+ *  Returns:
+ *      The weight configured for the object's type.
+ *
+ *  Comments:
+ *      None.
+ */
+double PriorityScheduler::GetWeight(const GSObject &value) const
+{
+    if (std::holds_alternative<Object1>(value)) return weights.object1;
+    if (std::holds_alternative<Head1>(value)) return weights.head1;
+    if (std::holds_alternative<Hand1>(value)) return weights.hand1;
+    if (std::holds_alternative<Hand2>(value)) return weights.hand2;
+    if (std::holds_alternative<Mesh1>(value)) return weights.mesh1;
+
+    return weights.other;
+}
+
+} // namespace gs
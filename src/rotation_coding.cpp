@@ -0,0 +1,239 @@
+/*
+ *  rotation_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements functions for compressing rotations using the
+ *      "smallest three" representation of a unit quaternion.  The largest of
+ *      the four quaternion components is dropped and identified by a 2-bit
+ *      index, and the remaining three components are quantized.  Since the
+ *      dropped component is made positive and the other three have magnitude
+ *      at most 1/sqrt(2), all of the quantization range is put to use.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include "rotation_coding.h"
+
+namespace gs
+{
+
+// Largest magnitude of any component other than the largest one
+constexpr float Component_Range = 0.70710678f;
+
+/*
+ *  CompressedRotationLength
+ *
+ *  Description:
+ *      This function will return the number of octets required to hold
+ *      a compressed rotation, which is 2 bits for the index of the dropped
+ *      component plus 3 quantized components, rounded up to whole octets.
+ *
+ *  Parameters:
+ *      bits [in]
+ *          The number of bits per quantized component.
+ *
+ *  Returns:
+ *      The number of octets.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t CompressedRotationLength(unsigned bits)
+{
+    return (2 + 3 * bits + 7) / 8;
+}
+
+/*
+ *  CompressRotations
+ *
+ *  Description:
+ *      This function will compress an array of rotations into packed
+ *      smallest-three values.  Each Rot1 holds the vector part of a unit
+ *      quaternion whose real part is implied to be non-negative.
+ *
+ *  Parameters:
+ *      rotations [in]
+ *          The rotations to compress.
+ *
+ *      count [in]
+ *          The number of rotations to compress.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component, which must be in the
+ *          range Min_Rotation_Bits to Max_Rotation_Bits.
+ *
+ *      packed [out]
+ *          The array into which count packed values shall be written.  The
+ *          index of the dropped component occupies the two bits above the
+ *          three quantized components, with the first component in the most
+ *          significant position.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The quaternion is renormalized before compression, so small errors
+ *      in the input magnitude are tolerated.  A zero quaternion is treated
+ *      as the identity rotation.
+ */
+void CompressRotations(const Rot1 *rotations,
+                       std::size_t count,
+                       unsigned bits,
+                       std::uint64_t *packed)
+{
+    const float levels = static_cast<float>((1u << bits) - 1);
+
+    for (std::size_t n = 0; n < count; n++)
+    {
+        const float i = rotations[n].i.value;
+        const float j = rotations[n].j.value;
+        const float k = rotations[n].k.value;
+        const float sum = i * i + j * j + k * k;
+        const float w = std::sqrt(std::fmax(0.0f, 1.0f - sum));
+        float q[4] = {w, i, j, k};
+
+        // Normalize the quaternion
+        const float length = std::sqrt(w * w + sum);
+        if (length > 0.0f)
+        {
+            for (auto &c : q) c /= length;
+        }
+        else
+        {
+            q[0] = 1.0f;
+        }
+
+        // Find the largest component
+        unsigned largest = 0;
+        for (unsigned c = 1; c < 4; c++)
+        {
+            if (std::fabs(q[c]) > std::fabs(q[largest])) largest = c;
+        }
+
+        // Negate the quaternion so the dropped component is positive
+        const float sign = (q[largest] < 0.0f) ? -1.0f : 1.0f;
+
+        // Quantize the other three components
+        std::uint64_t value = largest;
+        for (unsigned c = 0; c < 4; c++)
+        {
+            if (c == largest) continue;
+
+            float t = (q[c] * sign / Component_Range) * 0.5f + 0.5f;
+            t = (t > 0.0f) ? t : 0.0f;
+            t = (t < 1.0f) ? t : 1.0f;
+
+            value = (value << bits) |
+                    static_cast<std::uint64_t>(t * levels + 0.5f);
+        }
+
+        packed[n] = value;
+    }
+}
+
+/*
+ *  DecompressRotations
+ *
+ *  Description:
+ *      This function will decompress an array of packed smallest-three
+ *      values produced by CompressRotations() into rotations.
+ *
+ *  Parameters:
+ *      packed [in]
+ *          The packed values to decompress.
+ *
+ *      count [in]
+ *          The number of packed values.
+ *
+ *      bits [in]
+ *          The number of bits per quantized component, which must be in the
+ *          range Min_Rotation_Bits to Max_Rotation_Bits.
+ *
+ *      rotations [out]
+ *          The array into which count rotations shall be written.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The dropped component is reconstructed from the unit length
+ *      constraint.  If the real part of the result is negative, the
+ *      quaternion is negated so that the real part is non-negative as is
+ *      implied by the Rot1 representation.
+ */
+void DecompressRotations(const std::uint64_t *packed,
+                         std::size_t count,
+                         unsigned bits,
+                         Rot1 *rotations)
+{
+    const std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+    const float step = 2.0f * Component_Range /
+                       static_cast<float>((1u << bits) - 1);
+
+    for (std::size_t n = 0; n < count; n++)
+    {
+        const unsigned largest =
+            static_cast<unsigned>(packed[n] >> (3 * bits)) & 3;
+        float q[4];
+        float sum{};
+        unsigned shift = 3 * bits;
+
+        // Dequantize the three transmitted components
+        for (unsigned c = 0; c < 4; c++)
+        {
+            if (c == largest) continue;
+
+            shift -= bits;
+            q[c] = static_cast<float>((packed[n] >> shift) & mask) * step -
+                   Component_Range;
+            sum += q[c] * q[c];
+        }
+
+        // Reconstruct the dropped component
+        q[largest] = std::sqrt(std::fmax(0.0f, 1.0f - sum));
+
+        // Ensure the real part is non-negative
+        const float sign = (q[0] < 0.0f) ? -1.0f : 1.0f;
+
+        rotations[n].i.value = q[1] * sign;
+        rotations[n].j.value = q[2] * sign;
+        rotations[n].k.value = q[3] * sign;
+    }
+}
+
+} // namespace gs
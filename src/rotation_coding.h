@@ -0,0 +1,80 @@
+/*
+ *  rotation_coding.h
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module defines functions for compressing rotations using the
+ *      "smallest three" representation of a unit quaternion.  The largest of
+ *      the four quaternion components is dropped and identified by a 2-bit
+ *      index, and the remaining three components are quantized.  Since the
+ *      dropped component is made positive and the other three have magnitude
+ *      at most 1/sqrt(2), all of the quantization range is put to use.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ROTATION_CODING_H
+#define ROTATION_CODING_H
+
+#include <cstddef>
+#include <cstdint>
+#include "gs_types.h"
+
+namespace gs
+{
+
+// Minimum and maximum bits per quantized smallest-three component
+constexpr unsigned Min_Rotation_Bits = 2;
+constexpr unsigned Max_Rotation_Bits = 20;
+
+// Function to return the number of octets holding a compressed rotation
+std::size_t CompressedRotationLength(unsigned bits);
+
+// Function to compress rotations into packed smallest-three values
+void CompressRotations(const Rot1 *rotations,
+                       std::size_t count,
+                       unsigned bits,
+                       std::uint64_t *packed);
+
+// Function to decompress packed smallest-three values into rotations
+void DecompressRotations(const std::uint64_t *packed,
+                         std::size_t count,
+                         unsigned bits,
+                         Rot1 *rotations);
+
+} // namespace gs
+
+#endif // ROTATION_CODING_H
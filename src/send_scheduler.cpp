@@ -0,0 +1,442 @@
+/*
+ *  send_scheduler.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module implements the SendScheduler object, which holds the
+ *      objects to be sent along with the period at which each is to be sent,
+ *      and returns the objects due on each tick using a hierarchical timing
+ *      wheel.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <optional>
+#include "send_scheduler.h"
+#include "object_access.h"
+
+namespace gs
+{
+
+/*
+ *  SendScheduler::SendScheduler
+ *
+ *  Description:
+ *      Constructor for the SendScheduler object.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      The scheduler begins at tick zero.
+ */
+SendScheduler::SendScheduler() : tick{}
+{
+    slots.fill(No_Entry);
+}
+
+/*
+ *  SendScheduler::Insert
+ *
+ *  Description:
+ *      This function will schedule the given object to be sent periodically,
+ *      replacing any existing schedule for the object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object to send.
+ *
+ *      period [in]
+ *          The number of ticks between sends (e.g., 1 for an object sent at
+ *          90 Hz by a scheduler advanced at 90 Hz).
+ *
+ *      delay [in]
+ *          The number of ticks to wait before the first send.  Objects
+ *          sharing a period may be given differing delays to spread them
+ *          across ticks.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the period is zero or the object has
+ *      no object ID.
+ */
+void SendScheduler::Insert(const GSObject &value,
+                           std::uint64_t period,
+                           std::uint64_t delay)
+{
+    const std::uint64_t id = GetID(value);
+
+    if (period == 0) throw EncoderException("Send period must be non-zero");
+
+    // Unlink an existing entry, or extend the entries for a new index
+    const bool scheduled = (indices.Find(id) != ObjectTable::Not_Found);
+    const std::size_t entry = indices.Insert(id);
+    if (scheduled)
+    {
+        Unlink(entry);
+    }
+    else if (entry >= entries.size())
+    {
+        entries.resize(entry + 1);
+    }
+
+    entries[entry].id = id;
+    entries[entry].period = period;
+    entries[entry].due = tick + 1 + delay;
+    entries[entry].value = value;
+
+    Link(entry);
+}
+
+/*
+ *  SendScheduler::Update
+ *
+ *  Description:
+ *      This function will replace the value of a scheduled object without
+ *      changing when it is sent.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The latest value of the object.
+ *
+ *  Returns:
+ *      True if the object was scheduled, false otherwise.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the object has no object ID.
+ */
+bool SendScheduler::Update(const GSObject &value)
+{
+    const std::size_t entry = indices.Find(GetID(value));
+
+    if (entry == ObjectTable::Not_Found) return false;
+
+    entries[entry].value = value;
+
+    return true;
+}
+
+/*
+ *  SendScheduler::Remove
+ *
+ *  Description:
+ *      This function will stop sending the given object.
+ *
+ *  Parameters:
+ *      id [in]
+ *          The ID of the object to remove.
+ *
+ *  Returns:
+ *      True if the object was scheduled, false otherwise.
+ *
+ *  Comments:
+ *      None.
+ */
+bool SendScheduler::Remove(std::uint64_t id)
+{
+    const std::size_t entry = indices.Find(id);
+
+    if (entry == ObjectTable::Not_Found) return false;
+
+    Unlink(entry);
+    entries[entry].value = {};
+
+    return indices.Remove(id);
+}
+
+/*
+ *  SendScheduler::Advance
+ *
+ *  Description:
+ *      This function will advance to the next tick and return the IDs of
+ *      the objects due to be sent, rescheduling each for its next send.
+ *
+ *  Parameters:
+ *      None.
+ *
+ *  Returns:
+ *      The IDs of the objects due, which remain valid until the next call.
+ *
+ *  Comments:
+ *      The wheel has Wheel_Levels levels of 2^Wheel_Slot_Bits slots.  An
+ *      object is held in the lowest level whose span covers the ticks until
+ *      it is due.  When the lowest level wraps, the current slot of the
+ *      next level is cascaded, moving its objects down, and so on.  Aside
+ *      from cascading, whose cost is amortized over each object's period,
+ *      the cost of a tick is proportional to the number of objects due.
+ */
+const std::vector<std::uint64_t> &SendScheduler::Advance()
+{
+    tick++;
+
+    // Cascade higher levels as each lower level wraps
+    for (std::size_t level = 1; level < Wheel_Levels; level++)
+    {
+        if ((tick >> ((level - 1) * Wheel_Slot_Bits)) % Slot_Count) break;
+        Cascade(level);
+    }
+
+    // Every object in the current slot of the lowest level is due
+    due.clear();
+    due_ids.clear();
+    for (std::size_t entry = Detach(tick % Slot_Count);
+         entry != No_Entry;)
+    {
+        const std::size_t next = entries[entry].next;
+
+        due.push_back(entry);
+        due_ids.push_back(entries[entry].id);
+        entries[entry].due = tick + entries[entry].period;
+        Link(entry);
+
+        entry = next;
+    }
+
+    return due_ids;
+}
+
+/*
+ *  SendScheduler::Encode
+ *
+ *  Description:
+ *      This function will advance to the next tick and encode the objects
+ *      due to be sent, appending them to the data buffer.
+ *
+ *  Parameters:
+ *      data_buffer [in]
+ *          The data buffer into which the objects shall be written.
+ *
+ *  Returns:
+ *      A pair representing the number of objects and number of octets
+ *      serialized onto the data buffer.
+ *
+ *  Comments:
+ *      Objects that do not fit in the data buffer are rescheduled for the
+ *      next tick rather than waiting for their next period.
+ */
+EncodeResult SendScheduler::Encode(DataBuffer &data_buffer)
+{
+    EncodeResult result{};
+
+    Advance();
+
+    for (const std::size_t entry : due)
+    {
+        const EncodeResult encoded = encoder.Encode(data_buffer,
+                                                    entries[entry].value);
+
+        if (encoded.first == 0)
+        {
+            Unlink(entry);
+            entries[entry].due = tick + 1;
+            Link(entry);
+            continue;
+        }
+
+        result.first += encoded.first;
+        result.second += encoded.second;
+    }
+
+    return result;
+}
+
+/*
+ *  SendScheduler::GetID
+ *
+ *  Description:
+ *      This function will return the ID of the given object.
+ *
+ *  Parameters:
+ *      value [in]
+ *          The object whose ID is to be returned.
+ *
+ *  Returns:
+ *      The object's ID.
+ *
+ *  Comments:
+ *      An EncoderException is thrown if the object has no object ID.
+ */
+std::uint64_t SendScheduler::GetID(const GSObject &value) const
+{
+    const std::optional<std::uint64_t> id = GetObjectID(value);
+
+    if (!id) throw EncoderException("Object has no object ID");
+
+    return *id;
+}
+
+/*
+ *  SendScheduler::Link
+ *
+ *  Description:
+ *      This function will insert an entry into the slot corresponding to
+ *      the tick at which it is due.
+ *
+ *  Parameters:
+ *      entry [in]
+ *          The entry to insert.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      Entries due beyond the span of the wheel are placed in the slot of
+ *      the highest level that is furthest away and are moved again as the
+ *      wheel turns.
+ */
+void SendScheduler::Link(std::size_t entry)
+{
+    constexpr std::uint64_t Wheel_Span =
+        (std::uint64_t{1} << (Wheel_Levels * Wheel_Slot_Bits)) - 1;
+    std::uint64_t due_tick = entries[entry].due;
+    std::size_t level = 0;
+
+    // Find the lowest level spanning the ticks until the entry is due
+    if (due_tick - tick > Wheel_Span) due_tick = tick + Wheel_Span;
+    while ((level < Wheel_Levels - 1) &&
+           ((due_tick - tick) >> ((level + 1) * Wheel_Slot_Bits)))
+    {
+        level++;
+    }
+
+    const std::size_t slot =
+        level * Slot_Count +
+        ((due_tick >> (level * Wheel_Slot_Bits)) % Slot_Count);
+
+    entries[entry].slot = slot;
+    entries[entry].previous = No_Entry;
+    entries[entry].next = slots[slot];
+    if (slots[slot] != No_Entry) entries[slots[slot]].previous = entry;
+    slots[slot] = entry;
+}
+
+/*
+ *  SendScheduler::Unlink
+ *
+ *  Description:
+ *      This function will remove an entry from its slot.
+ *
+ *  Parameters:
+ *      entry [in]
+ *          The entry to remove.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SendScheduler::Unlink(std::size_t entry)
+{
+    const std::size_t previous = entries[entry].previous;
+    const std::size_t next = entries[entry].next;
+
+    if (previous != No_Entry)
+    {
+        entries[previous].next = next;
+    }
+    else
+    {
+        slots[entries[entry].slot] = next;
+    }
+    if (next != No_Entry) entries[next].previous = previous;
+}
+
+/*
+ *  SendScheduler::Detach
+ *
+ *  Description:
+ *      This function will empty a slot, returning its list of entries.
+ *
+ *  Parameters:
+ *      slot [in]
+ *          The slot to empty.
+ *
+ *  Returns:
+ *      The first entry in the slot's list or No_Entry if it was empty.  The
+ *      remaining entries are reached through each entry's next field.
+ *
+ *  Comments:
+ *      None.
+ */
+std::size_t SendScheduler::Detach(std::size_t slot)
+{
+    const std::size_t first = slots[slot];
+
+    slots[slot] = No_Entry;
+
+    return first;
+}
+
+/*
+ *  SendScheduler::Cascade
+ *
+ *  Description:
+ *      This function will move the entries in the current slot of the given
+ *      level to the slots of lower levels.
+ *
+ *  Parameters:
+ *      level [in]
+ *          The level whose current slot is to be cascaded.
+ *
+ *  Returns:
+ *      Nothing.
+ *
+ *  Comments:
+ *      None.
+ */
+void SendScheduler::Cascade(std::size_t level)
+{
+    const std::size_t slot =
+        level * Slot_Count +
+        ((tick >> (level * Wheel_Slot_Bits)) % Slot_Count);
+
+    for (std::size_t entry = Detach(slot); entry != No_Entry;)
+    {
+        const std::size_t next = entries[entry].next;
+
+        Link(entry);
+
+        entry = next;
+    }
+}
+
+} // namespace gs
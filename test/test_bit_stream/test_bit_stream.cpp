@@ -0,0 +1,178 @@
+/*
+ *  test_bit_stream.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the BitWriter and BitReader objects.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "bit_stream.h"
+
+namespace {
+
+    // Test that values spanning octets are written most significant first
+    TEST(BitStreamTest, Write_Octets)
+    {
+        gs::DataBuffer data_buffer(16);
+        gs::BitWriter writer(data_buffer);
+
+        writer.Write(0x5, 3);
+        writer.WriteBoolean(true);
+        writer.Write(0xabc, 12);
+        writer.Write(0x3, 2);
+
+        // Nothing is written until the accumulator is flushed
+        ASSERT_EQ(writer.GetBitLength(), 18);
+        ASSERT_EQ(data_buffer.GetDataLength(), 0);
+
+        ASSERT_EQ(writer.Flush(), 3);
+        ASSERT_EQ(writer.GetBitLength(), 24);
+        ASSERT_EQ(data_buffer.GetDataLength(), 3);
+
+        // 101 1 101010111100 11 (padded with six zero bits)
+        ASSERT_EQ(data_buffer[0], 0xba);
+        ASSERT_EQ(data_buffer[1], 0xbc);
+        ASSERT_EQ(data_buffer[2], 0xc0);
+    }
+
+    // Test that values of every width round-trip
+    TEST(BitStreamTest, Round_Trip)
+    {
+        gs::DataBuffer data_buffer(1500);
+        gs::BitWriter writer(data_buffer);
+        std::uint64_t value = 0x0123456789abcdef;
+
+        for (unsigned bits = 0; bits <= 64; bits++)
+        {
+            writer.Write(value, bits);
+            value = value * 6364136223846793005 + 1442695040888963407;
+        }
+        const std::size_t octets = writer.Flush();
+        ASSERT_EQ(octets, (64 * 65 / 2 + 7) / 8);
+        ASSERT_EQ(data_buffer.GetDataLength(), octets);
+
+        gs::BitReader reader(data_buffer);
+        value = 0x0123456789abcdef;
+
+        for (unsigned bits = 0; bits <= 64; bits++)
+        {
+            const std::uint64_t mask =
+                (bits == 64) ? ~std::uint64_t(0)
+                             : (std::uint64_t(1) << bits) - 1;
+            ASSERT_EQ(reader.Read(bits), value & mask);
+            value = value * 6364136223846793005 + 1442695040888963407;
+        }
+
+        ASSERT_EQ(reader.Align(), octets);
+        ASSERT_EQ(data_buffer.GetReadLength(), octets);
+    }
+
+    // Test that byte-aligned data may follow bit-packed data
+    TEST(BitStreamTest, Align)
+    {
+        gs::DataBuffer data_buffer(16);
+        gs::BitWriter writer(data_buffer);
+
+        writer.WriteBoolean(true);
+        writer.WriteBoolean(false);
+        writer.WriteBoolean(true);
+        ASSERT_EQ(writer.Flush(), 1);
+        data_buffer.AppendValue(std::uint16_t(0x1234));
+
+        gs::BitReader reader(data_buffer);
+        ASSERT_TRUE(reader.ReadBoolean());
+        ASSERT_FALSE(reader.ReadBoolean());
+        ASSERT_TRUE(reader.ReadBoolean());
+        ASSERT_EQ(reader.Align(), 1);
+
+        std::uint16_t value{};
+        data_buffer.ReadValue(value);
+        ASSERT_EQ(value, 0x1234);
+    }
+
+    // Test writing into a buffer too small for whole 64-bit stores
+    TEST(BitStreamTest, Small_Buffer)
+    {
+        gs::DataBuffer data_buffer(3);
+        gs::BitWriter writer(data_buffer);
+
+        writer.Write(0xfff, 12);
+        writer.Write(0x0ff, 12);
+        ASSERT_EQ(writer.Flush(), 3);
+        ASSERT_EQ(data_buffer[0], 0xff);
+        ASSERT_EQ(data_buffer[1], 0xf0);
+        ASSERT_EQ(data_buffer[2], 0xff);
+
+        // There is no room for more data
+        writer.Write(0x1, 1);
+        ASSERT_THROW(writer.Flush(), gs::DataBufferException);
+
+        // Reading beyond the data is an error
+        gs::BitReader reader(data_buffer);
+        ASSERT_EQ(reader.Read(20), 0xfff0f);
+        ASSERT_EQ(reader.Read(4), 0xf);
+        ASSERT_THROW(reader.Read(1), gs::DataBufferException);
+    }
+
+    // Test that a zero-length buffer is used only to count octets
+    TEST(BitStreamTest, Count_Only)
+    {
+        gs::DataBuffer data_buffer;
+        gs::BitWriter writer(data_buffer);
+
+        for (unsigned i = 0; i < 100; i++) writer.Write(i, 7);
+
+        ASSERT_EQ(writer.Flush(), 88);
+        ASSERT_EQ(data_buffer.GetDataLength(), 0);
+    }
+
+    // Test that invalid bit counts are rejected
+    TEST(BitStreamTest, Invalid_Bits)
+    {
+        gs::DataBuffer data_buffer(16);
+        gs::BitWriter writer(data_buffer);
+        gs::BitReader reader(data_buffer);
+
+        ASSERT_THROW(writer.Write(0, 65), gs::DataBufferException);
+        ASSERT_THROW(reader.Read(65), gs::DataBufferException);
+    }
+
+} // namespace
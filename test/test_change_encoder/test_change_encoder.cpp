@@ -0,0 +1,198 @@
+/*
+ *  test_change_encoder.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the ChangeEncoder object, which encodes only those
+ *      objects whose state has changed since last sent.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "change_encoder.h"
+
+namespace {
+
+    // The fixture for testing the ChangeEncoder object
+    class ChangeEncoderTest : public ::testing::Test
+    {
+        public:
+            ChangeEncoderTest()
+            {
+                for (std::uint64_t i = 0; i < 10; i++)
+                {
+                    gs::Object1 object1{};
+                    object1.id.value = i;
+                    object1.time = 100;
+                    object1.position = {1.0f, 2.0f, 3.0f};
+                    object1.scale = {1.0f, 1.0f, 1.0f};
+                    objects.push_back(object1);
+                }
+
+                gs::Hand2 hand2{};
+                hand2.id.value = 20;
+                hand2.location = {1.0f, 2.0f, 3.0f, {0.5f}, {0.5f}, {0.5f}};
+                objects.push_back(hand2);
+
+                gs::Mesh1 mesh1{};
+                mesh1.id.value = 30;
+                mesh1.vertices = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+                mesh1.triangles = {{0}, {1}, {1}};
+                objects.push_back(mesh1);
+            }
+
+            ~ChangeEncoderTest() = default;
+
+        protected:
+            gs::Encoder encoder;
+            gs::Decoder decoder;
+            gs::GSObjects objects;
+    };
+
+    // Test that objects are sent once and then only when changed
+    TEST_F(ChangeEncoderTest, Unchanged)
+    {
+        gs::ChangeEncoder change_encoder;
+        gs::DataBuffer expected(1500);
+        gs::DataBuffer buffer1(1500);
+
+        // All objects are sent initially
+        const auto result = encoder.Encode(expected, objects);
+        ASSERT_EQ(change_encoder.Encode(buffer1, objects), result);
+        ASSERT_EQ(buffer1, expected);
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), 0);
+
+        // Nothing is sent when nothing changes, even as time advances
+        for (auto &object : objects)
+        {
+            if (std::holds_alternative<gs::Object1>(object))
+            {
+                std::get<gs::Object1>(object).time = 200;
+            }
+        }
+        gs::DataBuffer buffer2(1500);
+        ASSERT_EQ(change_encoder.Encode(buffer2, objects),
+                  gs::EncodeResult(objects.size(), 0));
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), objects.size());
+
+        // Only changed objects are sent
+        std::get<gs::Object1>(objects[3]).active = true;
+        std::get<gs::Hand2>(objects[10]).index.tip.tx.value = 0.01f;
+        std::get<gs::Mesh1>(objects[11]).triangles[2].value = 0;
+        gs::DataBuffer buffer3(1500);
+        gs::GSObjects decoded;
+        ASSERT_EQ(change_encoder.Encode(buffer3, objects).first,
+                  objects.size());
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), objects.size() - 3);
+        decoder.Decode(buffer3, decoded);
+        ASSERT_EQ(decoded.size(), 3);
+        ASSERT_EQ(std::get<gs::Object1>(decoded[0]).id.value, 3);
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(decoded[1]));
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded[2]));
+    }
+
+    // Test that small changes are suppressed by the tolerance
+    TEST_F(ChangeEncoderTest, Epsilon)
+    {
+        gs::ChangeEncoder change_encoder(0.01f);
+        gs::DataBuffer buffer1(1500);
+        const auto length = encoder.GetEncodeLength(objects[0]).second;
+
+        change_encoder.Encode(buffer1, objects);
+
+        // Drift is measured from the state last sent
+        auto &object1 = std::get<gs::Object1>(objects[0]);
+        object1.position.x += 0.006f;
+        gs::DataBuffer buffer2(1500);
+        ASSERT_EQ(change_encoder.Encode(buffer2, objects[0]),
+                  gs::EncodeResult(1, 0));
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), 1);
+
+        object1.position.x += 0.006f;
+        gs::DataBuffer buffer3(1500);
+        ASSERT_EQ(change_encoder.Encode(buffer3, objects[0]),
+                  gs::EncodeResult(1, length));
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), 0);
+    }
+
+    // Test forgetting the state sent
+    TEST_F(ChangeEncoderTest, Invalidate)
+    {
+        gs::ChangeEncoder change_encoder;
+        gs::DataBuffer buffer1(1500);
+
+        change_encoder.Encode(buffer1, objects);
+
+        ASSERT_TRUE(change_encoder.Invalidate(5));
+        ASSERT_TRUE(change_encoder.Invalidate(30));
+        ASSERT_FALSE(change_encoder.Invalidate(40));
+        gs::DataBuffer buffer2(1500);
+        change_encoder.Encode(buffer2, objects);
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), objects.size() - 2);
+
+        change_encoder.Reset();
+        gs::DataBuffer buffer3(1500);
+        ASSERT_EQ(change_encoder.Encode(buffer3, objects),
+                  encoder.GetEncodeLength(objects));
+    }
+
+    // Test that state is not remembered when objects do not fit
+    TEST_F(ChangeEncoderTest, Buffer_Full)
+    {
+        gs::ChangeEncoder change_encoder;
+        const auto length = encoder.GetEncodeLength(objects[0]).second;
+
+        // Computing the length does not remember the state
+        gs::DataBuffer null_buffer;
+        ASSERT_EQ(change_encoder.Encode(null_buffer, objects),
+                  encoder.GetEncodeLength(objects));
+
+        gs::DataBuffer buffer1(length * 2);
+        ASSERT_EQ(change_encoder.Encode(buffer1, objects),
+                  gs::EncodeResult(2, length * 2));
+
+        gs::DataBuffer buffer2(1500);
+        change_encoder.Encode(buffer2, objects);
+        ASSERT_EQ(change_encoder.GetUnchangedCount(), 2);
+    }
+
+} // namespace
@@ -0,0 +1,254 @@
+/*
+ *  test_compressor.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the Compressor object.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "compressor.h"
+
+namespace {
+
+    // Produce a buffer holding the given octets
+    gs::DataBuffer MakeBuffer(const std::vector<std::uint8_t> &octets)
+    {
+        gs::DataBuffer data_buffer(octets.size());
+
+        for (const auto octet : octets) data_buffer.AppendValue(octet);
+
+        return data_buffer;
+    }
+
+    // Test the exact form of a small compressed packet
+    TEST(CompressorTest, Compress_Block)
+    {
+        const std::string text = "abcabcabcabcabcabc";
+        gs::DataBuffer input(64);
+        gs::DataBuffer output(64);
+        gs::Compressor compressor;
+        gs::CompressionOptions options{};
+
+        std::vector<std::uint8_t> expected =
+        {
+            // Method, original length
+            0x01, 0x12,
+
+            // Three literals followed by a 15-octet match at offset 3
+            0x3b, 'a', 'b', 'c', 0x00, 0x03,
+
+            // Final sequence with no literals
+            0x00
+        };
+
+        input.AppendValue(text);
+        options.min_length = 0;
+
+        ASSERT_EQ(compressor.Compress(input, output, options),
+                  expected.size());
+        ASSERT_EQ(output.GetDataLength(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(output[i], expected[i]);
+        }
+
+        gs::DataBuffer decompressed(64);
+        ASSERT_EQ(compressor.Decompress(output, decompressed), text.size());
+        ASSERT_EQ(decompressed, input);
+        ASSERT_EQ(output.GetReadLength(), output.GetDataLength());
+    }
+
+    // Test compressing repetitive data with long literal and match runs
+    TEST(CompressorTest, Round_Trip)
+    {
+        std::mt19937 generator(1234);
+        std::uniform_int_distribution<int> distribution(0, 255);
+        gs::DataBuffer input(4000);
+        gs::DataBuffer output(gs::Compressor::GetMaxBlockLength(4000) + 8);
+        gs::DataBuffer decompressed(4000);
+        gs::Compressor compressor;
+
+        // Random literals, a long run of zeros, and repeated records
+        for (std::size_t i = 0; i < 600; i++)
+        {
+            input.AppendValue(
+                static_cast<std::uint8_t>(distribution(generator)));
+        }
+        for (std::size_t i = 0; i < 1000; i++)
+        {
+            input.AppendValue(std::uint8_t(0));
+        }
+        for (std::size_t i = 0; i < 2400; i++)
+        {
+            input.AppendValue(static_cast<std::uint8_t>((i % 24) * 7));
+        }
+
+        const std::size_t length = compressor.Compress(input, output);
+        ASSERT_GT(length, 0);
+        ASSERT_LT(length, 1000);
+        ASSERT_EQ(output[0],
+                  static_cast<std::uint8_t>(gs::CompressionMethod::LZ));
+
+        ASSERT_EQ(compressor.Decompress(output, decompressed), 4000);
+        ASSERT_EQ(decompressed, input);
+
+        // The same compressor object produces the same output again
+        gs::DataBuffer second(output.GetBufferSize());
+        ASSERT_EQ(compressor.Compress(input, second), length);
+        ASSERT_EQ(second, output);
+    }
+
+    // Test that short and incompressible packets are stored
+    TEST(CompressorTest, Stored)
+    {
+        std::mt19937 generator(5678);
+        std::uniform_int_distribution<int> distribution(0, 255);
+        gs::DataBuffer small(16);
+        gs::DataBuffer random(1000);
+        gs::DataBuffer output(1100);
+        gs::DataBuffer decompressed(1100);
+        gs::Compressor compressor;
+
+        // Packets shorter than the minimum length are not compressed
+        small.AppendValue(std::string("aaaaaaaaaaaaaaaa"));
+        ASSERT_EQ(compressor.Compress(small, output), 17);
+        ASSERT_EQ(output[0],
+                  static_cast<std::uint8_t>(gs::CompressionMethod::Stored));
+        ASSERT_EQ(compressor.Decompress(output, decompressed), 16);
+        ASSERT_EQ(decompressed, small);
+
+        // Packets that do not compress well are not compressed
+        for (std::size_t i = 0; i < 1000; i++)
+        {
+            random.AppendValue(
+                static_cast<std::uint8_t>(distribution(generator)));
+        }
+        output.SetDataLength(0);
+        output.ResetReadLength();
+        decompressed.SetDataLength(0);
+        ASSERT_EQ(compressor.Compress(random, output), 1001);
+        ASSERT_EQ(output[0],
+                  static_cast<std::uint8_t>(gs::CompressionMethod::Stored));
+        ASSERT_EQ(compressor.Decompress(output, decompressed), 1000);
+        ASSERT_EQ(decompressed, random);
+
+        // An empty packet is stored as just the method octet
+        gs::DataBuffer empty(0);
+        output.SetDataLength(0);
+        output.ResetReadLength();
+        decompressed.SetDataLength(0);
+        ASSERT_EQ(compressor.Compress(empty, output), 1);
+        ASSERT_EQ(compressor.Decompress(output, decompressed), 0);
+    }
+
+    // Test that nothing is written if the output buffer is too small
+    TEST(CompressorTest, Insufficient_Space)
+    {
+        gs::DataBuffer input(256);
+        gs::DataBuffer output(8);
+        gs::DataBuffer decompressed(100);
+        gs::Compressor compressor;
+
+        input.AppendValue(std::string(200, 'x'));
+        ASSERT_EQ(compressor.Compress(input, output), 0);
+        ASSERT_EQ(output.GetDataLength(), 0);
+
+        gs::DataBuffer large(16);
+        ASSERT_GT(compressor.Compress(input, large), 0);
+        ASSERT_THROW(compressor.Decompress(large, decompressed),
+                     gs::CompressorException);
+    }
+
+    // Test that malformed packets are rejected
+    TEST(CompressorTest, Malformed)
+    {
+        gs::DataBuffer output(100);
+        gs::Compressor compressor;
+
+        // Unknown method, missing method, and empty block
+        gs::DataBuffer unknown = MakeBuffer({0x02, 0x00});
+        ASSERT_THROW(compressor.Decompress(unknown, output),
+                     gs::CompressorException);
+        gs::DataBuffer missing = MakeBuffer({});
+        ASSERT_THROW(compressor.Decompress(missing, output),
+                     gs::CompressorException);
+        gs::DataBuffer empty = MakeBuffer({0x01, 0x04});
+        ASSERT_THROW(compressor.Decompress(empty, output),
+                     gs::CompressorException);
+
+        // Match offset beyond the start of the data
+        gs::DataBuffer offset = MakeBuffer({0x01, 0x08, 0x20, 'a', 'b',
+                                            0x00, 0x03, 0x00});
+        ASSERT_THROW(compressor.Decompress(offset, output),
+                     gs::CompressorException);
+
+        // Literals extending beyond the end of the block
+        gs::DataBuffer literals = MakeBuffer({0x01, 0x08, 0x50, 'a', 'b'});
+        ASSERT_THROW(compressor.Decompress(literals, output),
+                     gs::CompressorException);
+
+        // Block producing fewer octets than the original length
+        gs::DataBuffer length = MakeBuffer({0x01, 0x08, 0x20, 'a', 'b',
+                                            0x00, 0x02, 0x00});
+        ASSERT_THROW(compressor.Decompress(length, output),
+                     gs::CompressorException);
+
+        // Block producing more octets than the original length
+        gs::DataBuffer excess = MakeBuffer({0x01, 0x04, 0x20, 'a', 'b',
+                                            0x00, 0x02, 0x00});
+        ASSERT_THROW(compressor.Decompress(excess, output),
+                     gs::CompressorException);
+
+        // Truncated match offset
+        gs::DataBuffer truncated = MakeBuffer({0x01, 0x08, 0x20, 'a', 'b',
+                                               0x00});
+        ASSERT_THROW(compressor.Decompress(truncated, output),
+                     gs::CompressorException);
+
+        // A valid block decodes
+        gs::DataBuffer valid = MakeBuffer({0x01, 0x06, 0x20, 'a', 'b',
+                                           0x00, 0x02, 0x00});
+        ASSERT_EQ(compressor.Decompress(valid, output), 6);
+    }
+
+} // namespace
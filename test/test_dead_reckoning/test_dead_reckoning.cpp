@@ -0,0 +1,200 @@
+/*
+ *  test_dead_reckoning.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the DeadReckoningEncoder and
+ *      DeadReckoningExtrapolator objects.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "dead_reckoning.h"
+
+namespace {
+
+    // Create a hand moving along the x axis at the given time
+    gs::Hand2 MakeHand(gs::Time1 time, float x, float vx)
+    {
+        gs::Hand2 hand2{};
+        hand2.id.value = 1;
+        hand2.time = time;
+        hand2.location = {x, 1.0f, 0.0f, {0.0f}, {vx}, {0.0f}};
+        return hand2;
+    }
+
+    // Test predicting a position, including when time wraps
+    TEST(DeadReckoningTest, Predict_Location)
+    {
+        const gs::Loc2 location{1.0f, 2.0f, 3.0f, {-2.0f}, {1.0f}, {0.5f}};
+
+        gs::Loc1 predicted = gs::PredictLocation(location, 65000, 536);
+        ASSERT_FLOAT_EQ(predicted.x, 2.072f);
+        ASSERT_FLOAT_EQ(predicted.y, -0.144f);
+        ASSERT_FLOAT_EQ(predicted.z, 3.536f);
+
+        predicted = gs::PredictLocation(location, 1000, 500);
+        ASSERT_FLOAT_EQ(predicted.x, 0.5f);
+        ASSERT_FLOAT_EQ(predicted.y, 3.0f);
+        ASSERT_FLOAT_EQ(predicted.z, 2.75f);
+    }
+
+    // Test that smooth motion is suppressed and changes are sent
+    TEST(DeadReckoningTest, Suppress)
+    {
+        gs::DeadReckoningEncoder encoder;
+        gs::DeadReckoningExtrapolator extrapolator;
+        gs::Decoder decoder;
+        std::size_t sent{};
+
+        // Move at a constant 1 m/s, sampled every 10 ms
+        for (gs::Time1 time = 0; time < 500; time += 10)
+        {
+            gs::DataBuffer buffer(1500);
+            gs::GSObject object;
+
+            const auto hand2 = MakeHand(time, time / 1000.0f, 1.0f);
+            const auto result = encoder.Encode(buffer, hand2);
+            ASSERT_EQ(result.first, 1);
+            if (result.second == 0)
+            {
+                ASSERT_EQ(encoder.GetSuppressedCount(), 1);
+                continue;
+            }
+
+            decoder.Decode(buffer, object);
+            extrapolator.Update(object);
+            sent++;
+        }
+        ASSERT_EQ(sent, 1);
+
+        // The receiver's prediction matches the actual position
+        const auto predicted = extrapolator.Predict(1, 490);
+        ASSERT_TRUE(predicted);
+        ASSERT_NEAR(predicted->x, 0.49f, 0.01f);
+        ASSERT_FALSE(extrapolator.Predict(2, 490));
+
+        // A change in direction is sent once the error grows
+        gs::DataBuffer buffer1(1500);
+        ASSERT_EQ(encoder.Encode(buffer1, MakeHand(500, 0.495f, 0.0f)).second,
+                  0);
+        gs::DataBuffer buffer2(1500);
+        ASSERT_GT(encoder.Encode(buffer2, MakeHand(510, 0.49f, 0.0f)).second,
+                  0);
+
+        // A change in rotation is sent
+        auto hand2 = MakeHand(520, 0.49f, 0.0f);
+        hand2.rotation.si.value = 0.5f;
+        gs::DataBuffer buffer3(1500);
+        ASSERT_GT(encoder.Encode(buffer3, hand2).second, 0);
+
+        // Objects without velocity are always sent
+        gs::Object1 object1{};
+        gs::DataBuffer buffer4(1500);
+        gs::GSObjects objects{object1, object1, hand2};
+        ASSERT_EQ(encoder.Encode(buffer4, objects).first, 3);
+        ASSERT_EQ(encoder.GetSuppressedCount(), 1);
+    }
+
+    // Test that updates are sent after the maximum interval
+    TEST(DeadReckoningTest, Max_Interval)
+    {
+        gs::DeadReckoningThresholds thresholds;
+        thresholds.max_interval = 100;
+        gs::DeadReckoningEncoder encoder(thresholds);
+        std::size_t sent{};
+
+        for (gs::Time1 time = 0; time < 1000; time += 10)
+        {
+            gs::DataBuffer buffer(1500);
+            if (encoder.Encode(buffer, MakeHand(time, 0.0f, 0.0f)).second)
+            {
+                sent++;
+            }
+        }
+        ASSERT_EQ(sent, 10);
+
+        // Forgetting the state causes the object to be sent
+        gs::DataBuffer buffer(1500);
+        ASSERT_TRUE(encoder.Invalidate(1));
+        ASSERT_FALSE(encoder.Invalidate(1));
+        ASSERT_GT(encoder.Encode(buffer, MakeHand(1000, 0.0f, 0.0f)).second,
+                  0);
+
+        // Intervals beyond half the range of Time1 are rejected
+        thresholds.max_interval = 32767;
+        ASSERT_NO_THROW(gs::DeadReckoningEncoder{thresholds});
+        thresholds.max_interval = 32768;
+        ASSERT_THROW(gs::DeadReckoningEncoder{thresholds},
+                     gs::EncoderException);
+    }
+
+    // Test that states arriving out of order do not replace newer states,
+    // including when time wraps
+    TEST(DeadReckoningTest, Out_Of_Order)
+    {
+        gs::DeadReckoningExtrapolator extrapolator;
+
+        ASSERT_TRUE(extrapolator.Update(MakeHand(65500, 0.0f, 1.0f)));
+        ASSERT_TRUE(extrapolator.Update(MakeHand(100, 0.136f, 0.0f)));
+
+        // Older and repeated states are ignored
+        ASSERT_FALSE(extrapolator.Update(MakeHand(65500, 0.0f, 1.0f)));
+        ASSERT_FALSE(extrapolator.Update(MakeHand(50, 0.086f, 1.0f)));
+        ASSERT_FALSE(extrapolator.Update(MakeHand(100, 0.136f, 1.0f)));
+
+        auto predicted = extrapolator.Predict(1, 200);
+        ASSERT_TRUE(predicted);
+        ASSERT_FLOAT_EQ(predicted->x, 0.136f);
+
+        // A newer state is recorded
+        ASSERT_TRUE(extrapolator.Update(MakeHand(150, 0.136f, 1.0f)));
+        predicted = extrapolator.Predict(1, 200);
+        ASSERT_TRUE(predicted);
+        ASSERT_FLOAT_EQ(predicted->x, 0.186f);
+
+        // Objects without a velocity are not recorded
+        ASSERT_FALSE(extrapolator.Update(gs::Object1{}));
+    }
+
+} // namespace
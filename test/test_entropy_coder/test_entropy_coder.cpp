@@ -0,0 +1,239 @@
+/*
+ *  test_entropy_coder.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the EntropyCoder object.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "entropy_coder.h"
+#include "compressor.h"
+
+namespace {
+
+    // Produce octets skewed toward small values, like quantized deltas
+    std::vector<unsigned char> SkewedData(std::size_t length,
+                                          unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::geometric_distribution<int> distribution(0.3);
+        std::vector<unsigned char> data(length);
+
+        for (auto &octet : data)
+        {
+            octet = static_cast<unsigned char>(
+                std::min(distribution(generator), 255));
+        }
+
+        return data;
+    }
+
+    // Produce a coder trained on skewed data
+    gs::EntropyCoder TrainedCoder()
+    {
+        const std::vector<unsigned char> training = SkewedData(20000, 1);
+        gs::DataBuffer data_buffer(training.size());
+        gs::SymbolCounts counts{};
+
+        data_buffer.AppendValue(training.data(), training.size());
+        gs::EntropyCoder::CountSymbols(data_buffer, counts);
+
+        return gs::EntropyCoder(counts);
+    }
+
+    // Test construction of the frequency tables
+    TEST(EntropyCoderTest, Frequencies)
+    {
+        const gs::EntropyCoder uniform;
+        const gs::EntropyCoder trained = TrainedCoder();
+        const std::uint32_t total = 1 << gs::EntropyCoder::Scale_Bits;
+
+        for (const auto f : uniform.GetFrequencies()) ASSERT_EQ(f, 16);
+
+        // Every symbol may be coded and the frequencies fill the range
+        const auto &frequencies = trained.GetFrequencies();
+        for (const auto f : frequencies) ASSERT_GE(f, 1);
+        ASSERT_EQ(std::accumulate(frequencies.begin(),
+                                  frequencies.end(),
+                                  std::uint32_t(0)),
+                  total);
+        ASSERT_GT(frequencies[0], frequencies[1]);
+        ASSERT_GT(frequencies[1], frequencies[8]);
+
+        // A table of scaled frequencies reproduces the coder
+        gs::SymbolCounts counts{};
+        for (std::size_t i = 0; i < counts.size(); i++)
+        {
+            counts[i] = frequencies[i];
+        }
+        ASSERT_EQ(gs::EntropyCoder(counts).GetFrequencies(), frequencies);
+    }
+
+    // Test encoding and decoding data of various lengths
+    TEST(EntropyCoderTest, Round_Trip)
+    {
+        const gs::EntropyCoder coder = TrainedCoder();
+
+        for (std::size_t length : {0, 1, 2, 3, 17, 1000, 5000})
+        {
+            const std::vector<unsigned char> data = SkewedData(length, 2);
+            std::vector<unsigned char> encoded(
+                gs::EntropyCoder::GetMaxEncodedLength(length));
+            std::vector<unsigned char> decoded(length);
+
+            const std::size_t encoded_length = coder.Encode(data.data(),
+                                                            length,
+                                                            encoded.data(),
+                                                            encoded.size());
+            coder.Decode(encoded.data(),
+                         encoded_length,
+                         decoded.data(),
+                         length);
+            ASSERT_EQ(decoded, data);
+
+            // Skewed data codes to well under half its length
+            if (length >= 1000)
+            {
+                ASSERT_LT(encoded_length, length / 2);
+            }
+        }
+    }
+
+    // Test that data unlike the training data can still be coded
+    TEST(EntropyCoderTest, Untrained_Data)
+    {
+        const gs::EntropyCoder coder = TrainedCoder();
+        std::vector<unsigned char> data(1000);
+        std::vector<unsigned char> encoded(
+            gs::EntropyCoder::GetMaxEncodedLength(data.size()));
+        std::vector<unsigned char> decoded(data.size());
+
+        for (std::size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = static_cast<unsigned char>(255 - (i % 64));
+        }
+
+        const std::size_t encoded_length = coder.Encode(data.data(),
+                                                        data.size(),
+                                                        encoded.data(),
+                                                        encoded.size());
+        coder.Decode(encoded.data(),
+                     encoded_length,
+                     decoded.data(),
+                     decoded.size());
+        ASSERT_EQ(decoded, data);
+    }
+
+    // Test that corrupt and truncated data is detected
+    TEST(EntropyCoderTest, Corrupt)
+    {
+        const gs::EntropyCoder coder = TrainedCoder();
+        const std::vector<unsigned char> data = SkewedData(500, 3);
+        std::vector<unsigned char> encoded(
+            gs::EntropyCoder::GetMaxEncodedLength(data.size()));
+        std::vector<unsigned char> decoded(data.size());
+
+        const std::size_t encoded_length = coder.Encode(data.data(),
+                                                        data.size(),
+                                                        encoded.data(),
+                                                        encoded.size());
+
+        ASSERT_THROW(coder.Decode(encoded.data(),
+                                  encoded_length - 1,
+                                  decoded.data(),
+                                  decoded.size()),
+                     gs::EntropyCoderException);
+        ASSERT_THROW(coder.Decode(encoded.data(),
+                                  4,
+                                  decoded.data(),
+                                  decoded.size()),
+                     gs::EntropyCoderException);
+
+        // Decoding with a different table fails the final state check
+        ASSERT_THROW(gs::EntropyCoder().Decode(encoded.data(),
+                                               encoded_length,
+                                               decoded.data(),
+                                               decoded.size()),
+                     gs::EntropyCoderException);
+
+        // Insufficient output space
+        ASSERT_THROW(coder.Encode(data.data(),
+                                  data.size(),
+                                  encoded.data(),
+                                  encoded_length - 1),
+                     gs::EntropyCoderException);
+    }
+
+    // Test selection of entropy coding by the Compressor
+    TEST(EntropyCoderTest, Compressor)
+    {
+        const std::vector<unsigned char> data = SkewedData(1000, 4);
+        gs::DataBuffer input(data.size());
+        gs::DataBuffer output(2000);
+        gs::DataBuffer decompressed(data.size());
+        gs::Compressor compressor;
+        gs::Compressor receiver;
+        gs::CompressionOptions options{};
+
+        input.AppendValue(data.data(), data.size());
+        compressor.SetEntropyCoder(TrainedCoder());
+        options.entropy_coding = true;
+
+        // Entropy coding beats LZ on skewed data without repetition
+        const std::size_t length = compressor.Compress(input, output, options);
+        ASSERT_GT(length, 0);
+        ASSERT_LT(length, data.size() / 2);
+        ASSERT_EQ(output[0],
+                  static_cast<std::uint8_t>(gs::CompressionMethod::Entropy));
+
+        // The receiver requires the same table
+        ASSERT_THROW(receiver.Decompress(output, decompressed),
+                     gs::CompressorException);
+        receiver.SetEntropyCoder(TrainedCoder());
+        output.ResetReadLength();
+        ASSERT_EQ(receiver.Decompress(output, decompressed), data.size());
+        ASSERT_EQ(decompressed, input);
+    }
+
+} // namespace
@@ -44,9 +44,11 @@
 #include <cstring>
 #include <cstdint>
 #include <cstddef>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 #include "gs_api.h"
+#include "gs_encoder.h"
 
 namespace {
 
@@ -592,6 +594,81 @@ namespace {
         ASSERT_EQ(GSDecoderDestroy(context), 0);
     }
 
+    TEST_F(GSAPITest, Test_Decode_PlayerFrame1)
+    {
+        gs::Encoder encoder;
+        gs::DataBuffer buffer(1500);
+        gs::PlayerFrame1 player_frame1{};
+        gs::ObjectEncoding encoding{};
+        GS_Object object;
+
+        player_frame1.head.id.value = 1;
+        player_frame1.left.id.value = 2;
+        player_frame1.left.left = true;
+        player_frame1.right.id.value = 3;
+        encoding.rotation_bits = 12;
+        encoding.joint_bits = 8;
+        ASSERT_EQ(encoder.Encode(buffer, player_frame1, encoding).first, 1);
+
+        // Create the decoder context
+        GS_Decoder_Context *context;
+        ASSERT_EQ(GSDecoderInit(&context,
+                                buffer.GetMutableBufferPointer(),
+                                buffer.GetDataLength()),
+                  0);
+
+        // The head is followed by the left and right hands
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.type, GS_Tag_Head1);
+        ASSERT_EQ(object.u.head1.id, 1);
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.type, GS_Tag_Hand2);
+        ASSERT_EQ(object.u.hand2.id, 2);
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.type, GS_Tag_Hand2);
+        ASSERT_EQ(object.u.hand2.id, 3);
+        ASSERT_EQ(GSDecodeObject(context, &object), 0);
+
+        // Hands not yet returned are discarded when the buffer is reset
+        ASSERT_EQ(GSDecoderResetBuffer(context, buffer.GetDataLength()), 0);
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.type, GS_Tag_Head1);
+        ASSERT_EQ(GSDecoderResetBuffer(context, buffer.GetDataLength()), 0);
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.type, GS_Tag_Head1);
+        ASSERT_EQ(GSDecodeObject(context, &object), 1);
+        ASSERT_EQ(object.u.hand2.id, 2);
+
+        // Destroy the decoder context
+        ASSERT_EQ(GSDecoderDestroy(context), 0);
+    }
+
+    TEST_F(GSAPITest, Test_Decode_Invalid_Mesh_Index)
+    {
+        gs::Encoder encoder;
+        gs::DataBuffer buffer(1500);
+        gs::Mesh1 mesh{};
+        GS_Object object;
+
+        // A triangle referring to a vertex the mesh does not have
+        mesh.id.value = 1;
+        mesh.vertices = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+        mesh.triangles = {{0}, {1}, {2}};
+        ASSERT_EQ(encoder.Encode(buffer, mesh).first, 1);
+
+        GS_Decoder_Context *context;
+        ASSERT_EQ(GSDecoderInit(&context,
+                                buffer.GetMutableBufferPointer(),
+                                buffer.GetDataLength()),
+                  0);
+
+        // The mesh is rejected rather than returned
+        ASSERT_EQ(GSDecodeObject(context, &object), -1);
+        ASSERT_NE(std::string(GetDecoderError(context)), "");
+
+        ASSERT_EQ(GSDecoderDestroy(context), 0);
+    }
+
     TEST_F(GSAPITest, Test_Decode_Head_IPD)
     {
         std::vector<std::uint8_t> expected =
@@ -44,7 +44,11 @@
 
 #include <cstring>
 #include <cstdint>
+#include <cmath>
+#include <algorithm>
 #include <cstddef>
+#include <limits>
+#include <optional>
 #include <variant>
 #include <vector>
 #include "gtest/gtest.h"
@@ -420,8 +424,10 @@ namespace {
         // Ensure we are at the start of the buffer
         ASSERT_EQ(data_buffer.GetReadLength(), 0);
 
-        // Decode the data buffer
-        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects), data_buffer.GetDataLength());
+        // Decode the data buffer (the indices do not refer to the vertices,
+        // so validation is declined)
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects, false),
+                  data_buffer.GetDataLength());
 
         // We should have found a single object
         ASSERT_EQ(decoded_objects.size(), 1);
@@ -809,4 +815,1037 @@ namespace {
         ASSERT_EQ(hand_decoded.pinky.tip.tz.value, hand2.pinky.tip.tz.value);
     }
 
+    // Test decoding a delta-coded CompactMesh1
+    TEST_F(GSDecoderTest, Test_CompactMesh1)
+    {
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        mesh.vertices.push_back({1.0f, 2.0f, 3.0f});
+        mesh.vertices.push_back({4.0f, 5.0f, 6.0f});
+        mesh.normals.push_back({{0.0f}, {1.0f}, {0.0f}});
+        mesh.textures.push_back({{1}, {129}});
+        mesh.triangles = {{20000}, {3}, {0xffff'ffff'ffff}, {0}, {1}, {2}};
+
+        // Encode the mesh using delta-coded indices
+        ASSERT_EQ(encoder.Encode(data_buffer, mesh, encoding).first, 1);
+
+        // Decode the data buffer (the indices do not refer to the vertices,
+        // so validation is declined)
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects, false),
+                  data_buffer.GetDataLength());
+
+        // Verify that what we got is a Mesh1 object
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded_objects.front()));
+
+        gs::Mesh1 &mesh_decoded = std::get<gs::Mesh1>(decoded_objects.front());
+
+        ASSERT_EQ(mesh_decoded.id.value, mesh.id.value);
+
+        ASSERT_EQ(mesh.vertices.size(), mesh_decoded.vertices.size());
+        for (std::size_t i = 0; i < mesh.vertices.size(); i++)
+        {
+            ASSERT_EQ(mesh.vertices[i].x, mesh_decoded.vertices[i].x);
+            ASSERT_EQ(mesh.vertices[i].y, mesh_decoded.vertices[i].y);
+            ASSERT_EQ(mesh.vertices[i].z, mesh_decoded.vertices[i].z);
+        }
+
+        ASSERT_EQ(mesh.normals.size(), mesh_decoded.normals.size());
+        ASSERT_EQ(mesh.textures.size(), mesh_decoded.textures.size());
+
+        ASSERT_EQ(mesh.triangles.size(), mesh_decoded.triangles.size());
+        for (std::size_t i = 0; i < mesh.triangles.size(); i++)
+        {
+            ASSERT_EQ(mesh.triangles[i].value, mesh_decoded.triangles[i].value);
+        }
+    }
+
+    // Test that unknown compact mesh encodings are rejected
+    TEST_F(GSDecoderTest, Test_CompactMesh1_Unknown_Flags)
+    {
+        std::vector<std::uint8_t> encoded =
+        {
+            // CompactMesh1 tag, length, id, and unknown flags
+            0xc0, 0x80, 0x03, 0x07, 0x1b, 0x7f,
+
+            // Empty vertices, normals, textures, and triangles
+            0x00, 0x00, 0x00, 0x00
+        };
+
+        gs::DataBuffer buffer(encoded.data(), encoded.size(), encoded.size());
+
+        ASSERT_THROW(decoder.Decode(buffer, decoded_objects),
+                     gs::DecoderException);
+    }
+
+    // Test decoding a CompactMesh1 having quantized vertex positions
+    TEST_F(GSDecoderTest, Test_CompactMesh1_Quantized)
+    {
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        for (std::size_t i = 0; i < 11; i++)
+        {
+            mesh.vertices.push_back({-2.0f + 0.37f * i,
+                                     10.0f - 1.5f * i,
+                                     0.125f * i * i});
+        }
+
+        for (std::uint8_t bits : {std::uint8_t(16), std::uint8_t(8)})
+        {
+            gs::DataBuffer buffer(1500);
+            gs::GSObjects objects;
+
+            encoding.position_bits = bits;
+
+            // Encode the mesh using quantized positions
+            ASSERT_EQ(encoder.Encode(buffer, mesh, encoding).first, 1);
+
+            // Decode the data buffer
+            ASSERT_EQ(decoder.Decode(buffer, objects), buffer.GetDataLength());
+            ASSERT_EQ(objects.size(), 1);
+            ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(objects.front()));
+
+            gs::Mesh1 &mesh_decoded = std::get<gs::Mesh1>(objects.front());
+
+            // Error is at most half of a quantization step per component
+            const float step_x = (1.0f + 0.37f * 10) / ((1 << bits) - 1);
+            const float step_y = (1.5f * 10) / ((1 << bits) - 1);
+            const float step_z = (0.125f * 100) / ((1 << bits) - 1);
+
+            ASSERT_EQ(mesh.vertices.size(), mesh_decoded.vertices.size());
+            for (std::size_t i = 0; i < mesh.vertices.size(); i++)
+            {
+                ASSERT_NEAR(mesh.vertices[i].x,
+                            mesh_decoded.vertices[i].x,
+                            step_x * 0.51f);
+                ASSERT_NEAR(mesh.vertices[i].y,
+                            mesh_decoded.vertices[i].y,
+                            step_y * 0.51f);
+                ASSERT_NEAR(mesh.vertices[i].z,
+                            mesh_decoded.vertices[i].z,
+                            step_z * 0.51f);
+            }
+        }
+    }
+
+
+    // Test decoding a CompactMesh1 having octahedral normals
+    TEST_F(GSDecoderTest, Test_CompactMesh1_Octahedral)
+    {
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        mesh.normals.push_back({{0.0f}, {0.0f}, {1.0f}});
+        mesh.normals.push_back({{0.6f}, {0.0f}, {-0.8f}});
+        mesh.normals.push_back({{0.0f}, {-1.0f}, {0.0f}});
+        encoding.normal_bits = 8;
+
+        // Each normal occupies two octets
+        ASSERT_EQ(encoder.GetEncodeLength(mesh, encoding).second, 17);
+
+        // Encode the mesh using octahedral normals
+        ASSERT_EQ(encoder.Encode(data_buffer, mesh, encoding),
+                  std::make_pair(std::size_t(1), std::size_t(17)));
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded_objects.front()));
+
+        gs::Mesh1 &mesh_decoded = std::get<gs::Mesh1>(decoded_objects.front());
+
+        ASSERT_EQ(mesh.normals.size(), mesh_decoded.normals.size());
+        for (std::size_t i = 0; i < mesh.normals.size(); i++)
+        {
+            ASSERT_NEAR(mesh.normals[i].x.value,
+                        mesh_decoded.normals[i].x.value,
+                        0.02f);
+            ASSERT_NEAR(mesh.normals[i].y.value,
+                        mesh_decoded.normals[i].y.value,
+                        0.02f);
+            ASSERT_NEAR(mesh.normals[i].z.value,
+                        mesh_decoded.normals[i].z.value,
+                        0.02f);
+        }
+    }
+
+
+    // Test decoding a CompactObject1 having a compressed rotation
+    TEST_F(GSDecoderTest, Test_CompactObject1)
+    {
+        gs::Object1 object1{};
+        gs::ObjectEncoding encoding{};
+
+        object1.id.value = 12;
+        object1.time = 0x0500;
+        object1.position = {1.0f, 2.0f, 3.0f};
+        object1.rotation.i.value = 0.5f;
+        object1.rotation.j.value = -0.5f;
+        object1.rotation.k.value = 0.25f;
+        object1.scale = {7.0f, 8.0f, 9.0f};
+        object1.active = true;
+        object1.parent = gs::ObjectID{0x1234};
+        encoding.rotation_bits = 12;
+
+        // Encode the object using a compressed rotation
+        ASSERT_EQ(encoder.Encode(data_buffer, object1, encoding).first, 1);
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(
+            std::holds_alternative<gs::Object1>(decoded_objects.front()));
+
+        gs::Object1 &decoded = std::get<gs::Object1>(decoded_objects.front());
+
+        ASSERT_EQ(decoded.id.value, object1.id.value);
+        ASSERT_EQ(decoded.time, object1.time);
+        ASSERT_EQ(decoded.position.x, object1.position.x);
+        ASSERT_EQ(decoded.position.y, object1.position.y);
+        ASSERT_EQ(decoded.position.z, object1.position.z);
+        ASSERT_NEAR(decoded.rotation.i.value, 0.5f, 0.001f);
+        ASSERT_NEAR(decoded.rotation.j.value, -0.5f, 0.001f);
+        ASSERT_NEAR(decoded.rotation.k.value, 0.25f, 0.001f);
+        ASSERT_EQ(decoded.scale.x, object1.scale.x);
+        ASSERT_EQ(decoded.scale.y, object1.scale.y);
+        ASSERT_EQ(decoded.scale.z, object1.scale.z);
+        ASSERT_EQ(decoded.active, object1.active);
+        ASSERT_TRUE(decoded.parent.has_value());
+        ASSERT_EQ(decoded.parent.value().value, 0x1234);
+    }
+
+    // Test decoding a CompactHead1 having a compressed rotation
+    TEST_F(GSDecoderTest, Test_CompactHead1)
+    {
+        gs::Head1 head1{};
+        gs::ObjectEncoding encoding{};
+
+        head1.id.value = 12;
+        head1.time = 0x0500;
+        head1.location.x = 1.1f;
+        head1.location.vx.value = 3.140625f;
+        head1.rotation.si.value = 0.0f;
+        head1.rotation.sj.value = 0.6f;
+        head1.rotation.sk.value = 0.0f;
+        head1.rotation.ei.value = -0.1f;
+        head1.rotation.ej.value = 0.2f;
+        head1.rotation.ek.value = -0.3f;
+        head1.ipd = gs::HeadIPD1{{0.0625f}};
+        encoding.rotation_bits = 16;
+
+        // Encode the object using a compressed rotation
+        ASSERT_EQ(encoder.Encode(data_buffer, head1, encoding).first, 1);
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Head1>(decoded_objects.front()));
+
+        gs::Head1 &decoded = std::get<gs::Head1>(decoded_objects.front());
+
+        ASSERT_EQ(decoded.id.value, head1.id.value);
+        ASSERT_EQ(decoded.time, head1.time);
+        ASSERT_EQ(decoded.location.x, head1.location.x);
+        ASSERT_EQ(decoded.location.vx.value, head1.location.vx.value);
+        ASSERT_NEAR(decoded.rotation.si.value, 0.0f, 0.0001f);
+        ASSERT_NEAR(decoded.rotation.sj.value, 0.6f, 0.0001f);
+        ASSERT_NEAR(decoded.rotation.sk.value, 0.0f, 0.0001f);
+        ASSERT_NEAR(decoded.rotation.ei.value, -0.1f, 0.0001f);
+        ASSERT_NEAR(decoded.rotation.ej.value, 0.2f, 0.0001f);
+        ASSERT_NEAR(decoded.rotation.ek.value, -0.3f, 0.0001f);
+        ASSERT_TRUE(decoded.ipd.has_value());
+        ASSERT_EQ(decoded.ipd.value().ipd.value, 0.0625f);
+    }
+
+    // Test decoding a CompactHand2 with and without rotation compression
+    TEST_F(GSDecoderTest, Test_CompactHand2)
+    {
+        gs::Hand2 hand2{};
+        gs::ObjectEncoding encoding{};
+
+        hand2.id.value = 12;
+        hand2.time = 0x0500;
+        hand2.left = true;
+        hand2.location.z = 30.0f;
+        hand2.rotation.sk.value = 0.5f;
+        hand2.rotation.ei.value = 0.25f;
+        hand2.wrist.ty.value = 3.140625f;
+        hand2.thumb.cmc.tz.value = 1.5f;
+        hand2.pinky.tip.tx.value = 3.140625f;
+
+        for (std::uint8_t bits : {std::uint8_t(0), std::uint8_t(10)})
+        {
+            gs::DataBuffer buffer(1500);
+            gs::GSObjects objects;
+
+            encoding.rotation_bits = bits;
+
+            // Encode the object
+            ASSERT_EQ(encoder.Encode(buffer, hand2, encoding).first, 1);
+
+            // Decode the data buffer
+            ASSERT_EQ(decoder.Decode(buffer, objects), buffer.GetDataLength());
+            ASSERT_EQ(objects.size(), 1);
+            ASSERT_TRUE(std::holds_alternative<gs::Hand2>(objects.front()));
+
+            gs::Hand2 &decoded = std::get<gs::Hand2>(objects.front());
+
+            // Uncompressed rotations are exact
+            const float tolerance = bits ? 0.002f : 0.0f;
+
+            ASSERT_EQ(decoded.id.value, hand2.id.value);
+            ASSERT_EQ(decoded.time, hand2.time);
+            ASSERT_EQ(decoded.left, hand2.left);
+            ASSERT_EQ(decoded.location.z, hand2.location.z);
+            ASSERT_NEAR(decoded.rotation.si.value, 0.0f, tolerance);
+            ASSERT_NEAR(decoded.rotation.sj.value, 0.0f, tolerance);
+            ASSERT_NEAR(decoded.rotation.sk.value, 0.5f, tolerance);
+            ASSERT_NEAR(decoded.rotation.ei.value, 0.25f, tolerance);
+            ASSERT_NEAR(decoded.rotation.ej.value, 0.0f, tolerance);
+            ASSERT_NEAR(decoded.rotation.ek.value, 0.0f, tolerance);
+            ASSERT_EQ(decoded.wrist.ty.value, hand2.wrist.ty.value);
+            ASSERT_EQ(decoded.thumb.cmc.tz.value, hand2.thumb.cmc.tz.value);
+            ASSERT_EQ(decoded.pinky.tip.tx.value, hand2.pinky.tip.tx.value);
+        }
+    }
+
+    // Test that invalid compact object encodings are rejected
+    TEST_F(GSDecoderTest, Test_CompactObject1_Invalid)
+    {
+        std::vector<std::uint8_t> unknown_flags =
+        {
+            // CompactObject1 tag, length, id, and unknown flags
+            0xc0, 0x80, 0x04, 0x02, 0x0c, 0x40
+        };
+
+        std::vector<std::uint8_t> invalid_bits =
+        {
+            // CompactObject1 tag, length, id, flags, and invalid bits
+            0xc0, 0x80, 0x04, 0x03, 0x0c, 0x01, 0x15
+        };
+
+        for (auto *encoded : {&unknown_flags, &invalid_bits})
+        {
+            gs::DataBuffer buffer(encoded->data(),
+                                  encoded->size(),
+                                  encoded->size());
+
+            ASSERT_THROW(decoder.Decode(buffer, decoded_objects),
+                         gs::DecoderException);
+        }
+    }
+
+
+    // Test decoding a CompactHand2 having quantized joints
+    TEST_F(GSDecoderTest, Test_CompactHand2_Joints)
+    {
+        gs::Hand2 hand2{};
+        gs::ObjectEncoding encoding{};
+
+        hand2.id.value = 12;
+        hand2.left = true;
+        hand2.wrist.tx.value = 0.01f;
+        hand2.thumb.tip.ty.value = -0.07f;
+        hand2.index.dip.tz.value = 0.12f;
+        hand2.middle.cmc.tx.value = -0.2f;
+        hand2.ring.pip.ty.value = 0.18f;
+        hand2.pinky.tip.tz.value = 0.3f;
+        encoding.rotation_bits = 10;
+        encoding.joint_bits = 12;
+        encoding.joint_range = 0.25f;
+
+        ASSERT_EQ(encoder.Encode(data_buffer, hand2, encoding).first, 1);
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(decoded_objects.front()));
+
+        gs::Hand2 &decoded = std::get<gs::Hand2>(decoded_objects.front());
+
+        // Error is at most half of a quantization step per component
+        const float tolerance = 0.51f * 0.5f / 4095.0f;
+
+        ASSERT_EQ(decoded.id.value, hand2.id.value);
+        ASSERT_EQ(decoded.left, hand2.left);
+        ASSERT_NEAR(decoded.wrist.tx.value, 0.01f, tolerance);
+        ASSERT_NEAR(decoded.wrist.ty.value, 0.0f, tolerance);
+        ASSERT_NEAR(decoded.thumb.tip.ty.value, -0.07f, tolerance);
+        ASSERT_NEAR(decoded.index.dip.tz.value, 0.12f, tolerance);
+        ASSERT_NEAR(decoded.middle.cmc.tx.value, -0.2f, tolerance);
+        ASSERT_NEAR(decoded.ring.pip.ty.value, 0.18f, tolerance);
+        ASSERT_NEAR(decoded.pinky.tip.tx.value, 0.0f, tolerance);
+
+        // Values beyond the range are clamped
+        ASSERT_NEAR(decoded.pinky.tip.tz.value, 0.25f, tolerance);
+    }
+
+
+    // Test decoding compact objects that omit default values
+    TEST_F(GSDecoderTest, Test_Compact_Presence)
+    {
+        gs::ObjectEncoding encoding{};
+
+        gs::Object1 object1{};
+        object1.id.value = 1;
+        object1.position = {1.0f, 2.0f, 3.0f};
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        object1.parent = gs::ObjectID{7};
+
+        gs::Head1 head1{};
+        head1.id.value = 2;
+        head1.rotation.ek.value = 0.5f;
+        head1.ipd = gs::HeadIPD1{{0.0625f}};
+
+        gs::Hand1 hand1{};
+        hand1.id.value = 3;
+        hand1.left = true;
+        hand1.location.x = 4.0f;
+
+        gs::Hand2 hand2{};
+        hand2.id.value = 4;
+        hand2.location.vy.value = 2.0f;
+        hand2.pinky.tip.tx.value = 0.125f;
+
+        encoding.omit_defaults = true;
+
+        // Encode each object compactly
+        ASSERT_EQ(encoder.Encode(data_buffer, object1, encoding).first, 1);
+        ASSERT_EQ(encoder.Encode(data_buffer, head1, encoding).first, 1);
+        ASSERT_EQ(encoder.Encode(data_buffer, hand1, encoding).first, 1);
+        ASSERT_EQ(encoder.Encode(data_buffer, hand2, encoding).first, 1);
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 4);
+
+        gs::Object1 &object1_decoded =
+            std::get<gs::Object1>(decoded_objects[0]);
+        ASSERT_EQ(object1_decoded.id.value, 1);
+        ASSERT_EQ(object1_decoded.position.z, 3.0f);
+        ASSERT_EQ(object1_decoded.rotation.i.value, 0.0f);
+        ASSERT_EQ(object1_decoded.scale.x, 1.0f);
+        ASSERT_EQ(object1_decoded.scale.y, 1.0f);
+        ASSERT_EQ(object1_decoded.scale.z, 1.0f);
+        ASSERT_FALSE(object1_decoded.active);
+        ASSERT_TRUE(object1_decoded.parent.has_value());
+        ASSERT_EQ(object1_decoded.parent.value().value, 7);
+
+        gs::Head1 &head1_decoded = std::get<gs::Head1>(decoded_objects[1]);
+        ASSERT_EQ(head1_decoded.id.value, 2);
+        ASSERT_EQ(head1_decoded.location.x, 0.0f);
+        ASSERT_EQ(head1_decoded.location.vx.value, 0.0f);
+        ASSERT_EQ(head1_decoded.rotation.ek.value, 0.5f);
+        ASSERT_TRUE(head1_decoded.ipd.has_value());
+        ASSERT_EQ(head1_decoded.ipd.value().ipd.value, 0.0625f);
+
+        gs::Hand1 &hand1_decoded = std::get<gs::Hand1>(decoded_objects[2]);
+        ASSERT_EQ(hand1_decoded.id.value, 3);
+        ASSERT_TRUE(hand1_decoded.left);
+        ASSERT_EQ(hand1_decoded.location.x, 4.0f);
+        ASSERT_EQ(hand1_decoded.location.vy.value, 0.0f);
+
+        gs::Hand2 &hand2_decoded = std::get<gs::Hand2>(decoded_objects[3]);
+        ASSERT_EQ(hand2_decoded.id.value, 4);
+        ASSERT_FALSE(hand2_decoded.left);
+        ASSERT_EQ(hand2_decoded.location.x, 0.0f);
+        ASSERT_EQ(hand2_decoded.location.vy.value, 2.0f);
+        ASSERT_EQ(hand2_decoded.pinky.tip.tx.value, 0.125f);
+    }
+
+    // Test that unknown presence bits are rejected
+    TEST_F(GSDecoderTest, Test_Compact_Presence_Unknown)
+    {
+        std::vector<std::uint8_t> encoded =
+        {
+            // CompactHand1 tag, length, id, flags, and presence with the
+            // Object1 scale bit set
+            0xc0, 0x80, 0x07, 0x05, 0x0c, 0x04, 0x08, 0x05, 0x00
+        };
+
+        gs::DataBuffer buffer(encoded.data(), encoded.size(), encoded.size());
+
+        ASSERT_THROW(decoder.Decode(buffer, decoded_objects),
+                     gs::DecoderException);
+    }
+
+
+    TEST_F(GSDecoderTest, Test_Compact_Omit_Velocity)
+    {
+        gs::ObjectEncoding encoding{};
+
+        gs::Hand2 hand2{};
+        hand2.id.value = 4;
+        hand2.location = {1.0f, 2.0f, 3.0f, {0.5f}, {0.25f}, {-0.5f}};
+
+        // Velocities may only be omitted using the field presence mask
+        encoding.omit_velocity = true;
+        ASSERT_THROW(encoder.Encode(data_buffer, hand2, encoding),
+                     gs::EncoderException);
+        encoding.omit_defaults = true;
+
+        // Omitting velocities saves the three Float16 values
+        encoding.omit_velocity = false;
+        const std::size_t length =
+            encoder.GetEncodeLength(hand2, encoding).second;
+        encoding.omit_velocity = true;
+        ASSERT_EQ(encoder.GetEncodeLength(hand2, encoding).second, length - 6);
+
+        // The decoded velocity is zero
+        ASSERT_EQ(encoder.Encode(data_buffer, hand2, encoding).first, 1);
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        const gs::Hand2 &decoded = std::get<gs::Hand2>(decoded_objects[0]);
+        ASSERT_EQ(decoded.location.x, 1.0f);
+        ASSERT_EQ(decoded.location.z, 3.0f);
+        ASSERT_EQ(decoded.location.vx.value, 0.0f);
+        ASSERT_EQ(decoded.location.vy.value, 0.0f);
+        ASSERT_EQ(decoded.location.vz.value, 0.0f);
+    }
+
+    // Test decoding a PlayerFrame1, which expands into three objects
+    TEST_F(GSDecoderTest, Test_PlayerFrame1)
+    {
+        gs::PlayerFrame1 player_frame1{};
+        gs::ObjectEncoding encoding{};
+
+        player_frame1.head.id.value = 300;
+        player_frame1.head.time = 1234;
+        player_frame1.head.location.x = 1.5f;
+        player_frame1.head.rotation.si.value = 0.5f;
+        player_frame1.head.ipd = gs::HeadIPD1{{0.0625f}};
+        player_frame1.left.id.value = 301;
+        player_frame1.left.time = 1234;
+        player_frame1.left.left = true;
+        player_frame1.left.location.vy.value = -2.0f;
+        player_frame1.left.index.tip.tx.value = 0.125f;
+        player_frame1.right.id.value = 200;
+        player_frame1.right.time = 1234;
+        player_frame1.right.thumb.cmc.tz.value = -0.25f;
+
+        ASSERT_EQ(encoder.Encode(data_buffer, player_frame1, encoding).first,
+                  1);
+
+        // Decode the data buffer
+        ASSERT_EQ(decoder.Decode(data_buffer, decoded_objects),
+                  data_buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 3);
+        ASSERT_TRUE(std::holds_alternative<gs::Head1>(decoded_objects[0]));
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(decoded_objects[1]));
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(decoded_objects[2]));
+
+        gs::Head1 &head = std::get<gs::Head1>(decoded_objects[0]);
+        gs::Hand2 &left = std::get<gs::Hand2>(decoded_objects[1]);
+        gs::Hand2 &right = std::get<gs::Hand2>(decoded_objects[2]);
+
+        ASSERT_EQ(head.id.value, 300);
+        ASSERT_EQ(head.time, 1234);
+        ASSERT_EQ(head.location.x, 1.5f);
+        ASSERT_EQ(head.rotation.si.value, 0.5f);
+        ASSERT_TRUE(head.ipd.has_value());
+        ASSERT_EQ(head.ipd->ipd.value, 0.0625f);
+
+        ASSERT_EQ(left.id.value, 301);
+        ASSERT_EQ(left.time, 1234);
+        ASSERT_TRUE(left.left);
+        ASSERT_EQ(left.location.vy.value, -2.0f);
+        ASSERT_EQ(left.index.tip.tx.value, 0.125f);
+
+        ASSERT_EQ(right.id.value, 200);
+        ASSERT_EQ(right.time, 1234);
+        ASSERT_FALSE(right.left);
+        ASSERT_EQ(right.thumb.cmc.tz.value, -0.25f);
+    }
+
+    // Test decoding a PlayerFrame1 one object at a time
+    TEST_F(GSDecoderTest, Test_PlayerFrame1_Single)
+    {
+        gs::PlayerFrame1 player_frame1{};
+        gs::Object1 object1{};
+        gs::GSObject object;
+        gs::GSObjects expanded;
+        gs::ObjectEncoding encoding{};
+
+        player_frame1.head.id.value = 1;
+        player_frame1.left.id.value = 2;
+        player_frame1.left.left = true;
+        player_frame1.right.id.value = 3;
+        object1.id.value = 4;
+        encoding.rotation_bits = 12;
+        encoding.joint_bits = 8;
+
+        ASSERT_EQ(encoder.Encode(data_buffer, player_frame1, encoding).first,
+                  1);
+        ASSERT_EQ(encoder.Encode(data_buffer, object1).first, 1);
+
+        // The head is returned and the hands are appended to the vector
+        const std::size_t frame_length =
+            decoder.Decode(data_buffer, object, expanded);
+        ASSERT_GT(frame_length, 0);
+        ASSERT_TRUE(std::holds_alternative<gs::Head1>(object));
+        ASSERT_EQ(std::get<gs::Head1>(object).id.value, 1);
+        ASSERT_EQ(expanded.size(), 2);
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(expanded[0]));
+        ASSERT_EQ(std::get<gs::Hand2>(expanded[0]).id.value, 2);
+        ASSERT_TRUE(std::get<gs::Hand2>(expanded[0]).left);
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(expanded[1]));
+        ASSERT_EQ(std::get<gs::Hand2>(expanded[1]).id.value, 3);
+        ASSERT_FALSE(std::get<gs::Hand2>(expanded[1]).left);
+
+        // Decoding continues with the object that follows
+        ASSERT_EQ(decoder.Decode(data_buffer, object, expanded),
+                  data_buffer.GetDataLength() - frame_length);
+        ASSERT_TRUE(std::holds_alternative<gs::Object1>(object));
+        ASSERT_EQ(std::get<gs::Object1>(object).id.value, 4);
+        ASSERT_EQ(expanded.size(), 2);
+
+        // A PlayerFrame1 cannot be decoded as a single object
+        gs::DataBuffer frame_buffer(1500);
+        ASSERT_EQ(encoder.Encode(frame_buffer, player_frame1, encoding).first,
+                  1);
+        ASSERT_THROW(decoder.Decode(frame_buffer, object),
+                     gs::DecoderException);
+
+        // The frame is left unread, so it may then be decoded with the
+        // overload accepting expanded objects
+        ASSERT_EQ(frame_buffer.GetReadLength(), 0);
+        expanded.clear();
+        ASSERT_EQ(decoder.Decode(frame_buffer, object, expanded),
+                  frame_buffer.GetDataLength());
+        ASSERT_EQ(std::get<gs::Head1>(object).id.value, 1);
+        ASSERT_EQ(expanded.size(), 2);
+    }
+
+    // Test that a PlayerFrame1 lacking field presence masks is rejected
+    TEST_F(GSDecoderTest, Test_PlayerFrame1_Invalid)
+    {
+        std::vector<std::uint8_t> encoded =
+        {
+            // PlayerFrame1 tag, length, id, flags (none), and time
+            0xc0, 0x80, 0x08, 0x04, 0x01, 0x00, 0x00, 0x00
+        };
+
+        gs::DataBuffer buffer(encoded.data(), encoded.size(), encoded.size());
+
+        ASSERT_THROW(decoder.Decode(buffer, decoded_objects),
+                     gs::DecoderException);
+    }
+
+
+    // Test decoding a CompactMesh1 having predicted vertex positions
+    TEST_F(GSDecoderTest, Test_CompactMesh1_Predicted)
+    {
+        const std::size_t n = 12;
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        // A gently curved surface with two triangles per grid cell
+        mesh.id.value = 0x2c;
+        for (std::size_t y = 0; y < n; y++)
+        {
+            for (std::size_t x = 0; x < n; x++)
+            {
+                mesh.vertices.push_back({0.5f * x,
+                                         0.01f * (x * x + y * y),
+                                         -0.5f * y});
+            }
+        }
+        for (std::size_t y = 0; y + 1 < n; y++)
+        {
+            for (std::size_t x = 0; x + 1 < n; x++)
+            {
+                const std::uint64_t v = y * n + x;
+                mesh.triangles.insert(mesh.triangles.end(),
+                                      {{v}, {v + n}, {v + 1}});
+                mesh.triangles.insert(mesh.triangles.end(),
+                                      {{v + 1}, {v + n}, {v + n + 1}});
+            }
+        }
+        encoding.position_bits = 14;
+
+        // Decode the mesh using quantized positions for reference
+        gs::DataBuffer quantized_buffer(4000);
+        gs::GSObjects quantized_objects;
+        ASSERT_EQ(encoder.Encode(quantized_buffer, mesh, encoding).first, 1);
+        decoder.Decode(quantized_buffer, quantized_objects);
+        const gs::Mesh1 &quantized =
+            std::get<gs::Mesh1>(quantized_objects.front());
+
+        // Encode and decode the mesh using predicted positions
+        encoding.predict_positions = true;
+        gs::DataBuffer buffer(4000);
+        ASSERT_EQ(encoder.Encode(buffer, mesh, encoding).first, 1);
+        ASSERT_LT(buffer.GetDataLength(),
+                  quantized_buffer.GetDataLength() - mesh.vertices.size());
+        ASSERT_EQ(decoder.Decode(buffer, decoded_objects),
+                  buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded_objects[0]));
+
+        // The positions are identical to those sent without prediction
+        const gs::Mesh1 &decoded = std::get<gs::Mesh1>(decoded_objects[0]);
+        ASSERT_EQ(decoded.id.value, mesh.id.value);
+        ASSERT_EQ(decoded.triangles, mesh.triangles);
+        ASSERT_EQ(decoded.vertices.size(), quantized.vertices.size());
+        for (std::size_t i = 0; i < decoded.vertices.size(); i++)
+        {
+            ASSERT_FLOAT_EQ(decoded.vertices[i].x, quantized.vertices[i].x);
+            ASSERT_FLOAT_EQ(decoded.vertices[i].y, quantized.vertices[i].y);
+            ASSERT_FLOAT_EQ(decoded.vertices[i].z, quantized.vertices[i].z);
+        }
+
+        // Prediction requires valid triangles and quantized positions
+        gs::DataBuffer unused(4000);
+        mesh.triangles.push_back({n * n});
+        mesh.triangles.push_back({0});
+        mesh.triangles.push_back({1});
+        ASSERT_THROW(encoder.Encode(unused, mesh, encoding),
+                     gs::EncoderException);
+        mesh.triangles.resize(mesh.triangles.size() - 3);
+        encoding.position_bits = 0;
+        ASSERT_THROW(encoder.Encode(unused, mesh, encoding),
+                     gs::EncoderException);
+    }
+
+
+    TEST_F(GSDecoderTest, Test_CompactMesh1_Welded)
+    {
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        // A quad whose two triangles do not share vertices
+        mesh.id.value = 0x2d;
+        mesh.vertices = {{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                         {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+                         {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+        mesh.normals.assign(mesh.vertices.size(), {{0}, {0}, {1}});
+        mesh.triangles = {{0}, {1}, {2}, {3}, {4}, {5}};
+
+        gs::DataBuffer unwelded_buffer(1000);
+        ASSERT_EQ(encoder.Encode(unwelded_buffer, mesh, encoding).first, 1);
+
+        encoding.weld_vertices = true;
+        gs::DataBuffer buffer(1000);
+        ASSERT_EQ(encoder.Encode(buffer, mesh, encoding).first, 1);
+        ASSERT_LT(buffer.GetDataLength(), unwelded_buffer.GetDataLength());
+        ASSERT_EQ(decoder.Decode(buffer, decoded_objects),
+                  buffer.GetDataLength());
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded_objects[0]));
+
+        // Each corner of every triangle is unchanged
+        const gs::Mesh1 &decoded = std::get<gs::Mesh1>(decoded_objects[0]);
+        ASSERT_EQ(decoded.vertices.size(), 4);
+        ASSERT_EQ(decoded.normals.size(), 4);
+        ASSERT_EQ(decoded.triangles.size(), mesh.triangles.size());
+        for (std::size_t i = 0; i < mesh.triangles.size(); i++)
+        {
+            const gs::Loc1 &expected = mesh.vertices[mesh.triangles[i]];
+            const gs::Loc1 &actual = decoded.vertices[decoded.triangles[i]];
+            ASSERT_FLOAT_EQ(actual.x, expected.x);
+            ASSERT_FLOAT_EQ(actual.y, expected.y);
+            ASSERT_FLOAT_EQ(actual.z, expected.z);
+        }
+
+        // Without any compact encoding, the welded mesh is a plain Mesh1
+        gs::DataBuffer plain_buffer(1000);
+        gs::DataBuffer plain_unwelded_buffer(1000);
+        encoding.delta_indices = false;
+        ASSERT_EQ(encoder.Encode(plain_buffer, mesh, encoding).first, 1);
+        ASSERT_EQ(encoder.Encode(plain_unwelded_buffer, mesh).first, 1);
+        ASSERT_LT(plain_buffer.GetDataLength(),
+                  plain_unwelded_buffer.GetDataLength());
+        ASSERT_EQ(plain_buffer[0], plain_unwelded_buffer[0]);
+        ASSERT_EQ(plain_buffer[1], plain_unwelded_buffer[1]);
+        ASSERT_EQ(plain_buffer[2], plain_unwelded_buffer[2]);
+
+        gs::GSObjects plain_objects;
+        ASSERT_EQ(decoder.Decode(plain_buffer, plain_objects),
+                  plain_buffer.GetDataLength());
+        ASSERT_EQ(plain_objects.size(), 1);
+        const gs::Mesh1 &plain = std::get<gs::Mesh1>(plain_objects[0]);
+        ASSERT_EQ(plain.vertices.size(), 4);
+        ASSERT_EQ(plain.triangles, decoded.triangles);
+        for (std::size_t i = 0; i < plain.vertices.size(); i++)
+        {
+            ASSERT_EQ(plain.vertices[i].x, decoded.vertices[i].x);
+            ASSERT_EQ(plain.vertices[i].y, decoded.vertices[i].y);
+            ASSERT_EQ(plain.vertices[i].z, decoded.vertices[i].z);
+        }
+    }
+
+
+    TEST_F(GSDecoderTest, Test_Mesh1_Threads)
+    {
+        const std::size_t n = 200;
+        gs::Mesh1 mesh{};
+
+        // A grid large enough to be divided among threads
+        mesh.id.value = 0x2e;
+        for (std::size_t y = 0; y < n; y++)
+        {
+            for (std::size_t x = 0; x < n; x++)
+            {
+                mesh.vertices.push_back({0.5f * x, 0.0f, -0.5f * y});
+                mesh.normals.push_back({{0.0f}, {1.0f}, {0.0f}});
+                mesh.textures.push_back({{x * 300}, {y}});
+            }
+        }
+        for (std::size_t y = 0; y + 1 < n; y++)
+        {
+            for (std::size_t x = 0; x + 1 < n; x++)
+            {
+                const std::uint64_t v = y * n + x;
+                mesh.triangles.insert(mesh.triangles.end(),
+                                      {{v}, {v + n}, {v + 1}});
+                mesh.triangles.insert(mesh.triangles.end(),
+                                      {{v + 1}, {v + n}, {v + n + 1}});
+            }
+        }
+
+        // Encode the mesh using one thread and then several
+        gs::Encoder threaded_encoder;
+        threaded_encoder.SetMaxThreads(4);
+        const auto result = encoder.GetEncodeLength(mesh);
+        ASSERT_EQ(threaded_encoder.GetEncodeLength(mesh), result);
+        gs::DataBuffer expected(result.second);
+        gs::DataBuffer buffer(result.second);
+        ASSERT_EQ(encoder.Encode(expected, mesh), result);
+        ASSERT_EQ(threaded_encoder.Encode(buffer, mesh), result);
+        ASSERT_EQ(buffer, expected);
+
+        // Decode the mesh using several threads
+        std::vector<std::optional<gs::MeshBounds>> bounds;
+        decoder.SetMaxThreads(4);
+        ASSERT_EQ(decoder.Decode(buffer, decoded_objects, bounds),
+                  result.second);
+        ASSERT_EQ(decoded_objects.size(), 1);
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(decoded_objects[0]));
+        const gs::Mesh1 &decoded = std::get<gs::Mesh1>(decoded_objects[0]);
+        ASSERT_EQ(decoded.id.value, mesh.id.value);
+        ASSERT_EQ(decoded.vertices.size(), mesh.vertices.size());
+        ASSERT_EQ(decoded.normals.size(), mesh.normals.size());
+        ASSERT_EQ(decoded.textures.size(), mesh.textures.size());
+        for (std::size_t i = 0; i < mesh.vertices.size(); i++)
+        {
+            ASSERT_EQ(decoded.vertices[i].x, mesh.vertices[i].x);
+            ASSERT_EQ(decoded.vertices[i].y, mesh.vertices[i].y);
+            ASSERT_EQ(decoded.vertices[i].z, mesh.vertices[i].z);
+            ASSERT_EQ(decoded.normals[i].y.value, mesh.normals[i].y.value);
+            ASSERT_EQ(decoded.textures[i].u.value, mesh.textures[i].u.value);
+            ASSERT_EQ(decoded.textures[i].v.value, mesh.textures[i].v.value);
+        }
+        ASSERT_EQ(decoded.triangles, mesh.triangles);
+        ASSERT_EQ(bounds.size(), 1);
+        ASSERT_TRUE(bounds[0].has_value());
+        ASSERT_EQ(bounds[0]->min.z, -0.5f * (n - 1));
+        ASSERT_EQ(bounds[0]->max.x, 0.5f * (n - 1));
+
+        // A truncated mesh is still rejected
+        gs::DataBuffer truncated(expected.GetMutableBufferPointer(),
+                                 result.second - 1,
+                                 result.second - 1);
+        gs::GSObjects truncated_objects;
+        ASSERT_ANY_THROW(decoder.Decode(truncated, truncated_objects));
+    }
+
+
+    TEST_F(GSDecoderTest, Test_Mesh1_Bounds)
+    {
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+        gs::Loc1 min;
+        gs::Loc1 max;
+        std::vector<std::optional<gs::MeshBounds>> bounds;
+
+        // A mesh spanning several blocks of vertices
+        mesh.id.value = 0x2f;
+        for (std::size_t i = 0; i < 3000; i++)
+        {
+            mesh.vertices.push_back({std::sin(0.01f * i) * i,
+                                     std::cos(0.02f * i),
+                                     -0.5f * i});
+        }
+        for (std::uint64_t i = 0; i + 2 < mesh.vertices.size(); i += 3)
+        {
+            mesh.triangles.insert(mesh.triangles.end(),
+                                  {{i}, {i + 1}, {i + 2}});
+        }
+        min = max = mesh.vertices.front();
+        for (const auto &vertex : mesh.vertices)
+        {
+            min = {std::min(min.x, vertex.x),
+                   std::min(min.y, vertex.y),
+                   std::min(min.z, vertex.z)};
+            max = {std::max(max.x, vertex.x),
+                   std::max(max.y, vertex.y),
+                   std::max(max.z, vertex.z)};
+        }
+
+        // The bounds are returned alongside the decoded mesh
+        gs::DataBuffer buffer(50000);
+        ASSERT_EQ(encoder.Encode(buffer, mesh).first, 1);
+        ASSERT_EQ(decoder.Decode(buffer, decoded_objects, bounds),
+                  buffer.GetDataLength());
+        ASSERT_EQ(bounds.size(), 1);
+        ASSERT_TRUE(bounds[0].has_value());
+        ASSERT_EQ(bounds[0]->min.x, min.x);
+        ASSERT_EQ(bounds[0]->min.y, min.y);
+        ASSERT_EQ(bounds[0]->min.z, min.z);
+        ASSERT_EQ(bounds[0]->max.x, max.x);
+        ASSERT_EQ(bounds[0]->max.y, max.y);
+        ASSERT_EQ(bounds[0]->max.z, max.z);
+
+        // Compact meshes have bounds as well
+        gs::DataBuffer compact_buffer(50000);
+        gs::GSObjects compact_objects;
+        std::vector<std::optional<gs::MeshBounds>> compact_bounds;
+        encoding.position_bits = 16;
+        ASSERT_EQ(encoder.Encode(compact_buffer, mesh, encoding).first, 1);
+        decoder.Decode(compact_buffer, compact_objects, compact_bounds);
+        ASSERT_EQ(compact_bounds.size(), 1);
+        ASSERT_TRUE(compact_bounds[0].has_value());
+        ASSERT_NEAR(compact_bounds[0]->min.x, min.x, 0.01f);
+        ASSERT_NEAR(compact_bounds[0]->max.z, max.z, 0.01f);
+
+        // An index beyond the vertices is rejected in either encoding
+        mesh.triangles.back().value = mesh.vertices.size();
+        for (bool compact : {false, true})
+        {
+            gs::DataBuffer invalid_buffer(50000);
+            gs::GSObjects invalid_objects;
+            if (compact)
+            {
+                encoder.Encode(invalid_buffer, mesh, encoding);
+            }
+            else
+            {
+                encoder.Encode(invalid_buffer, mesh);
+            }
+            ASSERT_THROW(decoder.Decode(invalid_buffer, invalid_objects),
+                         gs::DecoderException);
+        }
+
+        // Every overload rejects the mesh by default and accepts it if
+        // validation is declined
+        for (bool validate : {true, false})
+        {
+            for (int overload = 0; overload < 5; overload++)
+            {
+                gs::DataBuffer buffer(50000);
+                gs::GSObjects objects;
+                gs::GSObject object;
+                std::vector<std::optional<gs::MeshBounds>> mesh_bounds;
+                gs::ObjectIDMapper mapper;
+                std::vector<gs::ObjectHandle> handles;
+                encoder.Encode(buffer, mesh, encoding);
+
+                auto decode = [&]()
+                {
+                    switch (overload)
+                    {
+                        case 0:
+                            decoder.Decode(buffer, objects, validate);
+                            break;
+                        case 1:
+                            decoder.Decode(buffer,
+                                           objects,
+                                           mesh_bounds,
+                                           validate);
+                            break;
+                        case 2:
+                            decoder.Decode(buffer,
+                                           objects,
+                                           mapper,
+                                           handles,
+                                           validate);
+                            break;
+                        case 3:
+                            decoder.Decode(buffer, object, validate);
+                            break;
+                        default:
+                            decoder.Decode(buffer, object, objects, validate);
+                            break;
+                    }
+                };
+
+                if (validate)
+                {
+                    ASSERT_THROW(decode(), gs::DecoderException);
+                }
+                else
+                {
+                    ASSERT_NO_THROW(decode());
+                }
+            }
+        }
+    }
+
+    TEST_F(GSDecoderTest, Test_Mesh1_Bounds_Per_Mesh)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        gs::Mesh1 first{};
+        gs::Mesh1 second{};
+        gs::Object1 object1{};
+        gs::DataBuffer buffer(50000);
+        std::vector<std::optional<gs::MeshBounds>> bounds;
+
+        // A mesh whose first vertex has a NaN component, spanning blocks
+        first.id.value = 1;
+        first.vertices.push_back({nan, 100.0f, nan});
+        for (std::size_t i = 0; i < 2000; i++)
+        {
+            first.vertices.push_back({float(i), -1.0f, 2.0f});
+        }
+        second.id.value = 2;
+        second.vertices = {{-5.0f, 0.0f, 1.0f}, {5.0f, 3.0f, -1.0f}};
+        object1.id.value = 3;
+
+        encoder.Encode(buffer, first);
+        encoder.Encode(buffer, object1);
+        encoder.Encode(buffer, second);
+        ASSERT_EQ(decoder.Decode(buffer, decoded_objects, bounds),
+                  buffer.GetDataLength());
+
+        // Each mesh has its own bounds; other objects have none
+        ASSERT_EQ(decoded_objects.size(), 3);
+        ASSERT_EQ(bounds.size(), 3);
+        ASSERT_TRUE(bounds[0].has_value());
+        ASSERT_FALSE(bounds[1].has_value());
+        ASSERT_TRUE(bounds[2].has_value());
+        ASSERT_EQ(bounds[0]->min.x, 0.0f);
+        ASSERT_EQ(bounds[0]->max.x, 1999.0f);
+        ASSERT_EQ(bounds[0]->min.y, -1.0f);
+        ASSERT_EQ(bounds[0]->max.y, 100.0f);
+        ASSERT_EQ(bounds[0]->min.z, 2.0f);
+        ASSERT_EQ(bounds[0]->max.z, 2.0f);
+        ASSERT_EQ(bounds[2]->min.x, -5.0f);
+        ASSERT_EQ(bounds[2]->max.y, 3.0f);
+        ASSERT_EQ(bounds[2]->min.z, -1.0f);
+
+        // A mesh whose components along an axis are all NaN, or that has
+        // no vertices, has zero bounds along that axis
+        gs::DataBuffer nan_buffer(1500);
+        second.vertices = {{nan, 1.0f, 2.0f}};
+        encoder.Encode(nan_buffer, second);
+        encoder.Encode(nan_buffer, gs::Mesh1{});
+        decoder.Decode(nan_buffer, decoded_objects, bounds);
+        ASSERT_EQ(bounds.size(), 5);
+        ASSERT_EQ(bounds[3]->min.x, 0.0f);
+        ASSERT_EQ(bounds[3]->max.x, 0.0f);
+        ASSERT_EQ(bounds[3]->min.y, 1.0f);
+        ASSERT_EQ(bounds[4]->max.z, 0.0f);
+    }
+
 } // namespace
@@ -736,4 +736,567 @@ namespace {
         }
     };
 
+    TEST_F(GSEncoderTest, Test_CompactMesh1_Delta)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactMesh1 tag
+            0xc0, 0x80, 0x03,
+
+            // Octets to follow
+            0x0c,
+
+            // Object ID
+            0x1b,
+
+            // Flags (delta indices)
+            0x01,
+
+            // Number of vertices, normals, and textures
+            0x00, 0x00, 0x00,
+
+            // Number of triangle indices
+            0x06,
+
+            // Index deltas (5, -2, 1, -1, 1, 2)
+            0x05, 0x7e, 0x01, 0x7f, 0x01, 0x02
+        };
+
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        mesh.triangles = {{5}, {3}, {4}, {3}, {4}, {6}};
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(mesh, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, mesh, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+    }
+
+    TEST_F(GSEncoderTest, Test_CompactMesh1_Reorder)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactMesh1 tag
+            0xc0, 0x80, 0x03,
+
+            // Octets to follow
+            0x0c,
+
+            // Object ID
+            0x1b,
+
+            // Flags (delta indices)
+            0x01,
+
+            // Number of vertices, normals, and textures
+            0x00, 0x00, 0x00,
+
+            // Number of triangle indices
+            0x06,
+
+            // Index deltas for triangles (3, 4, 5) and (3, 4, 6)
+            0x03, 0x01, 0x01, 0x7e, 0x01, 0x02
+        };
+
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        mesh.triangles = {{5}, {3}, {4}, {3}, {4}, {6}};
+        encoding.reorder_triangles = true;
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, mesh, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+
+        // Reordering requires complete triangles
+        mesh.triangles.pop_back();
+        ASSERT_THROW(encoder.Encode(data_buffer, mesh, encoding),
+                     gs::EncoderException);
+    }
+
+    TEST_F(GSEncoderTest, Test_CompactMesh1_Quantized)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactMesh1 tag
+            0xc0, 0x80, 0x03,
+
+            // Octets to follow
+            0x22,
+
+            // Object ID
+            0x1b,
+
+            // Flags (quantized positions)
+            0x02,
+
+            // Number of vertices
+            0x01,
+
+            // Bits per component
+            0x08,
+
+            // Bounding box minimum
+            0x3f, 0x80, 0x00, 0x00,
+            0x40, 0x00, 0x00, 0x00,
+            0x40, 0x40, 0x00, 0x00,
+
+            // Bounding box maximum
+            0x3f, 0x80, 0x00, 0x00,
+            0x40, 0x00, 0x00, 0x00,
+            0x40, 0x40, 0x00, 0x00,
+
+            // Quantized vertex
+            0x00, 0x00, 0x00,
+
+            // Number of normals, textures, and triangle indices
+            0x00, 0x00, 0x00
+        };
+
+        gs::Mesh1 mesh{};
+        gs::MeshEncoding encoding{};
+
+        mesh.id.value = 0x1b;
+        mesh.vertices.push_back({1.0f, 2.0f, 3.0f});
+        encoding.delta_indices = false;
+        encoding.position_bits = 8;
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(mesh, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, mesh, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+
+        // Quantization is limited to 16 bits
+        encoding.position_bits = 17;
+        ASSERT_THROW(encoder.Encode(data_buffer, mesh, encoding),
+                     gs::EncoderException);
+    }
+
+
+    TEST_F(GSEncoderTest, Test_CompactObject1)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactObject1 tag
+            0xc0, 0x80, 0x04,
+
+            // Octets to follow
+            0x22,
+
+            // Object ID
+            0x0c,
+
+            // Flags (compressed rotation)
+            0x01,
+
+            // Bits per rotation component
+            0x0a,
+
+            // time
+            0x05, 0x00,
+
+            // location
+            0x3f, 0x80, 0x00, 0x00, 0x40, 0x00,
+            0x00, 0x00, 0x40, 0x40, 0x00, 0x00,
+
+            // rotation (identity)
+            0x20, 0x08, 0x02, 0x00,
+
+            // scale
+            0x40, 0xE0, 0x00, 0x00, 0x41, 0x00,
+            0x00, 0x00, 0x41, 0x10, 0x00, 0x00,
+
+            // active
+            0x01
+        };
+
+        gs::Object1 object1{};
+        gs::ObjectEncoding encoding{};
+
+        object1.id.value = 12;
+        object1.time = 0x0500;
+        object1.position.x = 1.0f;
+        object1.position.y = 2.0f;
+        object1.position.z = 3.0f;
+        object1.scale.x = 7.0f;
+        object1.scale.y = 8.0f;
+        object1.scale.z = 9.0f;
+        object1.active = true;
+        encoding.rotation_bits = 10;
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(object1, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, object1, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+
+        // The rotation bit budget must be in the range 2 to 20
+        encoding.rotation_bits = 1;
+        ASSERT_THROW(encoder.Encode(data_buffer, object1, encoding),
+                     gs::EncoderException);
+        encoding.rotation_bits = 21;
+        ASSERT_THROW(encoder.Encode(data_buffer, object1, encoding),
+                     gs::EncoderException);
+    }
+
+    TEST_F(GSEncoderTest, Test_CompactHand2_Length)
+    {
+        gs::Hand2 hand2{};
+        gs::ObjectEncoding encoding{};
+
+        // Without compression, only the flags are added to the Hand2 size
+        ASSERT_EQ(encoder.GetEncodeLength(hand2, encoding).second,
+                  encoder.GetEncodeLength(hand2).second + 1);
+
+        // With compression, the bits octet is added and each Rot2
+        // quaternion then takes 4 octets rather than 6
+        encoding.rotation_bits = 10;
+        ASSERT_EQ(encoder.GetEncodeLength(hand2, encoding).second,
+                  encoder.GetEncodeLength(hand2).second + 2 - 4);
+    }
+
+
+    TEST_F(GSEncoderTest, Test_CompactHand2_Joints)
+    {
+        gs::Hand2 hand2{};
+        gs::ObjectEncoding encoding{};
+
+        hand2.wrist.tx.value = -0.25f;
+        hand2.wrist.ty.value = 0.25f;
+        hand2.wrist.tz.value = 1.0f;
+        encoding.joint_bits = 8;
+        encoding.joint_range = 0.25f;
+
+        // Joints are sent as 75 8-bit components plus the bits and range,
+        // so the 113 octets of object data are preceded by a 1-octet length
+        ASSERT_EQ(encoder.GetEncodeLength(hand2, encoding).second,
+                  3 + 1 + 113);
+
+        ASSERT_EQ(encoder.Encode(data_buffer, hand2, encoding).first, 1);
+        ASSERT_EQ(data_buffer.GetDataLength(),
+                  encoder.GetEncodeLength(hand2, encoding).second);
+
+        // Locate the joints following the tag, length, id, flags, time,
+        // left, location, and rotation
+        const std::size_t offset = 3 + 1 + 1 + 1 + 2 + 1 + 18 + 12;
+        ASSERT_EQ(data_buffer[5], 0x02);
+
+        // Bits and range, then the wrist (the last component clamped)
+        ASSERT_EQ(data_buffer[offset], 0x08);
+        ASSERT_EQ(data_buffer[offset + 1], 0x34);
+        ASSERT_EQ(data_buffer[offset + 2], 0x00);
+        ASSERT_EQ(data_buffer[offset + 3], 0x00);
+        ASSERT_EQ(data_buffer[offset + 4], 0xff);
+        ASSERT_EQ(data_buffer[offset + 5], 0xff);
+
+        // The remaining joints are zero, which is mid-range
+        ASSERT_EQ(data_buffer[offset + 6], 0x80);
+
+        // Quantization is limited to 16 bits and requires a positive range
+        encoding.joint_bits = 17;
+        ASSERT_THROW(encoder.Encode(data_buffer, hand2, encoding),
+                     gs::EncoderException);
+        encoding.joint_bits = 8;
+        encoding.joint_range = 0.0f;
+        ASSERT_THROW(encoder.Encode(data_buffer, hand2, encoding),
+                     gs::EncoderException);
+    }
+
+
+    TEST_F(GSEncoderTest, Test_CompactObject1_Presence)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactObject1 tag
+            0xc0, 0x80, 0x04,
+
+            // Octets to follow
+            0x11,
+
+            // Object ID
+            0x0c,
+
+            // Flags (field presence)
+            0x04,
+
+            // Field presence (scale present and active)
+            0x48,
+
+            // time
+            0x05, 0x00,
+
+            // scale
+            0x40, 0xE0, 0x00, 0x00, 0x41, 0x00,
+            0x00, 0x00, 0x41, 0x10, 0x00, 0x00
+        };
+
+        gs::Object1 object1{};
+        gs::ObjectEncoding encoding{};
+
+        object1.id.value = 12;
+        object1.time = 0x0500;
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        object1.active = true;
+        encoding.omit_defaults = true;
+
+        // With all fields at default values, only the header remains
+        ASSERT_EQ(encoder.GetEncodeLength(object1, encoding).second, 9);
+
+        object1.scale = {7.0f, 8.0f, 9.0f};
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(object1, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, object1, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+    }
+
+    TEST_F(GSEncoderTest, Test_CompactHand1)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // CompactHand1 tag
+            0xc0, 0x80, 0x07,
+
+            // Octets to follow
+            0x0b,
+
+            // Object ID
+            0x0c,
+
+            // Flags (field presence)
+            0x04,
+
+            // Field presence (velocity present and left)
+            0x42,
+
+            // time
+            0x05, 0x00,
+
+            // velocity
+            0x3c, 0x00, 0x00, 0x00, 0xbc, 0x00
+        };
+
+        gs::Hand1 hand1{};
+        gs::ObjectEncoding encoding{};
+
+        hand1.id.value = 12;
+        hand1.time = 0x0500;
+        hand1.left = true;
+        hand1.location.vx.value = 1.0f;
+        hand1.location.vz.value = -1.0f;
+        encoding.omit_defaults = true;
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(hand1, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, hand1, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+    }
+
+
+    TEST_F(GSEncoderTest, Test_PlayerFrame1)
+    {
+        std::vector<std::uint8_t> expected =
+        {
+            // PlayerFrame1 tag
+            0xc0, 0x80, 0x08,
+
+            // Octets to follow
+            0x81, 0x35,
+
+            // Head object ID
+            0x05,
+
+            // Flags (field presence)
+            0x04,
+
+            // Head field presence (none)
+            0x00,
+
+            // time
+            0x00, 0x64
+        };
+
+        gs::PlayerFrame1 player_frame1{};
+        gs::ObjectEncoding encoding{};
+
+        player_frame1.head.id.value = 5;
+        player_frame1.head.time = 100;
+        player_frame1.left.id.value = 6;
+        player_frame1.left.time = 100;
+        player_frame1.left.left = true;
+        player_frame1.right.id.value = 7;
+        player_frame1.right.time = 100;
+
+        // Each hand is an ID difference, field presence, and Float16 joints
+        expected.push_back(0x01);
+        expected.push_back(0x40);
+        expected.insert(expected.end(), 150, 0x00);
+        expected.push_back(0x02);
+        expected.push_back(0x00);
+        expected.insert(expected.end(), 150, 0x00);
+
+        // Check that the encoding length matches the expected length
+        ASSERT_EQ(expected.size(),
+                  encoder.GetEncodeLength(player_frame1, encoding).second);
+
+        // Check the expected encoded length
+        ASSERT_EQ(encoder.Encode(data_buffer, player_frame1, encoding),
+                  std::make_pair(std::size_t(1), expected.size()));
+
+        // Verify the buffer contents
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+
+        // The frame is smaller than the three objects encoded separately
+        encoding.omit_defaults = true;
+        ASSERT_LT(expected.size(),
+                  encoder.GetEncodeLength(player_frame1.head,
+                                          encoding).second +
+                      encoder.GetEncodeLength(player_frame1.left,
+                                              encoding).second +
+                      encoder.GetEncodeLength(player_frame1.right,
+                                              encoding).second);
+    }
+
+    TEST_F(GSEncoderTest, Test_PlayerFrame1_Time)
+    {
+        gs::PlayerFrame1 player_frame1{};
+
+        player_frame1.head.time = 100;
+        player_frame1.left.time = 100;
+        player_frame1.right.time = 101;
+
+        // All objects in the frame must share the same time value
+        EXPECT_THROW(encoder.Encode(data_buffer, player_frame1, {}),
+                     gs::EncoderException);
+        ASSERT_EQ(data_buffer.GetDataLength(), 0);
+    }
+
+
+    // Test encoding a mesh whose elements are produced on demand
+    TEST_F(GSEncoderTest, Test_MeshSource)
+    {
+        const std::size_t n = 40;
+        gs::Mesh1 mesh{};
+        gs::MeshSource source{};
+
+        // A strip of triangles having indices of differing lengths
+        mesh.id.value = 0x1c;
+        for (std::size_t i = 0; i < n; i++)
+        {
+            mesh.vertices.push_back({float(i), float(i % 2), 0.0f});
+            mesh.normals.push_back({{0.0f}, {0.0f}, {1.0f}});
+            mesh.textures.push_back({{i * 10}, {i % 2}});
+        }
+        for (std::uint64_t i = 0; i + 2 < n; i++)
+        {
+            mesh.triangles.insert(mesh.triangles.end(),
+                                  {{i}, {i + 1}, {i + 2}});
+        }
+
+        // Produce the same elements without using the mesh's vectors
+        source.id.value = 0x1c;
+        source.vertex_count = n;
+        source.vertex = [](std::size_t i) -> gs::Loc1
+        {
+            return {float(i), float(i % 2), 0.0f};
+        };
+        source.normal_count = n;
+        source.normal = [](std::size_t) -> gs::Norm1
+        {
+            return {{0.0f}, {0.0f}, {1.0f}};
+        };
+        source.texture_count = n;
+        source.texture = [](std::size_t i) -> gs::TextureUV1
+        {
+            return {{i * 10}, {i % 2}};
+        };
+        source.triangle_count = (n - 2) * 3;
+        source.triangle = [](std::size_t i) -> gs::VarUint
+        {
+            return {i / 3 + i % 3};
+        };
+
+        gs::DataBuffer expected(1500);
+        const auto result = encoder.Encode(expected, mesh);
+        ASSERT_EQ(result.first, 1);
+
+        // The encodings are identical
+        ASSERT_EQ(encoder.GetEncodeLength(source), result);
+        ASSERT_EQ(encoder.Encode(data_buffer, source), result);
+        for (std::size_t i = 0; i < result.second; i++)
+        {
+            ASSERT_EQ(data_buffer[i], expected[i]);
+        }
+
+        // Nothing is written if there is insufficient space
+        gs::DataBuffer short_buffer(result.second - 1);
+        ASSERT_EQ(encoder.Encode(short_buffer, source),
+                  std::make_pair(std::size_t(0), std::size_t(0)));
+        ASSERT_EQ(short_buffer.GetDataLength(), 0);
+
+        // Each non-empty sequence requires a producer
+        source.texture = nullptr;
+        ASSERT_THROW(encoder.Encode(data_buffer, source),
+                     gs::EncoderException);
+        source.texture_count = 0;
+        gs::DataBuffer untextured(1500);
+        ASSERT_EQ(encoder.Encode(untextured, source).first, 1);
+    }
+
 } // namespace
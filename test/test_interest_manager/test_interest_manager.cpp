@@ -0,0 +1,209 @@
+/*
+ *  test_interest_manager.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the InterestManager object, which returns the
+ *      objects near each recipient using a uniform spatial grid.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "interest_manager.h"
+
+namespace {
+
+    // Create an Object1 having the given ID and position
+    gs::Object1 MakeObject(std::uint64_t id, const gs::Loc1 &position)
+    {
+        gs::Object1 object1{};
+        object1.id.value = id;
+        object1.position = position;
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        return object1;
+    }
+
+    // Find the objects within a radius by examining every object
+    std::vector<std::uint64_t> BruteForce(const std::vector<gs::Loc1> &points,
+                                          const gs::Loc1 &position,
+                                          float radius)
+    {
+        std::vector<std::uint64_t> ids;
+
+        for (std::size_t i = 0; i < points.size(); i++)
+        {
+            const double dx = points[i].x - position.x;
+            const double dy = points[i].y - position.y;
+            const double dz = points[i].z - position.z;
+            if (dx * dx + dy * dy + dz * dz <= double(radius) * radius)
+            {
+                ids.push_back(i);
+            }
+        }
+
+        return ids;
+    }
+
+    // Test finding objects near a position
+    TEST(InterestManagerTest, Query_Position)
+    {
+        gs::InterestManager manager({10.0f, 30.0f});
+
+        manager.Update(1, {0.0f, 0.0f, 0.0f});
+        manager.Update(2, {25.0f, 0.0f, 0.0f});
+        manager.Update(3, {-5.0f, -5.0f, -5.0f});
+        manager.Update(4, {100.0f, 0.0f, 0.0f});
+        ASSERT_EQ(manager.GetCount(), 4);
+
+        ASSERT_EQ(manager.Query({0.0f, 0.0f, 0.0f}, 30.0f),
+                  std::vector<std::uint64_t>({1, 2, 3}));
+        ASSERT_EQ(manager.Query({0.0f, 0.0f, 0.0f}, 10.0f),
+                  std::vector<std::uint64_t>({1, 3}));
+        ASSERT_EQ(manager.Query({90.0f, 0.0f, 0.0f}, 10.0f),
+                  std::vector<std::uint64_t>({4}));
+
+        // Move an object into another cell and remove another
+        manager.Update(4, {1.0f, 1.0f, 1.0f});
+        ASSERT_TRUE(manager.Remove(3));
+        ASSERT_FALSE(manager.Remove(3));
+        ASSERT_EQ(manager.Query({0.0f, 0.0f, 0.0f}, 10.0f),
+                  std::vector<std::uint64_t>({1, 4}));
+        ASSERT_TRUE(manager.Query({90.0f, 0.0f, 0.0f}, 10.0f).empty());
+    }
+
+    // Test per-recipient queries from objects of all types
+    TEST(InterestManagerTest, Recipients)
+    {
+        gs::InterestManager manager({5.0f, 10.0f});
+        gs::GSObjects objects;
+
+        gs::Head1 head1{};
+        head1.id.value = 10;
+        head1.location = {50.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f};
+        gs::Hand2 hand2{};
+        hand2.id.value = 11;
+        hand2.location = {51.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+        objects.push_back(MakeObject(1, {0.0f, 0.0f, 0.0f}));
+        objects.push_back(head1);
+        objects.push_back(hand2);
+        objects.push_back(gs::Mesh1{});
+        objects.push_back(MakeObject(2, {45.0f, 0.0f, 0.0f}));
+        manager.Update(objects);
+        ASSERT_EQ(manager.GetCount(), 4);
+
+        manager.UpdateRecipient(100, {0.0f, 0.0f, 0.0f});
+        manager.UpdateRecipient(200, {50.0f, 0.0f, 0.0f}, 2.0f);
+        manager.UpdateRecipient(300, {-1000.0f, 0.0f, 0.0f});
+        ASSERT_TRUE(manager.RemoveRecipient(300));
+
+        const std::vector<gs::InterestSet> sets = manager.Query();
+        ASSERT_EQ(sets.size(), 2);
+        ASSERT_EQ(sets[0].recipient, 100);
+        ASSERT_EQ(sets[0].ids, std::vector<std::uint64_t>({1}));
+        ASSERT_EQ(sets[1].recipient, 200);
+        ASSERT_EQ(sets[1].ids, std::vector<std::uint64_t>({10, 11}));
+
+        // Selection retains the mesh, whose position is not tracked
+        const gs::GSObjects selected = manager.Select(objects, sets[1]);
+        ASSERT_EQ(selected.size(), 3);
+        ASSERT_TRUE(std::holds_alternative<gs::Head1>(selected[0]));
+        ASSERT_TRUE(std::holds_alternative<gs::Hand2>(selected[1]));
+        ASSERT_TRUE(std::holds_alternative<gs::Mesh1>(selected[2]));
+    }
+
+    // Test random objects and recipients against a brute force search,
+    // using multiple threads and a radius spanning many cells
+    TEST(InterestManagerTest, Random_Positions)
+    {
+        gs::InterestManager manager({4.0f, 15.0f});
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+        std::vector<gs::Loc1> points(20000);
+        gs::GSObjects objects;
+
+        manager.SetMaxThreads(4);
+
+        for (std::size_t round = 0; round < 2; round++)
+        {
+            objects.clear();
+            for (std::size_t i = 0; i < points.size(); i++)
+            {
+                points[i] = {coordinate(generator),
+                             coordinate(generator),
+                             coordinate(generator)};
+                objects.push_back(MakeObject(i, points[i]));
+            }
+            manager.Update(objects);
+        }
+
+        std::vector<gs::Loc1> viewers;
+        for (std::uint64_t r = 0; r < 50; r++)
+        {
+            viewers.push_back({coordinate(generator),
+                               coordinate(generator),
+                               coordinate(generator)});
+            manager.UpdateRecipient(r, viewers.back());
+        }
+        viewers.push_back({0.0f, 0.0f, 0.0f});
+        manager.UpdateRecipient(50, viewers.back(), 1000.0f);
+
+        const std::vector<gs::InterestSet> sets = manager.Query();
+        ASSERT_EQ(sets.size(), 51);
+
+        for (std::size_t i = 0; i < sets.size(); i++)
+        {
+            const float radius = (i == 50) ? 1000.0f : 15.0f;
+            ASSERT_EQ(sets[i].recipient, i);
+            ASSERT_EQ(sets[i].ids, BruteForce(points, viewers[i], radius));
+        }
+        ASSERT_EQ(sets[50].ids.size(), points.size());
+    }
+
+    // Test that a cell size that is not positive is rejected
+    TEST(InterestManagerTest, Invalid_Cell_Size)
+    {
+        ASSERT_THROW(gs::InterestManager({0.0f, 10.0f}),
+                     gs::EncoderException);
+    }
+
+} // namespace
@@ -0,0 +1,238 @@
+/*
+ *  test_interpolation.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the functions used to blend arrays of state
+ *      components.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "interpolation.h"
+
+namespace {
+
+    // Ratio of a circle's circumference to its diameter
+    constexpr double Pi = 3.14159265358979323846;
+
+    // Test linear interpolation, including fractions outside [0, 1]
+    TEST(InterpolationTest, Lerp)
+    {
+        std::vector<float> a(13);
+        std::vector<float> b(13);
+        std::vector<float> s(13);
+        std::vector<float> result(13);
+
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            a[i] = static_cast<float>(i);
+            b[i] = static_cast<float>(i) + 10.0f;
+            s[i] = static_cast<float>(i) / 10.0f - 0.1f;
+        }
+
+        gs::LerpArrays(a.data(), b.data(), s.data(), result.data(), a.size());
+
+        for (std::size_t i = 0; i < a.size(); i++)
+        {
+            const float fraction = std::fmin(std::fmax(s[i], 0.0f), 1.0f);
+            ASSERT_FLOAT_EQ(result[i], a[i] + 10.0f * fraction);
+        }
+    }
+
+    // Test Hermite interpolation and extrapolation
+    TEST(InterpolationTest, Hermite)
+    {
+        const std::vector<float> p0(9, 1.0f);
+        const std::vector<float> v0(9, 2.0f);
+        const std::vector<float> p1(9, 2.0f);
+        const std::vector<float> v1(9, 2.0f);
+        const std::vector<float> duration(9, 0.5f);
+        const std::vector<float> s{-1.0f, 0.0f, 0.25f, 0.5f, 0.75f,
+                                   1.0f, 1.5f, 2.0f, 0.5f};
+        std::vector<float> result(9);
+
+        gs::HermiteArrays(p0.data(),
+                          v0.data(),
+                          p1.data(),
+                          v1.data(),
+                          s.data(),
+                          duration.data(),
+                          result.data(),
+                          s.size());
+
+        // Velocities consistent with the positions give a straight line
+        const std::vector<float> expected{1.0f, 1.0f, 1.25f, 1.5f, 1.75f,
+                                          2.0f, 2.5f, 3.0f, 1.5f};
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            ASSERT_NEAR(result[i], expected[i], 1e-6f);
+        }
+
+        // Tangents shape the curve between the end points
+        const std::vector<float> zero(9, 0.0f);
+        gs::HermiteArrays(p0.data(),
+                          zero.data(),
+                          p1.data(),
+                          zero.data(),
+                          s.data(),
+                          duration.data(),
+                          result.data(),
+                          s.size());
+        ASSERT_NEAR(result[2], 1.15625f, 1e-6f);
+        ASSERT_NEAR(result[3], 1.5f, 1e-6f);
+        ASSERT_NEAR(result[6], 2.0f, 1e-6f);
+    }
+
+    // Test quaternion interpolation
+    TEST(InterpolationTest, Nlerp)
+    {
+        // Rotations about the z axis by 0, 90, and 180 degrees, along with
+        // one by -90 degrees, whose real part is non-negative
+        const float h = std::sqrt(0.5f);
+        const std::vector<float> ai{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        const std::vector<float> aj{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        const std::vector<float> ak{0.0f, 0.0f, h, h, 0.0f};
+        const std::vector<float> bi{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        const std::vector<float> bj{0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        const std::vector<float> bk{h, h, 1.0f, -h, 0.0f};
+        const std::vector<float> s{0.5f, 2.0f, 0.5f, 0.5f, 0.5f};
+        std::vector<float> ri(5);
+        std::vector<float> rj(5);
+        std::vector<float> rk(5);
+        const float *const a[3] = {ai.data(), aj.data(), ak.data()};
+        const float *const b[3] = {bi.data(), bj.data(), bk.data()};
+        float *const result[3] = {ri.data(), rj.data(), rk.data()};
+
+        gs::NlerpArrays(a, b, s.data(), result, s.size());
+
+        // Halfway between 0 and 90 degrees is 45 degrees
+        ASSERT_NEAR(rk[0], std::sin(Pi / 8), 1e-6);
+
+        // Fractions beyond one hold the later rotation
+        ASSERT_NEAR(rk[1], h, 1e-6);
+
+        // Halfway between 90 and 180 degrees is 135 degrees
+        ASSERT_NEAR(rk[2], std::sin(3 * Pi / 8), 1e-6);
+
+        // Halfway between 90 and -90 degrees follows the shorter arc
+        ASSERT_NEAR(rk[3], 0.0f, 1e-6);
+        ASSERT_NEAR(rk[4], 0.0f, 1e-6);
+        for (std::size_t i = 0; i < s.size(); i++)
+        {
+            ASSERT_EQ(ri[i], 0.0f);
+            ASSERT_EQ(rj[i], 0.0f);
+        }
+    }
+
+    // Test that NaN fractions give the same results in the batch and scalar
+    // paths, with NaN treated as zero
+    TEST(InterpolationTest, NaN_Fraction)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const std::vector<float> s{0.5f, nan, 2.0f, -nan, -1.0f, nan, 0.25f};
+        const std::size_t count = s.size();
+        const std::vector<float> a{1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+        const std::vector<float> b{2.0f, 4.0f, 6.0f, 8.0f, 1.0f, 3.0f, 5.0f};
+        const std::vector<float> v(count, 0.5f);
+        const std::vector<float> duration(count, 0.5f);
+        const std::vector<float> zero(count, 0.0f);
+        const float h = std::sqrt(0.5f);
+        const std::vector<float> qk(count, h);
+        const float *const qa[3] = {zero.data(), zero.data(), zero.data()};
+        const float *const qb[3] = {zero.data(), zero.data(), qk.data()};
+        std::vector<float> lerp(count);
+        std::vector<float> hermite(count);
+        std::vector<float> ri(count);
+        std::vector<float> rj(count);
+        std::vector<float> rk(count);
+        float *const nlerp[3] = {ri.data(), rj.data(), rk.data()};
+
+        gs::LerpArrays(a.data(), b.data(), s.data(), lerp.data(), count);
+        gs::HermiteArrays(a.data(),
+                          v.data(),
+                          b.data(),
+                          v.data(),
+                          s.data(),
+                          duration.data(),
+                          hermite.data(),
+                          count);
+        gs::NlerpArrays(qa, qb, s.data(), nlerp, count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            // Interpolating one element at a time takes the scalar path
+            float single;
+            float si;
+            float sj;
+            float sk;
+            const float *const qai[3] = {qa[0] + i, qa[1] + i, qa[2] + i};
+            const float *const qbi[3] = {qb[0] + i, qb[1] + i, qb[2] + i};
+            float *const single_q[3] = {&si, &sj, &sk};
+
+            gs::LerpArrays(&a[i], &b[i], &s[i], &single, 1);
+            ASSERT_EQ(single, lerp[i]);
+
+            gs::HermiteArrays(&a[i],
+                              &v[i],
+                              &b[i],
+                              &v[i],
+                              &s[i],
+                              &duration[i],
+                              &single,
+                              1);
+            ASSERT_EQ(single, hermite[i]);
+
+            gs::NlerpArrays(qai, qbi, &s[i], single_q, 1);
+            ASSERT_EQ(si, ri[i]);
+            ASSERT_EQ(sj, rj[i]);
+            ASSERT_EQ(sk, rk[i]);
+
+            // A NaN fraction holds the earlier state
+            if (std::isnan(s[i]))
+            {
+                ASSERT_EQ(lerp[i], a[i]);
+                ASSERT_EQ(hermite[i], a[i]);
+                ASSERT_EQ(rk[i], 0.0f);
+            }
+        }
+    }
+
+} // namespace
@@ -0,0 +1,253 @@
+/*
+ *  test_interpolator.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the Interpolator object, which blends batches of
+ *      decoded object states.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_decoder.h"
+#include "interpolator.h"
+
+namespace {
+
+    // Ratio of a circle's circumference to its diameter
+    constexpr double Pi = 3.14159265358979323846;
+
+    // Test interpolating Object1 states
+    TEST(InterpolatorTest, Object1)
+    {
+        gs::Interpolator interpolator;
+        gs::Object1 from{};
+        gs::Object1 to{};
+        std::vector<gs::Object1> result;
+
+        from.id.value = 1;
+        from.scale = {1.0f, 1.0f, 1.0f};
+        to.id.value = 1;
+        to.time = 100;
+        to.position = {2.0f, 4.0f, 6.0f};
+        to.rotation.k.value = std::sqrt(0.5f);
+        to.scale = {3.0f, 3.0f, 3.0f};
+        to.active = true;
+
+        interpolator.Interpolate({from, from},
+                                 {to, to},
+                                 {0.5f, 1.5f},
+                                 result);
+        ASSERT_EQ(result.size(), 2);
+
+        ASSERT_EQ(result[0].id.value, 1);
+        ASSERT_EQ(result[0].time, 50);
+        ASSERT_TRUE(result[0].active);
+        ASSERT_FLOAT_EQ(result[0].position.x, 1.0f);
+        ASSERT_FLOAT_EQ(result[0].position.y, 2.0f);
+        ASSERT_FLOAT_EQ(result[0].position.z, 3.0f);
+        ASSERT_FLOAT_EQ(result[0].scale.x, 2.0f);
+        ASSERT_NEAR(result[0].rotation.k.value, std::sin(Pi / 8), 1e-6);
+
+        // Objects without velocity hold the later state when it is late
+        ASSERT_EQ(result[1].time, 150);
+        ASSERT_FLOAT_EQ(result[1].position.x, 2.0f);
+        ASSERT_FLOAT_EQ(result[1].scale.z, 3.0f);
+    }
+
+    // Test interpolating and extrapolating Hand2 states
+    TEST(InterpolatorTest, Hand2)
+    {
+        gs::Interpolator interpolator;
+        gs::Hand2 from{};
+        gs::Hand2 to{};
+        std::vector<gs::Hand2> result;
+
+        from.time = 65500;
+        from.location = {0.0f, 1.0f, 0.0f, {0.0f}, {1.0f}, {0.0f}};
+        from.pinky.tip.tz.value = 0.02f;
+        to.time = 64;
+        to.left = true;
+        to.location = {0.1f, 1.0f, 0.0f, {0.0f}, {1.0f}, {0.0f}};
+        to.pinky.tip.tz.value = 0.04f;
+        to.wrist.tx.value = -0.01f;
+
+        interpolator.Interpolate({from, from},
+                                 {to, to},
+                                 {0.5f, 2.0f},
+                                 result);
+
+        ASSERT_EQ(result[0].time, 14);
+        ASSERT_TRUE(result[0].left);
+        ASSERT_NEAR(result[0].location.x, 0.05f, 1e-6f);
+        ASSERT_FLOAT_EQ(result[0].location.y, 1.0f);
+        ASSERT_FLOAT_EQ(result[0].location.vx.value, 1.0f);
+        ASSERT_FLOAT_EQ(result[0].pinky.tip.tz.value, 0.03f);
+        ASSERT_FLOAT_EQ(result[0].wrist.tx.value, -0.005f);
+
+        // Late states are extrapolated along the velocity
+        ASSERT_EQ(result[1].time, 164);
+        ASSERT_NEAR(result[1].location.x, 0.2f, 1e-6f);
+        ASSERT_FLOAT_EQ(result[1].pinky.tip.tz.value, 0.04f);
+    }
+
+    // Test interpolating Head1 states
+    TEST(InterpolatorTest, Head1)
+    {
+        gs::Interpolator interpolator;
+        gs::Head1 from{};
+        gs::Head1 to{};
+        std::vector<gs::Head1> result;
+
+        from.ipd = gs::HeadIPD1{{0.06f}};
+        to.time = 10;
+        to.ipd = gs::HeadIPD1{{0.07f}};
+        to.rotation.ei.value = 1.0f;
+
+        interpolator.Interpolate({from}, {to}, {0.5f}, result);
+        ASSERT_TRUE(result[0].ipd);
+        ASSERT_FLOAT_EQ(result[0].ipd->ipd.value, 0.065f);
+        ASSERT_NEAR(result[0].rotation.ei.value, std::sqrt(0.5f), 1e-6f);
+        ASSERT_EQ(result[0].rotation.si.value, 0.0f);
+
+        // A missing IPD is taken from the later state
+        from.ipd.reset();
+        interpolator.Interpolate({from}, {to}, {0.5f}, result);
+        ASSERT_FLOAT_EQ(result[0].ipd->ipd.value, 0.07f);
+    }
+
+    // Test that results do not depend on the number of threads
+    TEST(InterpolatorTest, Threads)
+    {
+        gs::Interpolator interpolator;
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
+        std::vector<gs::Hand1> from(5000);
+        std::vector<gs::Hand1> to(5000);
+        std::vector<float> fractions(5000);
+        std::vector<gs::Hand1> result1;
+        std::vector<gs::Hand1> result2;
+
+        for (std::size_t i = 0; i < from.size(); i++)
+        {
+            for (gs::Hand1 *hand1 : {&from[i], &to[i]})
+            {
+                hand1->id.value = i;
+                hand1->location = {distribution(generator),
+                                   distribution(generator),
+                                   distribution(generator),
+                                   {distribution(generator)},
+                                   {distribution(generator)},
+                                   {distribution(generator)}};
+                hand1->rotation = {{distribution(generator)},
+                                   {distribution(generator)},
+                                   {distribution(generator)},
+                                   {distribution(generator)},
+                                   {distribution(generator)},
+                                   {distribution(generator)}};
+            }
+            to[i].time = 20;
+            fractions[i] = distribution(generator) * 3.0f + 1.0f;
+        }
+
+        interpolator.Interpolate(from, to, fractions, result1);
+        interpolator.SetMaxThreads(4);
+        interpolator.Interpolate(from, to, fractions, result2);
+
+        ASSERT_EQ(result1.size(), from.size());
+        ASSERT_EQ(result2.size(), from.size());
+        for (std::size_t i = 0; i < from.size(); i++)
+        {
+            ASSERT_EQ(result1[i].id.value, i);
+            ASSERT_EQ(result1[i].location.x, result2[i].location.x);
+            ASSERT_EQ(result1[i].location.vz.value,
+                      result2[i].location.vz.value);
+            ASSERT_EQ(result1[i].rotation.ek.value,
+                      result2[i].rotation.ek.value);
+        }
+    }
+
+    // Test that NaN and negative fractions give the earlier state's time,
+    // matching the earlier state's position
+    TEST(InterpolatorTest, Limited_Fraction)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        gs::Interpolator interpolator;
+        gs::Hand1 from{};
+        gs::Hand1 to{};
+        std::vector<gs::Hand1> result;
+
+        from.time = 100;
+        from.location = {1.0f, 0.0f, 0.0f, {0.0f}, {0.0f}, {0.0f}};
+        to.time = 120;
+        to.location = {2.0f, 0.0f, 0.0f, {0.0f}, {0.0f}, {0.0f}};
+
+        interpolator.Interpolate({from, from, from},
+                                 {to, to, to},
+                                 {nan, -0.5f, 1.5f},
+                                 result);
+        ASSERT_EQ(result.size(), 3);
+
+        ASSERT_EQ(result[0].time, 100);
+        ASSERT_FLOAT_EQ(result[0].location.x, 1.0f);
+        ASSERT_EQ(result[1].time, 100);
+        ASSERT_FLOAT_EQ(result[1].location.x, 1.0f);
+
+        // Fractions beyond one still extrapolate the time
+        ASSERT_EQ(result[2].time, 130);
+    }
+
+    // Test that vectors of differing lengths are rejected
+    TEST(InterpolatorTest, Length_Mismatch)
+    {
+        gs::Interpolator interpolator;
+        std::vector<gs::Object1> result;
+
+        ASSERT_THROW(interpolator.Interpolate({gs::Object1{}},
+                                              {gs::Object1{}},
+                                              {},
+                                              result),
+                     gs::DecoderException);
+    }
+
+} // namespace
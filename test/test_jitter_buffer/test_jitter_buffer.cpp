@@ -0,0 +1,252 @@
+/*
+ *  test_jitter_buffer.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the JitterBuffer and TimeUnwrapper objects.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_decoder.h"
+#include "jitter_buffer.h"
+
+namespace {
+
+    // Create a hand having the given time
+    gs::Hand1 MakeHand(gs::Time1 time)
+    {
+        gs::Hand1 hand1{};
+        hand1.id.value = 1;
+        hand1.time = time;
+        return hand1;
+    }
+
+    // Return the time of the state played out, if any
+    std::optional<gs::Time1> Playout(gs::JitterBuffer &buffer,
+                                     std::int64_t local_time)
+    {
+        const auto object = buffer.Playout(1, local_time);
+
+        if (!object) return {};
+
+        return std::get<gs::Hand1>(*object).time;
+    }
+
+    // Test unwrapping times
+    TEST(JitterBufferTest, Unwrap)
+    {
+        gs::TimeUnwrapper unwrapper;
+
+        ASSERT_EQ(unwrapper.Unwrap(65530), 65530);
+        ASSERT_EQ(unwrapper.Unwrap(65535), 65535);
+        ASSERT_EQ(unwrapper.Unwrap(4), 65540);
+        ASSERT_EQ(unwrapper.Unwrap(65533), 65533);
+        ASSERT_EQ(unwrapper.Unwrap(30000), 95536);
+        ASSERT_EQ(unwrapper.Unwrap(60000), 125536);
+        ASSERT_EQ(unwrapper.Unwrap(20000), 151072);
+    }
+
+    // Test that out-of-order states are played out in order
+    TEST(JitterBufferTest, Reorder)
+    {
+        gs::JitterBuffer buffer;
+
+        ASSERT_TRUE(buffer.Insert(MakeHand(0), 100));
+        ASSERT_TRUE(buffer.Insert(MakeHand(20), 120));
+        ASSERT_TRUE(buffer.Insert(MakeHand(10), 125));
+        ASSERT_TRUE(buffer.Insert(MakeHand(30), 130));
+        ASSERT_EQ(buffer.GetPlayoutDelay(1), 20);
+
+        ASSERT_EQ(Playout(buffer, 119), std::nullopt);
+        ASSERT_EQ(Playout(buffer, 120), 0);
+        ASSERT_EQ(Playout(buffer, 130), 10);
+        ASSERT_EQ(Playout(buffer, 135), std::nullopt);
+        ASSERT_EQ(Playout(buffer, 150), 30);
+
+        // States older than the one played out are discarded
+        ASSERT_FALSE(buffer.Insert(MakeHand(20), 160));
+        ASSERT_EQ(Playout(buffer, 200), std::nullopt);
+
+        ASSERT_EQ(buffer.Playout(2, 200), std::nullopt);
+        ASSERT_TRUE(buffer.Remove(1));
+        ASSERT_FALSE(buffer.Remove(1));
+    }
+
+    // Test that duplicate states are discarded without affecting the
+    // playout delay or evicting other states
+    TEST(JitterBufferTest, Duplicate)
+    {
+        gs::JitterBufferOptions options;
+        options.capacity = 3;
+        gs::JitterBuffer buffer(options);
+
+        ASSERT_TRUE(buffer.Insert(MakeHand(0), 100));
+        ASSERT_TRUE(buffer.Insert(MakeHand(10), 110));
+        ASSERT_TRUE(buffer.Insert(MakeHand(20), 120));
+        const std::int64_t delay = buffer.GetPlayoutDelay(1);
+
+        // Late copies of the latest and an earlier state are discarded
+        ASSERT_FALSE(buffer.Insert(MakeHand(20), 500));
+        ASSERT_FALSE(buffer.Insert(MakeHand(0), 500));
+        ASSERT_EQ(buffer.GetPlayoutDelay(1), delay);
+
+        ASSERT_EQ(Playout(buffer, 100 + delay), 0);
+        ASSERT_EQ(Playout(buffer, 110 + delay), 10);
+        ASSERT_EQ(Playout(buffer, 120 + delay), 20);
+        ASSERT_EQ(Playout(buffer, 1000), std::nullopt);
+    }
+
+    // Test that a full ring replaces its earliest state
+    TEST(JitterBufferTest, Full)
+    {
+        gs::JitterBufferOptions options;
+        options.capacity = 3;
+        gs::JitterBuffer buffer(options);
+
+        ASSERT_TRUE(buffer.Insert(MakeHand(10), 110));
+        ASSERT_TRUE(buffer.Insert(MakeHand(30), 130));
+        ASSERT_TRUE(buffer.Insert(MakeHand(40), 140));
+
+        // A state earlier than every buffered state is discarded
+        ASSERT_FALSE(buffer.Insert(MakeHand(0), 150));
+
+        // A late state replaces the earliest, not the latest received, so
+        // the ring then holds 20, 30, and 40
+        ASSERT_TRUE(buffer.Insert(MakeHand(20), 160));
+        ASSERT_FALSE(buffer.Insert(MakeHand(15), 170));
+        ASSERT_TRUE(buffer.Insert(MakeHand(35), 180));
+        ASSERT_EQ(Playout(buffer, 1000), 40);
+    }
+
+    // Test that late states are placed in time order within the ring
+    TEST(JitterBufferTest, Late_Placement)
+    {
+        gs::JitterBufferOptions options;
+        options.capacity = 4;
+        gs::JitterBuffer buffer(options);
+
+        ASSERT_TRUE(buffer.Insert(MakeHand(0), 100));
+        ASSERT_TRUE(buffer.Insert(MakeHand(30), 130));
+        ASSERT_TRUE(buffer.Insert(MakeHand(10), 130));
+        ASSERT_TRUE(buffer.Insert(MakeHand(20), 130));
+
+        // The ring is full, so the next state evicts the state at time 0
+        ASSERT_TRUE(buffer.Insert(MakeHand(40), 140));
+
+        ASSERT_EQ(Playout(buffer, 10), std::nullopt);
+        ASSERT_EQ(Playout(buffer, 130), 10);
+        ASSERT_EQ(Playout(buffer, 140), 20);
+        ASSERT_EQ(Playout(buffer, 150), 30);
+        ASSERT_EQ(Playout(buffer, 160), 40);
+        ASSERT_EQ(Playout(buffer, 170), std::nullopt);
+
+        // Space freed by playout is reused
+        ASSERT_TRUE(buffer.Insert(MakeHand(60), 160));
+        ASSERT_TRUE(buffer.Insert(MakeHand(50), 170));
+        ASSERT_EQ(Playout(buffer, 170), 50);
+        ASSERT_EQ(Playout(buffer, 180), 60);
+    }
+
+    // Test playout across the point at which time wraps
+    TEST(JitterBufferTest, Wraparound)
+    {
+        gs::JitterBuffer buffer;
+        std::int64_t arrival = 1000;
+
+        for (gs::Time1 time = 65500; time != 100; time += 10, arrival += 10)
+        {
+            ASSERT_TRUE(buffer.Insert(MakeHand(time), arrival));
+            ASSERT_EQ(Playout(buffer, arrival + 20), time);
+        }
+    }
+
+    // Test that the playout delay adapts to jitter
+    TEST(JitterBufferTest, Adaptive_Delay)
+    {
+        gs::JitterBufferOptions options;
+        options.capacity = 4;
+        gs::JitterBuffer buffer(options);
+
+        for (std::int64_t i = 0; i < 100; i++)
+        {
+            const auto time = static_cast<gs::Time1>(i * 10);
+            buffer.Insert(MakeHand(time), i * 10 + ((i % 2) ? 60 : 0));
+        }
+        ASSERT_GT(buffer.GetPlayoutDelay(1), 150);
+        ASSERT_LE(buffer.GetPlayoutDelay(1), 180);
+
+        // Only the most recent states are held
+        ASSERT_EQ(Playout(buffer, 10000), 990);
+
+        options.max_delay = 100;
+        gs::JitterBuffer limited(options);
+        for (std::int64_t i = 0; i < 100; i++)
+        {
+            const auto time = static_cast<gs::Time1>(i * 10);
+            limited.Insert(MakeHand(time), i * 10 + ((i % 2) ? 60 : 0));
+        }
+        ASSERT_EQ(limited.GetPlayoutDelay(1), 100);
+    }
+
+    // Test that objects without an object ID or time are rejected
+    TEST(JitterBufferTest, No_Time)
+    {
+        gs::JitterBuffer buffer;
+
+        ASSERT_THROW(buffer.Insert(gs::Mesh1{}, 0), gs::DecoderException);
+        ASSERT_THROW(buffer.Insert(gs::HeadIPD1{}, 0), gs::DecoderException);
+    }
+
+    // Test that delay bounds out of order are rejected
+    TEST(JitterBufferTest, Invalid_Delay_Bounds)
+    {
+        gs::JitterBufferOptions options;
+
+        options.min_delay = 200;
+        options.max_delay = 100;
+        ASSERT_THROW(gs::JitterBuffer{options}, gs::DecoderException);
+
+        options.max_delay = 200;
+        ASSERT_NO_THROW(gs::JitterBuffer{options});
+    }
+
+} // namespace
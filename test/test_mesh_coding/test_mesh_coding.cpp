@@ -0,0 +1,563 @@
+/*
+ *  test_mesh_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the utility functions used when producing or
+ *      consuming the compact mesh encoding.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "mesh_coding.h"
+
+namespace {
+
+    // Test that triangles are rotated and sorted without changing winding
+    TEST(MeshCodingTest, ReorderTriangles)
+    {
+        std::vector<gs::VarUint> triangles =
+        {
+            {7}, {8}, {6},
+            {4}, {2}, {3},
+            {2}, {3}, {1}
+        };
+
+        std::vector<std::uint64_t> expected =
+        {
+            1, 2, 3,
+            2, 3, 4,
+            6, 7, 8
+        };
+
+        gs::ReorderTriangles(triangles);
+
+        ASSERT_EQ(triangles.size(), expected.size());
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(triangles[i].value, expected[i]);
+        }
+    }
+
+    // Test that an incomplete triangle list is left unchanged
+    TEST(MeshCodingTest, ReorderTriangles_Incomplete)
+    {
+        std::vector<gs::VarUint> triangles = {{3}, {2}, {1}, {0}};
+
+        gs::ReorderTriangles(triangles);
+
+        ASSERT_EQ(triangles[0].value, 3);
+        ASSERT_EQ(triangles[1].value, 2);
+        ASSERT_EQ(triangles[2].value, 1);
+        ASSERT_EQ(triangles[3].value, 0);
+    }
+
+    // Test quantization of components, including clamping and empty ranges
+    TEST(MeshCodingTest, QuantizeComponent)
+    {
+        ASSERT_EQ(gs::QuantizeComponent(-1.0f, -1.0f, 1.0f, 8), 0);
+        ASSERT_EQ(gs::QuantizeComponent(1.0f, -1.0f, 1.0f, 8), 255);
+        ASSERT_EQ(gs::QuantizeComponent(0.0f, -1.0f, 1.0f, 8), 128);
+        ASSERT_EQ(gs::QuantizeComponent(1.0f, -1.0f, 1.0f, 16), 65535);
+        ASSERT_EQ(gs::QuantizeComponent(5.0f, -1.0f, 1.0f, 4), 15);
+        ASSERT_EQ(gs::QuantizeComponent(-5.0f, -1.0f, 1.0f, 4), 0);
+        ASSERT_EQ(gs::QuantizeComponent(3.0f, 3.0f, 3.0f, 12), 0);
+    }
+
+    // Test that the vectorized and scalar dequantization paths agree
+    TEST(MeshCodingTest, DequantizePositions)
+    {
+        const gs::Loc1 min{-1.0f, 0.0f, 10.0f};
+        const gs::Loc1 max{1.0f, 4.0f, 20.0f};
+
+        for (unsigned bits : {6u, 16u})
+        {
+            const std::size_t width = (bits > 8) ? 2 : 1;
+            const unsigned levels = (1u << bits) - 1;
+            std::vector<unsigned char> data;
+            std::vector<gs::Loc1> vertices(7);
+
+            // Produce a sequence of quantized components
+            for (unsigned i = 0; i < vertices.size() * 3; i++)
+            {
+                unsigned q = (i * 977) % (levels + 1);
+                if (width == 2) data.push_back(static_cast<unsigned char>(q >> 8));
+                data.push_back(static_cast<unsigned char>(q & 0xff));
+            }
+
+            gs::DequantizePositions(data.data(),
+                                    vertices.size(),
+                                    bits,
+                                    min,
+                                    max,
+                                    vertices.data());
+
+            for (unsigned i = 0; i < vertices.size(); i++)
+            {
+                const float qx = static_cast<float>(((i * 3) * 977) % (levels + 1));
+                const float qy = static_cast<float>(((i * 3 + 1) * 977) % (levels + 1));
+                const float qz = static_cast<float>(((i * 3 + 2) * 977) % (levels + 1));
+
+                ASSERT_FLOAT_EQ(vertices[i].x, min.x + qx * 2.0f / levels);
+                ASSERT_FLOAT_EQ(vertices[i].y, min.y + qy * 4.0f / levels);
+                ASSERT_FLOAT_EQ(vertices[i].z, min.z + qz * 10.0f / levels);
+            }
+
+            // Bounds computed while dequantizing match a separate pass
+            gs::Loc1 expected_min;
+            gs::Loc1 expected_max;
+            gs::Loc1 bounds_min;
+            gs::Loc1 bounds_max;
+            gs::ComputeBounds(vertices, expected_min, expected_max);
+            gs::ClearBounds(bounds_min, bounds_max);
+            gs::DequantizePositions(data.data(),
+                                    vertices.size(),
+                                    bits,
+                                    min,
+                                    max,
+                                    vertices.data(),
+                                    &bounds_min,
+                                    &bounds_max);
+            ASSERT_EQ(bounds_min.x, expected_min.x);
+            ASSERT_EQ(bounds_min.y, expected_min.y);
+            ASSERT_EQ(bounds_min.z, expected_min.z);
+            ASSERT_EQ(bounds_max.x, expected_max.x);
+            ASSERT_EQ(bounds_max.y, expected_max.y);
+            ASSERT_EQ(bounds_max.z, expected_max.z);
+        }
+    }
+
+    // Test computing the bounding box of vertices
+    TEST(MeshCodingTest, ComputeBounds)
+    {
+        std::vector<gs::Loc1> vertices =
+        {
+            {1.0f, -2.0f, 3.0f},
+            {-4.0f, 5.0f, 0.5f},
+            {2.0f, 0.0f, -6.0f}
+        };
+        gs::Loc1 min;
+        gs::Loc1 max;
+
+        gs::ComputeBounds(vertices, min, max);
+
+        ASSERT_EQ(min.x, -4.0f);
+        ASSERT_EQ(min.y, -2.0f);
+        ASSERT_EQ(min.z, -6.0f);
+        ASSERT_EQ(max.x, 2.0f);
+        ASSERT_EQ(max.y, 5.0f);
+        ASSERT_EQ(max.z, 3.0f);
+
+        // A NaN leading component is ignored rather than poisoning the box
+        vertices.insert(vertices.begin(),
+                        {std::numeric_limits<float>::quiet_NaN(), 9.0f, 0.0f});
+        gs::ComputeBounds(vertices, min, max);
+        ASSERT_EQ(min.x, -4.0f);
+        ASSERT_EQ(max.x, 2.0f);
+        ASSERT_EQ(max.y, 9.0f);
+
+        // No vertices yields a box at the origin
+        gs::ComputeBounds({}, min, max);
+        ASSERT_EQ(min.x, 0.0f);
+        ASSERT_EQ(max.z, 0.0f);
+    }
+
+
+    // Test that octahedral normals round-trip within the expected precision
+    TEST(MeshCodingTest, Octahedral_Round_Trip)
+    {
+        std::vector<gs::Norm1> normals;
+
+        // Produce normals spread over the sphere, including the poles
+        normals.push_back({{0.0f}, {0.0f}, {1.0f}});
+        normals.push_back({{0.0f}, {0.0f}, {-1.0f}});
+        normals.push_back({{1.0f}, {0.0f}, {0.0f}});
+        normals.push_back({{0.0f}, {-1.0f}, {0.0f}});
+        for (int i = 0; i < 57; i++)
+        {
+            const float theta = 0.37f * i;
+            const float z = -1.0f + (2.0f * i + 1.0f) / 57.0f;
+            const float r = std::sqrt(1.0f - z * z);
+            normals.push_back({{r * std::cos(theta)},
+                               {r * std::sin(theta)},
+                               {z}});
+        }
+
+        for (unsigned bits : {8u, 12u, 16u})
+        {
+            const std::size_t width = (bits > 8) ? 2 : 1;
+            std::vector<unsigned char> data(normals.size() * 2 * width);
+            std::vector<gs::Norm1> decoded(normals.size());
+
+            gs::EncodeOctahedral(normals.data(),
+                                 normals.size(),
+                                 bits,
+                                 data.data());
+            gs::DecodeOctahedral(data.data(),
+                                 normals.size(),
+                                 bits,
+                                 decoded.data());
+
+            // Angular error is bounded by roughly 4 / 2^bits radians
+            const float tolerance = 4.0f / static_cast<float>(1u << bits);
+
+            for (std::size_t i = 0; i < normals.size(); i++)
+            {
+                const double ax = normals[i].x.value;
+                const double ay = normals[i].y.value;
+                const double az = normals[i].z.value;
+                const double bx = decoded[i].x.value;
+                const double by = decoded[i].y.value;
+                const double bz = decoded[i].z.value;
+
+                // Compute the angle using the cross and dot products
+                const double cx = ay * bz - az * by;
+                const double cy = az * bx - ax * bz;
+                const double cz = ax * by - ay * bx;
+                const double angle =
+                    std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz),
+                               ax * bx + ay * by + az * bz);
+
+                ASSERT_NEAR(std::sqrt(bx * bx + by * by + bz * bz), 1.0, 1e-6);
+                ASSERT_LT(angle, tolerance);
+            }
+        }
+    }
+
+    // Test that the vectorized and scalar octahedral paths agree
+    TEST(MeshCodingTest, Octahedral_Batch_Matches_Single)
+    {
+        std::vector<gs::Norm1> normals;
+
+        for (int i = 0; i < 23; i++)
+        {
+            normals.push_back({{std::sin(1.3f * i)},
+                               {std::cos(0.7f * i)},
+                               {std::sin(2.9f * i) - 0.2f}});
+        }
+
+        std::vector<unsigned char> batch(normals.size() * 4);
+        std::vector<gs::Norm1> batch_decoded(normals.size());
+
+        gs::EncodeOctahedral(normals.data(), normals.size(), 16, batch.data());
+        gs::DecodeOctahedral(batch.data(),
+                             normals.size(),
+                             16,
+                             batch_decoded.data());
+
+        // Encoding one at a time uses only the scalar path
+        for (std::size_t i = 0; i < normals.size(); i++)
+        {
+            unsigned char single[4];
+            gs::Norm1 single_decoded;
+
+            gs::EncodeOctahedral(&normals[i], 1, 16, single);
+            gs::DecodeOctahedral(single, 1, 16, &single_decoded);
+
+            for (std::size_t j = 0; j < 4; j++)
+            {
+                ASSERT_EQ(single[j], batch[i * 4 + j]);
+            }
+            ASSERT_EQ(single_decoded.x.value, batch_decoded[i].x.value);
+            ASSERT_EQ(single_decoded.y.value, batch_decoded[i].y.value);
+            ASSERT_EQ(single_decoded.z.value, batch_decoded[i].z.value);
+        }
+    }
+
+    // Test that normals with NaN or infinite components encode identically
+    // in the batch and scalar paths, with NaN components treated as zero
+    TEST(MeshCodingTest, Octahedral_NaN)
+    {
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const float inf = std::numeric_limits<float>::infinity();
+        std::vector<gs::Norm1> normals =
+        {
+            {{nan}, {0.0f}, {1.0f}},
+            {{0.0f}, {nan}, {-1.0f}},
+            {{1.0f}, {0.0f}, {nan}},
+            {{nan}, {nan}, {nan}},
+            {{-nan}, {0.5f}, {-0.5f}},
+            {{inf}, {0.0f}, {0.0f}},
+            {{-inf}, {inf}, {-1.0f}},
+            {{0.0f}, {0.0f}, {0.0f}}
+        };
+
+        for (unsigned bits : {8u, 16u})
+        {
+            const std::size_t width = (bits > 8) ? 2 : 1;
+            std::vector<unsigned char> batch(normals.size() * 2 * width);
+
+            gs::EncodeOctahedral(normals.data(),
+                                 normals.size(),
+                                 bits,
+                                 batch.data());
+
+            for (std::size_t i = 0; i < normals.size(); i++)
+            {
+                unsigned char single[4];
+
+                gs::EncodeOctahedral(&normals[i], 1, bits, single);
+                for (std::size_t j = 0; j < 2 * width; j++)
+                {
+                    ASSERT_EQ(single[j], batch[i * 2 * width + j]);
+                }
+            }
+
+            // A NaN component encodes as if it were zero
+            std::vector<gs::Norm1> zeroed =
+            {
+                {{0.0f}, {0.0f}, {1.0f}},
+                {{0.0f}, {0.0f}, {-1.0f}},
+                {{1.0f}, {0.0f}, {0.0f}},
+                {{0.0f}, {0.0f}, {0.0f}}
+            };
+            std::vector<unsigned char> expected(zeroed.size() * 2 * width);
+            gs::EncodeOctahedral(zeroed.data(),
+                                 zeroed.size(),
+                                 bits,
+                                 expected.data());
+            for (std::size_t j = 0; j < expected.size(); j++)
+            {
+                ASSERT_EQ(batch[j], expected[j]);
+            }
+        }
+    }
+
+
+    // Test that parallelogram prediction is exact on a regular grid
+    TEST(MeshCodingTest, PredictPositions_Grid)
+    {
+        const std::size_t n = 4;
+        std::vector<std::uint16_t> quantized;
+        std::vector<gs::VarUint> triangles;
+
+        // A grid of vertices with two triangles per cell
+        for (std::size_t y = 0; y < n; y++)
+        {
+            for (std::size_t x = 0; x < n; x++)
+            {
+                quantized.push_back(static_cast<std::uint16_t>(100 + x * 7));
+                quantized.push_back(static_cast<std::uint16_t>(200 + y * 5));
+                quantized.push_back(static_cast<std::uint16_t>(x + y));
+            }
+        }
+        for (std::size_t y = 0; y + 1 < n; y++)
+        {
+            for (std::size_t x = 0; x + 1 < n; x++)
+            {
+                const std::uint64_t v = y * n + x;
+                triangles.insert(triangles.end(),
+                                 {{v}, {v + 1}, {v + n}});
+                triangles.insert(triangles.end(),
+                                 {{v + 1}, {v + n + 1}, {v + n}});
+            }
+        }
+
+        std::vector<std::int32_t> residuals(quantized.size());
+        gs::PredictPositions(triangles,
+                             n * n,
+                             10,
+                             quantized.data(),
+                             residuals.data());
+
+        // The first vertex is predicted from zero
+        ASSERT_EQ(residuals[0], 100);
+        ASSERT_EQ(residuals[1], 200);
+        ASSERT_EQ(residuals[2], 0);
+
+        // Vertices completing a parallelogram are predicted exactly
+        std::size_t exact{};
+        for (std::size_t i = 0; i < residuals.size(); i += 3)
+        {
+            if (!residuals[i] && !residuals[i + 1] && !residuals[i + 2])
+            {
+                exact++;
+            }
+        }
+        ASSERT_GE(exact, (n - 1) * (n - 1));
+
+        std::vector<std::uint16_t> reconstructed(quantized.size());
+        ASSERT_TRUE(gs::ReconstructPositions(triangles,
+                                             n * n,
+                                             10,
+                                             residuals.data(),
+                                             reconstructed.data()));
+        ASSERT_EQ(reconstructed, quantized);
+    }
+
+    // Test prediction of unreferenced vertices and corrupt residuals
+    TEST(MeshCodingTest, PredictPositions_Unreferenced)
+    {
+        const std::vector<std::uint16_t> quantized =
+        {
+            10, 20, 30,   200, 7, 9,   11, 22, 33,   15, 25, 35
+        };
+        const std::vector<gs::VarUint> triangles = {{2}, {0}, {3}};
+        std::vector<std::int32_t> residuals(quantized.size());
+        std::vector<std::uint16_t> reconstructed(quantized.size());
+
+        gs::PredictPositions(triangles,
+                             4,
+                             8,
+                             quantized.data(),
+                             residuals.data());
+
+        // Vertex 2 from zero, 0 from 2, 3 from 0, then unreferenced
+        // vertex 1 from 3
+        const std::vector<std::int32_t> expected =
+        {
+            11, 22, 33,   -1, -2, -3,   5, 5, 5,   185, -18, -26
+        };
+        ASSERT_EQ(residuals, expected);
+
+        ASSERT_TRUE(gs::ReconstructPositions(triangles,
+                                             4,
+                                             8,
+                                             residuals.data(),
+                                             reconstructed.data()));
+        ASSERT_EQ(reconstructed, quantized);
+
+        // A residual taking a component outside the range is rejected
+        residuals[0] = 300;
+        ASSERT_FALSE(gs::ReconstructPositions(triangles,
+                                              4,
+                                              8,
+                                              residuals.data(),
+                                              reconstructed.data()));
+    }
+
+
+    // Test that duplicate vertices are merged and indices remapped
+    TEST(MeshCodingTest, WeldVertices)
+    {
+        std::vector<gs::Loc1> vertices =
+        {
+            {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f}
+        };
+        std::vector<gs::Norm1> normals(vertices.size(), {{0}, {0}, {1}});
+        std::vector<gs::TextureUV1> textures =
+        {
+            {0, 0}, {1, 0}, {0, 1}, {1, 0}, {0, 1}, {1, 1}, {2, 0}
+        };
+        std::vector<gs::VarUint> triangles =
+        {
+            {0}, {1}, {2}, {3}, {5}, {4}, {6}, {5}, {4}
+        };
+
+        // The last vertex differs from the second only in texture coordinates
+        ASSERT_EQ(gs::WeldVertices(vertices, normals, textures, triangles), 2);
+
+        std::vector<std::uint64_t> expected = {0, 1, 2, 1, 3, 2, 4, 3, 2};
+        ASSERT_EQ(vertices.size(), 5);
+        ASSERT_EQ(normals.size(), 5);
+        ASSERT_EQ(textures.size(), 5);
+        for (std::size_t i = 0; i < expected.size(); i++)
+        {
+            ASSERT_EQ(triangles[i].value, expected[i]);
+        }
+        ASSERT_FLOAT_EQ(vertices[3].x, 1.0f);
+        ASSERT_FLOAT_EQ(vertices[3].y, 1.0f);
+        ASSERT_EQ(textures[4].u.value, 2);
+
+        // Welding again finds nothing to merge
+        ASSERT_EQ(gs::WeldVertices(vertices, normals, textures, triangles), 0);
+        ASSERT_EQ(vertices.size(), 5);
+    }
+
+    // Test that a mesh which cannot be rewritten is left unchanged
+    TEST(MeshCodingTest, WeldVertices_Invalid)
+    {
+        std::vector<gs::Loc1> vertices =
+        {
+            {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}
+        };
+        std::vector<gs::Norm1> normals(2, {{0}, {0}, {1}});
+        std::vector<gs::TextureUV1> textures;
+        std::vector<gs::VarUint> triangles = {{0}, {1}, {2}};
+
+        // Normals are not per-vertex
+        ASSERT_EQ(gs::WeldVertices(vertices, normals, textures, triangles), 0);
+        ASSERT_EQ(vertices.size(), 3);
+
+        // A triangle index exceeds the vertex count
+        normals.clear();
+        triangles.push_back({3});
+        ASSERT_EQ(gs::WeldVertices(vertices, normals, textures, triangles), 0);
+        ASSERT_EQ(vertices.size(), 3);
+        ASSERT_EQ(triangles[1].value, 1);
+    }
+
+
+    // Test that bounds are extended by each vertex, whatever its position
+    // within a group of four, and that NaN components are ignored
+    TEST(MeshCodingTest, ExtendBounds)
+    {
+        for (std::size_t count = 2; count < 11; count++)
+        {
+            for (std::size_t extreme = 0; extreme < count; extreme++)
+            {
+                std::vector<gs::Loc1> vertices(count, {0.0f, 0.0f, 0.0f});
+                gs::Loc1 min{};
+                gs::Loc1 max{};
+
+                vertices[extreme] = {-1.0f, 2.0f, -3.0f};
+                vertices[(extreme + 1) % count] = {4.0f, -5.0f, 6.0f};
+                if (count > 2)
+                {
+                    vertices[(extreme + 2) % count].y = std::nanf("");
+                }
+
+                gs::ExtendBounds(vertices.data(), count, min, max);
+
+                ASSERT_EQ(min.x, -1.0f);
+                ASSERT_EQ(min.y, -5.0f);
+                ASSERT_EQ(min.z, -3.0f);
+                ASSERT_EQ(max.x, 4.0f);
+                ASSERT_EQ(max.y, 2.0f);
+                ASSERT_EQ(max.z, 6.0f);
+            }
+        }
+    }
+
+} // namespace
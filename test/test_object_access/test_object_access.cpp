@@ -0,0 +1,117 @@
+/*
+ *  test_object_access.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the utility functions that return fields common to
+ *      several object types.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "object_access.h"
+
+namespace {
+
+    // Test retrieving object IDs
+    TEST(ObjectAccessTest, Object_ID)
+    {
+        gs::Object1 object1{};
+        object1.id.value = 1;
+        gs::Head1 head1{};
+        head1.id.value = 2;
+        gs::Hand1 hand1{};
+        hand1.id.value = 3;
+        gs::Hand2 hand2{};
+        hand2.id.value = 4;
+        gs::Mesh1 mesh1{};
+        mesh1.id.value = 5;
+
+        ASSERT_EQ(gs::GetObjectID(object1), 1);
+        ASSERT_EQ(gs::GetObjectID(head1), 2);
+        ASSERT_EQ(gs::GetObjectID(hand1), 3);
+        ASSERT_EQ(gs::GetObjectID(hand2), 4);
+        ASSERT_EQ(gs::GetObjectID(mesh1), 5);
+        ASSERT_FALSE(gs::GetObjectID(gs::HeadIPD1{}));
+        ASSERT_FALSE(gs::GetObjectID(gs::UnknownObject{}));
+    }
+
+    // Test retrieving object times
+    TEST(ObjectAccessTest, Object_Time)
+    {
+        gs::Object1 object1{};
+        object1.time = 1;
+        gs::Head1 head1{};
+        head1.time = 2;
+        gs::Hand1 hand1{};
+        hand1.time = 3;
+        gs::Hand2 hand2{};
+        hand2.time = 4;
+
+        ASSERT_EQ(gs::GetObjectTime(object1), 1);
+        ASSERT_EQ(gs::GetObjectTime(head1), 2);
+        ASSERT_EQ(gs::GetObjectTime(hand1), 3);
+        ASSERT_EQ(gs::GetObjectTime(hand2), 4);
+        ASSERT_FALSE(gs::GetObjectTime(gs::Mesh1{}));
+    }
+
+    // Test retrieving object positions
+    TEST(ObjectAccessTest, Object_Position)
+    {
+        gs::Object1 object1{};
+        object1.position = {1.0f, 2.0f, 3.0f};
+        gs::Hand2 hand2{};
+        hand2.location = {4.0f, 5.0f, 6.0f, {7.0f}, {8.0f}, {9.0f}};
+
+        const auto position1 = gs::GetObjectPosition(object1);
+        ASSERT_TRUE(position1);
+        ASSERT_EQ(position1->x, 1.0f);
+        ASSERT_EQ(position1->y, 2.0f);
+        ASSERT_EQ(position1->z, 3.0f);
+
+        const auto position2 = gs::GetObjectPosition(hand2);
+        ASSERT_TRUE(position2);
+        ASSERT_EQ(position2->x, 4.0f);
+        ASSERT_EQ(position2->y, 5.0f);
+        ASSERT_EQ(position2->z, 6.0f);
+
+        ASSERT_FALSE(gs::GetObjectPosition(gs::Mesh1{}));
+    }
+
+} // namespace
@@ -0,0 +1,197 @@
+/*
+ *  test_object_id_mapper.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the ObjectIDMapper object, which assigns dense
+ *      indices and generation counters to object IDs seen by a receiver.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "data_buffer.h"
+#include "object_id_mapper.h"
+
+namespace {
+
+    // Test assigning handles on first sight
+    TEST(ObjectIDMapperTest, Map)
+    {
+        gs::ObjectIDMapper mapper;
+
+        const gs::ObjectHandle a = mapper.Map(1000000);
+        const gs::ObjectHandle b = mapper.Map(42);
+
+        ASSERT_EQ(a.index, 0);
+        ASSERT_EQ(b.index, 1);
+        ASSERT_EQ(mapper.Map(1000000), a);
+        ASSERT_EQ(mapper.GetCount(), 2);
+        ASSERT_EQ(mapper.GetIndexLimit(), 2);
+        ASSERT_EQ(mapper.GetID(1), 42);
+
+        ASSERT_EQ(mapper.Find(42), b);
+        ASSERT_FALSE(mapper.Find(43).has_value());
+        ASSERT_TRUE(mapper.IsCurrent(a));
+        ASSERT_FALSE(mapper.IsCurrent(gs::ObjectHandle{}));
+    }
+
+    // Test that released indices are reused with a new generation
+    TEST(ObjectIDMapperTest, Release)
+    {
+        gs::ObjectIDMapper mapper;
+
+        const gs::ObjectHandle a = mapper.Map(10);
+        const gs::ObjectHandle b = mapper.Map(20);
+
+        ASSERT_TRUE(mapper.Release(10));
+        ASSERT_FALSE(mapper.Release(10));
+        ASSERT_FALSE(mapper.IsCurrent(a));
+        ASSERT_TRUE(mapper.IsCurrent(b));
+
+        const gs::ObjectHandle c = mapper.Map(30);
+        ASSERT_EQ(c.index, a.index);
+        ASSERT_NE(c.generation, a.generation);
+        ASSERT_NE(c, a);
+        ASSERT_TRUE(mapper.IsCurrent(c));
+        ASSERT_FALSE(mapper.IsCurrent(a));
+        ASSERT_EQ(mapper.GetIndexLimit(), 2);
+    }
+
+    // Test that clearing invalidates all handles issued
+    TEST(ObjectIDMapperTest, Clear)
+    {
+        gs::ObjectIDMapper mapper;
+
+        const gs::ObjectHandle a = mapper.Map(10);
+        mapper.Clear();
+
+        ASSERT_EQ(mapper.GetCount(), 0);
+        ASSERT_FALSE(mapper.IsCurrent(a));
+
+        const gs::ObjectHandle b = mapper.Map(10);
+        ASSERT_EQ(b.index, a.index);
+        ASSERT_NE(b, a);
+    }
+
+    // Test mapping a vector of objects
+    TEST(ObjectIDMapperTest, Map_Objects)
+    {
+        gs::ObjectIDMapper mapper;
+        gs::GSObjects objects;
+        std::vector<gs::ObjectHandle> handles;
+
+        gs::Object1 object1{};
+        object1.id.value = 7;
+        gs::Hand2 hand2{};
+        hand2.id.value = 9;
+
+        objects.push_back(object1);
+        objects.push_back(gs::HeadIPD1{});
+        objects.push_back(hand2);
+        objects.push_back(object1);
+
+        mapper.Map(9);
+        mapper.Map(objects, handles);
+
+        ASSERT_EQ(handles.size(), 4);
+        ASSERT_EQ(handles[0].index, 1);
+        ASSERT_FALSE(handles[1].IsValid());
+        ASSERT_EQ(handles[2].index, 0);
+        ASSERT_EQ(handles[3], handles[0]);
+
+        // Mapping from a given position leaves earlier handles alone
+        std::vector<gs::ObjectHandle> partial(1);
+        mapper.Map(objects, partial, 2);
+        ASSERT_EQ(partial.size(), 4);
+        ASSERT_FALSE(partial[0].IsValid());
+        ASSERT_FALSE(partial[1].IsValid());
+        ASSERT_EQ(partial[2], handles[2]);
+        ASSERT_EQ(partial[3], handles[3]);
+    }
+
+    // Test decoding objects along with their handles
+    TEST(ObjectIDMapperTest, Decode)
+    {
+        gs::Encoder encoder;
+        gs::Decoder decoder;
+        gs::ObjectIDMapper mapper;
+        gs::DataBuffer data_buffer(1500);
+        gs::GSObjects decoded;
+        std::vector<gs::ObjectHandle> handles;
+
+        gs::Object1 object1{};
+        object1.id.value = 0x1234567890;
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        gs::Head1 head1{};
+        head1.id.value = 3;
+
+        encoder.Encode(data_buffer, object1);
+        encoder.Encode(data_buffer, head1);
+        encoder.Encode(data_buffer, object1);
+
+        decoder.Decode(data_buffer, decoded, mapper, handles);
+
+        ASSERT_EQ(decoded.size(), 3);
+        ASSERT_EQ(handles.size(), 3);
+        ASSERT_EQ(handles[0].index, 0);
+        ASSERT_EQ(handles[1].index, 1);
+        ASSERT_EQ(handles[2], handles[0]);
+        ASSERT_EQ(mapper.GetID(handles[0].index), 0x1234567890);
+
+        // Decoding more objects into the vector maps only the new objects,
+        // so a released object is not mapped again
+        gs::DataBuffer next_buffer(1500);
+        const gs::ObjectHandle released = handles[0];
+        encoder.Encode(next_buffer, head1);
+        ASSERT_TRUE(mapper.Release(0x1234567890));
+
+        decoder.Decode(next_buffer, decoded, mapper, handles);
+
+        ASSERT_EQ(decoded.size(), 4);
+        ASSERT_EQ(handles.size(), 4);
+        ASSERT_EQ(handles[0], released);
+        ASSERT_EQ(handles[3], handles[1]);
+        ASSERT_FALSE(mapper.Find(0x1234567890).has_value());
+        ASSERT_FALSE(mapper.IsCurrent(handles[0]));
+    }
+
+} // namespace
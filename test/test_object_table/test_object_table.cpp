@@ -0,0 +1,265 @@
+/*
+ *  test_object_table.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the ObjectTable object, which maps object IDs to
+ *      stable dense indices using an open-addressing hash table, and the
+ *      ObjectStore template holding per-object components by index.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "object_table.h"
+
+namespace {
+
+    // Test inserting and finding objects
+    TEST(ObjectTableTest, Insert_Find)
+    {
+        gs::ObjectTable table;
+
+        ASSERT_EQ(table.Insert(100), 0);
+        ASSERT_EQ(table.Insert(gs::ObjectID{7}), 1);
+        ASSERT_EQ(table.Insert(100), 0);
+        ASSERT_EQ(table.GetCount(), 2);
+
+        ASSERT_EQ(table.Find(100), 0);
+        ASSERT_EQ(table.Find(gs::ObjectID{7}), 1);
+        ASSERT_EQ(table.Find(8), gs::ObjectTable::Not_Found);
+
+        ASSERT_EQ(table.GetID(1), 7);
+        ASSERT_TRUE(table.IsValid(1));
+        ASSERT_FALSE(table.IsValid(2));
+    }
+
+    // Test that removed indices are reused and others are unchanged
+    TEST(ObjectTableTest, Remove)
+    {
+        gs::ObjectTable table;
+
+        for (std::uint64_t id = 0; id < 10; id++)
+        {
+            ASSERT_EQ(table.Insert(id), id);
+        }
+
+        ASSERT_TRUE(table.Remove(3));
+        ASSERT_FALSE(table.Remove(3));
+        ASSERT_FALSE(table.IsValid(3));
+        ASSERT_EQ(table.Find(3), gs::ObjectTable::Not_Found);
+        ASSERT_EQ(table.GetCount(), 9);
+
+        for (std::uint64_t id = 0; id < 10; id++)
+        {
+            if (id != 3)
+            {
+                ASSERT_EQ(table.Find(id), id);
+            }
+        }
+
+        ASSERT_EQ(table.Insert(1000), 3);
+        ASSERT_EQ(table.GetID(3), 1000);
+        ASSERT_EQ(table.GetIndexLimit(), 10);
+    }
+
+    // Test a random mix of operations against a reference map, including
+    // enough objects to force the table to grow
+    TEST(ObjectTableTest, Random_Operations)
+    {
+        gs::ObjectTable table;
+        std::unordered_map<std::uint64_t, std::size_t> reference;
+        std::mt19937_64 generator(1);
+        std::uniform_int_distribution<std::uint64_t> ids(0, 5000);
+
+        for (std::size_t i = 0; i < 100000; i++)
+        {
+            const std::uint64_t id = ids(generator);
+
+            if (generator() % 3 == 0)
+            {
+                ASSERT_EQ(table.Remove(id), reference.erase(id) > 0);
+            }
+            else
+            {
+                const std::size_t index = table.Insert(id);
+                const auto it = reference.find(id);
+                if (it != reference.end())
+                {
+                    ASSERT_EQ(index, it->second);
+                }
+                reference[id] = index;
+            }
+        }
+
+        ASSERT_EQ(table.GetCount(), reference.size());
+
+        for (std::uint64_t id = 0; id <= 5000; id++)
+        {
+            const auto it = reference.find(id);
+            const std::size_t index = table.Find(id);
+            if (it == reference.end())
+            {
+                ASSERT_EQ(index, gs::ObjectTable::Not_Found);
+            }
+            else
+            {
+                ASSERT_EQ(index, it->second);
+                ASSERT_EQ(table.GetID(index), id);
+            }
+        }
+
+        ASSERT_LE(table.GetIndexLimit(), 5001);
+    }
+
+    // Test looking up several object IDs at once
+    TEST(ObjectTableTest, Batch_Find)
+    {
+        gs::ObjectTable table(1000);
+        std::vector<std::uint64_t> ids;
+        std::vector<std::size_t> indices;
+
+        for (std::uint64_t id = 0; id < 1000; id++) table.Insert(id * 3);
+        for (std::uint64_t id = 0; id < 100; id++) ids.push_back(id);
+
+        table.Find(ids, indices);
+        ASSERT_EQ(indices.size(), ids.size());
+
+        for (std::size_t i = 0; i < ids.size(); i++)
+        {
+            ASSERT_EQ(indices[i], table.Find(ids[i]));
+            ASSERT_EQ(indices[i] == gs::ObjectTable::Not_Found, i % 3 != 0);
+        }
+    }
+
+    // Test looking up the objects of a decoded frame
+    TEST(ObjectTableTest, Batch_Find_Objects)
+    {
+        gs::ObjectTable table;
+        gs::GSObjects objects;
+        std::vector<std::size_t> indices;
+
+        gs::Object1 object1{};
+        object1.id.value = 5;
+        gs::Head1 head1{};
+        head1.id.value = 9;
+        gs::HeadIPD1 head_ipd1{};
+
+        objects.push_back(object1);
+        objects.push_back(head_ipd1);
+        objects.push_back(head1);
+
+        table.Insert(9);
+        table.Insert(5);
+
+        table.Find(objects, indices);
+        ASSERT_EQ(indices, std::vector<std::size_t>({1,
+                                                     gs::ObjectTable::Not_Found,
+                                                     0}));
+    }
+
+    // Test clearing the table
+    TEST(ObjectTableTest, Clear)
+    {
+        gs::ObjectTable table;
+
+        table.Insert(1);
+        table.Insert(2);
+        table.Clear();
+
+        ASSERT_EQ(table.GetCount(), 0);
+        ASSERT_EQ(table.Find(1), gs::ObjectTable::Not_Found);
+        ASSERT_EQ(table.Insert(2), 0);
+    }
+
+    // Test storing components of objects in separate columns
+    TEST(ObjectStoreTest, Components)
+    {
+        gs::ObjectStore<gs::Loc1, std::uint32_t> store;
+
+        const std::size_t a = store.Insert(gs::ObjectID{500}.value);
+        const std::size_t b = store.Insert(9);
+
+        store.Get<0>(a) = {1.0f, 2.0f, 3.0f};
+        store.Get<1>(a) = 7;
+        store.Get<1>(b) = 8;
+
+        ASSERT_EQ(store.GetCount(), 2);
+        ASSERT_EQ(store.GetColumn<0>().size(), 2);
+        ASSERT_EQ(store.GetColumn<1>(), std::vector<std::uint32_t>({7, 8}));
+        ASSERT_EQ(store.Find(500), a);
+        ASSERT_EQ(store.Get<0>(store.Find(500)).y, 2.0f);
+        ASSERT_EQ(store.GetID(b), 9);
+        ASSERT_EQ(store.Insert(500), a);
+        ASSERT_EQ(store.Get<1>(a), 7);
+    }
+
+    // Test that removed objects leave reset components for reuse
+    TEST(ObjectStoreTest, Remove)
+    {
+        gs::ObjectStore<std::uint32_t> store;
+        std::vector<std::size_t> indices;
+        gs::GSObjects objects;
+        gs::Object1 object1{};
+
+        store.Get<0>(store.Insert(1)) = 10;
+        store.Get<0>(store.Insert(2)) = 20;
+
+        ASSERT_TRUE(store.Remove(1));
+        ASSERT_FALSE(store.Remove(1));
+        ASSERT_FALSE(store.IsValid(0));
+        ASSERT_EQ(store.Get<0>(0), 0);
+
+        ASSERT_EQ(store.Insert(3), 0);
+        ASSERT_EQ(store.Get<0>(0), 0);
+        ASSERT_EQ(store.GetIndexLimit(), 2);
+
+        object1.id.value = 2;
+        objects.push_back(object1);
+        store.Find(objects, indices);
+        ASSERT_EQ(indices, std::vector<std::size_t>({1}));
+
+        store.Clear();
+        ASSERT_EQ(store.GetCount(), 0);
+        ASSERT_TRUE(store.GetColumn<0>().empty());
+    }
+
+} // namespace
@@ -0,0 +1,142 @@
+/*
+ *  test_parallel_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the utility functions used to divide the
+ *      serialization of large vectors among multiple threads.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include "gtest/gtest.h"
+#include "parallel_coding.h"
+
+namespace {
+
+    // Test the length of a VarUint is determined from its first octet
+    TEST(ParallelCodingTest, VarUintLength)
+    {
+        ASSERT_EQ(gs::VarUintLength(0x00), 1);
+        ASSERT_EQ(gs::VarUintLength(0x7f), 1);
+        ASSERT_EQ(gs::VarUintLength(0x80), 2);
+        ASSERT_EQ(gs::VarUintLength(0xbf), 2);
+        ASSERT_EQ(gs::VarUintLength(0xc0), 3);
+        ASSERT_EQ(gs::VarUintLength(0xdf), 3);
+        ASSERT_EQ(gs::VarUintLength(0xe1), 5);
+        ASSERT_EQ(gs::VarUintLength(0xe2), 9);
+        ASSERT_EQ(gs::VarUintLength(0xe0), 0);
+        ASSERT_EQ(gs::VarUintLength(0xff), 0);
+    }
+
+    // Test that elements are divided only when each chunk is large enough
+    TEST(ParallelCodingTest, GetChunkCount)
+    {
+        ASSERT_EQ(gs::GetChunkCount(1000, 8, 100), 8);
+        ASSERT_EQ(gs::GetChunkCount(1000, 16, 100), 10);
+        ASSERT_EQ(gs::GetChunkCount(1000, 1, 100), 1);
+        ASSERT_EQ(gs::GetChunkCount(199, 8, 100), 1);
+        ASSERT_EQ(gs::GetChunkCount(0, 8, 100), 1);
+        ASSERT_GE(gs::GetChunkCount(1000, 0, 100), 1);
+    }
+
+    // Test that chunks cover every element exactly once
+    TEST(ParallelCodingTest, GetChunkBegin)
+    {
+        for (std::size_t chunks = 1; chunks < 8; chunks++)
+        {
+            ASSERT_EQ(gs::GetChunkBegin(1003, chunks, 0), 0);
+            ASSERT_EQ(gs::GetChunkBegin(1003, chunks, chunks), 1003);
+            for (std::size_t chunk = 0; chunk < chunks; chunk++)
+            {
+                const std::size_t length =
+                    gs::GetChunkBegin(1003, chunks, chunk + 1) -
+                    gs::GetChunkBegin(1003, chunks, chunk);
+                ASSERT_GE(length, 1003 / chunks);
+                ASSERT_LE(length, 1003 / chunks + 1);
+            }
+        }
+    }
+
+    // Test that each chunk is processed on its own thread
+    TEST(ParallelCodingTest, ParallelFor)
+    {
+        std::vector<unsigned> visits(1000);
+        std::vector<std::thread::id> ids(4);
+
+        gs::ParallelFor(visits.size(),
+                        ids.size(),
+                        [&](std::size_t chunk,
+                            std::size_t begin,
+                            std::size_t end)
+                        {
+                            ids[chunk] = std::this_thread::get_id();
+                            for (std::size_t i = begin; i < end; i++)
+                            {
+                                visits[i]++;
+                            }
+                        });
+
+        for (auto count : visits) ASSERT_EQ(count, 1);
+        ASSERT_EQ(ids[0], std::this_thread::get_id());
+        for (std::size_t i = 1; i < ids.size(); i++)
+        {
+            for (std::size_t j = 0; j < i; j++) ASSERT_NE(ids[i], ids[j]);
+        }
+    }
+
+    // Test that an exception thrown by a chunk reaches the caller
+    TEST(ParallelCodingTest, ParallelFor_Exception)
+    {
+        ASSERT_THROW(gs::ParallelFor(100,
+                                     4,
+                                     [](std::size_t chunk,
+                                        std::size_t,
+                                        std::size_t)
+                                     {
+                                         if (chunk == 2)
+                                         {
+                                             throw std::runtime_error("x");
+                                         }
+                                     }),
+                     std::runtime_error);
+    }
+
+} // namespace
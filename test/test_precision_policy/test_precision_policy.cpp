@@ -0,0 +1,195 @@
+/*
+ *  test_precision_policy.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the PrecisionPolicy object, which selects coarser
+ *      encodings as necessary to fit objects within an octet budget.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "precision_policy.h"
+
+namespace {
+
+    // The fixture for testing the PrecisionPolicy object
+    class PrecisionPolicyTest : public ::testing::Test
+    {
+        public:
+            PrecisionPolicyTest() : policy(MakeLadders())
+            {
+                for (std::uint64_t i = 0; i < 20; i++)
+                {
+                    gs::Hand2 hand2{};
+                    hand2.id.value = i;
+                    hand2.location = {1.0f, 2.0f, 3.0f, {0.5f}, {0.5f}, {1}};
+                    hand2.rotation.si.value = 0.25f;
+                    objects.push_back(hand2);
+
+                    gs::Object1 object1{};
+                    object1.id.value = 100 + i;
+                    object1.position = {4.0f, 5.0f, 6.0f};
+                    object1.rotation.i.value = 0.5f;
+                    object1.scale = {1.0f, 1.0f, 1.0f};
+                    objects.push_back(object1);
+                }
+            }
+
+            ~PrecisionPolicyTest() = default;
+
+            static gs::PrecisionLadders MakeLadders()
+            {
+                gs::PrecisionLadders ladders;
+                gs::ObjectEncoding encoding{};
+
+                encoding.rotation_bits = 12;
+                encoding.joint_bits = 12;
+                ladders.object1.push_back(encoding);
+                ladders.hand2.push_back(encoding);
+
+                encoding.rotation_bits = 8;
+                encoding.joint_bits = 8;
+                encoding.omit_defaults = true;
+                encoding.omit_velocity = true;
+                ladders.object1.push_back(encoding);
+                ladders.hand2.push_back(encoding);
+
+                return ladders;
+            }
+
+        protected:
+            gs::PrecisionPolicy policy;
+            gs::Encoder encoder;
+            gs::Decoder decoder;
+            gs::GSObjects objects;
+    };
+
+    // Test that objects are sent at full precision when they fit
+    TEST_F(PrecisionPolicyTest, Full_Precision)
+    {
+        gs::DataBuffer expected(10000);
+        gs::DataBuffer buffer(10000);
+
+        const auto result = encoder.Encode(expected, objects);
+        ASSERT_EQ(policy.Encode(buffer, objects, 10000), result);
+        ASSERT_EQ(buffer, expected);
+        ASSERT_EQ(policy.GetLevels().hand2, 0);
+        ASSERT_EQ(policy.GetLevels().object1, 0);
+    }
+
+    // Test that precision is reduced to fit the budget, beginning with the
+    // type offering the largest saving
+    TEST_F(PrecisionPolicyTest, Reduced_Precision)
+    {
+        const gs::PrecisionLadders ladders = MakeLadders();
+        const std::size_t full = encoder.GetEncodeLength(objects).second;
+        std::size_t coarsest{};
+
+        for (const auto &object : objects)
+        {
+            if (std::holds_alternative<gs::Hand2>(object))
+            {
+                coarsest += encoder.GetEncodeLength(std::get<gs::Hand2>(object),
+                                                    ladders.hand2[1]).second;
+            }
+            else
+            {
+                coarsest +=
+                    encoder.GetEncodeLength(std::get<gs::Object1>(object),
+                                            ladders.object1[1]).second;
+            }
+        }
+        ASSERT_LT(coarsest, full);
+
+        for (std::size_t budget : {full - 1, (full + coarsest) / 2, coarsest})
+        {
+            gs::DataBuffer buffer(10000);
+            gs::GSObjects decoded;
+
+            const auto result = policy.Encode(buffer, objects, budget);
+            ASSERT_EQ(result.first, objects.size());
+            ASSERT_LE(result.second, budget);
+            ASSERT_EQ(result.second, buffer.GetDataLength());
+            ASSERT_GE(policy.GetLevels().hand2, policy.GetLevels().object1);
+
+            // The decoder handles whatever mix of encodings was selected
+            ASSERT_EQ(decoder.Decode(buffer, decoded), result.second);
+            ASSERT_EQ(decoded.size(), objects.size());
+            for (std::size_t i = 0; i < decoded.size(); i++)
+            {
+                ASSERT_EQ(decoded[i].index(), objects[i].index());
+            }
+        }
+
+        // Hands offer the larger saving, so they are reduced first
+        gs::DataBuffer buffer(10000);
+        policy.Encode(buffer, objects, full - 1);
+        ASSERT_EQ(policy.GetLevels().hand2, 1);
+        ASSERT_EQ(policy.GetLevels().object1, 0);
+
+        // The first object level is longer, so it is skipped
+        policy.Encode(buffer, objects, coarsest);
+        ASSERT_EQ(policy.GetLevels().hand2, 2);
+        ASSERT_EQ(policy.GetLevels().object1, 2);
+    }
+
+    // Test that objects are omitted only if the coarsest precision does not
+    // fit the budget
+    TEST_F(PrecisionPolicyTest, Budget_Exceeded)
+    {
+        gs::DataBuffer buffer(10000);
+
+        const auto result = policy.Encode(buffer, objects, 300);
+        ASSERT_LT(result.first, objects.size());
+        ASSERT_GT(result.first, 0);
+        ASSERT_LE(result.second, 300);
+        ASSERT_EQ(policy.GetLevels().hand2, 2);
+        ASSERT_EQ(policy.GetLevels().object1, 2);
+
+        // The budget is limited by the buffer size
+        gs::DataBuffer short_buffer(300);
+        ASSERT_EQ(policy.Encode(short_buffer, objects, 10000), result);
+    }
+
+} // namespace
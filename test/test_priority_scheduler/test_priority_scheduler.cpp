@@ -0,0 +1,254 @@
+/*
+ *  test_priority_scheduler.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the PriorityScheduler object, which packs the
+ *      highest priority changed objects into an octet budget.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <vector>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "priority_scheduler.h"
+
+namespace {
+
+    // Create an Object1 at the given distance along the x axis
+    gs::Object1 MakeObject(std::uint64_t id, float x)
+    {
+        gs::Object1 object1{};
+        object1.id.value = id;
+        object1.position = {x, 0.0f, 0.0f};
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        return object1;
+    }
+
+    // Decode the object IDs in the buffer
+    std::vector<std::uint64_t> DecodeIDs(gs::DataBuffer &buffer)
+    {
+        gs::Decoder decoder;
+        gs::GSObjects objects;
+        std::vector<std::uint64_t> ids;
+
+        decoder.Decode(buffer, objects);
+        for (const auto &object : objects)
+        {
+            ids.push_back(std::get<gs::Object1>(object).id.value);
+        }
+
+        return ids;
+    }
+
+    // Test that nearer objects are sent first
+    TEST(PrioritySchedulerTest, Distance)
+    {
+        gs::PriorityScheduler scheduler;
+        gs::Encoder encoder;
+        const std::size_t length =
+            encoder.GetEncodeLength(MakeObject(1, 0.0f)).second;
+
+        scheduler.Update(MakeObject(1, 100.0f));
+        scheduler.Update(MakeObject(2, 0.0f));
+        scheduler.Update(MakeObject(3, 10.0f));
+        ASSERT_EQ(scheduler.GetPendingCount(), 3);
+
+        gs::DataBuffer buffer(1500);
+        ASSERT_EQ(scheduler.Encode(buffer, length * 2),
+                  gs::EncodeResult(2, length * 2));
+        ASSERT_EQ(DecodeIDs(buffer), std::vector<std::uint64_t>({2, 3}));
+        ASSERT_EQ(scheduler.GetPendingCount(), 1);
+
+        // The remaining object keeps its accrued priority
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(1), 1.0 / 11.0);
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(2), 0.0);
+
+        // An object reusing a sent object's slot starts with no priority
+        scheduler.Update(MakeObject(4, 0.0f));
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(4), 0.0);
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(1), 1.0 / 11.0);
+        ASSERT_TRUE(scheduler.Remove(1));
+        ASSERT_FALSE(scheduler.Remove(1));
+        ASSERT_EQ(scheduler.GetPendingCount(), 1);
+    }
+
+    // Test determining the length to be sent using a buffer with no size
+    TEST(PrioritySchedulerTest, Null_Buffer)
+    {
+        gs::PriorityScheduler scheduler;
+        gs::Encoder encoder;
+        const std::size_t length =
+            encoder.GetEncodeLength(MakeObject(1, 0.0f)).second;
+
+        scheduler.Update(MakeObject(1, 100.0f));
+        scheduler.Update(MakeObject(2, 0.0f));
+        scheduler.Update(MakeObject(3, 10.0f));
+
+        // The length is reported without changing the pending objects
+        gs::DataBuffer null_buffer;
+        ASSERT_EQ(scheduler.Encode(null_buffer, length * 2),
+                  gs::EncodeResult(2, length * 2));
+        ASSERT_EQ(scheduler.GetPendingCount(), 3);
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(1), 0.0);
+
+        // The same objects are then sent
+        gs::DataBuffer buffer(1500);
+        ASSERT_EQ(scheduler.Encode(buffer, length * 2),
+                  gs::EncodeResult(2, length * 2));
+        ASSERT_EQ(DecodeIDs(buffer), std::vector<std::uint64_t>({2, 3}));
+        ASSERT_EQ(scheduler.GetPendingCount(), 1);
+    }
+
+    // Test that objects not sent grow in priority until they are sent
+    TEST(PrioritySchedulerTest, Staleness)
+    {
+        gs::PriorityScheduler scheduler;
+        gs::Encoder encoder;
+        const std::size_t length =
+            encoder.GetEncodeLength(MakeObject(1, 0.0f)).second;
+        std::size_t ticks{};
+
+        // The near object changes every tick but the far one is still sent
+        scheduler.Update(MakeObject(1, 30.0f));
+        for (bool sent = false; !sent; ticks++)
+        {
+            ASSERT_LT(ticks, 10);
+            scheduler.Update(MakeObject(2, 0.0f));
+
+            gs::DataBuffer buffer(1500);
+            ASSERT_EQ(scheduler.Encode(buffer, length).first, 1);
+            sent = (DecodeIDs(buffer)[0] == 1);
+        }
+
+        // Priority grows by 1/4 per tick, reaching 1 on the fourth tick, and
+        // ties favor the lower object ID
+        ASSERT_EQ(ticks, 4);
+    }
+
+    // Test that type weights are applied
+    TEST(PrioritySchedulerTest, Type_Weight)
+    {
+        gs::PriorityWeights weights;
+        weights.object1 = 0.5;
+        weights.hand1 = 2.0;
+        gs::PriorityScheduler scheduler(weights);
+
+        gs::Hand1 hand1{};
+        hand1.id.value = 2;
+        hand1.location = {20.0f, 0.0f, 0.0f, {}, {}, {}};
+
+        scheduler.SetViewer({10.0f, 0.0f, 0.0f});
+        scheduler.Update(MakeObject(1, 10.0f));
+        scheduler.Update(hand1);
+
+        gs::DataBuffer buffer(1500);
+        scheduler.Encode(buffer, 0);
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(1), 0.5);
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(2), 1.0);
+
+        // Updating an object retains its priority
+        scheduler.Update(MakeObject(1, 10.0f));
+        ASSERT_DOUBLE_EQ(scheduler.GetPriority(1), 0.5);
+
+        // Removing an object discards it
+        ASSERT_TRUE(scheduler.Remove(2));
+        ASSERT_FALSE(scheduler.Remove(2));
+        ASSERT_EQ(scheduler.GetPendingCount(), 1);
+    }
+
+    // Test that objects too large for the remaining budget are skipped
+    TEST(PrioritySchedulerTest, Skip_Large)
+    {
+        gs::PriorityWeights weights;
+        weights.mesh1 = 10.0;
+        gs::PriorityScheduler scheduler(weights);
+        gs::Encoder encoder;
+        const std::size_t length =
+            encoder.GetEncodeLength(MakeObject(1, 0.0f)).second;
+
+        gs::Mesh1 mesh1{};
+        mesh1.id.value = 2;
+        mesh1.vertices.resize(100);
+
+        scheduler.Update(MakeObject(1, 0.0f));
+        scheduler.Update(mesh1);
+
+        gs::DataBuffer buffer(1500);
+        ASSERT_EQ(scheduler.Encode(buffer, length + 10),
+                  gs::EncodeResult(1, length));
+        ASSERT_EQ(DecodeIDs(buffer), std::vector<std::uint64_t>({1}));
+        ASSERT_EQ(scheduler.GetPendingCount(), 1);
+
+        // Objects without an ID cannot be scheduled
+        ASSERT_THROW(scheduler.Update(gs::HeadIPD1{}), gs::EncoderException);
+    }
+
+    // Test scheduling a large number of objects
+    TEST(PrioritySchedulerTest, Many_Objects)
+    {
+        gs::PriorityScheduler scheduler;
+        std::size_t total{};
+
+        for (std::uint64_t i = 0; i < 100000; i++)
+        {
+            scheduler.Update(MakeObject(i, static_cast<float>(i % 1000)));
+        }
+
+        for (std::size_t tick = 0; tick < 10; tick++)
+        {
+            gs::DataBuffer buffer(1400);
+            const auto result = scheduler.Encode(buffer, 1400);
+            ASSERT_GT(result.first, 0);
+            ASSERT_LE(result.second, 1400);
+            total += result.first;
+
+            // Only the nearest objects have been sent so far
+            for (const auto id : DecodeIDs(buffer))
+            {
+                ASSERT_LT(id % 1000, 10);
+            }
+        }
+
+        ASSERT_EQ(scheduler.GetPendingCount(), 100000 - total);
+    }
+
+} // namespace
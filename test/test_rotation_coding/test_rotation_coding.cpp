@@ -0,0 +1,170 @@
+/*
+ *  test_rotation_coding.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the functions used to compress rotations using
+ *      the smallest-three quaternion representation.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "rotation_coding.h"
+
+namespace {
+
+    // Return the angle in radians between the rotations represented by two
+    // Rot1 values, each having an implied non-negative real part
+    double RotationAngle(const gs::Rot1 &a, const gs::Rot1 &b)
+    {
+        const double ai = a.i.value, aj = a.j.value, ak = a.k.value;
+        const double bi = b.i.value, bj = b.j.value, bk = b.k.value;
+        double aw = 1.0 - (ai * ai + aj * aj + ak * ak);
+        double bw = 1.0 - (bi * bi + bj * bj + bk * bk);
+        aw = std::sqrt(aw > 0.0 ? aw : 0.0);
+        bw = std::sqrt(bw > 0.0 ? bw : 0.0);
+
+        const double dot = std::fabs(aw * bw + ai * bi + aj * bj + ak * bk);
+
+        return 2.0 * std::acos(dot < 1.0 ? dot : 1.0);
+    }
+
+    // Produce a set of unit rotations spread over the space of rotations
+    std::vector<gs::Rot1> TestRotations()
+    {
+        std::vector<gs::Rot1> rotations;
+
+        // Identity, half turns, and a rotation with a negative largest part
+        rotations.push_back({{0.0f}, {0.0f}, {0.0f}});
+        rotations.push_back({{1.0f}, {0.0f}, {0.0f}});
+        rotations.push_back({{0.0f}, {-1.0f}, {0.0f}});
+        rotations.push_back({{-0.9f}, {0.1f}, {0.1f}});
+
+        for (int n = 0; n < 96; n++)
+        {
+            const float angle = 0.13f * n;
+            const float z = -1.0f + (2.0f * n + 1.0f) / 96.0f;
+            const float r = std::sqrt(1.0f - z * z);
+            const float s = std::sin(angle / 2.0f);
+            rotations.push_back({{s * r * std::cos(1.7f * n)},
+                                 {s * r * std::sin(1.7f * n)},
+                                 {s * z}});
+        }
+
+        return rotations;
+    }
+
+    // Test the number of octets used to hold a compressed rotation
+    TEST(RotationCodingTest, Compressed_Length)
+    {
+        ASSERT_EQ(gs::CompressedRotationLength(2), 1);
+        ASSERT_EQ(gs::CompressedRotationLength(7), 3);
+        ASSERT_EQ(gs::CompressedRotationLength(9), 4);
+        ASSERT_EQ(gs::CompressedRotationLength(10), 4);
+        ASSERT_EQ(gs::CompressedRotationLength(20), 8);
+    }
+
+    // Test the packed form of the identity rotation
+    TEST(RotationCodingTest, Identity)
+    {
+        const gs::Rot1 identity{};
+        std::uint64_t packed{};
+        gs::Rot1 decoded{};
+
+        // The real part is dropped and the others are mid-range
+        gs::CompressRotations(&identity, 1, 10, &packed);
+        ASSERT_EQ(packed, 0x20080200);
+
+        gs::DecompressRotations(&packed, 1, 10, &decoded);
+        ASSERT_NEAR(decoded.i.value, 0.0f, 0.001f);
+        ASSERT_NEAR(decoded.j.value, 0.0f, 0.001f);
+        ASSERT_NEAR(decoded.k.value, 0.0f, 0.001f);
+    }
+
+    // Test that rotations round-trip within the quantization error
+    TEST(RotationCodingTest, Round_Trip)
+    {
+        const std::vector<gs::Rot1> rotations = TestRotations();
+
+        for (unsigned bits : {6u, 10u, 16u, 20u})
+        {
+            std::vector<std::uint64_t> packed(rotations.size());
+            std::vector<gs::Rot1> decoded(rotations.size());
+
+            gs::CompressRotations(rotations.data(),
+                                  rotations.size(),
+                                  bits,
+                                  packed.data());
+            gs::DecompressRotations(packed.data(),
+                                    packed.size(),
+                                    bits,
+                                    decoded.data());
+
+            // Each value fits within the compressed length
+            const unsigned total_bits = 2 + 3 * bits;
+            for (auto value : packed) ASSERT_EQ(value >> total_bits, 0);
+
+            // Angular error is bounded by a few quantization steps
+            const double tolerance = 4.0 * 1.4142 / ((1u << bits) - 1);
+
+            for (std::size_t i = 0; i < rotations.size(); i++)
+            {
+                ASSERT_LE(RotationAngle(rotations[i], decoded[i]), tolerance);
+            }
+        }
+    }
+
+    // Test that a non-unit rotation is normalized before compression
+    TEST(RotationCodingTest, Normalize)
+    {
+        const gs::Rot1 rotation{{1.0f}, {1.0f}, {0.0f}};
+        std::uint64_t packed{};
+        gs::Rot1 decoded{};
+
+        gs::CompressRotations(&rotation, 1, 16, &packed);
+        gs::DecompressRotations(&packed, 1, 16, &decoded);
+
+        ASSERT_NEAR(decoded.i.value, 0.70710678f, 0.0001f);
+        ASSERT_NEAR(decoded.j.value, 0.70710678f, 0.0001f);
+        ASSERT_NEAR(decoded.k.value, 0.0f, 0.0001f);
+    }
+
+} // namespace
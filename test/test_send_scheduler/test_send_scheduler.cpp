@@ -0,0 +1,208 @@
+/*
+ *  test_send_scheduler.cpp
+ *
+ *  Copyright (C) 2022
+ *  Cisco Systems, Inc.
+ *  All Rights Reserved
+ *
+ *  Description:
+ *      This module will test the SendScheduler object, which returns the
+ *      objects due to be sent on each tick using a hierarchical timing wheel.
+ *
+ *  Portability Issues:
+ *      None.
+ *
+ *  License:
+ *      BSD 2-Clause License
+ *
+ *      Copyright (c) 2022, Cisco Systems
+ *      All rights reserved.
+ *
+ *      Redistribution and use in source and binary forms, with or without
+ *      modification, are permitted provided that the following conditions are
+ *      met:
+ *
+ *      1. Redistributions of source code must retain the above copyright
+ *         notice, this list of conditions and the following disclaimer.
+ *
+ *      2. Redistributions in binary form must reproduce the above copyright
+ *         notice, this list of conditions and the following disclaimer in the
+ *         documentation and/or other materials provided with the distribution.
+ *
+ *      THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ *      IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+ *      TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+ *      PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *      HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *      SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *      LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *      DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *      THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *      (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *      OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <variant>
+#include "gtest/gtest.h"
+#include "gs_types.h"
+#include "gs_encoder.h"
+#include "gs_decoder.h"
+#include "send_scheduler.h"
+
+namespace {
+
+    // Create an Object1 having the given ID
+    gs::Object1 MakeObject(std::uint64_t id)
+    {
+        gs::Object1 object1{};
+        object1.id.value = id;
+        object1.scale = {1.0f, 1.0f, 1.0f};
+        return object1;
+    }
+
+    // Return the IDs due on the next tick in ascending order
+    std::vector<std::uint64_t> Advance(gs::SendScheduler &scheduler)
+    {
+        std::vector<std::uint64_t> ids = scheduler.Advance();
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    // Test objects having different periods
+    TEST(SendSchedulerTest, Periods)
+    {
+        gs::SendScheduler scheduler;
+        std::unordered_map<std::uint64_t, std::size_t> counts;
+
+        scheduler.Insert(MakeObject(1), 1);
+        scheduler.Insert(MakeObject(2), 3);
+        scheduler.Insert(MakeObject(3), 900);
+        ASSERT_EQ(scheduler.GetCount(), 3);
+
+        ASSERT_EQ(Advance(scheduler), std::vector<std::uint64_t>({1, 2, 3}));
+        ASSERT_EQ(scheduler.Advance(), std::vector<std::uint64_t>({1}));
+        ASSERT_EQ(scheduler.Advance(), std::vector<std::uint64_t>({1}));
+        ASSERT_EQ(scheduler.GetTick(), 3);
+
+        for (std::size_t tick = 3; tick < 2701; tick++)
+        {
+            for (const auto id : scheduler.Advance()) counts[id]++;
+        }
+
+        ASSERT_EQ(counts[1], 2698);
+        ASSERT_EQ(counts[2], 900);
+        ASSERT_EQ(counts[3], 3);
+    }
+
+    // Test that objects are due exactly when expected across all levels
+    TEST(SendSchedulerTest, Random_Periods)
+    {
+        gs::SendScheduler scheduler;
+        std::mt19937_64 generator(1);
+        std::uniform_int_distribution<std::uint64_t> periods(1, 100000);
+        std::unordered_map<std::uint64_t, std::uint64_t> next_due;
+        std::unordered_map<std::uint64_t, std::uint64_t> period_of;
+
+        for (std::uint64_t id = 0; id < 1000; id++)
+        {
+            const std::uint64_t period = periods(generator);
+            const std::uint64_t delay = periods(generator);
+
+            scheduler.Insert(MakeObject(id), period, delay);
+            next_due[id] = delay + 1;
+            period_of[id] = period;
+        }
+
+        for (std::uint64_t tick = 1; tick <= 300000; tick++)
+        {
+            for (const auto id : scheduler.Advance())
+            {
+                ASSERT_EQ(next_due[id], tick);
+                next_due[id] += period_of[id];
+            }
+        }
+
+        // No object missed a send
+        for (std::uint64_t id = 0; id < 1000; id++)
+        {
+            ASSERT_GT(next_due[id], 300000);
+        }
+    }
+
+    // Test rescheduling, updating, and removing objects
+    TEST(SendSchedulerTest, Modify)
+    {
+        gs::SendScheduler scheduler;
+
+        scheduler.Insert(MakeObject(1), 2);
+        scheduler.Insert(MakeObject(2), 2);
+        ASSERT_EQ(scheduler.Advance().size(), 2);
+
+        // Reinserting replaces the schedule
+        scheduler.Insert(MakeObject(1), 5, 2);
+        ASSERT_EQ(scheduler.Advance(), std::vector<std::uint64_t>());
+        ASSERT_EQ(scheduler.Advance(), std::vector<std::uint64_t>({2}));
+        ASSERT_EQ(scheduler.Advance(), std::vector<std::uint64_t>({1}));
+
+        ASSERT_TRUE(scheduler.Update(MakeObject(2)));
+        ASSERT_FALSE(scheduler.Update(MakeObject(3)));
+        ASSERT_TRUE(scheduler.Remove(2));
+        ASSERT_FALSE(scheduler.Remove(2));
+        ASSERT_EQ(scheduler.GetCount(), 1);
+
+        for (std::size_t tick = 0; tick < 10; tick++)
+        {
+            for (const auto id : scheduler.Advance()) ASSERT_EQ(id, 1);
+        }
+
+        ASSERT_THROW(scheduler.Insert(MakeObject(3), 0),
+                     gs::EncoderException);
+        ASSERT_THROW(scheduler.Insert(gs::HeadIPD1{}, 1),
+                     gs::EncoderException);
+    }
+
+    // Test encoding the objects due
+    TEST(SendSchedulerTest, Encode)
+    {
+        gs::SendScheduler scheduler;
+        gs::Encoder encoder;
+        gs::Decoder decoder;
+        gs::Object1 object1 = MakeObject(1);
+        const std::size_t length = encoder.GetEncodeLength(object1).second;
+        gs::Hand2 hand2{};
+        hand2.id.value = 2;
+
+        scheduler.Insert(object1, 1);
+        scheduler.Insert(hand2, 10);
+
+        // The hand does not fit and is sent on the next tick
+        gs::DataBuffer buffer1(length);
+        ASSERT_EQ(scheduler.Encode(buffer1), gs::EncodeResult(1, length));
+
+        // The latest value of an object is sent
+        object1.position = {1.0f, 2.0f, 3.0f};
+        scheduler.Update(object1);
+
+        gs::DataBuffer buffer2(1500);
+        gs::GSObjects objects;
+        ASSERT_EQ(scheduler.Encode(buffer2).first, 2);
+        decoder.Decode(buffer2, objects);
+        ASSERT_EQ(objects.size(), 2);
+        if (std::holds_alternative<gs::Hand2>(objects[0]))
+        {
+            std::swap(objects[0], objects[1]);
+        }
+        ASSERT_EQ(std::get<gs::Object1>(objects[0]).id.value, 1);
+        ASSERT_EQ(std::get<gs::Object1>(objects[0]).position.z, 3.0f);
+        ASSERT_EQ(std::get<gs::Hand2>(objects[1]).id.value, 2);
+
+        gs::DataBuffer buffer3(1500);
+        ASSERT_EQ(scheduler.Encode(buffer3).first, 1);
+    }
+
+} // namespace